@@ -0,0 +1,160 @@
+/** @file
+    @brief Measures how long it takes to process a device descriptor with a
+    large semantic tree into a path tree, and then to resolve every semantic
+    alias it created to its original source.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/ProcessDeviceDescriptor.h>
+#include <osvr/Common/ResolveTreeNode.h>
+
+// Library/third-party includes
+#include <boost/program_options.hpp>
+#include <json/value.h>
+
+// Standard includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace opt = boost::program_options;
+namespace common = osvr::common;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock clock_type;
+
+static const char DEVICE_NAME[] = "com_osvr_Benchmark/Device";
+static const int SENSORS = 64;
+/// @brief Semantic entries per level before nesting another level.
+static const int ENTRIES_PER_GROUP = 16;
+
+/// @brief Builds a descriptor with a tracker interface and a semantic tree of
+/// @p entries entries, nested in groups, alternating between plain sensor
+/// paths and transforms wrapped around them.
+///
+/// @param [out] paths the absolute paths of the semantic aliases
+static std::string buildDescriptor(int entries,
+                                   std::vector<std::string> &paths) {
+    Json::Value desc(Json::objectValue);
+    desc["interfaces"]["tracker"]["count"] = SENSORS;
+    auto &semantic = desc["semantic"];
+    for (int i = 0; i < entries; ++i) {
+        auto group = "group" + std::to_string(i / ENTRIES_PER_GROUP);
+        auto name = "entry" + std::to_string(i % ENTRIES_PER_GROUP);
+        auto sensor = "tracker/" + std::to_string(i % SENSORS);
+        Json::Value source;
+        if (i % 2 == 0) {
+            source = sensor;
+        } else {
+            // Transforms go in a $target, so as not to be taken for more of
+            // the semantic tree.
+            auto &target = source["$target"];
+            target["rotate"]["axis"] = "x";
+            target["rotate"]["degrees"] = 90;
+            target["child"] = sensor;
+        }
+        semantic[group][name] = source;
+        paths.push_back(std::string("/") + DEVICE_NAME + "/semantic/" + group +
+                        "/" + name);
+    }
+    return desc.toStyledString();
+}
+
+/// @brief Runs @p f @p iterations times
+/// @returns microseconds per run.
+template <typename F> static double timeRuns(int iterations, F &&f) {
+    auto start = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        f();
+    }
+    auto elapsed = clock_type::now() - start;
+    return std::chrono::duration<double, std::micro>(elapsed).count() /
+           double(iterations);
+}
+
+int main(int argc, char *argv[]) {
+    int entries;
+    int iterations;
+    opt::options_description desc("Options");
+    desc.add_options()("help,h", "produce help message")(
+        "entries", opt::value<int>(&entries)->default_value(2000),
+        "number of entries in the semantic tree")(
+        "iterations", opt::value<int>(&iterations)->default_value(10),
+        "number of times to process the descriptor");
+    opt::variables_map vm;
+    try {
+        opt::store(opt::parse_command_line(argc, argv, desc), vm);
+        opt::notify(vm);
+    } catch (std::exception &e) {
+        cerr << "Error parsing command line: " << e.what() << endl;
+        cerr << desc << endl;
+        return 1;
+    }
+    if (vm.count("help")) {
+        cout << desc << endl;
+        return 0;
+    }
+    if (entries < 1 || iterations < 1) {
+        cerr << "Entry and iteration counts must be positive." << endl;
+        return 1;
+    }
+
+    std::vector<std::string> paths;
+    auto descriptor = buildDescriptor(entries, paths);
+
+    auto processing = timeRuns(iterations, [&] {
+        common::PathTree tree;
+        common::processDeviceDescriptorForPathTree(tree, DEVICE_NAME,
+                                                   descriptor);
+    });
+
+    common::PathTree tree;
+    common::processDeviceDescriptorForPathTree(tree, DEVICE_NAME, descriptor);
+    std::size_t resolved = 0;
+    auto resolution = timeRuns(iterations, [&] {
+        for (auto const &path : paths) {
+            if (common::resolveTreeNode(tree, path)) {
+                ++resolved;
+            }
+        }
+    });
+    if (resolved != paths.size() * iterations) {
+        cerr << "Warning: only " << resolved << " of "
+             << paths.size() * iterations << " resolutions succeeded!"
+             << endl;
+    }
+
+    cout << entries << " semantic entries, " << iterations
+         << " iterations: microseconds" << endl;
+    cout << std::fixed << std::setprecision(1);
+    cout << std::left << std::setw(28) << "process descriptor" << std::right
+         << std::setw(12) << processing << endl;
+    cout << std::left << std::setw(28) << "resolve all semantic paths"
+         << std::right << std::setw(12) << resolution << endl;
+    return 0;
+}
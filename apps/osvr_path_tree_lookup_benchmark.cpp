@@ -0,0 +1,216 @@
+/** @file
+    @brief Measures how long it takes to look up every node of synthetic
+    10k-node path trees by path: through getNodeByPath, and component by
+    component both by name (using the child index where there is one) and by
+    a linear scan of each node's children.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/RoutingConstants.h>
+
+// Library/third-party includes
+#include <boost/algorithm/string/split.hpp>
+#include <boost/program_options.hpp>
+
+// Standard includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace opt = boost::program_options;
+namespace common = osvr::common;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock clock_type;
+
+/// @brief Adds @p nodes nodes below the root, @p fanout children per
+/// node, breadth first.
+/// @returns the paths of the new nodes
+static std::vector<std::string> buildTree(common::PathTree &tree, int nodes,
+                                          int fanout) {
+    std::vector<std::string> ret;
+    std::vector<std::string> parents(1, "");
+    std::size_t parent = 0;
+    while (int(ret.size()) < nodes) {
+        for (int i = 0; i < fanout && int(ret.size()) < nodes; ++i) {
+            ret.push_back(parents[parent] + "/node" + std::to_string(i));
+            tree.getNodeByPath(ret.back());
+            parents.push_back(ret.back());
+        }
+        ++parent;
+    }
+    return ret;
+}
+
+/// @brief Finds a child by comparing each child's name in turn, the way
+/// every lookup worked before the child index.
+struct LinearChildFinder {
+    void operator()(common::PathNode const &node) {
+        if (nullptr == found && node.getName() == *name) {
+            found = &node;
+        }
+    }
+    std::string const *name;
+    common::PathNode const *found;
+};
+
+static common::PathNode const *
+linearChildLookup(common::PathNode const &node, std::string const &name) {
+    LinearChildFinder finder{&name, nullptr};
+    node.visitConstChildren(finder);
+    return finder.found;
+}
+
+static common::PathNode const *
+indexedChildLookup(common::PathNode const &node, std::string const &name) {
+    try {
+        return &node.getChildByName(name);
+    } catch (osvr::util::tree::NoSuchChild &) {
+        return nullptr;
+    }
+}
+
+/// @brief Splits paths into their components ahead of time, so the two
+/// component-wise lookups time only the child lookups.
+static std::vector<std::vector<std::string> >
+splitPaths(std::vector<std::string> const &paths) {
+    std::vector<std::vector<std::string> > ret;
+    for (auto const &path : paths) {
+        std::vector<std::string> components;
+        // Skip the empty component before the leading separator.
+        boost::algorithm::split(components, path.substr(1), [](char c) {
+            return c == common::getPathSeparatorCharacter();
+        });
+        ret.push_back(std::move(components));
+    }
+    return ret;
+}
+
+template <typename F>
+static bool lookupComponents(common::PathNode const &root,
+                             std::vector<std::string> const &components,
+                             F &&childLookup) {
+    auto node = &root;
+    for (auto const &component : components) {
+        node = childLookup(*node, component);
+        if (nullptr == node) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Runs @p f on every path, @p iterations times
+/// @returns nanoseconds per lookup.
+template <typename PathType, typename F>
+static double timeLookups(std::vector<PathType> const &paths,
+                          int iterations, F &&f) {
+    std::size_t found = 0;
+    auto start = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (auto const &path : paths) {
+            if (f(path)) {
+                ++found;
+            }
+        }
+    }
+    auto elapsed = clock_type::now() - start;
+    if (found != paths.size() * iterations) {
+        cerr << "Warning: only " << found << " of "
+             << paths.size() * iterations << " lookups succeeded!" << endl;
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           double(paths.size() * iterations);
+}
+
+int main(int argc, char *argv[]) {
+    int nodes;
+    int iterations;
+    opt::options_description desc("Options");
+    desc.add_options()("help,h", "produce help message")(
+        "nodes", opt::value<int>(&nodes)->default_value(10000),
+        "number of nodes in each synthetic tree")(
+        "iterations", opt::value<int>(&iterations)->default_value(10),
+        "number of times to look up every node");
+    opt::variables_map vm;
+    try {
+        opt::store(opt::parse_command_line(argc, argv, desc), vm);
+        opt::notify(vm);
+    } catch (std::exception &e) {
+        cerr << "Error parsing command line: " << e.what() << endl;
+        cerr << desc << endl;
+        return 1;
+    }
+    if (vm.count("help")) {
+        cout << desc << endl;
+        return 0;
+    }
+    if (nodes < 1 || iterations < 1) {
+        cerr << "Node and iteration counts must be positive." << endl;
+        return 1;
+    }
+
+    struct Shape {
+        const char *name;
+        int fanout;
+    };
+    // Flat (like one device with many sensors), wide (like many devices
+    // with many sensors each), and narrow and deep.
+    const Shape shapes[] = {{"flat", nodes}, {"wide", 100}, {"narrow", 4}};
+
+    cout << nodes << " nodes, " << iterations
+         << " iterations: nanoseconds per lookup" << endl;
+    cout << std::left << std::setw(10) << "shape" << std::right
+         << std::setw(16) << "getNodeByPath" << std::setw(12) << "by name"
+         << std::setw(14) << "linear scan" << endl;
+    cout << std::fixed << std::setprecision(1);
+    for (auto const &shape : shapes) {
+        common::PathTree tree;
+        auto paths = buildTree(tree, nodes, shape.fanout);
+        auto components = splitPaths(paths);
+        common::PathTree const &constTree = tree;
+        auto &root = constTree.getRoot();
+
+        auto full = timeLookups(paths, iterations, [&](
+            std::string const &path) {
+            return !constTree.getNodeByPath(path).getName().empty();
+        });
+        auto byName = timeLookups(components, iterations, [&](
+            std::vector<std::string> const &path) {
+            return lookupComponents(root, path, &indexedChildLookup);
+        });
+        auto linear = timeLookups(components, iterations, [&](
+            std::vector<std::string> const &path) {
+            return lookupComponents(root, path, &linearChildLookup);
+        });
+        cout << std::left << std::setw(10) << shape.name << std::right
+             << std::setw(16) << full << std::setw(12) << byName
+             << std::setw(14) << linear << endl;
+    }
+    return 0;
+}
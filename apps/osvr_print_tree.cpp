@@ -24,6 +24,8 @@
 
 // Internal Includes
 #include <osvr/ClientKit/Context.h>
+#include <osvr/ClientKit/Interface.h>
+#include <osvr/ClientKit/InterfaceLatencyC.h>
 #include <osvr/Common/ClientContext.h>
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Common/ResolveFullTree.h>
@@ -45,6 +47,9 @@
 #include <iomanip>
 #include <thread>
 #include <chrono>
+#include <map>
+#include <string>
+#include <vector>
 
 struct Options {
     bool showAliasSource;
@@ -53,13 +58,65 @@ struct Options {
     bool showDeviceDescriptor;
     bool showSensors;
     bool showStringData;
+    double latencySeconds;
 };
 
+/// @brief Latency statistics measured for an alias.
+struct LatencyResult {
+    OSVR_LatencyStatistics received;
+    OSVR_LatencyStatistics dispatched;
+};
+typedef std::map<std::string, LatencyResult> LatencyResults;
+
+/// @brief Connects to every alias in the tree and measures the latency of
+/// the reports received for the given number of seconds.
+static LatencyResults measureLatency(osvr::clientkit::ClientContext &context,
+                                     osvr::common::PathTree const &pathTree,
+                                     double seconds) {
+    typedef std::pair<std::string, osvr::clientkit::Interface> PathInterface;
+    std::vector<PathInterface> ifaces;
+    osvr::util::traverseWith(
+        pathTree.getRoot(), [&](osvr::common::PathNode const &node) {
+            if (boost::get<osvr::common::elements::AliasElement>(
+                    &node.value())) {
+                auto path = osvr::common::getFullPath(node);
+                auto iface = context.getInterface(path);
+                osvrClientSetLatencyStatisticsEnabled(iface.get(), OSVR_TRUE);
+                ifaces.emplace_back(path, iface);
+            }
+        });
+
+    std::cerr << "Measuring latency on " << ifaces.size() << " aliases for "
+              << seconds << " seconds..." << std::endl;
+    auto end = std::chrono::steady_clock::now() +
+               std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                   std::chrono::duration<double>(seconds));
+    while (std::chrono::steady_clock::now() < end) {
+        context.update();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    LatencyResults ret;
+    for (auto &pathIface : ifaces) {
+        auto iface = pathIface.second.get();
+        LatencyResult result;
+        osvrClientGetLatencyStatistics(iface, OSVR_LATENCY_STAGE_RECEIVED,
+                                       &result.received);
+        osvrClientGetLatencyStatistics(iface, OSVR_LATENCY_STAGE_DISPATCHED,
+                                       &result.dispatched);
+        if (result.received.count > 0) {
+            ret[pathIface.first] = result;
+        }
+        pathIface.second.free();
+    }
+    return ret;
+}
+
 class TreeNodePrinter : public boost::static_visitor<>, boost::noncopyable {
   public:
     /// @brief Constructor
-    TreeNodePrinter(Options opts)
-        : boost::static_visitor<>(), m_opts(opts),
+    TreeNodePrinter(Options opts, LatencyResults const &latency)
+        : boost::static_visitor<>(), m_opts(opts), m_latency(latency),
           m_maxTypeLen(osvr::common::elements::getMaxTypeNameLength()),
           m_os(std::cout), m_indentStream{m_maxTypeLen + 2 + 1 + 2, m_os} {
         // Some initial space to set the output off.
@@ -93,6 +150,12 @@ class TreeNodePrinter : public boost::static_visitor<>, boost::noncopyable {
             m_indentStream << "Priority: " << osvr::common::outputPriority(
                                                   elt.priority()) << std::endl;
         }
+        auto latency = m_latency.find(osvr::common::getFullPath(node));
+        if (latency != m_latency.end()) {
+            m_outputLatency("Latency to receive", latency->second.received);
+            m_outputLatency("Latency to dispatch",
+                            latency->second.dispatched);
+        }
     }
     /// @brief Print Devices
     void operator()(osvr::common::PathNode const &node,
@@ -133,7 +196,18 @@ class TreeNodePrinter : public boost::static_visitor<>, boost::noncopyable {
              << "] " << osvr::common::getFullPath(node);
         return m_os;
     }
+
+    void m_outputLatency(const char *label,
+                         OSVR_LatencyStatistics const &stats) {
+        m_indentStream << label << " (us, " << stats.count
+                       << " reports): min " << stats.minimum << ", median "
+                       << stats.median << ", 90% " << stats.percentile90
+                       << ", 99% " << stats.percentile99 << ", 99.9% "
+                       << stats.percentile999 << ", max " << stats.maximum
+                       << std::endl;
+    }
     Options m_opts;
+    LatencyResults const &m_latency;
     size_t m_maxTypeLen;
     std::ostream &m_os;
     osvr::util::IndentingStream m_indentStream;
@@ -152,6 +226,7 @@ int main(int argc, char *argv[]) {
         ("show-device-descriptors", po::value<bool>(&opts.showDeviceDescriptor)->default_value(false), "Whether or not to show the JSON descriptors associated with each device")
         ("show-sensors", po::value<bool>(&opts.showSensors)->default_value(true), "Whether or not to show the 'sensor' nodes")
         ("show-string-data", po::value<bool>(&opts.showStringData)->default_value(true), "Whether or not to show the data in 'string' nodes")
+        ("latency", po::value<double>(&opts.latencySeconds)->default_value(0), "Seconds to spend measuring the latency of reports to each alias: 0 to skip")
         ;
     // clang-format on
     po::variables_map vm;
@@ -179,9 +254,10 @@ int main(int argc, char *argv[]) {
     }
 
     osvr::common::PathTree pathTree;
+    LatencyResults latency;
     {
         /// We only actually need the client open for long enough to get the
-        /// path tree and clone it.
+        /// path tree and clone it (and measure latency, if requested).
         osvr::clientkit::ClientContext context("com.osvr.tools.printtree");
 
         if (!context.checkStatus()) {
@@ -196,9 +272,13 @@ int main(int argc, char *argv[]) {
         osvr::common::clonePathTree(context.get()->getPathTree(), pathTree);
         /// Resolve all aliases
         osvr::common::resolveFullTree(pathTree);
+
+        if (opts.latencySeconds > 0) {
+            latency = measureLatency(context, pathTree, opts.latencySeconds);
+        }
     }
 
-    TreeNodePrinter printer{opts};
+    TreeNodePrinter printer{opts, latency};
     /// Now traverse for output
     osvr::util::traverseWith(
         pathTree.getRoot(), [&printer](osvr::common::PathNode const &node) {
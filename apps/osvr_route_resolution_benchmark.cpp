@@ -0,0 +1,195 @@
+/** @file
+    @brief Measures how long it takes to resolve every alias in a synthetic
+    path tree to its original source, directly and through the resolved-route
+    cache.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/ResolvedRouteCache.h>
+
+// Library/third-party includes
+#include <boost/program_options.hpp>
+#include <json/value.h>
+
+// Standard includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace opt = boost::program_options;
+namespace common = osvr::common;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock clock_type;
+
+static const int SENSORS_PER_DEVICE = 16;
+
+/// @brief Builds a tree with enough devices for the requested number of
+/// aliases, and aliases of three kinds in turn: a plain path to a sensor, a
+/// transform wrapped around a sensor, and a transform wrapped around the
+/// previous alias.
+///
+/// @returns the alias paths
+static std::vector<std::string> buildTree(common::PathTree &tree,
+                                          int aliases) {
+    using namespace common::elements;
+    static const std::string PLUGIN = "com_osvr_Benchmark";
+    tree.getNodeByPath("/" + PLUGIN, PluginElement());
+    auto devices = aliases / SENSORS_PER_DEVICE + 1;
+    for (int i = 0; i < devices; ++i) {
+        auto device = PLUGIN + "/Device" + std::to_string(i);
+        tree.getNodeByPath("/" + device,
+                           DeviceElement::createVRPNDeviceElement(
+                               device, "localhost"));
+        tree.getNodeByPath("/" + device + "/tracker", InterfaceElement());
+    }
+
+    std::vector<std::string> ret;
+    for (int i = 0; i < aliases; ++i) {
+        auto sensorPath = "/" + PLUGIN + "/Device" +
+                          std::to_string(i / SENSORS_PER_DEVICE) +
+                          "/tracker/" + std::to_string(i % SENSORS_PER_DEVICE);
+        auto aliasPath = "/bench/alias" + std::to_string(i);
+        std::string source;
+        switch (i % 3) {
+        case 0:
+            source = sensorPath;
+            break;
+        case 1: {
+            Json::Value val(Json::objectValue);
+            val["rotate"]["axis"] = "x";
+            val["rotate"]["degrees"] = 90;
+            val["child"] = sensorPath;
+            source = val.toStyledString();
+            break;
+        }
+        case 2: {
+            Json::Value val(Json::objectValue);
+            val["translate"] = Json::Value(Json::arrayValue);
+            val["translate"].append(0.1);
+            val["translate"].append(0.);
+            val["translate"].append(0.);
+            val["child"] = ret.back();
+            source = val.toStyledString();
+            break;
+        }
+        }
+        tree.getNodeByPath(aliasPath, AliasElement(source));
+        ret.push_back(aliasPath);
+    }
+    return ret;
+}
+
+/// @brief Runs @p f on every path, @p iterations times
+/// @returns nanoseconds per resolution.
+template <typename F>
+static double timeResolutions(std::vector<std::string> const &paths,
+                              int iterations, F &&f) {
+    std::size_t resolved = 0;
+    auto start = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (auto const &path : paths) {
+            if (f(path)) {
+                ++resolved;
+            }
+        }
+    }
+    auto elapsed = clock_type::now() - start;
+    if (resolved != paths.size() * iterations) {
+        cerr << "Warning: only " << resolved << " of "
+             << paths.size() * iterations << " resolutions succeeded!"
+             << endl;
+    }
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           double(paths.size() * iterations);
+}
+
+int main(int argc, char *argv[]) {
+    int aliases;
+    int iterations;
+    opt::options_description desc("Options");
+    desc.add_options()("help,h", "produce help message")(
+        "aliases", opt::value<int>(&aliases)->default_value(5000),
+        "number of aliases in the synthetic tree")(
+        "iterations", opt::value<int>(&iterations)->default_value(20),
+        "number of times to resolve every alias");
+    opt::variables_map vm;
+    try {
+        opt::store(opt::parse_command_line(argc, argv, desc), vm);
+        opt::notify(vm);
+    } catch (std::exception &e) {
+        cerr << "Error parsing command line: " << e.what() << endl;
+        cerr << desc << endl;
+        return 1;
+    }
+    if (vm.count("help")) {
+        cout << desc << endl;
+        return 0;
+    }
+    if (aliases < 1 || iterations < 1) {
+        cerr << "Alias and iteration counts must be positive." << endl;
+        return 1;
+    }
+
+    common::PathTree tree;
+    auto paths = buildTree(tree, aliases);
+    common::ResolvedRouteCache cache;
+
+    auto uncached = timeResolutions(paths, iterations, [&](
+        std::string const &path) {
+        return common::resolveTreeNode(tree, path).is_initialized();
+    });
+    auto cold = timeResolutions(paths, iterations, [&](
+        std::string const &path) {
+        // As if the tree changed before every lookup.
+        cache.invalidate();
+        return cache.resolve(tree, path).is_initialized();
+    });
+    // Fill the cache for the current generation.
+    cache.invalidate();
+    for (auto const &path : paths) {
+        cache.resolve(tree, path);
+    }
+    auto warm = timeResolutions(paths, iterations, [&](
+        std::string const &path) {
+        return cache.resolve(tree, path).is_initialized();
+    });
+
+    cout << paths.size() << " aliases, " << iterations
+         << " iterations: nanoseconds per resolution" << endl;
+    cout << std::fixed << std::setprecision(1);
+    cout << std::left << std::setw(16) << "uncached" << std::right
+         << std::setw(12) << uncached << endl;
+    cout << std::left << std::setw(16) << "cache (miss)" << std::right
+         << std::setw(12) << cold << endl;
+    cout << std::left << std::setw(16) << "cache (hit)" << std::right
+         << std::setw(12) << warm << endl;
+    return 0;
+}
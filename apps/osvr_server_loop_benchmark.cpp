@@ -0,0 +1,224 @@
+/** @file
+    @brief Measures, for each server main loop idle mode, how long a report
+    from an async device waits before the server main loop handles it, and
+    how much CPU time the process uses meanwhile.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Server/Server.h>
+#include <osvr/Connection/Connection.h>
+#include <osvr/Connection/DeviceInitObject.h>
+#include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/MessageType.h>
+#include <osvr/Util/Microsleep.h>
+
+// Library/third-party includes
+#include <boost/program_options.hpp>
+#include <boost/chrono/process_cpu_clocks.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opt = boost::program_options;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock clock_type;
+
+enum class IdleMode { Yield, Sleep, Wait };
+
+static const char *getModeName(IdleMode mode) {
+    switch (mode) {
+    case IdleMode::Yield:
+        return "yield";
+    case IdleMode::Sleep:
+        return "sleep";
+    case IdleMode::Wait:
+        return "wait";
+    }
+    return "";
+}
+
+struct BenchmarkOptions {
+    int seconds;
+    int rate;
+    int sleepTime;
+};
+
+struct BenchmarkResults {
+    std::vector<double> latencies;
+    double cpuPercent;
+};
+
+static BenchmarkResults runMode(IdleMode mode, BenchmarkOptions const &opts) {
+    BenchmarkResults results;
+    auto conn = osvr::connection::Connection::createLocalConnection();
+    auto server = osvr::server::Server::create(conn);
+    server->setSleepTime(mode == IdleMode::Yield ? 0 : opts.sleepTime);
+    server->setWaitForActivity(mode == IdleMode::Wait);
+
+    auto msgType = conn->registerMessageType("com.osvr.benchmark.report");
+
+    /// Time (since the clock epoch) at which the device thread sent the
+    /// latest report not yet seen by the main loop, or 0 if none.
+    std::atomic<clock_type::rep> sentAt(0);
+
+    osvr::connection::DeviceInitObject init(conn);
+    init.setName("LoopBenchmark");
+    auto token = OSVR_DeviceTokenObject::createAsyncDevice(init);
+    auto tokenPtr = token.get();
+    auto const period = 1000000 / opts.rate;
+    token->setUpdateCallback([&, tokenPtr, period] {
+        osvr::util::time::microsleep(period);
+        // Noted before sending, so the main loop can't handle the report
+        // before we've recorded when it was sent.
+        sentAt = clock_type::now().time_since_epoch().count();
+        const char payload[] = "report";
+        tokenPtr->sendData(msgType.get(), payload, sizeof(payload));
+        return OSVR_RETURN_SUCCESS;
+    });
+
+    /// Only called from the server thread.
+    server->registerMainloopMethod([&] {
+        auto sent = sentAt.exchange(0);
+        if (sent != 0) {
+            auto delay = clock_type::now() -
+                         clock_type::time_point(clock_type::duration(sent));
+            results.latencies.push_back(
+                std::chrono::duration<double, std::micro>(delay).count());
+        }
+    });
+
+    auto cpuStart = boost::chrono::process_cpu_clock::now();
+    auto wallStart = clock_type::now();
+    server->start();
+    std::this_thread::sleep_for(std::chrono::seconds(opts.seconds));
+    server->stop();
+    auto wallElapsed = clock_type::now() - wallStart;
+    auto cpuElapsed =
+        (boost::chrono::process_cpu_clock::now() - cpuStart).count();
+
+    // Stop the device thread before the connection goes away.
+    token.reset();
+
+    auto cpuNanoseconds = double(cpuElapsed.user + cpuElapsed.system);
+    auto wallNanoseconds = double(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(wallElapsed)
+            .count());
+    results.cpuPercent = 100.0 * cpuNanoseconds / wallNanoseconds;
+    return results;
+}
+
+static void printResults(IdleMode mode, BenchmarkResults &results) {
+    auto &lat = results.latencies;
+    cout << std::left << std::setw(8) << getModeName(mode) << std::right
+         << std::fixed << std::setprecision(1);
+    if (lat.empty()) {
+        cout << "no reports handled" << endl;
+        return;
+    }
+    std::sort(begin(lat), end(lat));
+    double sum = 0;
+    for (auto val : lat) {
+        sum += val;
+    }
+    auto percentile = [&](double p) {
+        return lat[std::min(lat.size() - 1, std::size_t(p * lat.size()))];
+    };
+    cout << std::setw(10) << lat.size() << std::setw(12) << sum / lat.size()
+         << std::setw(12) << percentile(0.5) << std::setw(12)
+         << percentile(0.99) << std::setw(12) << lat.back() << std::setw(10)
+         << results.cpuPercent << endl;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOptions opts;
+    std::string modeName;
+    opt::options_description desc("Options");
+    desc.add_options()("help,h", "produce help message")(
+        "seconds", opt::value<int>(&opts.seconds)->default_value(5),
+        "how long to run each mode")(
+        "rate", opt::value<int>(&opts.rate)->default_value(500),
+        "reports per second sent by the async device")(
+        "sleep", opt::value<int>(&opts.sleepTime)->default_value(1000),
+        "server sleep time in microseconds (the longest wait in wait mode)")(
+        "mode", opt::value<std::string>(&modeName)->default_value("all"),
+        "idle mode to measure: yield, sleep, wait, or all");
+    opt::variables_map vm;
+    try {
+        opt::store(opt::parse_command_line(argc, argv, desc), vm);
+        opt::notify(vm);
+    } catch (std::exception &e) {
+        cerr << "Error parsing command line: " << e.what() << endl;
+        cerr << desc << endl;
+        return 1;
+    }
+    if (vm.count("help")) {
+        cout << desc << endl;
+        return 0;
+    }
+    if (opts.seconds < 1 || opts.rate < 1 || opts.rate > 1000000) {
+        cerr << "Duration and rate must be positive, and rate at most 1 MHz."
+             << endl;
+        return 1;
+    }
+
+    std::vector<IdleMode> modes;
+    for (auto mode : {IdleMode::Yield, IdleMode::Sleep, IdleMode::Wait}) {
+        if (modeName == "all" || modeName == getModeName(mode)) {
+            modes.push_back(mode);
+        }
+    }
+    if (modes.empty()) {
+        cerr << "Unrecognized mode: " << modeName << endl;
+        return 1;
+    }
+
+    cout << "Async device at " << opts.rate << " Hz, sleep time "
+         << opts.sleepTime << " us, " << opts.seconds << " s per mode.\n"
+         << "Latencies in microseconds from report sent to handled by the "
+            "server main loop.\n"
+         << endl;
+    cout << std::left << std::setw(8) << "mode" << std::right << std::setw(10)
+         << "reports" << std::setw(12) << "mean" << std::setw(12) << "median"
+         << std::setw(12) << "p99" << std::setw(12) << "max" << std::setw(10)
+         << "CPU %" << endl;
+    for (auto mode : modes) {
+        try {
+            auto results = runMode(mode, opts);
+            printResults(mode, results);
+        } catch (std::exception &e) {
+            cerr << getModeName(mode) << ": " << e.what() << endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,348 @@
+/** @file
+    @brief Measures the cost of delivering the poses of many tracker sensors
+    sampled at the same time, over a loopback VRPN connection: as one standard
+    tracker message per sensor, and as a single pose batch message.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerPoseBatch.h>
+
+// Library/third-party includes
+#include <boost/program_options.hpp>
+#include <vrpn_ConnectionPtr.h>
+#include <vrpn_Tracker.h>
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace opt = boost::program_options;
+namespace common = osvr::common;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock clock_type;
+
+static const char DEVICE_NAME[] = "BatchBenchmark";
+
+struct BenchmarkOptions {
+    int seconds;
+    int rate;
+    int sensors;
+    int port;
+};
+
+struct FrameTimes {
+    /// @brief Microseconds to encode the frame and flush it to the socket.
+    std::vector<double> send;
+    /// @brief Microseconds from then until the client has dispatched a
+    /// callback for every sensor in the frame.
+    std::vector<double> receive;
+};
+
+/// @brief The client end: counts the tracker callbacks it dispatches, from
+/// either kind of message.
+class Receiver {
+  public:
+    Receiver(vrpn_ConnectionPtr const &conn, std::string const &src)
+        : m_conn(conn), m_remote(src.c_str(), conn.get()), m_reports(0),
+          m_checksum(0) {
+        m_remote.register_change_handler(this, &Receiver::handle);
+        m_batchType = m_conn->register_message_type(
+            common::messages::TrackerPoseBatch::identifier());
+        m_sender = m_conn->register_sender(DEVICE_NAME);
+        m_conn->register_handler(m_batchType, &Receiver::handleBatch, this,
+                                 m_sender);
+    }
+    ~Receiver() {
+        m_conn->unregister_handler(m_batchType, &Receiver::handleBatch, this,
+                                   m_sender);
+        m_remote.unregister_change_handler(this, &Receiver::handle);
+    }
+
+    void mainloop() { m_remote.mainloop(); }
+    bool connected() { return 0 != m_conn->connected(); }
+    std::size_t getReports() const { return m_reports; }
+    void resetReports() { m_reports = 0; }
+    double getChecksum() const { return m_checksum; }
+
+  private:
+    static void VRPN_CALLBACK handle(void *userdata, vrpn_TRACKERCB info) {
+        auto self = static_cast<Receiver *>(userdata);
+        self->m_report(info.sensor, info.pos[0]);
+    }
+
+    static int VRPN_CALLBACK handleBatch(void *userdata,
+                                         vrpn_HANDLERPARAM p) {
+        auto self = static_cast<Receiver *>(userdata);
+        auto bufReader = common::readExternalBuffer(p.buffer, p.payload_len);
+        common::messages::TrackerPoseBatch::MessageSerialization msg(
+            self->m_poses);
+        common::deserialize(bufReader, msg);
+        for (auto const &entry : self->m_poses) {
+            self->m_report(entry.sensor, entry.pose.translation.data[0]);
+        }
+        return 0;
+    }
+
+    void m_report(vrpn_int32 sensor, double x) {
+        ++m_reports;
+        m_checksum += sensor + x;
+    }
+
+    vrpn_ConnectionPtr m_conn;
+    vrpn_Tracker_Remote m_remote;
+    vrpn_int32 m_batchType;
+    vrpn_int32 m_sender;
+    common::SensorPoseList m_poses;
+    std::size_t m_reports;
+    double m_checksum;
+};
+
+/// @brief The server end, sending a frame of poses either way.
+class Sender {
+  public:
+    Sender(vrpn_ConnectionPtr const &conn, int sensors)
+        : m_conn(conn), m_tracker(DEVICE_NAME, conn.get(), sensors),
+          m_poses(sensors), m_sensors(sensors) {
+        m_batchType = m_conn->register_message_type(
+            common::messages::TrackerPoseBatch::identifier());
+        m_sender = m_conn->register_sender(DEVICE_NAME);
+        for (int i = 0; i < sensors; ++i) {
+            m_sensors[i] = i;
+        }
+    }
+
+    void setFrame(int frame) {
+        for (std::size_t i = 0; i < m_poses.size(); ++i) {
+            auto &pose = m_poses[i];
+            pose.translation.data[0] = 0.001 * frame;
+            pose.translation.data[1] = 0.01 * i;
+            pose.translation.data[2] = -1;
+            pose.rotation.data[0] = 1;
+            pose.rotation.data[1] = 0;
+            pose.rotation.data[2] = 0;
+            pose.rotation.data[3] = 0;
+        }
+    }
+
+    void sendPerSensor() {
+        struct timeval now;
+        vrpn_gettimeofday(&now, nullptr);
+        for (std::size_t i = 0; i < m_poses.size(); ++i) {
+            auto const &pose = m_poses[i];
+            // quatlib order: x, y, z, w
+            vrpn_float64 quat[] = {
+                pose.rotation.data[1], pose.rotation.data[2],
+                pose.rotation.data[3], pose.rotation.data[0]};
+            m_tracker.report_pose(static_cast<int>(i), now,
+                                  pose.translation.data, quat);
+        }
+        mainloop();
+    }
+
+    /// @brief Sends the poses as the server does: in batches that each fit
+    /// in a datagram.
+    void sendBatch() {
+        typedef common::messages::TrackerPoseBatch TrackerPoseBatch;
+        static const std::size_t POSES_PER_MESSAGE =
+            TrackerPoseBatch::getMaxPoses(vrpn_CONNECTION_UDP_BUFLEN);
+        struct timeval now;
+        vrpn_gettimeofday(&now, nullptr);
+        for (std::size_t offset = 0; offset < m_poses.size();
+             offset += POSES_PER_MESSAGE) {
+            auto n = (std::min)(POSES_PER_MESSAGE, m_poses.size() - offset);
+            m_batch.resize(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                m_batch[i].sensor = m_sensors[offset + i];
+                m_batch[i].pose = m_poses[offset + i];
+            }
+            common::Buffer<> buf;
+            TrackerPoseBatch::MessageSerialization msg(m_batch);
+            common::serialize(buf, msg);
+            m_conn->pack_message(static_cast<vrpn_uint32>(buf.size()), now,
+                                 m_batchType, m_sender, buf.data(),
+                                 vrpn_CONNECTION_LOW_LATENCY);
+        }
+        mainloop();
+    }
+
+    void mainloop() {
+        m_tracker.mainloop();
+        m_conn->mainloop();
+    }
+
+  private:
+    vrpn_ConnectionPtr m_conn;
+    vrpn_Tracker_Server m_tracker;
+    vrpn_int32 m_batchType;
+    vrpn_int32 m_sender;
+    std::vector<OSVR_PoseState> m_poses;
+    std::vector<OSVR_ChannelCount> m_sensors;
+    common::SensorPoseList m_batch;
+};
+
+static double toMicroseconds(clock_type::duration d) {
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+
+/// @returns false if the frame didn't arrive within a second.
+static bool receiveFrame(Sender &sender, Receiver &receiver,
+                         std::size_t expected) {
+    auto deadline = clock_type::now() + std::chrono::seconds(1);
+    while (receiver.getReports() < expected) {
+        if (clock_type::now() > deadline) {
+            return false;
+        }
+        sender.mainloop();
+        receiver.mainloop();
+    }
+    return true;
+}
+
+static FrameTimes runMode(bool batch, Sender &sender, Receiver &receiver,
+                          BenchmarkOptions const &opts) {
+    FrameTimes times;
+    auto const frames = opts.seconds * opts.rate;
+    auto const period = std::chrono::duration_cast<clock_type::duration>(
+        std::chrono::duration<double>(1.0 / opts.rate));
+    auto nextFrame = clock_type::now();
+    for (int frame = 0; frame < frames; ++frame) {
+        std::this_thread::sleep_until(nextFrame);
+        nextFrame += period;
+        sender.setFrame(frame);
+        receiver.resetReports();
+
+        auto start = clock_type::now();
+        if (batch) {
+            sender.sendBatch();
+        } else {
+            sender.sendPerSensor();
+        }
+        auto sent = clock_type::now();
+        if (!receiveFrame(sender, receiver, opts.sensors)) {
+            cerr << "Timed out waiting for frame " << frame << endl;
+            break;
+        }
+        auto received = clock_type::now();
+        times.send.push_back(toMicroseconds(sent - start));
+        times.receive.push_back(toMicroseconds(received - sent));
+    }
+    return times;
+}
+
+static void printTimes(const char *name, std::vector<double> &vals) {
+    cout << std::left << std::setw(20) << name << std::right;
+    if (vals.empty()) {
+        cout << "no frames delivered" << endl;
+        return;
+    }
+    std::sort(begin(vals), end(vals));
+    double sum = 0;
+    for (auto val : vals) {
+        sum += val;
+    }
+    auto percentile = [&](double p) {
+        return vals[std::min(vals.size() - 1, std::size_t(p * vals.size()))];
+    };
+    cout << std::setw(12) << sum / vals.size() << std::setw(12)
+         << percentile(0.5) << std::setw(12) << percentile(0.99) << endl;
+}
+
+int main(int argc, char *argv[]) {
+    BenchmarkOptions opts;
+    opt::options_description desc("Options");
+    desc.add_options()("help,h", "produce help message")(
+        "seconds", opt::value<int>(&opts.seconds)->default_value(5),
+        "how long to run each mode")(
+        "rate", opt::value<int>(&opts.rate)->default_value(1000),
+        "frames per second")(
+        "sensors", opt::value<int>(&opts.sensors)->default_value(32),
+        "sensors reported in each frame")(
+        "port", opt::value<int>(&opts.port)->default_value(3884),
+        "local port for the loopback VRPN connection");
+    opt::variables_map vm;
+    try {
+        opt::store(opt::parse_command_line(argc, argv, desc), vm);
+        opt::notify(vm);
+    } catch (std::exception &e) {
+        cerr << "Error parsing command line: " << e.what() << endl;
+        cerr << desc << endl;
+        return 1;
+    }
+    if (vm.count("help")) {
+        cout << desc << endl;
+        return 0;
+    }
+    if (opts.seconds < 1 || opts.rate < 1 || opts.sensors < 1) {
+        cerr << "Duration, rate, and sensor count must be positive." << endl;
+        return 1;
+    }
+
+    auto serverConn = vrpn_ConnectionPtr::create_server_connection(opts.port);
+    auto src = std::string(DEVICE_NAME) + "@localhost:" +
+               std::to_string(opts.port);
+    auto clientConn = vrpn_ConnectionPtr::get_connection_by_name(src.c_str());
+    Sender sender(serverConn, opts.sensors);
+    Receiver receiver(clientConn, src);
+
+    auto deadline = clock_type::now() + std::chrono::seconds(5);
+    while (!receiver.connected() || !serverConn->connected()) {
+        if (clock_type::now() > deadline) {
+            cerr << "Could not connect to " << src << endl;
+            return 1;
+        }
+        sender.mainloop();
+        receiver.mainloop();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    cout << opts.sensors << " sensors at " << opts.rate << " Hz, "
+         << opts.seconds << " s per mode.\n"
+         << "Microseconds per frame to encode and send (send), and from then "
+            "until every\nsensor's callback has run on the client (receive).\n"
+         << endl;
+    cout << std::left << std::setw(20) << "" << std::right << std::setw(12)
+         << "mean" << std::setw(12) << "median" << std::setw(12) << "p99"
+         << endl;
+    cout << std::fixed << std::setprecision(1);
+    for (auto batch : {false, true}) {
+        auto times = runMode(batch, sender, receiver, opts);
+        std::string name = batch ? "batch" : "per-sensor";
+        printTimes((name + " send").c_str(), times.send);
+        printTimes((name + " receive").c_str(), times.receive);
+    }
+    // So the optimizer can't discard the work.
+    if (receiver.getChecksum() == 42) {
+        cout << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,152 @@
+/** @file
+    @brief Measures the per-report cost of applying a routing transform to a
+    tracker pose: through the general 4x4 matrix path, and through a
+    CompiledTransform.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+#include <boost/program_options.hpp>
+#include <json/value.h>
+#include <json/reader.h>
+
+// Standard includes
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace opt = boost::program_options;
+namespace common = osvr::common;
+namespace util = osvr::util;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock clock_type;
+
+struct Case {
+    const char *name;
+    const char *json;
+};
+
+static const Case CASES[] = {
+    {"identity", "{}"},
+    {"rotation", R"({"rotate": {"axis": "x", "degrees": 90}, "child": "/a"})"},
+    {"changeBasis",
+     R"({"changeBasis": {"x": "x", "y": "y", "z": "-z"}, "child": "/a"})"},
+    {"rigid", R"({"posttranslate": [0, 0.1, 0],
+        "rotate": {"axis": "y", "degrees": 30}, "child": "/a"})"}};
+
+/// @brief Poses to transform, so that the work can't be hoisted out of the
+/// loop.
+static std::vector<OSVR_Pose3> makePoses(std::size_t n) {
+    std::vector<OSVR_Pose3> ret(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        Eigen::Quaterniond rot(
+            Eigen::AngleAxisd(0.01 * i, Eigen::Vector3d(1, 2, 3).normalized()));
+        util::toQuat(rot, ret[i].rotation);
+        util::vecMap(ret[i].translation) = Eigen::Vector3d(0.001 * i, 1, -1);
+    }
+    return ret;
+}
+
+/// @returns nanoseconds per report
+template <typename F>
+static double timeReports(std::vector<OSVR_Pose3> const &poses,
+                          int iterations, double &checksum, F &&f) {
+    auto start = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (auto pose : poses) {
+            f(pose);
+            checksum += pose.translation.data[0] + osvrQuatGetW(&pose.rotation);
+        }
+    }
+    auto elapsed = clock_type::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() /
+           double(poses.size() * iterations);
+}
+
+int main(int argc, char *argv[]) {
+    int iterations;
+    opt::options_description desc("Options");
+    desc.add_options()("help,h", "produce help message")(
+        "iterations", opt::value<int>(&iterations)->default_value(1000),
+        "number of times to transform the set of 1000 poses");
+    opt::variables_map vm;
+    try {
+        opt::store(opt::parse_command_line(argc, argv, desc), vm);
+        opt::notify(vm);
+    } catch (std::exception &e) {
+        cerr << "Error parsing command line: " << e.what() << endl;
+        cerr << desc << endl;
+        return 1;
+    }
+    if (vm.count("help")) {
+        cout << desc << endl;
+        return 0;
+    }
+    if (iterations < 1) {
+        cerr << "Iteration count must be positive." << endl;
+        return 1;
+    }
+
+    auto poses = makePoses(1000);
+    double checksum = 0;
+    cout << "nanoseconds per report" << endl;
+    cout << std::left << std::setw(14) << "transform" << std::right
+         << std::setw(10) << "matrix" << std::setw(10) << "compiled"
+         << endl;
+    cout << std::fixed << std::setprecision(1);
+    for (auto const &c : CASES) {
+        Json::Value val;
+        Json::Reader reader;
+        reader.parse(c.json, val);
+        common::Transform xform =
+            common::JSONTransformVisitor(val).getTransform();
+        common::CompiledTransform compiled(xform);
+
+        auto matrix = timeReports(poses, iterations, checksum,
+                                  [&](OSVR_Pose3 &pose) {
+            Eigen::Matrix4d mat =
+                xform.transform(util::fromPose(pose).matrix());
+            util::toPose(mat, pose);
+        });
+        auto fused = timeReports(poses, iterations, checksum,
+                                 [&](OSVR_Pose3 &pose) {
+            compiled.apply(pose);
+        });
+        cout << std::left << std::setw(14) << c.name << std::right
+             << std::setw(10) << matrix << std::setw(10) << fused << endl;
+    }
+    // So the optimizer can't discard the work.
+    if (checksum == 42) {
+        cout << endl;
+    }
+    return 0;
+}
@@ -33,9 +33,10 @@
 #include <osvr/Util/UniquePtr.h>
 #include <osvr/Client/InternalInterfaceOwner.h>
 #include <osvr/Util/ContainerWrapper.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
-// - none
+#include <boost/optional.hpp>
 
 // Standard includes
 #include <vector>
@@ -81,6 +82,12 @@ namespace client {
 
         OSVR_CLIENT_EXPORT bool isStartupComplete() const;
 
+        /// @brief Sets the time (typically, when the frame being rendered
+        /// will scan out) that all viewer and eye poses should be predicted
+        /// to, or clears it to use the most recent reports.
+        OSVR_CLIENT_EXPORT void
+        setPoseTime(boost::optional<util::time::TimeValue> const &when);
+
       private:
         friend class DisplayConfigFactory;
         DisplayConfig();
@@ -32,9 +32,10 @@
 #include <osvr/Client/ViewerEye.h>
 #include <osvr/Client/InternalInterfaceOwner.h>
 #include <osvr/Util/ContainerWrapper.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
-// - none
+#include <boost/optional.hpp>
 
 // Standard includes
 #include <utility>
@@ -51,7 +52,8 @@ namespace client {
       public:
         Viewer(Viewer const &) = delete;
         Viewer &operator=(Viewer const &) = delete;
-        Viewer(Viewer &&other) : m_head(std::move(other.m_head)) {}
+        Viewer(Viewer &&other)
+            : m_head(std::move(other.m_head)), m_poseTime(other.m_poseTime) {}
 
         inline OSVR_EyeCount size() const {
             return static_cast<OSVR_EyeCount>(container().size());
@@ -60,10 +62,17 @@ namespace client {
         OSVR_CLIENT_EXPORT OSVR_Pose3 getPose() const;
         OSVR_CLIENT_EXPORT bool hasPose() const;
 
+        /// @brief Sets the time that the poses of the viewer and its eyes
+        /// should be predicted to, or clears it to use the most recent
+        /// report.
+        OSVR_CLIENT_EXPORT void
+        setPoseTime(boost::optional<util::time::TimeValue> const &when);
+
       private:
         friend class DisplayConfigFactory;
         Viewer(OSVR_ClientContext ctx, const char path[]);
         InternalInterfaceOwner m_head;
+        boost::optional<util::time::TimeValue> m_poseTime;
     };
 
 } // namespace client
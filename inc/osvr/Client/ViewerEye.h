@@ -35,6 +35,7 @@
 #include <osvr/Util/Rect.h>
 #include <osvr/Util/MatrixConventionsC.h>
 #include <osvr/Util/RadialDistortionParametersC.h>
+#include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
 #include <boost/optional.hpp>
@@ -66,7 +67,8 @@ namespace client {
               m_offset(std::move(other.m_offset)), m_viewport(other.m_viewport),
               m_unitBounds(std::move(other.m_unitBounds)),
               m_rot180(other.m_rot180), m_pitchTilt(other.m_pitchTilt),
-              m_radDistortParams(std::move(other.m_radDistortParams)) {}
+              m_radDistortParams(std::move(other.m_radDistortParams)),
+              m_poseTime(other.m_poseTime) {}
 
         inline OSVR_SurfaceCount size() const { return 1; }
 #if 0
@@ -84,6 +86,13 @@ namespace client {
         OSVR_CLIENT_EXPORT OSVR_Pose3 getPose() const;
         OSVR_CLIENT_EXPORT bool hasPose() const;
 
+        /// @brief Sets the time (typically, when the frame being rendered
+        /// will scan out) that the pose and view should be predicted to, or
+        /// clears it to use the most recent report.
+        void setPoseTime(boost::optional<util::time::TimeValue> const &when) {
+            m_poseTime = when;
+        }
+
         OSVR_CLIENT_EXPORT Eigen::Matrix4d getView() const;
 
         bool wantDistortion() const {
@@ -131,6 +140,7 @@ namespace client {
         bool m_rot180;
         double m_pitchTilt;
         boost::optional<OSVR_RadialDistortionParameters> m_radDistortParams;
+        boost::optional<util::time::TimeValue> m_poseTime;
     };
 
 } // namespace client
@@ -432,6 +432,21 @@ namespace clientkit {
             return osvrClientCheckDisplayStartup(m_disp) == OSVR_RETURN_SUCCESS;
         }
 
+        /// @brief Predicts viewer and eye poses to the given time (typically,
+        /// when the next frame will scan out) until called again.
+        /// @sa osvrClientSetDisplayPoseTime()
+        void setPoseTime(OSVR_TimeValue const &when) const {
+            ensureValid();
+            osvrClientSetDisplayPoseTime(m_disp, &when);
+        }
+
+        /// @brief Goes back to using the most recent reports for poses.
+        /// @sa osvrClientSetDisplayPoseTime()
+        void clearPoseTime() const {
+            ensureValid();
+            osvrClientSetDisplayPoseTime(m_disp, NULL);
+        }
+
         /// @name Child-related methods
         /// @{
         OSVR_ViewerCount getNumViewers() const {
@@ -39,6 +39,7 @@
 #include <osvr/Util/Pose3C.h>
 #include <osvr/Util/BoolC.h>
 #include <osvr/Util/RadialDistortionParametersC.h>
+#include <osvr/Util/TimeValueC.h>
 
 /* Library/third-party includes */
 /* none */
@@ -126,6 +127,24 @@ osvrClientFreeDisplay(OSVR_DisplayConfig disp);
 OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
 osvrClientCheckDisplayStartup(OSVR_DisplayConfig disp);
 
+/** @brief Sets the time that viewer and eye poses (and view matrices) should
+    be predicted to - typically, when the frame about to be rendered will scan
+    out - until called again.
+
+    Poses are interpolated or extrapolated from a short history of tracker
+    reports. If that history can't provide a pose for the time, the most
+    recent report is used as before.
+
+    @param disp Display config object
+    @param when Time to predict to, or NULL to go back to using the most
+    recent report.
+
+    @return OSVR_RETURN_FAILURE if a null config was passed.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetDisplayPoseTime(OSVR_DisplayConfig disp,
+                             const struct OSVR_TimeValue *when);
+
 /** @brief A display config can have one (or theoretically more) viewers:
     retrieve the viewer count.
 
@@ -0,0 +1,121 @@
+/** @file
+    @brief Header
+
+    Must be c-safe!
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+/*
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#ifndef INCLUDED_InterfaceLatencyC_h_GUID_37881013_553A_4774_A65F_878E80E8A3AC
+#define INCLUDED_InterfaceLatencyC_h_GUID_37881013_553A_4774_A65F_878E80E8A3AC
+
+/* Internal Includes */
+#include <osvr/ClientKit/Export.h>
+#include <osvr/Util/APIBaseC.h>
+#include <osvr/Util/ReturnCodesC.h>
+#include <osvr/Util/AnnotationMacrosC.h>
+#include <osvr/Util/ClientOpaqueTypesC.h>
+#include <osvr/Util/BoolC.h>
+#include <osvr/Util/StdInt.h>
+
+/* Library/third-party includes */
+/* none */
+
+/* Standard includes */
+/* none */
+
+OSVR_EXTERN_C_BEGIN
+/** @addtogroup ClientKit
+@{
+*/
+
+/** @brief The point in a report's trip to the client at which its latency
+    (time since the device timestamp) is measured.
+*/
+typedef enum OSVR_LatencyStage {
+    /** @brief When the report reaches the client interface. */
+    OSVR_LATENCY_STAGE_RECEIVED = 0,
+    /** @brief When the interface's state and callbacks have been updated. */
+    OSVR_LATENCY_STAGE_DISPATCHED = 1
+} OSVR_LatencyStage;
+
+/** @brief Summary of the latencies measured at one stage, in microseconds.
+
+    Values are bucketed, so percentiles are accurate to within about 3%.
+*/
+typedef struct OSVR_LatencyStatistics {
+    /** @brief Number of reports measured. */
+    uint64_t count;
+    uint64_t minimum;
+    double mean;
+    uint64_t median;
+    uint64_t percentile90;
+    uint64_t percentile99;
+    uint64_t percentile999;
+    uint64_t maximum;
+} OSVR_LatencyStatistics;
+
+/** @brief Start or stop measuring the latency of the reports delivered to an
+    interface. Measurement is off by default; enabling it discards any
+    statistics gathered previously.
+
+    Latencies are measured against the device timestamps reported by the
+    server, so are only meaningful when the client and server clocks agree
+    (typically, when they run on the same machine).
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetLatencyStatisticsEnabled(OSVR_ClientInterface iface,
+                                      OSVR_CBool enable);
+
+/** @brief Get a summary of the latencies measured at the given stage.
+
+    Call from the thread that calls osvrClientUpdate().
+
+    @returns OSVR_RETURN_FAILURE if given a null pointer or an invalid stage,
+   or if measurement isn't enabled on the interface.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetLatencyStatistics(OSVR_ClientInterface iface,
+                               OSVR_LatencyStage stage,
+                               OSVR_OUT_PTR OSVR_LatencyStatistics *stats);
+
+/** @brief Get an arbitrary percentile (from 0 to 100) of the latencies
+    measured at the given stage, in microseconds.
+
+    @returns OSVR_RETURN_FAILURE as osvrClientGetLatencyStatistics() does.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientGetLatencyPercentile(OSVR_ClientInterface iface,
+                               OSVR_LatencyStage stage, double percentile,
+                               OSVR_OUT_PTR uint64_t *microseconds);
+
+/** @brief Discard the latencies measured so far on an interface, without
+    stopping measurement.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientResetLatencyStatistics(OSVR_ClientInterface iface);
+
+/** @} */
+OSVR_EXTERN_C_END
+
+#endif
@@ -37,6 +37,7 @@
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ClientReportTypesC.h>
 #include <osvr/Util/TimeValueC.h>
+#include <osvr/Util/StdInt.h>
 
 /* Library/third-party includes */
 /* none */
@@ -66,6 +67,37 @@ OSVR_CALLBACK_METHODS(EyeTrackerBlink)
 
 #undef OSVR_CALLBACK_METHODS
 
+/** @brief Keep a history of the most recent pose reports on an interface, so
+    that osvrGetPoseStateAtTime() can be used. Off (0) by default; 32 is a
+    reasonable capacity for prediction and for looking up poses up to a few
+    frames old.
+
+    @param iface Interface
+    @param capacity Number of pose reports to keep, or 0 to stop keeping
+   (and discard) the history.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrClientSetPoseHistoryCapacity(OSVR_ClientInterface iface,
+                                 uint32_t capacity);
+
+/** @brief Get the pose of an interface at an arbitrary time, from its pose
+    history (see osvrClientSetPoseHistoryCapacity()).
+
+    Between two reports, the pose is interpolated; after the newest report it
+    is predicted, assuming constant linear and angular velocity.
+
+    @param iface Interface
+    @param when Time of interest, such as when the next frame will scan out.
+    @param[out] state The pose at that time.
+
+    @returns OSVR_RETURN_FAILURE if the interface keeps no history, or it has
+   no reports as old as the given time.
+*/
+OSVR_CLIENTKIT_EXPORT OSVR_ReturnCode
+osvrGetPoseStateAtTime(OSVR_ClientInterface iface,
+                       const struct OSVR_TimeValue *when,
+                       OSVR_PoseState *state);
+
 OSVR_EXTERN_C_END
 
 #endif
@@ -31,11 +31,14 @@
 #include <osvr/Common/ClientInterfacePtr.h>
 #include <osvr/Common/InterfaceState.h>
 #include <osvr/Common/InterfaceCallbacks.h>
+#include <osvr/Common/InterfaceLatency.h>
+#include <osvr/Common/PoseHistory.h>
 #include <osvr/Common/StateType.h>
 #include <osvr/Common/ReportStateTraits.h>
 #include <osvr/Common/Tracing.h>
 #include <osvr/Util/ClientOpaqueTypesC.h>
 #include <osvr/Util/ClientCallbackTypesC.h>
+#include <osvr/Util/UniquePtr.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -93,9 +96,40 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     template <typename ReportType>
     void triggerCallbacks(const OSVR_TimeValue &timestamp,
                           ReportType const &report) {
+        if (m_latency) {
+            m_latency->record(osvr::common::LatencyStage::Received,
+                              timestamp);
+        }
         m_setState(timestamp, report,
                    osvr::common::traits::KeepStateForReport<ReportType>());
+        m_addToHistory(timestamp, report);
         m_callbacks.triggerCallbacks(timestamp, report);
+        if (m_latency) {
+            m_latency->record(osvr::common::LatencyStage::Dispatched,
+                              timestamp);
+        }
+    }
+
+    /// @brief Start (discarding any previous statistics) or stop measuring
+    /// the latency of reports delivered to this interface.
+    OSVR_COMMON_EXPORT void enableLatencyStatistics(bool enable);
+
+    /// @brief Get the latency statistics, or nullptr if not enabled.
+    osvr::common::InterfaceLatency *getLatencyStatistics() {
+        return m_latency.get();
+    }
+
+    /// @brief Keep a history of the given number of pose reports (0 to stop
+    /// and discard it), so that getPoseAt() can be used.
+    OSVR_COMMON_EXPORT void setPoseHistoryCapacity(std::size_t capacity);
+
+    /// @brief Get the pose at (interpolated) or predicted to the given time
+    /// from the pose history.
+    ///
+    /// @returns false if there's no history, or the time is older than it.
+    bool getPoseAt(osvr::util::time::TimeValue const &when,
+                   OSVR_Pose3 &pose) const {
+        return m_poseHistory && m_poseHistory->getPoseAt(when, pose);
     }
 
     /// @brief Update any state.
@@ -119,10 +153,22 @@ struct OSVR_ClientInterfaceObject : boost::noncopyable {
     template <typename ReportType>
     void m_setState(const OSVR_TimeValue &, ReportType const &,
                     std::false_type const &) {}
+
+    /// @brief Only pose reports go in the pose history.
+    template <typename ReportType>
+    void m_addToHistory(const OSVR_TimeValue &, ReportType const &) {}
+    void m_addToHistory(const OSVR_TimeValue &timestamp,
+                        OSVR_PoseReport const &report) {
+        if (m_poseHistory) {
+            m_poseHistory->add(timestamp, report.pose);
+        }
+    }
     osvr::common::ClientContext *m_ctx;
     std::string const m_path;
     osvr::common::InterfaceCallbacks m_callbacks;
     osvr::common::InterfaceState m_state;
+    osvr::unique_ptr<osvr::common::InterfaceLatency> m_latency;
+    osvr::unique_ptr<osvr::common::PoseHistory> m_poseHistory;
     boost::any m_data;
     friend struct OSVR_ClientContextObject;
 };
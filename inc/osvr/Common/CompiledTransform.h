@@ -0,0 +1,181 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_CompiledTransform_h_GUID_03BE5D1D_DF5B_438F_BA1A_0EBD9D45F972
+#define INCLUDED_CompiledTransform_h_GUID_03BE5D1D_DF5B_438F_BA1A_0EBD9D45F972
+
+// Internal Includes
+#include <osvr/Common/Transform.h>
+#include <osvr/Util/EigenInterop.h>
+#include <osvr/Util/Pose3C.h>
+
+// Library/third-party includes
+#include <osvr/Util/EigenCoreGeometry.h>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    /// @brief A Transform, reduced once (at construction) to the cheapest
+    /// operation that applies it to a pose.
+    ///
+    /// When the pre and post components are each a rotation, optionally
+    /// combined with a reflection (as in a change of basis that flips
+    /// handedness) and a translation, the transform is applied with
+    /// quaternion products instead of 4x4 matrix products and the matrix to
+    /// quaternion conversion. Anything else (e.g. scaling) falls back to
+    /// the general matrix path.
+    class CompiledTransform {
+      public:
+        enum class Kind {
+            /// @brief Leaves poses unchanged.
+            Identity,
+            /// @brief Only rotates (or changes the basis of) poses.
+            Rotation,
+            /// @brief Rotation and translation.
+            Rigid,
+            /// @brief Needs the full matrix product.
+            Matrix
+        };
+
+        CompiledTransform() : m_kind(Kind::Identity), m_translationSign(1) {
+            m_setIdentity();
+        }
+
+        explicit CompiledTransform(Transform const &xform)
+            : m_kind(Kind::Matrix), m_translationSign(1), m_xform(xform) {
+            m_setIdentity();
+            double preSign = 0;
+            double postSign = 0;
+            if (!m_decompose(xform.getPre(), m_preRotation, m_preTranslation,
+                             preSign) ||
+                !m_decompose(xform.getPost(), m_postRotation,
+                             m_postTranslation, postSign) ||
+                preSign != postSign) {
+                // Either a component isn't rigid (up to reflection), or only
+                // one reflects: the result wouldn't be a pose without the
+                // general path.
+                return;
+            }
+            m_translationSign = postSign;
+            bool rotates = !m_isIdentity(m_preRotation) ||
+                           !m_isIdentity(m_postRotation) || postSign < 0;
+            bool translates = !m_preTranslation.isZero(m_tolerance()) ||
+                              !m_postTranslation.isZero(m_tolerance());
+            if (translates) {
+                m_kind = Kind::Rigid;
+            } else if (rotates) {
+                m_kind = Kind::Rotation;
+            } else {
+                m_kind = Kind::Identity;
+            }
+        }
+
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+        Kind getKind() const { return m_kind; }
+
+        /// @brief Apply the transformation to a pose, in place.
+        void apply(OSVR_Pose3 &pose) const {
+            switch (m_kind) {
+            case Kind::Identity:
+                return;
+            case Kind::Rotation: {
+                Eigen::Quaterniond rot = util::fromQuat(pose.rotation);
+                auto trans = util::vecMap(pose.translation);
+                trans = m_translationSign * (m_postRotation * trans);
+                util::toQuat(
+                    (m_postRotation * rot * m_preRotation).normalized(),
+                    pose.rotation);
+                return;
+            }
+            case Kind::Rigid: {
+                Eigen::Quaterniond rot = util::fromQuat(pose.rotation);
+                auto trans = util::vecMap(pose.translation);
+                trans = m_translationSign *
+                            (m_postRotation *
+                             (rot * m_preTranslation + trans)) +
+                        m_postTranslation;
+                util::toQuat(
+                    (m_postRotation * rot * m_preRotation).normalized(),
+                    pose.rotation);
+                return;
+            }
+            case Kind::Matrix:
+                util::toPose(
+                    m_xform.transform(util::fromPose(pose).matrix()), pose);
+                return;
+            }
+        }
+
+      private:
+        static double m_tolerance() { return 1e-9; }
+
+        void m_setIdentity() {
+            m_preRotation.setIdentity();
+            m_postRotation.setIdentity();
+            m_preTranslation.setZero();
+            m_postTranslation.setZero();
+        }
+
+        static bool m_isIdentity(Eigen::Quaterniond const &q) {
+            return q.vec().isZero(m_tolerance());
+        }
+
+        /// @brief Splits a matrix into sign * rotation, plus translation, if
+        /// it is one.
+        static bool m_decompose(Eigen::Matrix4d const &mat,
+                                Eigen::Quaterniond &rotation,
+                                Eigen::Vector3d &translation, double &sign) {
+            if (!mat.row(3).isApprox(Eigen::RowVector4d(0, 0, 0, 1),
+                                     m_tolerance())) {
+                return false;
+            }
+            Eigen::Matrix3d linear = mat.topLeftCorner<3, 3>();
+            if (!(linear * linear.transpose())
+                     .isApprox(Eigen::Matrix3d::Identity(), m_tolerance())) {
+                return false;
+            }
+            sign = linear.determinant() < 0 ? -1 : 1;
+            rotation = Eigen::Quaterniond(sign * linear).normalized();
+            translation = mat.topRightCorner<3, 1>();
+            return true;
+        }
+
+        Kind m_kind;
+        /// @brief -1 if the pre and post components are both reflections.
+        double m_translationSign;
+        Eigen::Quaterniond m_preRotation;
+        Eigen::Quaterniond m_postRotation;
+        Eigen::Vector3d m_preTranslation;
+        Eigen::Vector3d m_postTranslation;
+        /// @brief The original transform, for Kind::Matrix
+        Transform m_xform;
+    };
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_CompiledTransform_h_GUID_03BE5D1D_DF5B_438F_BA1A_0EBD9D45F972
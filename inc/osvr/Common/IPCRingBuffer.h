@@ -36,6 +36,7 @@
 
 // Standard includes
 #include <string>
+#include <utility>
 
 namespace osvr {
 namespace common {
@@ -62,6 +63,9 @@ namespace common {
     /// segment name and signalling new data, and no guarantee that the data you
     /// were notified about won't be overwritten - just that if you're currently
     /// accessing data, we won't overwrite that.
+    ///
+    /// How that last guarantee is kept depends on the
+    /// IPCRingBuffer::Synchronization chosen when creating the buffer.
     class IPCRingBuffer : public enable_shared_from_this<IPCRingBuffer> {
       public:
         typedef uint8_t BackendType;
@@ -69,6 +73,20 @@ namespace common {
         typedef uint16_t entry_count_type;
         typedef uint32_t entry_size_type;
         typedef uint32_t abi_level_type;
+
+        /// @brief How access to entries is coordinated between the producer
+        /// and readers. Each has its own ABI level.
+        enum class Synchronization : uint8_t {
+            /// @brief Interprocess mutexes on the bookkeeping and each entry:
+            /// readers access entries in place, but a reader holding an entry
+            /// stalls the producer.
+            Mutex,
+            /// @brief Per-entry generation counters (a seqlock): the producer
+            /// never waits, and readers get a validated copy of the entry, or
+            /// nothing if it was overwritten while copying.
+            Seqlock
+        };
+
         class Options {
           public:
             OSVR_COMMON_EXPORT Options();
@@ -81,28 +99,36 @@ namespace common {
 
             /// @brief sets the name, after sanitizing the input string.
             /// @return *this for chained method idiom.
-            Options &setName(std::string const &name);
+            OSVR_COMMON_EXPORT Options &setName(std::string const &name);
             std::string const &getName() const { return m_name; }
 
             /// @brief Sets the alignment for each entry, which must be a power
             /// of 2 (rounded up to the nearest if it's not).
             /// @return *this for chained method idiom.
-            Options &setAlignment(alignment_type alignment);
+            OSVR_COMMON_EXPORT Options &setAlignment(alignment_type alignment);
             alignment_type getAlignment() const { return m_alignment; }
 
             /// @brief Sets the number of entries in the ring buffer.
             /// @return *this for chained method idiom.
-            Options &setEntries(entry_count_type entries);
+            OSVR_COMMON_EXPORT Options &setEntries(entry_count_type entries);
             entry_count_type getEntries() const { return m_entries; }
 
             /// @brief Sets the size of each entry in the ring buffer.
             /// @return *this for chained method idiom.
-            Options &setEntrySize(entry_size_type entrySize);
+            OSVR_COMMON_EXPORT Options &setEntrySize(entry_size_type entrySize);
             entry_size_type getEntrySize() const { return m_entrySize; }
 
+            /// @brief Sets the synchronization scheme. When finding an
+            /// existing buffer, this must match the one it was created with.
+            /// @return *this for chained method idiom.
+            OSVR_COMMON_EXPORT Options &
+            setSynchronization(Synchronization sync);
+            Synchronization getSynchronization() const { return m_sync; }
+
           private:
             std::string m_name;
             BackendType m_shmBackend;
+            Synchronization m_sync = Synchronization::Mutex;
             alignment_type m_alignment = 16;
             entry_count_type m_entries = 16;
             entry_size_type m_entrySize = 65536;
@@ -112,8 +138,16 @@ namespace common {
         /// internal shared memory layout, such that if two processes try to
         /// communicate with different ABI levels, they will (likely) not
         /// succeed and thus should not try.
+        ///
+        /// This overload gives the ABI level of the default
+        /// (Synchronization::Mutex) layout.
         OSVR_COMMON_EXPORT static abi_level_type getABILevel();
 
+        /// @brief Gets the ABI level of the shared memory layout used with
+        /// the given synchronization scheme.
+        OSVR_COMMON_EXPORT static abi_level_type
+        getABILevel(Synchronization sync);
+
         /// @brief Named constructor, for use by server processes: creates a
         /// shared memory ring buffer given the options structure.
         ///
@@ -122,8 +156,8 @@ namespace common {
         OSVR_COMMON_EXPORT static IPCRingBufferPtr create(Options const &opts);
 
         /// @brief Named constructor, for use by client processes: accesses an
-        /// IPC ring buffer using the options structure. Only the name field is
-        /// used from the options.
+        /// IPC ring buffer using the options structure. Only the name, backend,
+        /// and synchronization fields are used from the options.
         ///
         /// If the returned pointer is not valid, the named buffer could not be
         /// found.
@@ -132,6 +166,9 @@ namespace common {
         /// @brief Returns an integer identifying the IPC backend used.
         OSVR_COMMON_EXPORT BackendType getBackend() const;
 
+        /// @brief Returns the synchronization scheme used.
+        OSVR_COMMON_EXPORT Synchronization getSynchronization() const;
+
         /// @brief Returns the name string used to create or find this ring
         /// buffer
         OSVR_COMMON_EXPORT std::string const &getName() const;
@@ -159,6 +196,10 @@ namespace common {
         /// access to the sequence number.
         class BufferWriteProxy {
           public:
+            /// @brief Default constructor: an empty proxy, not referring to
+            /// any buffer entry.
+            BufferWriteProxy() {}
+
             /// @brief not copyable
             BufferWriteProxy(BufferWriteProxy const &) = delete;
 
@@ -167,33 +208,50 @@ namespace common {
 
             /// @brief move-constructible
             BufferWriteProxy(BufferWriteProxy &&other) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
             }
 
             /// @brief move-assignable
             BufferWriteProxy &operator=(BufferWriteProxy &&other) {
+                std::swap(m_buf, other.m_buf);
+                std::swap(m_seq, other.m_seq);
                 std::swap(m_data, other.m_data);
                 return *this;
             }
 
+            /// @brief Checks validity of pointer - do we hold a buffer entry?
+            explicit operator bool() const { return nullptr != m_buf; }
+
             operator pointer_type() const { return get(); }
 
             pointer_type get() const { return m_buf; }
 
             sequence_type getSequenceNumber() const { return m_seq; }
 
+            /// @brief Gives the entry back without publishing it, leaving
+            /// this proxy empty: getLatest() keeps returning the previous
+            /// entry, and the next put() reuses the sequence number. (Letting
+            /// the proxy go out of scope instead publishes the entry.)
+            ///
+            /// If the buffer was full, the oldest entry is still lost, since
+            /// its storage was handed out for writing.
+            OSVR_COMMON_EXPORT void cancel();
+
           private:
             BufferWriteProxy(detail::IPCPutResultPtr &&data,
                              IPCRingBufferPtr &&shm);
             friend class IPCRingBuffer;
-            pointer_type m_buf;
-            sequence_type m_seq;
+            pointer_type m_buf = nullptr;
+            sequence_type m_seq = 0;
             detail::IPCPutResultPtr m_data;
         };
 
         /// @brief A class providing access to an entry in the ring buffer,
         /// holding a sharable mutex lock preventing it from being overwritten
-        /// while this object is in scope.
+        /// while this object is in scope (or, with Synchronization::Seqlock,
+        /// owning a private copy of it).
         ///
         /// As such, you should only access the memory pointed to by this object
         /// while you keep this object alive, and you should let it go out of
@@ -238,7 +296,7 @@ namespace common {
         /// @brief Gets a proxy object for putting data in the next element in
         /// the buffer. You're responsible for doing the copying and, once you
         /// let the returned object exit scope, the notification (possibly with
-        /// sequence number)
+        /// sequence number) - or call BufferWriteProxy::cancel() to back out.
         OSVR_COMMON_EXPORT BufferWriteProxy put();
 
         /// @brief Gets access to an element in the buffer by sequence number:
@@ -250,6 +308,16 @@ namespace common {
         /// also contains the associated sequence number.
         OSVR_COMMON_EXPORT BufferReadProxy getLatest();
 
+        /// @brief Copies the element with the given sequence number, if it is
+        /// (still) available, into memory provided by the caller, which must
+        /// hold getEntrySize() bytes.
+        ///
+        /// Unlike get(), allocates nothing, and holds no lock once it
+        /// returns.
+        ///
+        /// @return true if the element was copied.
+        OSVR_COMMON_EXPORT bool copy(sequence_type num, pointer_type dest);
+
         /// @brief Destructor.
         OSVR_COMMON_EXPORT ~IPCRingBuffer();
 
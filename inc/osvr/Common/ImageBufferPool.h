@@ -0,0 +1,103 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageBufferPool_h_GUID_05579CA3_F423_4D30_B6E7_615DD8C4847D
+#define INCLUDED_ImageBufferPool_h_GUID_05579CA3_F423_4D30_B6E7_615DD8C4847D
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/SharedPtr.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <map>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    typedef shared_ptr<OSVR_ImageBufferElement> ImageBufferPtr;
+
+    /// @brief A received frame.
+    struct ImageData {
+        OSVR_ChannelCount sensor;
+        OSVR_ImagingMetadata metadata;
+        ImageBufferPtr buffer;
+    };
+
+    /// @brief Gets the number of bytes in an image with the given metadata.
+    inline uint32_t getImageBufferSize(OSVR_ImagingMetadata const &meta) {
+        return meta.height * meta.width * meta.depth * meta.channels;
+    }
+
+    /// @brief Do two images with the given metadata have the same layout?
+    inline bool sameImageMetadata(OSVR_ImagingMetadata const &a,
+                                  OSVR_ImagingMetadata const &b) {
+        return a.height == b.height && a.width == b.width &&
+               a.channels == b.channels && a.depth == b.depth &&
+               a.type == b.type;
+    }
+
+    /// @brief Recycles image buffers, one bucket per buffer size, so that a
+    /// steady stream of frames needs no heap allocations once there are as
+    /// many buffers as frames in flight.
+    ///
+    /// The pool keeps one shared pointer to each buffer, and hands out
+    /// copies of it: a buffer is free for reuse once the pool holds the only
+    /// reference, so neither the buffer nor the shared pointer's control
+    /// block is ever freed and reallocated. A buffer stays alive as long as
+    /// anyone holds an ImageBufferPtr to it, even past the pool's
+    /// destruction.
+    ///
+    /// Buffers may be released on any thread, but acquire() must only be
+    /// called on one thread at a time.
+    class ImageBufferPool : boost::noncopyable {
+      public:
+        OSVR_COMMON_EXPORT ImageBufferPool();
+
+        /// @brief Get a buffer of the given size, with unspecified contents,
+        /// held until the last copy of the returned pointer is released.
+        OSVR_COMMON_EXPORT ImageBufferPtr acquire(std::size_t bytes);
+
+        /// @brief Total number of buffers owned by the pool, in use or free.
+        OSVR_COMMON_EXPORT std::size_t size() const;
+
+      private:
+        struct Entry;
+        typedef shared_ptr<Entry> EntryPtr;
+        typedef std::vector<EntryPtr> Bucket;
+        std::map<std::size_t, Bucket> m_buckets;
+        /// @brief The bucket used last, since most calls use the same size.
+        Bucket *m_lastBucket;
+        std::size_t m_lastBytes;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageBufferPool_h_GUID_05579CA3_F423_4D30_B6E7_615DD8C4847D
@@ -0,0 +1,194 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_ImageCodec_h_GUID_140F83BF_6BF0_494D_A33B_F8C145884133
+#define INCLUDED_ImageCodec_h_GUID_140F83BF_6BF0_494D_A33B_F8C145884133
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/ImageBufferPool.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <cstddef>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief How a frame's data is encoded for the network.
+    enum class ImageEncoding : uint8_t {
+        /// @brief The image data, as is.
+        Raw,
+        /// @brief Byte-wise run-length encoding.
+        RunLength,
+        /// @brief Exclusive-or with an earlier frame from the same sensor,
+        /// then run-length encoded: cheap for mostly static images.
+        DeltaRunLength
+    };
+
+    /// @brief Describes how a frame was encoded.
+    struct ImageEncodingInfo {
+        ImageEncoding encoding;
+        /// @brief For DeltaRunLength, the frame this one is relative to.
+        uint32_t reference;
+        /// @brief Bytes of encoded data.
+        uint32_t size;
+    };
+
+    /// @brief Run-length encodes data.
+    ///
+    /// Runs of at least three equal bytes become a count byte of 128 or more
+    /// followed by the byte; anything else becomes a count byte below 128
+    /// followed by up to 128 literal bytes.
+    ///
+    /// @return The number of bytes written to @p out, or 0 if that would be
+    /// more than @p capacity.
+    OSVR_COMMON_EXPORT std::size_t
+    runLengthEncode(OSVR_ImageBufferElement const *data, std::size_t size,
+                    OSVR_ImageBufferElement *out, std::size_t capacity);
+
+    /// @brief Decodes data from runLengthEncode().
+    ///
+    /// @return true if the data decoded to exactly @p outSize bytes.
+    OSVR_COMMON_EXPORT bool
+    runLengthDecode(OSVR_ImageBufferElement const *data, std::size_t size,
+                    OSVR_ImageBufferElement *out, std::size_t outSize);
+
+    /// @brief Running totals for the frames an ImageEncoder has handled.
+    struct ImageCodecStats {
+        ImageCodecStats()
+            : frames(0), keyframes(0), rawBytes(0), encodedBytes(0),
+              encodeSeconds(0) {}
+        uint64_t frames;
+        /// @brief Frames not encoded relative to an earlier frame.
+        uint64_t keyframes;
+        uint64_t rawBytes;
+        uint64_t encodedBytes;
+        double encodeSeconds;
+
+        /// @brief Raw bytes per encoded byte.
+        double getRatio() const {
+            return encodedBytes == 0 ? 1.0
+                                     : double(rawBytes) / double(encodedBytes);
+        }
+    };
+
+    /// @brief Encodes frames for the network, keeping a copy of the last
+    /// frame from each sensor when delta encoding.
+    ///
+    /// Frames that don't get smaller are sent raw. A delta-encoded frame is
+    /// relative to the previous frame from its sensor, and a keyframe is sent
+    /// at least every keyframe interval so that clients that join, or miss a
+    /// frame, can pick up the stream again.
+    class ImageEncoder : boost::noncopyable {
+      public:
+        OSVR_COMMON_EXPORT ImageEncoder();
+
+        /// @brief Sets the encoding to use from now on, and how many frames
+        /// from a sensor may pass between keyframes. Resets the stats.
+        OSVR_COMMON_EXPORT void setEncoding(ImageEncoding encoding,
+                                            uint32_t keyframeInterval);
+
+        ImageEncoding getEncoding() const { return m_encoding; }
+
+        /// @brief Encodes a frame.
+        ///
+        /// @param metadata Describes the frame.
+        /// @param [in,out] data The frame's data: set to the encoded data,
+        /// which stays valid until the next call.
+        /// @param sensor Sensor number
+        /// @param frame Identifies the frame, for later frames to refer to.
+        OSVR_COMMON_EXPORT ImageEncodingInfo
+        encode(OSVR_ImagingMetadata const &metadata,
+               OSVR_ImageBufferElement const *&data, OSVR_ChannelCount sensor,
+               uint32_t frame);
+
+        ImageCodecStats const &getStats() const { return m_stats; }
+
+      private:
+        struct SensorState {
+            SensorState() : valid(false), frame(0), sinceKeyframe(0) {}
+            bool valid;
+            OSVR_ImagingMetadata metadata;
+            uint32_t frame;
+            uint32_t sinceKeyframe;
+            std::vector<OSVR_ImageBufferElement> previous;
+        };
+        ImageEncoding m_encoding;
+        uint32_t m_keyframeInterval;
+        std::vector<SensorState> m_sensors;
+        std::vector<OSVR_ImageBufferElement> m_delta;
+        std::vector<OSVR_ImageBufferElement> m_output;
+        ImageCodecStats m_stats;
+    };
+
+    /// @brief Decodes frames from an ImageEncoder, into buffers from a pool,
+    /// keeping a copy of the last frame from each sensor to apply deltas to.
+    ///
+    /// The copy is its own, since the buffers returned are handed on to apps
+    /// that may change them in place.
+    ///
+    /// Frames for sensors beyond the number given on construction are
+    /// rejected.
+    class ImageDecoder : boost::noncopyable {
+      public:
+        ImageDecoder(ImageBufferPool &pool, OSVR_ChannelCount numSensors)
+            : m_pool(pool), m_references(numSensors) {}
+
+        /// @brief Decodes a frame.
+        ///
+        /// @param frame Identifies the frame.
+        /// @param info How the frame was encoded.
+        /// @param [in,out] image The encoded frame, with its metadata and
+        /// sensor, in a buffer at least as large as the decoded image: set to
+        /// the decoded frame.
+        /// @return false if the frame couldn't be decoded, for instance
+        /// because the frame it's relative to was missed, or is from an
+        /// unknown sensor.
+        OSVR_COMMON_EXPORT bool decode(uint32_t frame,
+                                       ImageEncodingInfo const &info,
+                                       ImageData &image);
+
+      private:
+        struct Reference {
+            Reference() : valid(false), frame(0) {}
+            bool valid;
+            uint32_t frame;
+            OSVR_ImagingMetadata metadata;
+            std::vector<OSVR_ImageBufferElement> data;
+        };
+        ImageBufferPool &m_pool;
+        /// @brief Indexed by sensor.
+        std::vector<Reference> m_references;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageCodec_h_GUID_140F83BF_6BF0_494D_A33B_F8C145884133
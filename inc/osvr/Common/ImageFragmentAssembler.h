@@ -0,0 +1,107 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ImageFragmentAssembler_h_GUID_2D42CFC9_CE66_466E_95E7_19F6CE51106D
+#define INCLUDED_ImageFragmentAssembler_h_GUID_2D42CFC9_CE66_466E_95E7_19F6CE51106D
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/ImageBufferPool.h>
+#include <osvr/Common/ImageCodec.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief Describes one piece of a frame sent in several messages.
+    struct ImageFragmentHeader {
+        /// @brief Metadata of the whole frame.
+        OSVR_ImagingMetadata metadata;
+        OSVR_ChannelCount sensor;
+        /// @brief Identifies the frame: increases (with wraparound) from
+        /// one frame to the next.
+        uint32_t frame;
+        /// @brief How the frame is encoded: its size is that of all the
+        /// fragments' data together.
+        ImageEncodingInfo encoding;
+        /// @brief Where this fragment's data goes in the frame, in bytes.
+        uint32_t offset;
+        /// @brief Bytes of data in this fragment.
+        uint32_t length;
+    };
+
+    /// @brief Puts frames back together from their fragments, into buffers
+    /// from a pool, with one frame in progress per sensor. Encoded frames are
+    /// put back together still encoded.
+    ///
+    /// Fragments for sensors beyond the number given on construction are
+    /// dropped, so data from the network can't make it allocate more.
+    ///
+    /// Fragments of a frame must arrive in order (as they do over a reliable
+    /// connection), but may be interleaved with those of other sensors. A
+    /// frame still incomplete when a fragment of a newer frame for the same
+    /// sensor arrives is dropped, as are fragments of older frames and
+    /// fragments that don't fit the frame.
+    class ImageFragmentAssembler {
+      public:
+        ImageFragmentAssembler(ImageBufferPool &pool,
+                               OSVR_ChannelCount numSensors)
+            : m_pool(pool), m_frames(numSensors) {}
+
+        /// @brief Adds a fragment.
+        ///
+        /// @param header Describes the fragment.
+        /// @param data The fragment's data: header.length bytes.
+        /// @param [out] completed Set to the frame, if this fragment
+        /// completed it, still encoded as @p header describes: its buffer is
+        /// at least as large as the decoded image.
+        /// @return true if this fragment completed a frame.
+        OSVR_COMMON_EXPORT bool
+        addFragment(ImageFragmentHeader const &header,
+                    OSVR_ImageBufferElement const *data, ImageData &completed);
+
+      private:
+        struct PartialFrame {
+            PartialFrame() : active(false), frame(0), received(0) {}
+            bool active;
+            uint32_t frame;
+            uint32_t received;
+            ImageEncodingInfo encoding;
+            ImageData image;
+        };
+        ImageBufferPool &m_pool;
+        /// @brief Indexed by sensor.
+        std::vector<PartialFrame> m_frames;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ImageFragmentAssembler_h_GUID_2D42CFC9_CE66_466E_95E7_19F6CE51106D
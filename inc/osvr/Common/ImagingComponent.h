@@ -29,24 +29,23 @@
 #include <osvr/Common/Export.h>
 #include <osvr/Common/DeviceComponent.h>
 #include <osvr/Common/SerializationTags.h>
+#include <osvr/Common/Buffer.h>
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/ImagingReportTypesC.h>
 #include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Common/ImageBufferPool.h>
+#include <osvr/Common/ImageCodec.h>
+#include <osvr/Common/ImageFragmentAssembler.h>
 
 // Library/third-party includes
 #include <vrpn_BaseClass.h>
+#include <boost/optional.hpp>
 
 // Standard includes
-// - none
+#include <vector>
 
 namespace osvr {
 namespace common {
-    typedef shared_ptr<OSVR_ImageBufferElement> ImageBufferPtr;
-    struct ImageData {
-        OSVR_ChannelCount sensor;
-        OSVR_ImagingMetadata metadata;
-        ImageBufferPtr buffer;
-    };
     namespace messages {
         class ImageRegion : public MessageRegistration<ImageRegion> {
           public:
@@ -60,8 +59,32 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+        class ImageFragment : public MessageRegistration<ImageFragment> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
+    /// @brief Which part of each frame to send to clients over the network.
+    /// Frames in shared memory are always whole.
+    struct ImagingNetworkOptions {
+        ImagingNetworkOptions()
+            : left(0), top(0), width(0), height(0), rowStep(1) {}
+        /// @brief First column of the region of interest.
+        OSVR_ImageDimension left;
+        /// @brief First row of the region of interest.
+        OSVR_ImageDimension top;
+        /// @brief Width of the region of interest, or 0 for all columns from
+        /// the left one.
+        OSVR_ImageDimension width;
+        /// @brief Height of the region of interest, or 0 for all rows from the
+        /// top one.
+        OSVR_ImageDimension height;
+        /// @brief Send only every rowStep-th row of the region of interest.
+        OSVR_ImageDimension rowStep;
+    };
+
     /// @brief BaseDevice component
     class ImagingComponent : public DeviceComponent {
       public:
@@ -69,6 +92,9 @@ namespace common {
         ///
         /// Required to ensure that allocation and deallocation stay on the same
         /// side of a DLL line.
+        ///
+        /// @param numSensor Number of sensors: when receiving, frames for
+        /// other sensors are ignored.
         static OSVR_COMMON_EXPORT shared_ptr<ImagingComponent>
         create(OSVR_ChannelCount numSensor = 0);
 
@@ -79,10 +105,76 @@ namespace common {
         /// shared memory ring buffer.
         messages::ImagePlacedInSharedMemory imagePlacedInSharedMemory;
 
+        /// @brief Message from server to client, containing part of a frame
+        /// too big for an imageRegion message, or encoded.
+        messages::ImageFragment imageFragment;
+
+        /// @brief Sets how shared memory for frames created from now on is
+        /// synchronized. The default, IPCRingBuffer::Synchronization::Mutex,
+        /// is the only scheme clients predating the seqlock scheme
+        /// understand; with Seqlock, a slow client can't hold up the device.
+        /// Call before sending frames, or from the thread sending them.
+        OSVR_COMMON_EXPORT void
+        setSharedMemorySynchronization(IPCRingBuffer::Synchronization sync);
+
+        /// @brief Sets whether frames too big for one message are sent over
+        /// the network in fragments (encoded as set by setNetworkEncoding()).
+        /// Off by default, so such frames only reach clients on this
+        /// machine, through shared memory. Call before sending frames, or
+        /// from the thread sending them.
+        OSVR_COMMON_EXPORT void setNetworkFragments(bool enable);
+
+        /// @brief Sets which part of each frame to send over the network from
+        /// now on. Call before sending frames, or from the thread sending
+        /// them.
+        OSVR_COMMON_EXPORT void
+        setNetworkOptions(ImagingNetworkOptions const &opts);
+
+        /// @brief Sets how frames sent over the network in fragments are
+        /// encoded from now on: each frame is encoded once, whatever the
+        /// number of clients. Call before sending frames, or from the thread
+        /// sending them.
+        ///
+        /// @param encoding Encoding to use
+        /// @param keyframeInterval Most frames a sensor may send between
+        /// frames not relative to an earlier one, with delta encoding.
+        OSVR_COMMON_EXPORT void setNetworkEncoding(ImageEncoding encoding,
+                                                   uint32_t keyframeInterval);
+
+        /// @brief Gets how well network encoding has done since it was set.
+        ImageCodecStats const &getNetworkEncodingStats() const {
+            return m_encoder.getStats();
+        }
+
         OSVR_COMMON_EXPORT void sendImageData(
             OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
             OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp);
 
+        /// @brief Reserves the next shared memory ring buffer entry for the
+        /// given sensor, so that a frame can be written directly into it
+        /// instead of being copied in by sendImageData().
+        ///
+        /// Readers of that ring buffer are locked out while the returned
+        /// proxy is alive, so pass it to sendReservedImageData() (or call
+        /// cancel() on it to abandon the frame) promptly. Just letting it go
+        /// out of scope makes the unreported entry the latest one in shared
+        /// memory.
+        ///
+        /// @return An empty proxy if shared memory is unavailable.
+        OSVR_COMMON_EXPORT IPCRingBuffer::BufferWriteProxy
+        reserveImageBuffer(OSVR_ImagingMetadata const &metadata,
+                           OSVR_ChannelCount sensor);
+
+        /// @brief Publishes a frame written into an entry obtained from
+        /// reserveImageBuffer() with the same metadata and sensor.
+        ///
+        /// @return false if the proxy was empty and nothing was sent.
+        OSVR_COMMON_EXPORT bool
+        sendReservedImageData(OSVR_ImagingMetadata metadata,
+                              IPCRingBuffer::BufferWriteProxy &&frame,
+                              OSVR_ChannelCount sensor,
+                              OSVR_TimeValue const &timestamp);
+
         typedef std::function<void(ImageData const &,
                                    util::time::TimeValue const &)> ImageHandler;
         OSVR_COMMON_EXPORT void registerImageHandler(ImageHandler cb);
@@ -97,18 +189,57 @@ namespace common {
                                             OSVR_ChannelCount sensor,
                                             OSVR_TimeValue const &timestamp);
 
+        /// @brief Gets the shared memory ring buffer for a sensor, creating
+        /// or replacing it if required to fit the frame size.
+        /// @return nullptr if shared memory couldn't be set up.
+        IPCRingBuffer *m_getShmBuf(OSVR_ImagingMetadata const &metadata,
+                                   OSVR_ChannelCount sensor);
+
+        /// @brief Notify clients of a frame in shared memory.
+        void m_sendSharedMemoryNotice(OSVR_ImagingMetadata const &metadata,
+                                      IPCRingBuffer &shm,
+                                      IPCRingBuffer::sequence_type seq,
+                                      OSVR_ChannelCount sensor,
+                                      OSVR_TimeValue const &timestamp);
+
         /// @return true if we could send it.
         bool m_sendImageDataOnTheWire(OSVR_ImagingMetadata metadata,
                                       OSVR_ImageBufferElement *imageData,
                                       OSVR_ChannelCount sensor,
                                       OSVR_TimeValue const &timestamp);
 
+        /// @brief Packs the message (or, if it doesn't fit in one or is
+        /// encoded, and fragments are enabled, the fragment messages) carrying
+        /// a frame to network clients, without sending them yet.
+        /// @return true if anything was packed.
+        bool m_packImageDataForWire(OSVR_ImagingMetadata metadata,
+                                    OSVR_ImageBufferElement *imageData,
+                                    OSVR_ChannelCount sensor,
+                                    OSVR_TimeValue const &timestamp);
+
+        /// @brief Cuts a frame down to the part to send over the network,
+        /// adjusting the metadata to match.
+        /// @return the data to send (possibly @p imageData itself), or
+        /// nullptr if the region of interest is outside the frame.
+        OSVR_ImageBufferElement *
+        m_applyNetworkOptions(OSVR_ImagingMetadata &metadata,
+                              OSVR_ImageBufferElement *imageData);
+
         static int VRPN_CALLBACK
         m_handleImageRegion(void *userdata, vrpn_HANDLERPARAM p);
 
         static int VRPN_CALLBACK
         m_handleImagePlacedInSharedMemory(void *userdata, vrpn_HANDLERPARAM p);
 
+        static int VRPN_CALLBACK
+        m_handleImageFragment(void *userdata, vrpn_HANDLERPARAM p);
+
+        /// @brief Passes a received frame to the handlers, unless it was
+        /// already passed on: local clients get frames both through shared
+        /// memory and over the network.
+        void m_deliver(ImageData const &data,
+                       util::time::TimeValue const &timestamp);
+
         void m_checkFirst(OSVR_ImagingMetadata const &metadata);
         void m_growShmVecIfRequired(OSVR_ChannelCount sensor);
 
@@ -117,6 +248,25 @@ namespace common {
         bool m_gotOne;
         /// @brief One for each sensor
         std::vector<IPCRingBufferPtr> m_shmBuf;
+        /// @brief Recycled buffers for received frames.
+        ImageBufferPool m_bufferPool;
+        ImageFragmentAssembler m_assembler;
+        ImageDecoder m_decoder;
+        ImagingNetworkOptions m_networkOptions;
+        ImageEncoder m_encoder;
+        /// @brief Holds the part of a frame to send over the network, when
+        /// that isn't the whole frame.
+        std::vector<OSVR_ImageBufferElement> m_networkFrame;
+        /// @brief Identifies the next frame sent in fragments.
+        uint32_t m_nextFragmentedFrame;
+        /// @brief Whether frames too big for one message are sent in
+        /// fragments.
+        bool m_networkFragments;
+        /// @brief Synchronization of the shared memory we create.
+        IPCRingBuffer::Synchronization m_shmSync;
+        /// @brief Timestamp of the last frame delivered for each sensor, to
+        /// recognize the same frame arriving by another path.
+        std::vector<boost::optional<util::time::TimeValue> > m_lastDelivered;
     };
 } // namespace common
 } // namespace osvr
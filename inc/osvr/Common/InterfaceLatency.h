@@ -0,0 +1,86 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_InterfaceLatency_h_GUID_0451779B_A20E_4E17_AE8E_86513BA7F629
+#define INCLUDED_InterfaceLatency_h_GUID_0451779B_A20E_4E17_AE8E_86513BA7F629
+
+// Internal Includes
+#include <osvr/Common/LatencyHistogram.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+
+namespace osvr {
+namespace common {
+    /// @brief Points in a report's trip to the client, after the device
+    /// sampled it, at which its latency is measured.
+    enum class LatencyStage {
+        /// @brief The report reached the client interface.
+        Received,
+        /// @brief The interface's state and callbacks have been updated.
+        Dispatched
+    };
+
+    /// @brief Latency histograms for the reports delivered to one client
+    /// interface, measured from the device timestamp of each report.
+    ///
+    /// Only meaningful when the device timestamps come from a clock in step
+    /// with the client's: typically, when client and server share a machine.
+    class InterfaceLatency {
+      public:
+        /// @brief Record the latency of a report at the given stage.
+        void record(LatencyStage stage,
+                    util::time::TimeValue const &deviceTimestamp) {
+            util::time::TimeValue now;
+            util::time::getNow(now);
+            get(stage).record(
+                (now.seconds - deviceTimestamp.seconds) * 1000000 +
+                (now.microseconds - deviceTimestamp.microseconds));
+        }
+
+        LatencyHistogram &get(LatencyStage stage) {
+            return m_stages[static_cast<std::size_t>(stage)];
+        }
+
+        LatencyHistogram const &get(LatencyStage stage) const {
+            return m_stages[static_cast<std::size_t>(stage)];
+        }
+
+        void reset() {
+            for (auto &hist : m_stages) {
+                hist.reset();
+            }
+        }
+
+      private:
+        std::array<LatencyHistogram, 2> m_stages;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_InterfaceLatency_h_GUID_0451779B_A20E_4E17_AE8E_86513BA7F629
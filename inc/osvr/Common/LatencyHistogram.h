@@ -0,0 +1,103 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_LatencyHistogram_h_GUID_23DF2673_181D_45EE_B809_3B2D67C7C49D
+#define INCLUDED_LatencyHistogram_h_GUID_23DF2673_181D_45EE_B809_3B2D67C7C49D
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <array>
+
+namespace osvr {
+namespace common {
+    /// @brief A histogram of latencies in microseconds, with buckets whose
+    /// width grows with their magnitude (in the style of HdrHistogram), so
+    /// recorded values are kept to within about 3% over the whole range at a
+    /// fixed size and a constant recording cost.
+    ///
+    /// Values below 64 are counted exactly; above that, each power of two is
+    /// split into 32 buckets.
+    class LatencyHistogram {
+      public:
+        typedef uint64_t count_type;
+        typedef uint64_t value_type;
+
+        OSVR_COMMON_EXPORT LatencyHistogram();
+
+        /// @brief Record a latency. Negative values (possible when the
+        /// timestamps come from different clocks) are recorded as zero.
+        OSVR_COMMON_EXPORT void record(int64_t microseconds);
+
+        /// @brief Forget all recorded values.
+        OSVR_COMMON_EXPORT void reset();
+
+        count_type getCount() const { return m_count; }
+
+        /// @brief Smallest value recorded, or 0 if none.
+        value_type getMin() const { return m_count ? m_min : 0; }
+
+        /// @brief Largest value recorded, or 0 if none.
+        value_type getMax() const { return m_max; }
+
+        /// @brief Mean of the values recorded (exact, not bucketed), or 0 if
+        /// none.
+        OSVR_COMMON_EXPORT double getMean() const;
+
+        /// @brief Gets a value that at least the given percentage (0 to 100)
+        /// of recorded values are less than or equal to: the upper end of
+        /// the bucket containing that percentile, limited to the largest
+        /// value recorded. 0 if nothing has been recorded.
+        OSVR_COMMON_EXPORT value_type
+        getValueAtPercentile(double percentile) const;
+
+        /// @brief Add the counts from another histogram to this one.
+        OSVR_COMMON_EXPORT void add(LatencyHistogram const &other);
+
+      private:
+        static const std::size_t LINEAR_BUCKETS = 64;
+        static const std::size_t SUB_BUCKET_BITS = 5;
+        static const std::size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+        /// @brief Enough for any 64-bit value.
+        static const std::size_t BUCKETS =
+            LINEAR_BUCKETS + (64 - SUB_BUCKET_BITS - 1) * SUB_BUCKETS;
+
+        static std::size_t m_getBucket(value_type value);
+        static value_type m_getBucketUpperBound(std::size_t bucket);
+
+        std::array<count_type, BUCKETS> m_buckets;
+        count_type m_count;
+        value_type m_min;
+        value_type m_max;
+        double m_sum;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_LatencyHistogram_h_GUID_23DF2673_181D_45EE_B809_3B2D67C7C49D
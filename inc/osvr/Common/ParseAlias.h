@@ -36,13 +36,15 @@
 
 namespace osvr {
 namespace common {
+    /// @brief An alias source, parsed: a leaf path, possibly wrapped in a
+    /// chain of transforms.
     class ParsedAlias {
       public:
         /// @brief Constructor - performs parse and normalization of format.
         OSVR_COMMON_EXPORT ParsedAlias(std::string const &src);
 
         /// @brief Constructor - performs normalization of format.
-        ParsedAlias(Json::Value src);
+        OSVR_COMMON_EXPORT ParsedAlias(Json::Value src);
 
         /// @brief Did the alias parse in a valid way?
         OSVR_COMMON_EXPORT bool isValid() const;
@@ -54,14 +56,13 @@ namespace common {
         OSVR_COMMON_EXPORT std::string getLeaf() const;
 
         /// @brief Set the leaf of the alias: should be an absolute path.
-        void setLeaf(std::string const &leaf);
+        OSVR_COMMON_EXPORT void setLeaf(std::string const &leaf);
 
         /// @brief Get the normalized, cleaned, compacted version of the alias.
         OSVR_COMMON_EXPORT std::string getAlias() const;
 
-        /// @brief Gets a copy of the normalized version of the alias as a
-        /// Json::Value
-        OSVR_COMMON_EXPORT Json::Value getAliasValue() const;
+        /// @brief Gets the normalized version of the alias as a Json::Value
+        OSVR_COMMON_EXPORT Json::Value const &getAliasValue() const;
 
       private:
         void m_parse(std::string const &src);
@@ -37,6 +37,7 @@
 // Internal Includes
 #include <osvr/Common/Export.h>
 #include <osvr/Common/PathElementTypes_fwd.h> // IWYU pragma: export
+#include <osvr/Common/ParseAlias.h>
 
 // Library/third-party includes
 #include <boost/variant/variant.hpp>
@@ -173,21 +174,32 @@ namespace common {
             OSVR_COMMON_EXPORT
             AliasElement(std::string const &source);
 
+            /// @brief Constructor with already-parsed source and priority.
+            OSVR_COMMON_EXPORT
+            AliasElement(ParsedAlias const &source, AliasPriority priority);
+
             /// @brief default constructor
-            AliasElement() : AliasElement("", ALIASPRIORITY_MINIMUM) {}
+            OSVR_COMMON_EXPORT AliasElement();
 
-            /// @brief Sets the source of this alias
+            /// @brief Sets the source of this alias, parsing it.
             /// @param source absolute path of the target, possibly wrapped in
             /// transforms.
             /// @todo support relative paths - either here or at a different
             /// level
             OSVR_COMMON_EXPORT void setSource(std::string const &source);
 
-            /// @brief Get the source of data for this alias
-            OSVR_COMMON_EXPORT std::string &getSource();
-            /// @overload
+            /// @brief Sets the source of this alias from an already-parsed
+            /// one.
+            OSVR_COMMON_EXPORT void setSource(ParsedAlias const &source);
+
+            /// @brief Get the source of data for this alias, as a string (as
+            /// sent over the wire).
             OSVR_COMMON_EXPORT std::string const &getSource() const;
 
+            /// @brief Get the source of data for this alias, parsed when it
+            /// was set.
+            OSVR_COMMON_EXPORT ParsedAlias const &getParsedSource() const;
+
             /// @brief Get/set whether this alias was automatically set (and
             /// thus subject to being override by explicit routing)
             OSVR_COMMON_EXPORT AliasPriority &priority();
@@ -201,6 +213,7 @@ namespace common {
 
           private:
             std::string m_source;
+            ParsedAlias m_parsedSource;
             AliasPriority m_priority;
         };
 
@@ -39,10 +39,13 @@
 
 namespace osvr {
 namespace common {
-    /// @brief Gets the absolute path for the given node.
+    /// @brief Gets the absolute path for the given node: built once when the
+    /// node was created, so this is cheap.
     ///
     /// @ingroup Routing
-    OSVR_COMMON_EXPORT std::string getFullPath(PathNode const &node);
+    inline std::string const &getFullPath(PathNode const &node) {
+        return node.getPath();
+    }
 } // namespace common
 } // namespace osvr
 
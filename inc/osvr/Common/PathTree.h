@@ -38,6 +38,8 @@
 
 namespace osvr {
 namespace common {
+    class ParsedAlias;
+
     /// @brief A tree representation, with path/url syntax, of the known OSVR
     /// system.
     class PathTree : boost::noncopyable {
@@ -114,6 +116,13 @@ namespace common {
         PathNode &node, std::string const &source, std::string const &dest,
         AliasPriority priority = ALIASPRIORITY_MANUAL);
 
+    /// @overload
+    ///
+    /// Takes an already-parsed source, whose leaf may be relative to @p node.
+    bool addAliasFromSourceAndRelativeDest(
+        PathNode &node, ParsedAlias const &source, std::string const &dest,
+        AliasPriority priority = ALIASPRIORITY_MANUAL);
+
     bool isPathAbsolute(std::string const &source);
 
     /// @brief Clones a path tree
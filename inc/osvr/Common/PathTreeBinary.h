@@ -0,0 +1,79 @@
+/** @file
+    @brief Header for the compact binary encoding of a path tree.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_PathTreeBinary_h_GUID_411F05BD_69A0_4566_B8BD_487731408AED
+#define INCLUDED_PathTreeBinary_h_GUID_411F05BD_69A0_4566_B8BD_487731408AED
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Common/PathTreeDelta.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief Version of the binary path tree encoding written by
+    /// pathTreeToBinary(), and the only one the decoding functions accept.
+    static const uint32_t PATH_TREE_BINARY_VERSION = 1;
+
+    /// @brief Append a binary encoding of a path tree to a buffer.
+    ///
+    /// Much more compact than pathTreeToJson(): every distinct string (node
+    /// names, device names, alias sources, descriptors...) is stored once in a
+    /// string table, and nodes refer to their parent by index instead of
+    /// spelling out their full path. Device descriptors are stored as JSON
+    /// text, so they needn't be parsed unless used.
+    OSVR_COMMON_EXPORT void pathTreeToBinary(PathTree const &tree,
+                                             Buffer<> &buf);
+
+    /// @brief Deserialize a binary-encoded path tree into a tree, creating
+    /// each node directly under its parent.
+    ///
+    /// @throws std::runtime_error if the data is truncated, malformed, or
+    /// of another version.
+    OSVR_COMMON_EXPORT void binaryToPathTree(PathTree &tree, const char *buf,
+                                             std::size_t len);
+
+    /// @brief Index a binary-encoded path tree by path, like
+    /// pathTreeSnapshotFromJson() on the equivalent pathTreeToJson() output.
+    ///
+    /// Device descriptors are left as JSON strings, which jsonToPathTree()
+    /// parses only for the nodes it is given.
+    ///
+    /// @throws std::runtime_error if the data is truncated, malformed, or
+    /// of another version.
+    OSVR_COMMON_EXPORT PathTreeSnapshot
+    pathTreeSnapshotFromBinary(const char *buf, std::size_t len);
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PathTreeBinary_h_GUID_411F05BD_69A0_4566_B8BD_487731408AED
@@ -0,0 +1,128 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PathTreeDelta_h_GUID_A016ABAD_E190_437D_A120_15355FE2227D
+#define INCLUDED_PathTreeDelta_h_GUID_A016ABAD_E190_437D_A120_15355FE2227D
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <json/value.h>
+#include <boost/optional.hpp>
+
+// Standard includes
+#include <map>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    /// @brief A serialized path tree (as from pathTreeToJson()) keyed by
+    /// path, for comparing trees node by node.
+    typedef std::map<std::string, Json::Value> PathTreeSnapshot;
+
+    /// @brief Index a JSON array of path tree nodes by path.
+    OSVR_COMMON_EXPORT PathTreeSnapshot
+    pathTreeSnapshotFromJson(Json::Value const &nodes);
+
+    /// @brief Version of the path tree delta messages (see PathTreeDelta)
+    /// a client understands, reported to the server so it only sends deltas
+    /// once every client can apply them.
+    static const uint32_t PATH_TREE_DELTA_VERSION = 1;
+
+    /// @brief The changes turning one version of a path tree into another.
+    struct PathTreeDelta {
+        typedef uint32_t version_type;
+        PathTreeDelta() : version(0), changed(Json::arrayValue) {}
+
+        /// @brief Version of the tree once the delta is applied.
+        version_type version;
+
+        /// @brief Version of the tree the delta applies to. If empty, this
+        /// is just an announcement of the version of the full tree sent
+        /// immediately before.
+        boost::optional<version_type> base;
+
+        /// @brief Serialized nodes that are new or have a new value.
+        Json::Value changed;
+
+        /// @brief Paths of nodes that are no longer in the tree.
+        std::vector<std::string> removed;
+
+        /// @brief Number of nodes changed or removed.
+        OSVR_COMMON_EXPORT std::size_t size() const;
+        bool empty() const { return size() == 0; }
+    };
+
+    /// @brief Identifies the content of a full path tree sent by the server,
+    /// so that clients can skip a tree identical to the one they have
+    /// without decoding it.
+    struct PathTreeStamp {
+        PathTreeStamp() : generation(0), hash(0) {}
+        PathTreeStamp(PathTreeDelta::version_type gen, uint64_t contentHash)
+            : generation(gen), hash(contentHash) {}
+
+        /// @brief Version of the tree, as in PathTreeDelta: only changes
+        /// when the content of the tree does.
+        PathTreeDelta::version_type generation;
+
+        /// @brief Hash of the serialized tree, from hashPathTreeJson().
+        uint64_t hash;
+    };
+
+    inline bool operator==(PathTreeStamp const &a, PathTreeStamp const &b) {
+        return a.generation == b.generation && a.hash == b.hash;
+    }
+
+    inline bool operator!=(PathTreeStamp const &a, PathTreeStamp const &b) {
+        return !(a == b);
+    }
+
+    /// @brief Compute a 64-bit hash of the content of a JSON array of path
+    /// tree nodes (as from pathTreeToJson()), without serializing it to a
+    /// string.
+    OSVR_COMMON_EXPORT uint64_t hashPathTreeJson(Json::Value const &nodes);
+
+    /// @brief Compute the node changes from one snapshot to another.
+    OSVR_COMMON_EXPORT PathTreeDelta
+    diffPathTreeSnapshots(PathTreeSnapshot const &from,
+                          PathTreeSnapshot const &to);
+
+    /// @brief Apply the node changes of a delta to a snapshot.
+    OSVR_COMMON_EXPORT void applyPathTreeDelta(PathTreeSnapshot &snapshot,
+                                               PathTreeDelta const &delta);
+
+    /// @brief Serialize a delta (including versions) to a JSON object.
+    OSVR_COMMON_EXPORT Json::Value
+    pathTreeDeltaToJson(PathTreeDelta const &delta);
+
+    /// @brief Deserialize a delta from a JSON object.
+    OSVR_COMMON_EXPORT PathTreeDelta
+    pathTreeDeltaFromJson(Json::Value const &json);
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PathTreeDelta_h_GUID_A016ABAD_E190_437D_A120_15355FE2227D
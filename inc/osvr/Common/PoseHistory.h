@@ -0,0 +1,87 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_PoseHistory_h_GUID_C529F168_C15A_4453_BFFC_271A31BDF123
+#define INCLUDED_PoseHistory_h_GUID_C529F168_C15A_4453_BFFC_271A31BDF123
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Util/Pose3C.h>
+#include <osvr/Util/TimeValue.h>
+
+// Library/third-party includes
+#include <boost/circular_buffer.hpp>
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace common {
+    /// @brief A fixed-capacity history of timestamped poses, kept in
+    /// timestamp order, that can be queried for the pose at an arbitrary
+    /// time.
+    ///
+    /// Unlike InterfaceState, reports arriving out of order are kept (in
+    /// their place), as long as they are newer than the oldest entry.
+    class PoseHistory {
+      public:
+        /// @brief Default number of poses kept.
+        static const std::size_t DEFAULT_CAPACITY = 32;
+
+        OSVR_COMMON_EXPORT explicit PoseHistory(
+            std::size_t capacity = DEFAULT_CAPACITY);
+
+        /// @brief Add a pose, dropping the oldest if full.
+        OSVR_COMMON_EXPORT void add(util::time::TimeValue const &timestamp,
+                                    OSVR_Pose3 const &pose);
+
+        /// @brief Gets the pose at the given time.
+        ///
+        /// - Between two entries, interpolates: linearly for position,
+        ///   spherically (slerp) for orientation.
+        /// - After the newest entry, extrapolates from the two newest with
+        ///   constant linear and angular velocity.
+        /// - At an entry, or after the only entry, returns it unchanged.
+        ///
+        /// @returns false (leaving @p pose untouched) if the history is
+        /// empty or the time is before the oldest entry.
+        OSVR_COMMON_EXPORT bool getPoseAt(util::time::TimeValue const &when,
+                                          OSVR_Pose3 &pose) const;
+
+        std::size_t size() const { return m_entries.size(); }
+        bool empty() const { return m_entries.empty(); }
+        std::size_t capacity() const { return m_entries.capacity(); }
+        void clear() { m_entries.clear(); }
+
+      private:
+        struct Entry {
+            util::time::TimeValue timestamp;
+            OSVR_Pose3 pose;
+        };
+        boost::circular_buffer<Entry> m_entries;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_PoseHistory_h_GUID_C529F168_C15A_4453_BFFC_271A31BDF123
@@ -0,0 +1,89 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ResolvedRouteCache_h_GUID_840EAB24_5334_408A_866B_681807EA67CA
+#define INCLUDED_ResolvedRouteCache_h_GUID_840EAB24_5334_408A_866B_681807EA67CA
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Common/OriginalSource.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <boost/optional.hpp>
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <string>
+#include <unordered_map>
+
+namespace osvr {
+namespace common {
+    /// @brief Caches the results of resolveTreeNode() by path, so that
+    /// (re)connecting an interface whose route hasn't changed is a hash
+    /// lookup rather than a walk through the tree and its aliases.
+    ///
+    /// The cached sources refer to nodes in the tree and carry their
+    /// already-parsed transforms, so the cache must be invalidated whenever
+    /// the tree is modified, and in particular before nodes are deleted (as
+    /// by PathTree::reset()).
+    class ResolvedRouteCache : boost::noncopyable {
+      public:
+        typedef uint64_t generation_type;
+        typedef boost::optional<OriginalSource> result_type;
+
+        OSVR_COMMON_EXPORT ResolvedRouteCache();
+
+        /// @brief Resolve a path, re-using the result cached for it in the
+        /// current generation if there is one.
+        ///
+        /// The reference returned is valid until the next call to resolve().
+        OSVR_COMMON_EXPORT result_type const &resolve(PathTree &tree,
+                                                      std::string const &path);
+
+        /// @brief Start a new generation: results resolved before now will be
+        /// resolved again when next requested.
+        OSVR_COMMON_EXPORT void invalidate();
+
+        /// @brief Gets the current generation, which changes every time the
+        /// cache is invalidated.
+        generation_type getGeneration() const { return m_generation; }
+
+        /// @brief Number of paths with an entry (current or stale).
+        std::size_t size() const { return m_entries.size(); }
+
+      private:
+        struct Entry {
+            Entry() : generation(0) {}
+            generation_type generation;
+            result_type source;
+        };
+        std::unordered_map<std::string, Entry> m_entries;
+        generation_type m_generation;
+    };
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_ResolvedRouteCache_h_GUID_840EAB24_5334_408A_866B_681807EA67CA
@@ -31,12 +31,15 @@
 #include <osvr/Common/DeviceComponent.h>
 #include <osvr/Common/SerializationTags.h>
 #include <osvr/Common/PathTree_fwd.h>
+#include <osvr/Common/PathTreeDelta.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <json/value.h>
+#include <boost/optional.hpp>
 
 // Standard includes
-// - none
+#include <cstddef>
 
 namespace osvr {
 namespace common {
@@ -69,6 +72,46 @@ namespace common {
             class MessageSerialization;
             static const char *identifier();
         };
+
+        class TreeStampFromServer
+            : public MessageRegistration<TreeStampFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class TreeDeltaFromServer
+            : public MessageRegistration<TreeDeltaFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class FullTreeRequestToServer
+            : public MessageRegistration<FullTreeRequestToServer> {
+          public:
+            static const char *identifier();
+        };
+
+        class BinaryTreeFromServer
+            : public MessageRegistration<BinaryTreeFromServer> {
+          public:
+            static const char *identifier();
+        };
+
+        class TreeFormatQueryFromServer
+            : public MessageRegistration<TreeFormatQueryFromServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
+
+        class TreeFormatReplyToServer
+            : public MessageRegistration<TreeFormatReplyToServer> {
+          public:
+            class MessageSerialization;
+            static const char *identifier();
+        };
     } // namespace messages
 
     /// @brief BaseDevice component, to be used only with the "OSVR" special
@@ -110,15 +153,142 @@ namespace common {
                                    util::time::TimeValue const &)> JsonHandler;
         OSVR_COMMON_EXPORT void registerReplaceTreeHandler(JsonHandler cb);
 
+        /// @brief Send the tree, in the binary format (see
+        /// pathTreeToBinary()) if every connected client has said it
+        /// understands it, otherwise as JSON.
         OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree);
 
+        /// @overload
+        ///
+        /// Takes the tree already serialized by pathTreeToJson() as well, to
+        /// send if the binary format can't be used.
+        OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree,
+                                                    Json::Value const &nodes);
+
+        /// @overload
+        ///
+        /// Takes the tree already serialized by pathTreeToJson()
+        OSVR_COMMON_EXPORT void sendReplacementTree(Json::Value const &nodes);
+
+        /// @overload
+        ///
+        /// Sends the stamp of the tree first, so clients that already have
+        /// a tree with the same stamp skip it without decoding it.
+        OSVR_COMMON_EXPORT void sendReplacementTree(PathTree &tree,
+                                                    Json::Value const &nodes,
+                                                    PathTreeStamp const &stamp);
+
+        /// @brief Message from server, identifying the replacement tree
+        /// sent right after it.
+        ///
+        /// Clients that don't know this message ignore it and still get the
+        /// tree, so the tree messages themselves are unchanged.
+        messages::TreeStampFromServer treeStampOut;
+
+        /// @brief Message from server, changing only some nodes of the
+        /// client's path tree (see PathTreeDelta)
+        messages::TreeDeltaFromServer treeDeltaOut;
+
+        /// @brief Send a delta already serialized by pathTreeDeltaToJson()
+        OSVR_COMMON_EXPORT void sendTreeDelta(Json::Value const &delta);
+
+        /// @brief Handle tree deltas: also tells the server, whenever it
+        /// asks, that this client can apply them.
+        OSVR_COMMON_EXPORT void registerTreeDeltaHandler(JsonHandler cb);
+
+        /// @brief Whether every connected client has said it can apply tree
+        /// deltas: otherwise, changes must go out as full replacement trees,
+        /// since clients that don't know deltas ignore them.
+        OSVR_COMMON_EXPORT bool clientsSupportTreeDeltas() const;
+
+        /// @brief Message from client, asking for a replacement tree because
+        /// it can't apply a delta.
+        messages::FullTreeRequestToServer fullTreeRequestIn;
+
+        typedef std::function<void()> RequestHandler;
+        OSVR_COMMON_EXPORT void sendFullTreeRequest();
+        OSVR_COMMON_EXPORT void
+        registerFullTreeRequestHandler(RequestHandler cb);
+
+        /// @brief Message from server, replacing the client's configuration
+        /// with a tree in the binary format of pathTreeToBinary().
+        messages::BinaryTreeFromServer binaryTreeOut;
+
+        typedef std::function<void(const char *, std::size_t,
+                                   util::time::TimeValue const &)>
+            BinaryTreeHandler;
+        /// @brief Handle binary replacement trees: also tells the server,
+        /// whenever it asks, that this client understands them.
+        OSVR_COMMON_EXPORT void registerBinaryTreeHandler(BinaryTreeHandler cb);
+
+        /// @brief Message from server, asking clients which path tree
+        /// formats they understand.
+        messages::TreeFormatQueryFromServer treeFormatQueryOut;
+
+        /// @brief Message from client, answering the latest query.
+        messages::TreeFormatReplyToServer treeFormatReplyIn;
+
+        /// @brief Ask clients which tree formats (binary trees, deltas) they
+        /// understand: call whenever a client connects or disconnects, with
+        /// the number of clients now connected.
+        ///
+        /// Until every one of them has answered, trees are sent as JSON and
+        /// clientsSupportTreeDeltas() is false.
+        OSVR_COMMON_EXPORT void queryTreeFormats(std::size_t clients);
+
       private:
         SystemComponent();
         virtual void m_parentSet();
         static int VRPN_CALLBACK
         m_handleReplaceTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeStamp(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeDelta(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleFullTreeRequest(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleBinaryTree(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeFormatQuery(void *userdata, vrpn_HANDLERPARAM p);
+        static int VRPN_CALLBACK
+        m_handleTreeFormatReply(void *userdata, vrpn_HANDLERPARAM p);
+
+        void m_sendBinaryTree(PathTree &tree);
+        /// @brief Answer tree format queries, when registering the first
+        /// handler for a format that needs the server to ask.
+        void m_registerTreeFormatQueryHandler();
+        /// @brief Register for tree stamps, when registering the first
+        /// replacement tree handler of either format.
+        void m_registerTreeStampHandler();
+        /// @brief Called on receiving a replacement tree: whether it has the
+        /// same stamp as the last tree handled, so can be skipped.
+        bool m_isRepeatedTree();
+        /// @brief Whether the binary tree format can be sent.
+        bool m_clientsSupportBinaryTree() const;
 
         std::vector<JsonHandler> m_replaceTreeHandlers;
+        std::vector<JsonHandler> m_treeDeltaHandlers;
+        std::vector<RequestHandler> m_fullTreeRequestHandlers;
+        std::vector<BinaryTreeHandler> m_binaryTreeHandlers;
+
+        /// @brief Number of the latest tree format query sent, so that
+        /// replies to earlier ones can be ignored.
+        uint32_t m_treeFormatQuery;
+        /// @brief Clients connected as of the latest query.
+        std::size_t m_clients;
+        /// @brief Clients that answered the latest query with binary tree
+        /// support.
+        std::size_t m_binaryTreeClients;
+        /// @brief Clients that answered the latest query with tree delta
+        /// support.
+        std::size_t m_treeDeltaClients;
+
+        /// @brief Stamp received for the next replacement tree, if any.
+        boost::optional<PathTreeStamp> m_nextTreeStamp;
+        /// @brief Stamp of the last replacement tree handled, if any. Deltas
+        /// change the generation, so need not reset it.
+        boost::optional<PathTreeStamp> m_treeStamp;
     };
 } // namespace common
 } // namespace osvr
@@ -35,6 +35,7 @@
 // Standard includes
 #include <string>
 #include <cstdint>
+#include <iosfwd>
 
 namespace osvr {
 namespace common {
@@ -80,6 +81,14 @@ namespace common {
                                       std::string const &string) {
             Policy::mark((fixedString + string).c_str());
         }
+#ifdef OSVR_COMMON_TRACING_RINGLOG
+        /// @brief Writes the most recent events recorded by each thread as
+        /// Chrome trace-event JSON, for chrome://tracing and similar viewers.
+        ///
+        /// Also done at exit, to the file named by the OSVR_TRACE_FILE
+        /// environment variable, if set.
+        OSVR_COMMON_EXPORT void writeChromeTrace(std::ostream &os);
+#endif
 #else  // OSVR_COMMON_TRACING_ENABLED ^^ // vv !OSVR_COMMON_TRACING_ENABLED
         struct MainTracePolicy {
             static TraceBeginStamp begin(const char *) { return 0; }
@@ -0,0 +1,117 @@
+/** @file
+    @brief Header for the message carrying several sensors' poses at once.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_TrackerPoseBatch_h_GUID_5D48D088_120B_49E1_9372_88A5CCD52F6F
+#define INCLUDED_TrackerPoseBatch_h_GUID_5D48D088_120B_49E1_9372_88A5CCD52F6F
+
+// Internal Includes
+#include <osvr/Common/Export.h>
+#include <osvr/Common/MessageRegistration.h>
+#include <osvr/Util/ChannelCountC.h>
+#include <osvr/Util/ClientReportTypesC.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <vrpn_Connection.h>
+
+// Standard includes
+#include <stdexcept>
+#include <vector>
+#include <stddef.h>
+
+namespace osvr {
+namespace common {
+
+    struct SensorPose {
+        OSVR_ChannelCount sensor;
+        OSVR_PoseState pose;
+    };
+
+    typedef std::vector<SensorPose> SensorPoseList;
+
+    namespace messages {
+        /// @brief Poses of several of a tracker's sensors, sharing a single
+        /// timestamp, sent in place of the standard per-sensor VRPN tracker
+        /// messages for those sensors. A batch too large for one message is
+        /// sent as several.
+        class TrackerPoseBatch : public MessageRegistration<TrackerPoseBatch> {
+          public:
+            /// @brief Bytes each pose adds to a message: the sensor, padding
+            /// to align the pose, and the pose itself.
+            static const uint32_t BYTES_PER_POSE = 64;
+            /// @brief Bytes of a message not spent on poses, at most: VRPN's
+            /// message header, the pose count, and alignment padding.
+            static const uint32_t OVERHEAD_BYTES = 32;
+            /// @brief The most poses a single message may carry: as many as
+            /// fit in VRPN's largest (TCP) message.
+            static const uint32_t MAX_POSES =
+                (vrpn_CONNECTION_TCP_BUFLEN - OVERHEAD_BYTES) / BYTES_PER_POSE;
+
+            /// @brief The most poses that fit in a message, given the size
+            /// limit of the transport carrying it.
+            static uint32_t getMaxPoses(size_t messageSizeLimit) {
+                if (messageSizeLimit <= OVERHEAD_BYTES) {
+                    return 0;
+                }
+                auto ret = (messageSizeLimit - OVERHEAD_BYTES) / BYTES_PER_POSE;
+                return ret < MAX_POSES ? static_cast<uint32_t>(ret)
+                                       : MAX_POSES;
+            }
+
+            class MessageSerialization;
+
+            OSVR_COMMON_EXPORT static const char *identifier();
+        };
+
+        class TrackerPoseBatch::MessageSerialization {
+          public:
+            /// @brief Serializes from, or deserializes into (reusing its
+            /// storage), the given list.
+            explicit MessageSerialization(SensorPoseList &poses)
+                : m_poses(poses) {}
+
+            template <typename T> void processMessage(T &p) {
+                uint32_t count = static_cast<uint32_t>(m_poses.size());
+                p(count);
+                if (count > MAX_POSES) {
+                    throw std::runtime_error(
+                        "Tracker pose batch has too many poses!");
+                }
+                m_poses.resize(count);
+                for (auto &entry : m_poses) {
+                    p(entry.sensor);
+                    p(entry.pose);
+                }
+            }
+
+          private:
+            SensorPoseList &m_poses;
+        };
+    } // namespace messages
+
+} // namespace common
+} // namespace osvr
+
+#endif // INCLUDED_TrackerPoseBatch_h_GUID_5D48D088_120B_49E1_9372_88A5CCD52F6F
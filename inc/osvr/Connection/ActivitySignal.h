@@ -0,0 +1,73 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_ActivitySignal_h_GUID_5E6D5F13_30B6_4113_B583_92AF35525F22
+#define INCLUDED_ActivitySignal_h_GUID_5E6D5F13_30B6_4113_B583_92AF35525F22
+
+// Internal Includes
+#include <osvr/Connection/Export.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace connection {
+    /// @brief Lets any thread wake up a thread (typically the server main
+    /// loop) waiting for something to do on a connection.
+    ///
+    /// Signals are "sticky": a signal raised while nobody is waiting makes the
+    /// next wait return immediately, so work posted just after a loop
+    /// iteration finished is never missed.
+    class ActivitySignal : boost::noncopyable {
+      public:
+        OSVR_CONNECTION_EXPORT ActivitySignal();
+
+        /// @brief Note that there is work to do, waking the waiting thread if
+        /// any. Callable from any thread.
+        OSVR_CONNECTION_EXPORT void signal();
+
+        /// @brief Wait until signalled, or until the timeout passes,
+        /// consuming any pending signal.
+        ///
+        /// @param timeoutMicroseconds Upper bound on the wait: a value of
+        /// zero or less just consumes any pending signal without blocking.
+        /// @returns true if signalled, false if timed out.
+        OSVR_CONNECTION_EXPORT bool wait(int timeoutMicroseconds);
+
+      private:
+        boost::mutex m_mutex;
+        boost::condition_variable m_cond;
+        bool m_pending;
+    };
+    typedef shared_ptr<ActivitySignal> ActivitySignalPtr;
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_ActivitySignal_h_GUID_5E6D5F13_30B6_4113_B583_92AF35525F22
@@ -0,0 +1,69 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncQueueOptions_h_GUID_D17A4EAD_6A8C_417F_BB9A_0DFDC2BD9DCF
+#define INCLUDED_AsyncQueueOptions_h_GUID_D17A4EAD_6A8C_417F_BB9A_0DFDC2BD9DCF
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+
+namespace osvr {
+namespace connection {
+    /// @brief What an async device's report queue does when the device thread
+    /// sends a report while the queue is full.
+    enum class AsyncQueueFullPolicy {
+        /// @brief Discard the oldest queued report to make room for the new
+        /// one.
+        DropOldest,
+        /// @brief Discard the report being sent.
+        DropNewest,
+        /// @brief Block the device thread until the main thread has drained
+        /// some space (the behavior closest to the old handshake).
+        Block
+    };
+
+    /// @brief Configuration of the report queue between an async device's
+    /// thread and the server main loop.
+    struct AsyncQueueOptions {
+        AsyncQueueOptions()
+            : capacity(DEFAULT_CAPACITY),
+              policy(AsyncQueueFullPolicy::DropOldest) {}
+        /// @brief The default number of reports that may be pending
+        static const std::size_t DEFAULT_CAPACITY = 64;
+
+        /// @brief Maximum number of reports pending at once.
+        std::size_t capacity;
+        /// @brief Behavior when a report is sent with the queue full.
+        AsyncQueueFullPolicy policy;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncQueueOptions_h_GUID_D17A4EAD_6A8C_417F_BB9A_0DFDC2BD9DCF
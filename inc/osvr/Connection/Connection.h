@@ -27,11 +27,14 @@
 
 // Internal Includes
 #include <osvr/Connection/Export.h>
+#include <osvr/Connection/ActivitySignal.h>
+#include <osvr/Connection/SyncDeviceThreadOptions.h>
 #include <osvr/Connection/MessageTypePtr.h>
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
 #include <osvr/Connection/DeviceInitObject.h>
 #include <osvr/Util/DeviceCallbackTypesC.h>
+#include <osvr/Util/UniquePtr.h>
 #include <osvr/PluginHost/RegistrationContext_fwd.h>
 
 // Library/third-party includes
@@ -49,6 +52,7 @@ namespace osvr {
 /// @brief Messaging transport and device communication functionality
 /// @ingroup Connection
 namespace connection {
+    class SyncDeviceWorkers;
 
     /// @brief Class wrapping a messaging transport (server or internal)
     /// connection.
@@ -124,6 +128,32 @@ namespace connection {
         /// handlers.
         OSVR_CONNECTION_EXPORT void triggerDescriptorHandlers();
 
+        /// @brief Note that there is work for the next process() call, waking
+        /// a thread waiting in waitForActivity(). Callable from any thread.
+        OSVR_CONNECTION_EXPORT void signalActivity();
+
+        /// @brief Block until signalActivity() is called or the timeout (in
+        /// microseconds) passes.
+        ///
+        /// Network traffic does not signal activity, so the timeout bounds
+        /// how long incoming messages may wait to be processed.
+        ///
+        /// @returns true if signalled, false if timed out.
+        OSVR_CONNECTION_EXPORT bool waitForActivity(int timeoutMicroseconds);
+
+        /// @brief Get the object used by signalActivity() and
+        /// waitForActivity(), to be able to signal even after the connection
+        /// itself may have been destroyed.
+        OSVR_CONNECTION_EXPORT ActivitySignalPtr getActivitySignal() const;
+
+        /// @brief Set where the update callbacks of sync devices run.
+        ///
+        /// Must be called before the first process() call.
+        ///
+        /// @throws std::logic_error if sync devices have already been set up.
+        OSVR_CONNECTION_EXPORT void
+        setSyncDeviceThreadOptions(SyncDeviceThreadOptions const &opts);
+
         /// @brief Destructor
         OSVR_CONNECTION_EXPORT virtual ~Connection();
 
@@ -175,6 +205,10 @@ namespace connection {
         /// @brief Returns some implementation-defined string based on the
         /// dynamic type of the connection.
         OSVR_CONNECTION_EXPORT virtual const char *getConnectionKindID();
+
+        /// @brief Access the worker threads for sync devices (internal),
+        /// setting them up on first call.
+        SyncDeviceWorkers &getSyncDeviceWorkers();
         /// @}
 
       protected:
@@ -202,6 +236,9 @@ namespace connection {
       private:
         DeviceList m_devices;
         std::vector<std::function<void()> > m_descriptorHandlers;
+        ActivitySignalPtr m_activity;
+        SyncDeviceThreadOptions m_syncDeviceThreadOptions;
+        unique_ptr<SyncDeviceWorkers> m_syncDeviceWorkers;
     };
 } // namespace connection
 } // namespace osvr
@@ -30,6 +30,7 @@
 #include <osvr/Connection/ConnectionDevicePtr.h>
 #include <osvr/Connection/MessageTypePtr.h>
 #include <osvr/Connection/DeviceTokenPtr.h>
+#include <osvr/Util/StdInt.h>
 #include <osvr/Util/TimeValue.h>
 
 // Library/third-party includes
@@ -78,6 +79,14 @@ namespace connection {
         /// @brief Get the most current JSON device descriptor
         OSVR_CONNECTION_EXPORT std::string const &getDeviceDescriptor() const;
 
+        /// @brief Identifies the current descriptor: changes each time
+        /// setDeviceDescriptor() is given a descriptor different from the
+        /// current one, to a value no device has had before. 0 until then.
+        ///
+        /// Lets descriptor handlers skip devices whose descriptor they have
+        /// already seen, without comparing descriptors.
+        OSVR_CONNECTION_EXPORT uint64_t getDeviceDescriptorRevision() const;
+
       protected:
         /// @brief Does this connection device have a device token? Should be
         /// true in nearly every case.
@@ -103,6 +112,7 @@ namespace connection {
         NameList m_names;
         DeviceToken *m_token;
         std::string m_descriptor;
+        uint64_t m_descriptorRevision;
     };
 } // namespace connection
 } // namespace osvr
@@ -37,6 +37,7 @@
 #include <osvr/Connection/ServerInterfaceList.h>
 #include <osvr/Common/DeviceComponentPtr.h>
 #include <osvr/Connection/DeviceInterfaceBase.h>
+#include <osvr/Connection/AsyncQueueOptions.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -96,6 +97,10 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     OSVR_CONNECTION_EXPORT void
     addComponent(osvr::common::DeviceComponentPtr const &comp);
 
+    /// @brief Configure the report queue used if this is an async device.
+    OSVR_CONNECTION_EXPORT void
+    setAsyncQueueOptions(osvr::connection::AsyncQueueOptions const &opts);
+
     /// @brief A helper method to make a "device interface object" of
     /// user-designated type and apppropriate lifetime.
     template <typename T> T *makeInterfaceObject() {
@@ -156,6 +161,10 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
         return m_components;
     }
 
+    osvr::connection::AsyncQueueOptions const &getAsyncQueueOptions() const {
+        return m_asyncQueueOptions;
+    }
+
   private:
     osvr::pluginhost::PluginSpecificRegistrationContext *m_context;
     osvr::connection::ConnectionPtr m_conn;
@@ -169,6 +178,7 @@ struct OSVR_DeviceInitObject : boost::noncopyable {
     osvr::connection::TrackerServerInterface **m_trackerIface;
     osvr::connection::ServerInterfaceList m_serverInterfaces;
     osvr::common::DeviceComponentList m_components;
+    osvr::connection::AsyncQueueOptions m_asyncQueueOptions;
     std::vector<OSVR_DeviceTokenObject **> m_tokenInterest;
 
     std::vector<osvr::connection::DeviceInterfaceBase *> m_deviceInterfaces;
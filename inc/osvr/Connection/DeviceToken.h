@@ -88,17 +88,19 @@ struct OSVR_DeviceTokenObject : boost::noncopyable {
     /// The timestamp for the data is assumed to be at the time this call is
     /// placed.
     ///
-    /// This may block until the next connectionInteract call before
-    /// forwarding on to ConnectionDevice::sendData, depending on the type
-    /// of device token.
+    /// Depending on the type of device token, this may forward directly to
+    /// ConnectionDevice::sendData, or queue the data for the next
+    /// connectionInteract call (which may block if that queue is full and
+    /// configured to do so).
     OSVR_CONNECTION_EXPORT void sendData(osvr::connection::MessageType *type,
                                          const char *bytestream, size_t len);
 
     /// @brief Send data.
     ///
-    /// This may block until the next connectionInteract call before
-    /// forwarding on to ConnectionDevice::sendData, depending on the type
-    /// of device token.
+    /// Depending on the type of device token, this may forward directly to
+    /// ConnectionDevice::sendData, or queue the data for the next
+    /// connectionInteract call (which may block if that queue is full and
+    /// configured to do so).
     OSVR_CONNECTION_EXPORT void
     sendData(osvr::util::time::TimeValue const &timestamp,
              osvr::connection::MessageType *type, const char *bytestream,
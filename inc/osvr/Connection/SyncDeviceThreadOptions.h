@@ -0,0 +1,68 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SyncDeviceThreadOptions_h_GUID_102B6CEE_6670_41DC_B59B_A62B8C74E328
+#define INCLUDED_SyncDeviceThreadOptions_h_GUID_102B6CEE_6670_41DC_B59B_A62B8C74E328
+
+// Internal Includes
+// - none
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstddef>
+#include <map>
+#include <string>
+
+namespace osvr {
+namespace connection {
+    /// @brief Configuration of where the update callbacks of sync devices
+    /// run.
+    ///
+    /// By default, they all run in turn in the server main loop. Given worker
+    /// threads, each group of sync devices is instead updated on one of the
+    /// workers (once per main loop iteration, without holding up the main
+    /// loop), with reports passed back to the main loop through a queue per
+    /// device.
+    struct SyncDeviceThreadOptions {
+        SyncDeviceThreadOptions() : threads(0) {}
+
+        /// @brief Number of worker threads: 0 (the default) runs sync
+        /// devices in the main loop.
+        std::size_t threads;
+
+        /// @brief Map from a fully-qualified device name
+        /// ("plugin/device") or a plugin name to the name of a group.
+        ///
+        /// Devices in the same group always share a worker thread, and
+        /// groups are spread across the workers. A device not listed,
+        /// directly or by its plugin, is in a group named after its plugin,
+        /// since devices from one plugin may share state.
+        std::map<std::string, std::string> groups;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_SyncDeviceThreadOptions_h_GUID_102B6CEE_6670_41DC_B59B_A62B8C74E328
@@ -56,6 +56,17 @@ namespace connection {
         virtual void sendReport(OSVR_PoseState const &val,
                                 OSVR_ChannelCount chan,
                                 util::time::TimeValue const &timestamp) = 0;
+
+        /// @brief Send the poses of several sensors, sharing a timestamp, in
+        /// as few messages as the transport allows.
+        ///
+        /// @param poses Array of @p count poses
+        /// @param sensors Array of @p count sensor numbers, one per pose
+        /// @returns false if any message could not be sent.
+        virtual bool sendReports(OSVR_PoseState const *poses,
+                                 OSVR_ChannelCount const *sensors,
+                                 OSVR_ChannelCount count,
+                                 util::time::TimeValue const &timestamp) = 0;
     };
 
 } // namespace connection
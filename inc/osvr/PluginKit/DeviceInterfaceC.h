@@ -212,8 +212,40 @@ osvrDeviceSyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext ctx,
    method run in a thread of its own, repeatedly as long as the device exists.
     Calls sending data from an async device are automatically made thread-safe.
 
+    Raw data sent with osvrDeviceSendData() or
+   osvrDeviceSendTimestampedData() from an async device is copied into a
+   bounded queue without waiting for the main thread, which sends everything
+   queued on each pass through its loop. The queue size and its behavior when
+   full may be configured with osvrDeviceAsyncQueueOptions().
+
     @{
 */
+
+/** @brief What an async device's report queue does when data is sent while
+    it is full.
+*/
+typedef enum OSVR_AsyncQueueFullPolicy {
+    /** @brief Discard the oldest queued report (the default) */
+    OSVR_ASYNC_QUEUE_DROP_OLDEST = 0,
+    /** @brief Discard the report being sent */
+    OSVR_ASYNC_QUEUE_DROP_NEWEST = 1,
+    /** @brief Block the sending thread until there is space */
+    OSVR_ASYNC_QUEUE_BLOCK = 2
+} OSVR_AsyncQueueFullPolicy;
+
+/** @brief Configure the report queue of an asynchronous device to be created
+    with the given options.
+
+    @param options The DeviceInitOptions for your device.
+    @param capacity Maximum number of reports pending at once (minimum 1)
+    @param policy Behavior when sending data with the queue full.
+*/
+OSVR_PLUGINKIT_EXPORT OSVR_ReturnCode
+osvrDeviceAsyncQueueOptions(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                            OSVR_IN size_t capacity,
+                            OSVR_IN OSVR_AsyncQueueFullPolicy policy)
+    OSVR_FUNC_NONNULL((1));
+
 /** @brief Initialize an asynchronous device token.
 
     This primarily allocates the device token, and does not start reporting.
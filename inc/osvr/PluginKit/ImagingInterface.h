@@ -37,6 +37,7 @@
 
 // Standard includes
 #include <iosfwd>
+#include <utility>
 
 namespace osvr {
 namespace pluginkit {
@@ -72,6 +73,123 @@ namespace pluginkit {
         OSVR_ChannelCount m_sensor;
     };
 
+    namespace detail {
+        /// @brief Describe an OpenCV image type and size as imaging metadata.
+        inline OSVR_ImagingMetadata makeImagingMetadata(int rows, int cols,
+                                                        int cvType) {
+            util::NumberTypeData typedata = util::opencvNumberTypeData(cvType);
+            OSVR_ImagingMetadata metadata;
+            metadata.channels = CV_MAT_CN(cvType);
+            metadata.depth = typedata.getSize();
+            metadata.width = cols;
+            metadata.height = rows;
+            metadata.type = typedata.isFloatingPoint()
+                                ? OSVR_IVT_FLOATING_POINT
+                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
+                                                       : OSVR_IVT_UNSIGNED_INT);
+            return metadata;
+        }
+    } // namespace detail
+
+    /// @brief A frame buffer reserved by
+    /// osvr::pluginkit::ImagingInterface::beginFrame(), to write an image into
+    /// in place rather than having it copied when sent.
+    ///
+    /// Move-only. If destroyed without being passed to
+    /// osvr::pluginkit::ImagingInterface::sendFrame(), the frame is abandoned.
+    class ImagingFrameBuffer {
+      public:
+        /// @brief Constructs an empty frame buffer.
+        ImagingFrameBuffer()
+            : m_dev(NULL), m_iface(NULL), m_frame(NULL), m_buffer(NULL),
+              m_metadata(), m_sensor(0) {}
+
+        ImagingFrameBuffer(OSVR_DeviceToken dev,
+                           OSVR_ImagingDeviceInterface iface,
+                           OSVR_ImagingFrameBuffer frame,
+                           OSVR_ImageBufferElement *buffer,
+                           OSVR_ImagingMetadata const &metadata,
+                           OSVR_ChannelCount sensor)
+            : m_dev(dev), m_iface(iface), m_frame(frame), m_buffer(buffer),
+              m_metadata(metadata), m_sensor(sensor) {}
+
+        ~ImagingFrameBuffer() { abandon(); }
+
+        ImagingFrameBuffer(ImagingFrameBuffer &&other) : ImagingFrameBuffer() {
+            swap(other);
+        }
+        ImagingFrameBuffer &operator=(ImagingFrameBuffer &&other) {
+            if (&other != this) {
+                abandon();
+                swap(other);
+            }
+            return *this;
+        }
+
+        /// @brief Is there a reserved frame in this object?
+        explicit operator bool() const { return m_frame != NULL; }
+
+        /// @brief Start of the buffer to write the image into.
+        OSVR_ImageBufferElement *data() const { return m_buffer; }
+
+        /// @brief Gets a cv::Mat header pointing directly into the buffer:
+        /// write into it without reallocating it (e.g. use functions with an
+        /// output parameter of the right size and type).
+        cv::Mat getMat() const {
+            return cv::Mat(m_metadata.height, m_metadata.width,
+                           util::computeOpenCVMatType(m_metadata), m_buffer);
+        }
+
+        OSVR_ImagingMetadata const &getMetadata() const { return m_metadata; }
+
+        /// @brief Gets the sensor number.
+        OSVR_ChannelCount getSensor() const { return m_sensor; }
+
+        OSVR_DeviceToken getDevice() const { return m_dev; }
+
+        /// @brief Release the reserved frame without sending it.
+        void abandon() {
+            if (m_frame) {
+                osvrDeviceImagingAbandonFrame(m_dev, m_iface, m_frame);
+            }
+            m_reset();
+        }
+
+        /// @brief Gives up ownership of the reserved frame handle - used by
+        /// osvr::pluginkit::ImagingInterface::sendFrame()
+        OSVR_ImagingFrameBuffer release() {
+            OSVR_ImagingFrameBuffer ret = m_frame;
+            m_reset();
+            return ret;
+        }
+
+        void swap(ImagingFrameBuffer &other) {
+            using std::swap;
+            swap(m_dev, other.m_dev);
+            swap(m_iface, other.m_iface);
+            swap(m_frame, other.m_frame);
+            swap(m_buffer, other.m_buffer);
+            swap(m_metadata, other.m_metadata);
+            swap(m_sensor, other.m_sensor);
+        }
+
+      private:
+        ImagingFrameBuffer(ImagingFrameBuffer const &);
+        ImagingFrameBuffer &operator=(ImagingFrameBuffer const &);
+
+        void m_reset() {
+            m_frame = NULL;
+            m_buffer = NULL;
+        }
+
+        OSVR_DeviceToken m_dev;
+        OSVR_ImagingDeviceInterface m_iface;
+        OSVR_ImagingFrameBuffer m_frame;
+        OSVR_ImageBufferElement *m_buffer;
+        OSVR_ImagingMetadata m_metadata;
+        OSVR_ChannelCount m_sensor;
+    };
+
     /// @brief A class wrapping an imaging interface for a device.
     class ImagingInterface {
       public:
@@ -94,6 +212,85 @@ namespace pluginkit {
             }
         }
 
+        /// @brief Limit frames sent over the network (rather than through
+        /// shared memory) to a region of interest, and optionally to every
+        /// rowStep-th row of it. A width or height of 0 extends the region to
+        /// the edge of the frame.
+        void configureNetwork(OSVR_ImageDimension left, OSVR_ImageDimension top,
+                              OSVR_ImageDimension width = 0,
+                              OSVR_ImageDimension height = 0,
+                              OSVR_ImageDimension rowStep = 1) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret = osvrDeviceImagingConfigureNetwork(
+                m_iface, left, top, width, height, rowStep);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::invalid_argument(
+                    "Could not configure imaging network options!");
+            }
+        }
+
+        /// @brief Choose how shared memory for frames is synchronized.
+        void configureSharedMemory(OSVR_ImagingSharedMemorySync sync) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret =
+                osvrDeviceImagingConfigureSharedMemory(m_iface, sync);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::invalid_argument(
+                    "Could not configure imaging shared memory!");
+            }
+        }
+
+        /// @brief Send frames too large for one message over the network
+        /// anyway, in fragments, rather than only through shared memory.
+        void configureNetworkFragments(bool enable = true) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret = osvrDeviceImagingConfigureNetworkFragments(
+                m_iface, enable ? OSVR_TRUE : OSVR_FALSE);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::invalid_argument(
+                    "Could not configure imaging network fragments!");
+            }
+        }
+
+        /// @brief Compress frames sent over the network (rather than through
+        /// shared memory) with the given lossless encoding, once fragments
+        /// are enabled with configureNetworkFragments().
+        void configureNetworkEncoding(OSVR_ImagingNetworkEncoding encoding,
+                                      uint32_t keyframeInterval = 30) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ReturnCode ret = osvrDeviceImagingConfigureNetworkEncoding(
+                m_iface, encoding, keyframeInterval);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::invalid_argument(
+                    "Could not configure imaging network encoding!");
+            }
+        }
+
+        /// @brief Get statistics on network encoding since it was
+        /// configured.
+        OSVR_ImagingNetworkEncodingStats getNetworkEncodingStats() const {
+            OSVR_ImagingNetworkEncodingStats stats;
+            OSVR_ReturnCode ret =
+                osvrDeviceImagingGetNetworkEncodingStats(m_iface, &stats);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            return stats;
+        }
+
         /// @brief Send method - usually called by
         /// osvr::pluginkit::DeviceToken::send()
         void send(DeviceToken &dev, ImagingMessage const &message,
@@ -103,17 +300,8 @@ namespace pluginkit {
                     "Must initialize the imaging interface before using it!");
             }
             cv::Mat const &frame(message.getFrame());
-            util::NumberTypeData typedata =
-                util::opencvNumberTypeData(frame.type());
-            OSVR_ImagingMetadata metadata;
-            metadata.channels = frame.channels();
-            metadata.depth = typedata.getSize();
-            metadata.width = frame.cols;
-            metadata.height = frame.rows;
-            metadata.type = typedata.isFloatingPoint()
-                                ? OSVR_IVT_FLOATING_POINT
-                                : (typedata.isSigned() ? OSVR_IVT_SIGNED_INT
-                                                       : OSVR_IVT_UNSIGNED_INT);
+            OSVR_ImagingMetadata metadata = detail::makeImagingMetadata(
+                frame.rows, frame.cols, frame.type());
 
             OSVR_ReturnCode ret =
                 osvrDeviceImagingReportFrame(dev, m_iface, metadata, frame.data,
@@ -123,6 +311,46 @@ namespace pluginkit {
             }
         }
 
+        /// @brief Reserve a frame buffer of the given size and OpenCV type to
+        /// write an image into in place, avoiding the copies made by send().
+        ///
+        /// @returns an empty frame buffer if none could be reserved, in which
+        /// case fall back to send().
+        ImagingFrameBuffer beginFrame(DeviceToken &dev, int rows, int cols,
+                                      int cvType,
+                                      OSVR_ChannelCount sensor = 0) {
+            if (!m_iface) {
+                throw std::logic_error(
+                    "Must initialize the imaging interface before using it!");
+            }
+            OSVR_ImagingMetadata metadata =
+                detail::makeImagingMetadata(rows, cols, cvType);
+            OSVR_ImagingFrameBuffer frame = NULL;
+            OSVR_ImageBufferElement *buffer = NULL;
+            OSVR_ReturnCode ret = osvrDeviceImagingBeginFrame(
+                dev, m_iface, metadata, sensor, &frame, &buffer);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                return ImagingFrameBuffer();
+            }
+            return ImagingFrameBuffer(dev, m_iface, frame, buffer, metadata,
+                                      sensor);
+        }
+
+        /// @brief Send a frame written into a buffer from beginFrame(). The
+        /// frame buffer is empty afterwards.
+        void sendFrame(ImagingFrameBuffer &frame,
+                       OSVR_TimeValue const &timestamp) {
+            if (!frame) {
+                throw std::logic_error("Can't send an empty frame buffer!");
+            }
+            OSVR_DeviceToken dev = frame.getDevice();
+            OSVR_ReturnCode ret = osvrDeviceImagingSendFrame(
+                dev, m_iface, frame.release(), &timestamp);
+            if (OSVR_RETURN_SUCCESS != ret) {
+                throw std::runtime_error("Could not send imaging frame!");
+            }
+        }
+
       private:
         OSVR_ImagingDeviceInterface m_iface;
     };
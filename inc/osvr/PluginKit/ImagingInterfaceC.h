@@ -31,8 +31,10 @@
 
 /* Internal Includes */
 #include <osvr/PluginKit/DeviceInterfaceC.h>
+#include <osvr/Util/BoolC.h>
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/ImagingReportTypesC.h>
+#include <osvr/Util/StdInt.h>
 
 /* Library/third-party includes */
 /* none */
@@ -74,6 +76,125 @@ osvrDeviceImagingConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                            OSVR_IN OSVR_ChannelCount numSensors
                                OSVR_CPP_ONLY(= 1)) OSVR_FUNC_NONNULL((1, 2));
 
+/** @brief Limit what is sent to clients over the network (as opposed to
+    through shared memory) to a region of interest, and optionally to only
+    every few rows of it, to save bandwidth.
+
+    @param iface Imaging interface
+    @param left First column of the region of interest
+    @param top First row of the region of interest
+    @param width Width of the region of interest, or 0 for all columns from
+   the left one.
+    @param height Height of the region of interest, or 0 for all rows from the
+   top one.
+    @param rowStep Send only every rowStep-th row of the region of interest: 1
+   sends them all.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingConfigureNetwork(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImageDimension left, OSVR_IN OSVR_ImageDimension top,
+    OSVR_IN OSVR_ImageDimension width, OSVR_IN OSVR_ImageDimension height,
+    OSVR_IN OSVR_ImageDimension rowStep) OSVR_FUNC_NONNULL((1));
+
+/** @brief How shared memory carrying frames to local clients is
+    synchronized. */
+typedef enum OSVR_ImagingSharedMemorySync {
+    /** @brief Interprocess mutexes: understood by all clients, but a client
+        slow to read a frame holds up the device. */
+    OSVR_ISMS_MUTEX = 0,
+    /** @brief Lock-free: the device never waits for clients, but clients
+        predating this option can't read it, and only get frames small
+        enough to send over the network. */
+    OSVR_ISMS_SEQLOCK = 1
+} OSVR_ImagingSharedMemorySync;
+
+/** @brief Choose how shared memory for frames is synchronized: by default,
+    OSVR_ISMS_MUTEX.
+
+    @param iface Imaging interface
+    @param sync Synchronization scheme
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingConfigureSharedMemory(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingSharedMemorySync sync) OSVR_FUNC_NONNULL((1));
+
+/** @brief Send frames too large for a single message to clients over the
+    network anyway, split across several messages.
+
+    Off by default, in which case such frames only reach clients on the same
+    machine, through shared memory. A 640x480 RGB frame takes several hundred
+    messages, so only enable this for devices whose frames remote clients
+    need.
+
+    @param iface Imaging interface
+    @param enable OSVR_TRUE to send large frames in fragments
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingConfigureNetworkFragments(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface, OSVR_IN OSVR_CBool enable)
+    OSVR_FUNC_NONNULL((1));
+
+/** @brief Encodings for frames sent over the network: all lossless. */
+typedef enum OSVR_ImagingNetworkEncoding {
+    /** @brief Raw image data */
+    OSVR_INE_RAW = 0,
+    /** @brief Run-length encoded */
+    OSVR_INE_RUN_LENGTH = 1,
+    /** @brief Encoded as the difference from the previous frame, then
+        run-length encoded: best for mostly static images, such as from IR
+        cameras. */
+    OSVR_INE_DELTA_RUN_LENGTH = 2
+} OSVR_ImagingNetworkEncoding;
+
+/** @brief Compress frames sent to clients over the network (as opposed to
+    through shared memory, which always gets raw frames). Each frame is
+    compressed once, however many clients there are, and sent raw if that
+    doesn't make it smaller.
+
+    Only applies once osvrDeviceImagingConfigureNetworkFragments() has
+    enabled fragments, since encoded frames are always sent that way.
+
+    @param iface Imaging interface
+    @param encoding Encoding to use
+    @param keyframeInterval With delta encoding, the most frames a sensor may
+   send between frames not relative to an earlier frame: clients that connect
+   or miss a frame wait at most this long for the next one.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingConfigureNetworkEncoding(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingNetworkEncoding encoding,
+    OSVR_IN uint32_t keyframeInterval OSVR_CPP_ONLY(= 30))
+    OSVR_FUNC_NONNULL((1));
+
+/** @brief Statistics on network encoding since it was configured. */
+typedef struct OSVR_ImagingNetworkEncodingStats {
+    /** @brief Frames encoded */
+    uint64_t frames;
+    /** @brief Frames not relative to an earlier frame */
+    uint64_t keyframes;
+    /** @brief Total bytes of the frames before encoding */
+    uint64_t rawBytes;
+    /** @brief Total bytes of the frames after encoding */
+    uint64_t encodedBytes;
+    /** @brief Total time spent encoding */
+    double encodeSeconds;
+} OSVR_ImagingNetworkEncodingStats;
+
+/** @brief Get statistics on network encoding, for instance to work out the
+    compression ratio. Call from the thread sending frames.
+
+    @param iface Imaging interface
+    @param [out] stats Statistics
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceImagingGetNetworkEncodingStats(
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_OUT_PTR OSVR_ImagingNetworkEncodingStats *stats)
+    OSVR_FUNC_NONNULL((1, 2));
+
 /** @brief Report a frame for a sensor. Takes ownership of the buffer and
     **frees it with the OpenCV deallocation functions** when done, so only
     pass in memory allocated by the matching version of OpenCV.
@@ -95,6 +216,78 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
                              OSVR_IN OSVR_ChannelCount sensor,
                              OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 4, 6));
+
+/** @brief Opaque type of a frame being written directly into the buffer that
+    will be shared with clients, avoiding a copy of the image data.
+*/
+typedef struct OSVR_ImagingFrameBufferObject *OSVR_ImagingFrameBuffer;
+
+/** @brief Reserve the next frame buffer for a sensor, to write a frame into
+    in place.
+
+    Clients can't read earlier frames from this sensor while a frame is
+   reserved, so write the image and call osvrDeviceImagingSendFrame() (or
+   osvrDeviceImagingAbandonFrame()) promptly. Only one frame per sensor may be
+   reserved at a time.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param metadata Metadata of the image to be written: determines the size of
+   the buffer.
+    @param sensor Sensor number, usually 0
+    @param [out] frame Handle to the reserved frame, to pass to
+   osvrDeviceImagingSendFrame() or osvrDeviceImagingAbandonFrame().
+    @param [out] buffer Start of the buffer to write the image into, tightly
+   packed with rows in order.
+
+    @returns OSVR_RETURN_FAILURE if no frame buffer is available (for instance,
+   shared memory could not be set up), in which case you may fall back to
+   osvrDeviceImagingReportFrame().
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingBeginFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                            OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                            OSVR_IN OSVR_ImagingMetadata metadata,
+                            OSVR_IN OSVR_ChannelCount sensor,
+                            OSVR_OUT_PTR OSVR_ImagingFrameBuffer *frame,
+                            OSVR_OUT_PTR OSVR_ImageBufferElement **buffer)
+    OSVR_FUNC_NONNULL((1, 2, 5, 6));
+
+/** @brief Report a frame written into a buffer from
+    osvrDeviceImagingBeginFrame(). The frame handle is released whether or not
+    this succeeds.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param frame Frame handle from osvrDeviceImagingBeginFrame()
+    @param timestamp Timestamp correlating to frame.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingSendFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                           OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_ImagingFrameBuffer frame,
+                           OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 3, 4));
+
+/** @brief Release a frame from osvrDeviceImagingBeginFrame() without
+    reporting it.
+
+    Clients keep getting the previous frame as the latest one. If all of the
+    sensor's frame buffers were in use, though, the oldest frame is no longer
+    available, since its buffer was handed out for the abandoned frame.
+
+    @param dev Device token
+    @param iface Imaging interface
+    @param frame Frame handle from osvrDeviceImagingBeginFrame()
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceImagingAbandonFrame(OSVR_IN_PTR OSVR_DeviceToken dev,
+                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                              OSVR_IN_PTR OSVR_ImagingFrameBuffer frame)
+    OSVR_FUNC_NONNULL((1, 2, 3));
 /** @} */ /* end of group */
 
 OSVR_EXTERN_C_END
@@ -88,6 +88,45 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
     OSVR_IN_PTR OSVR_TimeValue const *timestamp)
     OSVR_FUNC_NONNULL((1, 2, 3, 5));
 
+/** @brief Report the full rigid body poses of several sensors, measured at
+    the same time, batched into as few messages as possible.
+
+    Cheaper than one osvrDeviceTrackerSendPose() call per sensor for devices
+    that report many sensors at once: clients receive and dispatch each
+    message's poses at once. The batch replaces, rather than accompanies,
+    the per-sensor reports, so clients built before this call was added
+    won't see these poses.
+
+    @param poses Array of @p count poses.
+    @param sensors Array of @p count sensor numbers, one for each pose.
+    @param count Number of poses.
+
+    @returns failure if any part of the batch could not be sent.
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode
+osvrDeviceTrackerSendPoses(OSVR_IN_PTR OSVR_DeviceToken dev,
+                           OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_PoseState const *poses,
+                           OSVR_IN_PTR OSVR_ChannelCount const *sensors,
+                           OSVR_IN OSVR_ChannelCount count)
+    OSVR_FUNC_NONNULL((1, 2, 3, 4));
+
+/** @brief Report the full rigid body poses of several sensors with the
+    supplied timestamp, in a single message.
+
+    @see osvrDeviceTrackerSendPoses()
+*/
+OSVR_PLUGINKIT_EXPORT
+OSVR_ReturnCode osvrDeviceTrackerSendPosesTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken dev,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_PoseState const *poses,
+    OSVR_IN_PTR OSVR_ChannelCount const *sensors,
+    OSVR_IN OSVR_ChannelCount count,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp)
+    OSVR_FUNC_NONNULL((1, 2, 3, 4, 6));
+
 /** @brief Report the position of a position-only sensor.
 */
 OSVR_PLUGINKIT_EXPORT
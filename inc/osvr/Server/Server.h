@@ -29,6 +29,7 @@
 #include <osvr/Server/Export.h>
 #include <osvr/Server/ServerPtr.h>
 #include <osvr/Connection/ConnectionPtr.h>
+#include <osvr/Connection/SyncDeviceThreadOptions.h>
 #include <osvr/Common/PathElementTypes_fwd.h>
 #include <osvr/Util/UniquePtr.h>
 
@@ -229,6 +230,32 @@ namespace server {
         /// Call only before starting the server or from within server thread.
         OSVR_SERVER_EXPORT int getSleepTime() const;
 
+        /// @brief Sets whether the server loop, between iterations, waits
+        /// to be woken by activity (reports from async devices, calls into
+        /// the server from other threads) instead of sleeping or yielding.
+        ///
+        /// This trades network latency for idle CPU use. Messages from
+        /// clients and sync devices do not wake the loop. They are handled
+        /// only when it wakes for other activity or when the sleep time,
+        /// now the longest the loop waits, runs out.
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT void setWaitForActivity(bool wait);
+
+        /// @brief Returns whether the server loop waits for activity between
+        /// iterations.
+        ///
+        /// Call only before starting the server or from within server thread.
+        OSVR_SERVER_EXPORT bool getWaitForActivity() const;
+
+        /// @brief Sets where the update callbacks of sync devices run: by
+        /// default in the server loop, optionally on a pool of worker
+        /// threads.
+        ///
+        /// Call only before starting the server.
+        OSVR_SERVER_EXPORT void setSyncDeviceThreadOptions(
+            connection::SyncDeviceThreadOptions const &opts);
+
       private:
         unique_ptr<ServerImpl> m_impl;
     };
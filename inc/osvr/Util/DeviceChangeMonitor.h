@@ -0,0 +1,65 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_DeviceChangeMonitor_h_GUID_E94B10CA_D490_4457_9F26_989BE159DC12
+#define INCLUDED_DeviceChangeMonitor_h_GUID_E94B10CA_D490_4457_9F26_989BE159DC12
+
+// Internal Includes
+#include <osvr/Util/Export.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace util {
+    /// @brief Tells whether devices may have been plugged in or removed, so
+    /// that the results of enumerating them (USB serial ports, HID devices)
+    /// can be kept until then.
+    ///
+    /// On Linux, watches /dev for device nodes being created or removed. On
+    /// other platforms, or if the watch can't be set up, always reports a
+    /// possible change, so callers just enumerate every time as before.
+    ///
+    /// Not thread-safe: callers sharing one must serialize access.
+    class DeviceChangeMonitor : boost::noncopyable {
+      public:
+        OSVR_UTIL_EXPORT DeviceChangeMonitor();
+        OSVR_UTIL_EXPORT ~DeviceChangeMonitor();
+
+        /// @brief Have devices possibly changed since the last call? Always
+        /// true the first time.
+        OSVR_UTIL_EXPORT bool checkForChanges();
+
+      private:
+        /// @brief Watch handle, or -1 if not watching.
+        int m_fd;
+        bool m_checked;
+    };
+} // namespace util
+} // namespace osvr
+
+#endif // INCLUDED_DeviceChangeMonitor_h_GUID_E94B10CA_D490_4457_9F26_989BE159DC12
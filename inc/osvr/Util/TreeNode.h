@@ -32,12 +32,15 @@
 #include <boost/noncopyable.hpp>
 #include <boost/operators.hpp>
 #include <boost/assert.hpp>
+#include <boost/functional/hash.hpp>
 
 // Standard includes
 #include <string>
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include <memory>
+#include <unordered_map>
 
 namespace osvr {
 namespace util {
@@ -49,6 +52,26 @@ namespace util {
             NoSuchChild(std::string const &name)
                 : std::runtime_error("No child found with the name " + name) {}
         };
+
+        namespace detail {
+            /// @brief Hashes the string pointed to, so that a child index can
+            /// be keyed on the children's own (immutable) names without
+            /// copying them.
+            struct NamePointerHash {
+                std::size_t operator()(std::string const *name) const {
+                    return boost::hash_range(name->begin(), name->end());
+                }
+            };
+
+            /// @brief Compares the strings pointed to.
+            struct NamePointerEqual {
+                bool operator()(std::string const *a,
+                                std::string const *b) const {
+                    return *a == *b;
+                }
+            };
+        } // namespace detail
+
         /// @brief A node in a generic tree, which can contain an object by
         /// value.
         /// @tparam ValueType The contained value type: must be
@@ -66,6 +89,11 @@ namespace util {
         /// - A "get or create" method is provided that guarantees the return a
         /// child of the given name (default-constructing one if it doesn't
         /// exist)
+        /// - Children are visited in the order they were created. Nodes with
+        /// many children also keep a hash index of them by name, so lookups
+        /// don't scan every child.
+        /// - Since nodes are never moved to another parent, each node's
+        /// absolute path is built once, when it is created.
         ///
         /// @todo methods to remove a child (by pointer and by name)
         template <typename ValueType>
@@ -115,6 +143,11 @@ namespace util {
             /// only if this is the root.
             std::string const &getName() const;
 
+            /// @brief Gets the absolute path of the current node: the names
+            /// from the root down to this node, each preceded by a slash, or a
+            /// single slash for the root.
+            std::string const &getPath() const;
+
             /// @brief Is the current node a root node?
             bool isRoot() const;
 
@@ -137,7 +170,7 @@ namespace util {
             value_type const &value() const { return m_value; }
 
             /// @brief Generic visitation method that calls a functor on each of
-            /// the children in an undefined order.
+            /// the children in the order they were created.
             template <typename F> void visitChildren(F &visitor) {
                 typedef typename ChildList::size_type size_type;
                 for (size_type i = 0; i < m_children.size(); ++i) {
@@ -148,7 +181,8 @@ namespace util {
             }
 
             /// @brief Generic constant visitation method that calls a functor
-            /// on each of the children (as const) in an undefined order.
+            /// on each of the children (as const) in the order they were
+            /// created.
             template <typename F> void visitConstChildren(F &visitor) const {
                 for (auto const &node : m_children) {
                     visitor(const_cast<type const &>(*node));
@@ -156,7 +190,7 @@ namespace util {
             }
 
             /// @brief Generic constant visitation method that calls a functor
-            /// on each of the children in an undefined order.
+            /// on each of the children in the order they were created.
             /// @todo does this overload clutter the interface and reduce
             /// clarity between const and non-const visitors?
             template <typename F> void visitChildren(F &visitor) const {
@@ -182,6 +216,11 @@ namespace util {
             /// @brief Private constructor for a root node with a value
             explicit TreeNode(value_type const &val);
 
+            /// @brief Internal helper to build the path of a new child of
+            /// @p parent.
+            static std::string m_childPath(type const &parent,
+                                           std::string const &name);
+
             /// @brief Internal helper to get child by name, or a null pointer
             /// if no such child.
             weak_ptr_type m_getChildByName(std::string const &name) const;
@@ -190,16 +229,32 @@ namespace util {
             /// child already exists!
             void m_addChild(ptr_type const &child);
 
+            /// @brief Number of children above which lookups by name go
+            /// through the index rather than a linear scan.
+            static std::size_t m_indexThreshold() { return 8; }
+
             /// @brief Contained value.
             value_type m_value;
 
             typedef std::vector<ptr_type> ChildList;
-            /// @brief Ownership of children
+            /// @brief Ownership of children, in creation order.
             ChildList m_children;
 
+            typedef std::unordered_map<std::string const *, weak_ptr_type,
+                                       detail::NamePointerHash,
+                                       detail::NamePointerEqual>
+                ChildIndex;
+            /// @brief Children by name, keyed on pointers to their names:
+            /// only created once there are more than m_indexThreshold()
+            /// children.
+            std::unique_ptr<ChildIndex> m_index;
+
             /// @brief Name
             std::string const m_name;
 
+            /// @brief Absolute path
+            std::string const m_path;
+
             /// @brief Weak pointer to parent.
             parent_ptr_type m_parent;
         };
@@ -272,6 +327,11 @@ namespace util {
             return m_name;
         }
 
+        template <typename ValueType>
+        inline std::string const &TreeNode<ValueType>::getPath() const {
+            return m_path;
+        }
+
         template <typename ValueType>
         inline bool TreeNode<ValueType>::isRoot() const {
             BOOST_ASSERT_MSG(
@@ -302,8 +362,10 @@ namespace util {
         template <typename ValueType>
         inline typename TreeNode<ValueType>::weak_ptr_type
         TreeNode<ValueType>::m_getChildByName(std::string const &name) const {
-            /// @todo Don't use a linear search here - use an unordered map or
-            /// something.
+            if (m_index) {
+                auto indexed = m_index->find(&name);
+                return indexed == m_index->end() ? nullptr : indexed->second;
+            }
             auto it = std::find_if(
                 begin(m_children), end(m_children),
                 [&](ptr_type const &n) { return n->getName() == name; });
@@ -318,12 +380,36 @@ namespace util {
         inline void TreeNode<ValueType>::m_addChild(
             typename TreeNode<ValueType>::ptr_type const &child) {
             m_children.push_back(child);
+            if (m_index) {
+                m_index->emplace(&child->getName(), child.get());
+            } else if (m_children.size() > m_indexThreshold()) {
+                m_index.reset(new ChildIndex);
+                m_index->reserve(m_children.size() * 2);
+                for (auto const &existing : m_children) {
+                    m_index->emplace(&existing->getName(), existing.get());
+                }
+            }
+        }
+
+        template <typename ValueType>
+        inline std::string
+        TreeNode<ValueType>::m_childPath(TreeNode<ValueType> const &parent,
+                                         std::string const &name) {
+            std::string ret;
+            ret.reserve(parent.m_path.size() + 1 + name.size());
+            if (!parent.isRoot()) {
+                ret += parent.m_path;
+            }
+            ret += '/';
+            ret += name;
+            return ret;
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name)
-            : m_value(), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(), m_children(), m_name(name),
+              m_path(m_childPath(parent, name)), m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -334,7 +420,8 @@ namespace util {
         inline TreeNode<ValueType>::TreeNode(TreeNode<ValueType> &parent,
                                              std::string const &name,
                                              ValueType const &val)
-            : m_value(val), m_children(), m_name(name), m_parent(&parent) {
+            : m_value(val), m_children(), m_name(name),
+              m_path(m_childPath(parent, name)), m_parent(&parent) {
             if (m_name.empty()) {
                 throw std::logic_error(
                     "Can't create a named tree node with an empty name!");
@@ -343,13 +430,15 @@ namespace util {
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode()
-            : m_value(), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(), m_children(), m_name(), m_path(1, '/'),
+              m_parent(nullptr) {
             /// Special root constructor
         }
 
         template <typename ValueType>
         inline TreeNode<ValueType>::TreeNode(ValueType const &val)
-            : m_value(val), m_children(), m_name(), m_parent(nullptr) {
+            : m_value(val), m_children(), m_name(), m_path(1, '/'),
+              m_parent(nullptr) {
             /// Special root constructor
         }
 
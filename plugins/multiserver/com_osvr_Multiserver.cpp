@@ -33,6 +33,7 @@
 #include "DevicesWithParameters.h"
 #include <osvr/PluginKit/PluginKit.h>
 #include <osvr/Util/UniquePtr.h>
+#include <osvr/Util/DeviceChangeMonitor.h>
 #include <osvr/Util/StringLiteralFileToString.h>
 #include <osvr/VRPNServer/VRPNDeviceRegistration.h>
 
@@ -67,29 +68,35 @@
 #include <iostream>
 #endif
 
+/// @brief The parts of a HID device's enumeration info used in detection.
+struct HIDDeviceInfo {
+    std::string path;
+    unsigned short vendor_id;
+    unsigned short product_id;
+};
+
 class VRPNHardwareDetect : boost::noncopyable {
   public:
     VRPNHardwareDetect(VRPNMultiserverData &data) : m_data(data) {}
     OSVR_ReturnCode operator()(OSVR_PluginRegContext ctx) {
+        m_updateHIDDevices();
         bool gotDevice;
 #ifdef OSVR_MULTISERVER_VERBOSE
         bool first = true;
 #endif
         do {
             gotDevice = false;
-            struct hid_device_info *enumData = hid_enumerate(0, 0);
-            for (struct hid_device_info *dev = enumData; dev != nullptr;
-                 dev = dev->next) {
+            for (auto const &dev : m_hidDevices) {
 
-                if (m_isPathHandled(dev->path)) {
+                if (m_isPathHandled(dev.path)) {
                     continue;
                 }
 
 #ifdef OSVR_MULTISERVER_VERBOSE
                 if (first) {
                     std::cout << "[OSVR Multiserver] HID Enumeration: "
-                              << boost::format("0x%04x") % dev->vendor_id << ":"
-                              << boost::format("0x%04x") % dev->product_id
+                              << boost::format("0x%04x") % dev.vendor_id << ":"
+                              << boost::format("0x%04x") % dev.product_id
                               << std::endl;
                 }
 #endif
@@ -98,9 +105,9 @@ class VRPNHardwareDetect : boost::noncopyable {
                     continue;
                 }
                 // Razer Hydra
-                if (dev->vendor_id == 0x1532 && dev->product_id == 0x0300) {
+                if (dev.vendor_id == 0x1532 && dev.product_id == 0x0300) {
                     gotDevice = true;
-                    m_handlePath(dev->path);
+                    m_handlePath(dev.path);
                     auto hydraJsonString = osvr::util::makeString(
                         com_osvr_Multiserver_RazerHydra_json);
                     Json::Value hydraJson;
@@ -166,10 +173,10 @@ class VRPNHardwareDetect : boost::noncopyable {
                 }
 
                 // OSVR Hacker Dev Kit
-                if ((dev->vendor_id == 0x1532 && dev->product_id == 0x0300) ||
-                    (dev->vendor_id == 0x03EB && dev->product_id == 0x2421)) {
+                if ((dev.vendor_id == 0x1532 && dev.product_id == 0x0300) ||
+                    (dev.vendor_id == 0x03EB && dev.product_id == 0x2421)) {
                     gotDevice = true;
-                    m_handlePath(dev->path);
+                    m_handlePath(dev.path);
                     osvr::vrpnserver::VRPNDeviceRegistration reg(ctx);
                     auto name = m_data.getName("OSVRHackerDevKit");
                     auto decName = reg.useDecoratedName(name);
@@ -191,7 +198,6 @@ class VRPNHardwareDetect : boost::noncopyable {
                     continue;
                 }
             }
-            hid_free_enumeration(enumData);
 
 #ifdef OSVR_MULTISERVER_VERBOSE
             first = false;
@@ -202,15 +208,32 @@ class VRPNHardwareDetect : boost::noncopyable {
     }
 
   private:
-    bool m_isPathHandled(const char *path) {
-        return std::find(begin(m_handledPaths), end(m_handledPaths),
-                         std::string(path)) != end(m_handledPaths);
+    /// @brief Enumerate HID devices again, only if devices may have been
+    /// plugged in or removed since last time.
+    void m_updateHIDDevices() {
+        if (!m_hidChanges.checkForChanges()) {
+            return;
+        }
+        m_hidDevices.clear();
+        struct hid_device_info *enumData = hid_enumerate(0, 0);
+        for (struct hid_device_info *dev = enumData; dev != nullptr;
+             dev = dev->next) {
+            HIDDeviceInfo info = {dev->path, dev->vendor_id, dev->product_id};
+            m_hidDevices.push_back(info);
+        }
+        hid_free_enumeration(enumData);
+    }
+    bool m_isPathHandled(std::string const &path) {
+        return std::find(begin(m_handledPaths), end(m_handledPaths), path) !=
+               end(m_handledPaths);
     }
-    void m_handlePath(const char *path) {
-        m_handledPaths.push_back(std::string(path));
+    void m_handlePath(std::string const &path) {
+        m_handledPaths.push_back(path);
     }
     VRPNMultiserverData &m_data;
     std::vector<std::string> m_handledPaths;
+    osvr::util::DeviceChangeMonitor m_hidChanges;
+    std::vector<HIDDeviceInfo> m_hidDevices;
 };
 
 OSVR_PLUGIN(com_osvr_Multiserver) {
@@ -98,6 +98,10 @@ class CameraDevice : boost::noncopyable {
             // No frame available.
             return OSVR_RETURN_SUCCESS;
         }
+        if (m_retrieveInPlace(frameTime)) {
+            return OSVR_RETURN_SUCCESS;
+        }
+
         bool retrieved = m_camera.retrieve(m_frame, m_channel);
         if (!retrieved) {
             return OSVR_RETURN_FAILURE;
@@ -113,6 +117,38 @@ class CameraDevice : boost::noncopyable {
     }
 
   private:
+    /// @brief Once we know the frame size, try to retrieve the grabbed frame
+    /// straight into the buffer shared with clients, saving the copies made
+    /// by sending an ImagingMessage.
+    ///
+    /// @returns true if the frame was retrieved and sent.
+    bool m_retrieveInPlace(OSVR_TimeValue const &frameTime) {
+        if (m_frame.empty()) {
+            return false;
+        }
+        auto frame = m_imaging.beginFrame(m_dev, m_frame.rows, m_frame.cols,
+                                          m_frame.type());
+        if (!frame) {
+            return false;
+        }
+        cv::Mat target = frame.getMat();
+        auto buffer = target.data;
+        if (!m_camera.retrieve(target, m_channel)) {
+            return false;
+        }
+        if (target.data != buffer) {
+            // The frame changed size or type, so OpenCV reallocated: send it
+            // the regular way, and reserve the new size next time.
+            frame.abandon();
+            m_frame = target;
+            m_dev.send(m_imaging, osvr::pluginkit::ImagingMessage(m_frame),
+                       frameTime);
+            return true;
+        }
+        m_imaging.sendFrame(frame, frameTime);
+        return true;
+    }
+
     osvr::pluginkit::DeviceToken m_dev;
     osvr::pluginkit::ImagingInterface m_imaging;
     cv::VideoCapture m_camera;
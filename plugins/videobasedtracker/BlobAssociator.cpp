@@ -0,0 +1,148 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlobAssociator.h"
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <tuple>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief Most cells in a grid: points spread far apart get larger cells
+    /// rather than a huge, nearly empty table.
+    static const int MAX_GRID_CELLS = 1 << 14;
+
+    KeyPointGrid::KeyPointGrid()
+        : m_originX(0), m_originY(0), m_inverseCellSize(1), m_cols(0),
+          m_rows(0) {}
+
+    void KeyPointGrid::build(KeyPointList const &keyPoints, float cellSize) {
+        m_entries.clear();
+        m_cols = 0;
+        m_rows = 0;
+        if (keyPoints.empty()) {
+            return;
+        }
+        auto minX = keyPoints.front().pt.x;
+        auto maxX = minX;
+        auto minY = keyPoints.front().pt.y;
+        auto maxY = minY;
+        for (auto const &keyPoint : keyPoints) {
+            minX = std::min(minX, keyPoint.pt.x);
+            maxX = std::max(maxX, keyPoint.pt.x);
+            minY = std::min(minY, keyPoint.pt.y);
+            maxY = std::max(maxY, keyPoint.pt.y);
+        }
+        cellSize = std::max(cellSize, 1.f);
+        double cols = 0;
+        double rows = 0;
+        while (true) {
+            cols = std::floor((maxX - minX) / cellSize) + 1;
+            rows = std::floor((maxY - minY) / cellSize) + 1;
+            if (cols * rows <= MAX_GRID_CELLS) {
+                break;
+            }
+            cellSize *= 2;
+        }
+        m_originX = minX;
+        m_originY = minY;
+        m_inverseCellSize = 1.f / cellSize;
+        m_cols = static_cast<int>(cols);
+        m_rows = static_cast<int>(rows);
+
+        // Counting sort of the keypoints by cell.
+        auto numKeyPoints = static_cast<int>(keyPoints.size());
+        m_cellOf.resize(numKeyPoints);
+        m_cellStart.assign(m_cols * m_rows + 1, 0);
+        for (int i = 0; i < numKeyPoints; ++i) {
+            // Clamped in case of rounding at the far edges.
+            auto const &pt = keyPoints[i].pt;
+            auto cell =
+                std::min(m_getCell(pt.y, m_originY, m_rows), m_rows - 1) *
+                    m_cols +
+                std::min(m_getCell(pt.x, m_originX, m_cols), m_cols - 1);
+            m_cellOf[i] = cell;
+            ++m_cellStart[cell + 1];
+        }
+        for (std::size_t cell = 1; cell < m_cellStart.size(); ++cell) {
+            m_cellStart[cell] += m_cellStart[cell - 1];
+        }
+        m_cursor.assign(m_cellStart.begin(), m_cellStart.end() - 1);
+        m_entries.resize(numKeyPoints);
+        for (int i = 0; i < numKeyPoints; ++i) {
+            m_entries[m_cursor[m_cellOf[i]]++] = i;
+        }
+    }
+
+    BlobAssociator::BlobAssociator() : m_blobs(nullptr), m_threshold(0) {}
+
+    void BlobAssociator::setBlobs(KeyPointList const &blobs, float threshold) {
+        m_blobs = &blobs;
+        m_threshold = threshold;
+        m_grid.build(blobs, threshold);
+    }
+
+    void BlobAssociator::associate(std::vector<cv::Point2f> const &positions,
+                                   std::vector<int> &ledToBlob,
+                                   std::vector<int> &blobToLed) {
+        BOOST_ASSERT_MSG(m_blobs, "Must call setBlobs() first");
+        auto const &blobs = *m_blobs;
+        ledToBlob.assign(positions.size(), -1);
+        blobToLed.assign(blobs.size(), -1);
+
+        m_candidates.clear();
+        auto const thresholdSquared = m_threshold * m_threshold;
+        auto numLeds = static_cast<int>(positions.size());
+        for (int led = 0; led < numLeds; ++led) {
+            auto const &position = positions[led];
+            m_grid.forEachCandidate(position, [&](int blob) {
+                auto offset = blobs[blob].pt - position;
+                auto distanceSquared = offset.dot(offset);
+                if (distanceSquared <= thresholdSquared) {
+                    m_candidates.push_back(
+                        Candidate{distanceSquared, led, blob});
+                }
+            });
+        }
+
+        // Closest pairs first: ties broken by index, so the result doesn't
+        // depend on the sort.
+        std::sort(m_candidates.begin(), m_candidates.end(),
+                  [](Candidate const &a, Candidate const &b) {
+                      return std::tie(a.distanceSquared, a.led, a.blob) <
+                             std::tie(b.distanceSquared, b.led, b.blob);
+                  });
+        for (auto const &candidate : m_candidates) {
+            if (ledToBlob[candidate.led] < 0 && blobToLed[candidate.blob] < 0) {
+                ledToBlob[candidate.led] = candidate.blob;
+                blobToLed[candidate.blob] = candidate.led;
+            }
+        }
+    }
+} // namespace vbtracker
+} // namespace osvr
@@ -0,0 +1,149 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_BlobAssociator_h_GUID_88CC2FB1_4837_4440_8D19_C5E8ECB17A6B
+#define INCLUDED_BlobAssociator_h_GUID_88CC2FB1_4837_4440_8D19_C5E8ECB17A6B
+
+// Internal Includes
+#include "Types.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief A spatial hash of keypoint locations: a uniform grid over their
+    /// bounding box, rebuilt for each frame, with the keypoints of each cell
+    /// stored together.
+    class KeyPointGrid {
+      public:
+        KeyPointGrid();
+
+        /// @brief Indexes the locations of the keypoints, in cells at least
+        /// as large as the biggest radius that will be searched.
+        void build(KeyPointList const &keyPoints, float cellSize);
+
+        /// @brief Calls @p f with the index of each keypoint in the cells
+        /// around the one containing @p p: this includes every keypoint
+        /// within one cell size of @p p, as well as some farther away.
+        template <typename F>
+        void forEachCandidate(cv::Point2f const &p, F &&f) const {
+            if (m_entries.empty()) {
+                return;
+            }
+            auto cellX = m_getCell(p.x, m_originX, m_cols);
+            auto cellY = m_getCell(p.y, m_originY, m_rows);
+            auto endX = std::min(cellX + 2, m_cols);
+            auto endY = std::min(cellY + 2, m_rows);
+            for (auto y = std::max(cellY - 1, 0); y < endY; ++y) {
+                for (auto x = std::max(cellX - 1, 0); x < endX; ++x) {
+                    auto cell = y * m_cols + x;
+                    for (auto i = m_cellStart[cell]; i < m_cellStart[cell + 1];
+                         ++i) {
+                        f(m_entries[i]);
+                    }
+                }
+            }
+        }
+
+      private:
+        /// @brief Gets a cell coordinate, clamped to one cell beyond the
+        /// grid on either side.
+        int m_getCell(float value, float origin, int numCells) const {
+            auto cell = (value - origin) * m_inverseCellSize;
+            if (!(cell >= -1)) {
+                return -2;
+            }
+            if (cell >= numCells + 1) {
+                return numCells + 1;
+            }
+            return static_cast<int>(std::floor(cell));
+        }
+        float m_originX;
+        float m_originY;
+        float m_inverseCellSize;
+        int m_cols;
+        int m_rows;
+        /// @brief Cell of each keypoint.
+        std::vector<int> m_cellOf;
+        /// @brief Where each cell's keypoints start in m_entries, with an
+        /// extra element for the end of the last cell.
+        std::vector<int> m_cellStart;
+        /// @brief Where the next keypoint of each cell goes while building.
+        std::vector<int> m_cursor;
+        /// @brief Indices of the keypoints, grouped by cell.
+        std::vector<int> m_entries;
+    };
+
+    /// @brief Matches the LEDs of a sensor to the blobs found in a frame.
+    ///
+    /// Every LED-blob pair within the move threshold is a candidate, found
+    /// using a KeyPointGrid; then the closest pairs are matched first, each
+    /// LED and blob being used at most once. Keeps its buffers between
+    /// calls.
+    class BlobAssociator {
+      public:
+        BlobAssociator();
+
+        /// @brief Sets the blobs found in a frame, to match the LEDs of each
+        /// sensor to in turn.
+        ///
+        /// @param blobs The blobs: must outlive the calls to associate().
+        /// @param threshold How far in pixels a blob may be from where an
+        /// LED is expected and still be taken for it.
+        void setBlobs(KeyPointList const &blobs, float threshold);
+
+        /// @brief Matches LEDs to the blobs.
+        ///
+        /// @param positions Where each LED is expected: its last location,
+        /// or one predicted from its motion.
+        /// @param [out] ledToBlob For each LED, the index of its blob, or -1
+        /// if none.
+        /// @param [out] blobToLed For each blob, the index of its LED, or -1
+        /// if none.
+        void associate(std::vector<cv::Point2f> const &positions,
+                       std::vector<int> &ledToBlob,
+                       std::vector<int> &blobToLed);
+
+      private:
+        struct Candidate {
+            float distanceSquared;
+            int led;
+            int blob;
+        };
+        KeyPointList const *m_blobs;
+        float m_threshold;
+        KeyPointGrid m_grid;
+        std::vector<Candidate> m_candidates;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_BlobAssociator_h_GUID_88CC2FB1_4837_4440_8D19_C5E8ECB17A6B
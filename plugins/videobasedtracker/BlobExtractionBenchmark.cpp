@@ -0,0 +1,149 @@
+/** @file
+    @brief Times finding the LED blobs in the HDK_random_images (or other
+    numbered images), with the LedBlobExtractor and with the multi-threshold
+    cv::SimpleBlobDetector setup it replaced.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "LedBlobExtractor.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+#include <opencv2/core/version.hpp>
+#include <opencv2/features2d/features2d.hpp>
+#include <opencv2/highgui/highgui.hpp>
+#include <opencv2/imgproc/imgproc.hpp>
+
+// Standard includes
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using osvr::vbtracker::KeyPointList;
+using osvr::vbtracker::LedBlobExtractor;
+
+typedef std::chrono::steady_clock clock_type;
+
+static const double THRESHOLD = 220;
+
+/// @brief What VideoBasedTracker used to do for every frame.
+static void simpleBlobDetect(cv::Mat const &gray, cv::Mat &thresholdImage,
+                             KeyPointList &keyPoints) {
+    double minVal, maxVal;
+    cv::minMaxLoc(gray, &minVal, &maxVal);
+    cv::threshold(gray, thresholdImage, THRESHOLD, 255, CV_THRESH_BINARY);
+    cv::SimpleBlobDetector::Params params;
+    params.minThreshold = static_cast<float>(THRESHOLD);
+    params.maxThreshold =
+        static_cast<float>(THRESHOLD + (maxVal - THRESHOLD) * 0.3);
+    params.thresholdStep = (params.maxThreshold - params.minThreshold) / 10;
+    params.blobColor = static_cast<uchar>(255);
+    params.filterByColor = false;
+    params.minInertiaRatio = 0.5;
+    params.maxInertiaRatio = 1.0;
+    params.filterByInertia = false;
+    params.minArea = 1;
+    params.filterByConvexity = false;
+    params.filterByCircularity = false;
+    params.minDistBetweenBlobs = 3;
+#if CV_MAJOR_VERSION == 2
+    cv::Ptr<cv::SimpleBlobDetector> detector =
+        new cv::SimpleBlobDetector(params);
+#elif CV_MAJOR_VERSION == 3
+    auto detector = cv::SimpleBlobDetector::create(params);
+#else
+#error "Unrecognized OpenCV version!"
+#endif
+    detector->detect(gray, keyPoints);
+}
+
+/// @brief Runs @p f on every image, @p iterations times.
+/// @return milliseconds per image
+template <typename F>
+static double timeImages(std::vector<cv::Mat> const &images, int iterations,
+                         F &&f) {
+    auto start = clock_type::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (auto const &image : images) {
+            f(image);
+        }
+    }
+    auto elapsed = clock_type::now() - start;
+    return std::chrono::duration<double, std::milli>(elapsed).count() /
+           double(images.size() * iterations);
+}
+
+int main(int argc, char *argv[]) {
+    std::string directory = VBTRACKER_HDK_RANDOM_IMAGES;
+    int iterations = 20;
+    if (argc > 1) {
+        directory = argv[1];
+    }
+    if (argc > 2) {
+        iterations = std::stoi(argv[2]);
+    }
+
+    // Images are numbered 0001.tif, 0002.tif, ...
+    std::vector<cv::Mat> images;
+    for (int i = 1;; ++i) {
+        char name[16];
+        std::sprintf(name, "/%04d.tif", i);
+        auto image = cv::imread(directory + name, cv::IMREAD_GRAYSCALE);
+        if (!image.data) {
+            break;
+        }
+        images.push_back(image);
+    }
+    if (images.empty()) {
+        std::cerr << "No images found in " << directory << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [directory [iterations]]"
+                  << std::endl;
+        return 1;
+    }
+
+    LedBlobExtractor extractor(static_cast<uchar>(THRESHOLD));
+    KeyPointList keyPoints;
+    cv::Mat thresholdImage;
+    for (std::size_t i = 0; i < images.size(); ++i) {
+        simpleBlobDetect(images[i], thresholdImage, keyPoints);
+        auto simpleCount = keyPoints.size();
+        extractor.extract(images[i], keyPoints);
+        std::cout << "Image " << i + 1 << ": " << simpleCount
+                  << " blobs with cv::SimpleBlobDetector, "
+                  << keyPoints.size() << " with LedBlobExtractor" << std::endl;
+    }
+
+    auto simple = timeImages(images, iterations, [&](cv::Mat const &image) {
+        simpleBlobDetect(image, thresholdImage, keyPoints);
+    });
+    auto extracted = timeImages(images, iterations, [&](cv::Mat const &image) {
+        extractor.extract(image, keyPoints);
+    });
+    std::cout << images.size() << " images, " << iterations
+              << " iterations: milliseconds per image" << std::endl;
+    std::cout << "cv::SimpleBlobDetector: " << simple << std::endl;
+    std::cout << "LedBlobExtractor:       " << extracted << std::endl;
+    return 0;
+}
@@ -0,0 +1,84 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_BrightnessHistory_h_GUID_2C3EC8DA_B866_4D98_972E_1A3F16DB81BF
+#define INCLUDED_BrightnessHistory_h_GUID_2C3EC8DA_B866_4D98_972E_1A3F16DB81BF
+
+// Internal Includes
+#include "Types.h"
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <array>
+#include <cstddef>
+
+namespace osvr {
+namespace vbtracker {
+
+    /// @brief The most recent brightness measurements of an LED, one per
+    /// frame, in a fixed-size ring buffer: adding one overwrites the oldest
+    /// once it is full, and never allocates.
+    class BrightnessHistory {
+      public:
+        /// @brief Number of measurements kept: no identifier can use longer
+        /// patterns. A power of two.
+        static const std::size_t CAPACITY = 64;
+
+        BrightnessHistory() : m_next(0), m_size(0) {}
+
+        /// @brief Adds the measurement for the latest frame.
+        void push(Brightness brightness) {
+            m_values[m_next] = brightness;
+            m_next = (m_next + 1) % CAPACITY;
+            if (m_size < CAPACITY) {
+                ++m_size;
+            }
+        }
+
+        /// @brief Number of measurements kept: the number added, up to
+        /// CAPACITY.
+        std::size_t size() const { return m_size; }
+
+        bool empty() const { return m_size == 0; }
+
+        /// @brief Gets a measurement by its age: 0 is the most recent.
+        Brightness fromNewest(std::size_t age) const {
+            BOOST_ASSERT_MSG(age < m_size, "Not that many measurements!");
+            return m_values[(m_next + CAPACITY - 1 - age) % CAPACITY];
+        }
+
+      private:
+        std::array<Brightness, CAPACITY> m_values;
+        /// @brief Where the next measurement goes.
+        std::size_t m_next;
+        std::size_t m_size;
+    };
+
+} // End namespace vbtracker
+} // End namespace osvr
+
+#endif // INCLUDED_BrightnessHistory_h_GUID_2C3EC8DA_B866_4D98_972E_1A3F16DB81BF
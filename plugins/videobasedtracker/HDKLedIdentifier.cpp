@@ -35,9 +35,18 @@
 namespace osvr {
 namespace vbtracker {
 
+    /// @brief Rotates the low @p length bits of @p pattern by one, the most
+    /// significant moving to the least.
+    static inline LedPattern rotatePattern(LedPattern pattern, size_t length) {
+        const LedPattern mask = (length < 64)
+                                    ? ((LedPattern(1) << length) - 1)
+                                    : ~LedPattern(0);
+        return ((pattern << 1) | (pattern >> (length - 1))) & mask;
+    }
+
     OsvrHdkLedIdentifier::~OsvrHdkLedIdentifier() {}
-    // Convert from string encoding representations into lists
-    // of boolean values for use in comparison.
+    // Convert from string encoding representations into bit patterns, and
+    // index every rotation of them for use in comparison.
     OsvrHdkLedIdentifier::OsvrHdkLedIdentifier(
         const PatternStringList &PATTERNS) {
         // Ensure that we have at least one entry in our list and
@@ -47,51 +56,53 @@ namespace vbtracker {
             return;
         }
         d_length = PATTERNS[0].size();
+        if (d_length == 0 || d_length > BrightnessHistory::CAPACITY) {
+            d_length = 0;
+            return;
+        }
 
-        // Decode each string into a new list of boolean values, making
-        // sure each have the correct length.
+        // Decode each string into bits, making sure each has the correct
+        // length.
         for (size_t i = 0; i < PATTERNS.size(); i++) {
 
             // Make sure the pattern is the correct length.
             if (PATTERNS[i].size() != d_length) {
-                d_patterns.clear();
+                d_rotations.clear();
                 d_length = 0;
                 return;
             }
 
-            // Make a new boolean-list encoding from it, replacing every
-            // non-'.' character with true and every '.' with false.
-            std::list<bool> pattern;
+            // Make a new bit encoding from it, replacing every non-'.'
+            // character with a 1 and every '.' with a 0.
+            LedPattern pattern = 0;
             for (size_t j = 0; j < PATTERNS[i].size(); j++) {
-                if (PATTERNS[i][j] == '.') {
-                    pattern.push_back(false);
-                } else {
-                    pattern.push_back(true);
-                }
+                pattern = (pattern << 1) | LedPattern(PATTERNS[i][j] != '.');
             }
 
-            // Add the pattern to the vector of lists.
-            d_patterns.push_back(pattern);
+            // Add each of its rotations, since we don't know when the code
+            // started: for the HDK, the codes are rotationally invariant.
+            // An earlier pattern keeps a rotation they share.
+            for (size_t j = 0; j < d_length; j++) {
+                d_rotations.emplace(pattern, static_cast<int>(i));
+                pattern = rotatePattern(pattern, d_length);
+            }
         }
-        // std::cout << "XXX d_length = " << d_length << ", num patterns = " <<
-        // d_patterns.size() << std::endl;
     }
 
-    int OsvrHdkLedIdentifier::getId(std::list<float> &brightnesses) const {
+    int OsvrHdkLedIdentifier::getId(
+        BrightnessHistory const &brightnesses) const {
         // If we don't have at least the required number of frames of data, we
         // don't know anything.
-        if (brightnesses.size() < d_length) {
+        if (d_length == 0 || brightnesses.size() < d_length) {
             return -1;
         }
 
-        // We only care about the d_length most-recent levels.
-        truncateBrightnessListTo(brightnesses, d_length);
-
-        // Compute the minimum and maximum brightness values.  If
+        // Compute the minimum and maximum brightness values among the
+        // d_length most-recent levels, the only ones we care about.  If
         // they are too close to each other, we have a light rather
         // than an LED.  If not, compute a threshold to separate the
         // 0's and 1's.
-        auto extrema = findMinMaxBrightness(brightnesses);
+        auto extrema = findMinMaxBrightness(brightnesses, d_length);
         const auto minVal = extrema.first;
         const auto maxVal = extrema.second;
         static const double TODO_MIN_BRIGHTNESS_DIFF = 0.5;
@@ -100,30 +111,12 @@ namespace vbtracker {
         }
         const auto threshold = (minVal + maxVal) / 2;
 
-        // Get a list of boolean values for 0's and 1's using
-        // the threshold computed above.
-        auto bits = getBitsUsingThreshold(brightnesses, threshold);
-
-        // Search through the available patterns to see if the passed-in
-        // pattern matches any of them.  If so, return that pattern.  We
-        // need to check all potential rotations of the pattern, since we
-        // don't know when the code started.  For the HDK, the codes are
-        // rotationally invariant.
-
-        /// @todo feels like there should be a good algorithm for
-        /// rotation-invariant string matching besides brute-forcing it here.
-        ///  -- rpavlik
-        for (size_t i = 0; i < d_patterns.size(); i++) {
-            for (size_t j = 0; j < bits.size(); j++) {
-                if (bits == d_patterns[i]) {
-                    return static_cast<int>(i);
-                }
-
-                // So long as we don't find the solution, this rotates
-                // back to the initial configuration after each inner loop.
-                std::list<bool>::iterator mid = bits.begin();
-                std::rotate(bits.begin(), ++mid, bits.end());
-            }
+        // Get the bits for 0's and 1's using the threshold computed above,
+        // and look them up among the rotations of the patterns.
+        auto bits = getBitsUsingThreshold(brightnesses, d_length, threshold);
+        auto it = d_rotations.find(bits);
+        if (it != d_rotations.end()) {
+            return it->second;
         }
 
         // No pattern recognized and we should have recognized one, so return
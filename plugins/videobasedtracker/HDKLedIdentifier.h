@@ -32,7 +32,7 @@
 // - none
 
 // Standard includes
-// - none
+#include <unordered_map>
 
 namespace osvr {
 namespace vbtracker {
@@ -42,20 +42,21 @@ namespace vbtracker {
         /// @brief Give it a list of patterns to use.  There is a string for
         /// each LED, and each is encoded with '*' meaning that the LED is
         /// bright and '.' that it is dim at this point in time. All patterns
-        /// must have the same length.
+        /// must have the same length, of at most
+        /// BrightnessHistory::CAPACITY.
         OsvrHdkLedIdentifier(const PatternStringList &PATTERNS);
 
         ~OsvrHdkLedIdentifier() override;
 
-        /// @brief Determine an ID based on a list of brightnesses
-        /// This truncates the passed-in list to only as many elements
-        /// as are in the pattern list, to keep it from growing too
-        /// large and wasting time and space.
-        int getId(BrightnessList &brightnesses) const override;
+        /// @brief Determine an ID based on the most recent brightnesses, as
+        /// many as the patterns are long.
+        int getId(BrightnessHistory const &brightnesses) const override;
 
       private:
-        size_t d_length;        //< Length of all patterns
-        PatternList d_patterns; //< Patterns by index
+        size_t d_length; //< Length of all patterns
+        /// @brief Every rotation of every pattern, mapped to the pattern's
+        /// index: the lowest index, where patterns share a rotation.
+        std::unordered_map<LedPattern, int> d_rotations;
     };
 
 } // End namespace vbtracker
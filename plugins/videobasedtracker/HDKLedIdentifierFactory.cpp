@@ -214,5 +214,15 @@ namespace vbtracker {
         return createHDKLedIdentifier(
             OsvrHdkLedIdentifier_RANDOM_IMAGES_PATTERNS);
     }
+
+    PatternStringList const &getHDKLedPatterns(uint8_t sensor) {
+        BOOST_ASSERT_MSG(sensor < 2, "Valid sensors are only 0 or 1!");
+        return (sensor == 0) ? OsvrHdkLedIdentifier_SENSOR0_PATTERNS
+                             : OsvrHdkLedIdentifier_SENSOR1_PATTERNS;
+    }
+
+    PatternStringList const &getRandomHDKLedPatterns() {
+        return OsvrHdkLedIdentifier_RANDOM_IMAGES_PATTERNS;
+    }
 } // End namespace vbtracker
 } // End namespace osvr
@@ -45,6 +45,13 @@ namespace vbtracker {
     /// @brief Factory function to create an HDK Led Identifier object using the
     /// random images patterns.
     LedIdentifierPtr createRandomHDKLedIdentifier();
+
+    /// @brief Gets the patterns that createHDKLedIdentifier() uses.
+    /// @param sensor either 0 (front plate) or 1 (back plate)
+    PatternStringList const &getHDKLedPatterns(uint8_t sensor);
+
+    /// @brief Gets the patterns that createRandomHDKLedIdentifier() uses.
+    PatternStringList const &getRandomHDKLedPatterns();
 } // End namespace vbtracker
 } // End namespace osvr
 
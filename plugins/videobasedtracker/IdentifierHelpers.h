@@ -26,6 +26,7 @@
 #define INCLUDED_IdentifierHelpers_h_GUID_B6F81E02_BE7B_4382_12E5_87296135997D
 
 // Internal Includes
+#include "BrightnessHistory.h"
 #include "Types.h"
 
 // Library/third-party includes
@@ -37,43 +38,38 @@
 namespace osvr {
 namespace vbtracker {
 
-    /// @brief Helper for implementations of LedIdentifier to truncate the
-    /// passed-in brightness list to the maximum useful length.
-    inline void truncateBrightnessListTo(BrightnessList &brightnesses,
-                                         size_t n) {
-        /// @todo has to be a more efficient method.
-        while (brightnesses.size() > n) {
-            brightnesses.pop_front();
-        }
-    }
-
     /// @brief Helper function for implementations of LedIdentifier to find
-    /// the minimum and maximum values in a non-empty list of brightnesses.
+    /// the minimum and maximum values among the @p n most recent
+    /// brightnesses, of which there must be at least one.
     inline BrightnessMinMax
-    findMinMaxBrightness(const BrightnessList &brightnesses) {
-
-        BOOST_ASSERT_MSG(!brightnesses.empty(), "Must be a non-empty list!");
-        auto extremaIterators =
-            std::minmax_element(begin(brightnesses), end(brightnesses));
-        return std::make_pair(*extremaIterators.first,
-                              *extremaIterators.second);
+    findMinMaxBrightness(const BrightnessHistory &brightnesses, size_t n) {
+        BOOST_ASSERT_MSG(n > 0 && n <= brightnesses.size(),
+                         "Must be a non-empty range of the history!");
+        auto ret = std::make_pair(brightnesses.fromNewest(0),
+                                  brightnesses.fromNewest(0));
+        for (size_t i = 1; i < n; ++i) {
+            auto val = brightnesses.fromNewest(i);
+            ret.first = std::min(ret.first, val);
+            ret.second = std::max(ret.second, val);
+        }
+        return ret;
     }
 
-    /// @brief Helper for implementations of LedIdentifier to turn a
-    /// brightness list into a boolean list based on thresholding on the
-    /// halfway point between minimum and maximum brightness.
-    inline LedPattern getBitsUsingThreshold(const BrightnessList &brightnesses,
-                                            float threshold) {
-        LedPattern ret;
-        // Allocate output space for our transform.
-        ret.resize(brightnesses.size());
-
-        // Transform the brightnesses into a container of bools using this
-        // little lambda
-        std::transform(
-            begin(brightnesses), end(brightnesses), begin(ret),
-            [threshold](Brightness val) { return val >= threshold; });
-
+    /// @brief Helper for implementations of LedIdentifier to turn the @p n
+    /// most recent brightnesses into a bit pattern based on thresholding on
+    /// the halfway point between minimum and maximum brightness.
+    inline LedPattern
+    getBitsUsingThreshold(const BrightnessHistory &brightnesses, size_t n,
+                          float threshold) {
+        BOOST_ASSERT_MSG(n <= brightnesses.size() &&
+                             n <= BrightnessHistory::CAPACITY,
+                         "Not that many measurements!");
+        LedPattern ret = 0;
+        // Oldest first, so it ends up in the most significant bit.
+        for (size_t i = n; i > 0; --i) {
+            ret = (ret << 1) |
+                  LedPattern(brightnesses.fromNewest(i - 1) >= threshold);
+        }
         return ret;
     }
 } // End namespace vbtracker
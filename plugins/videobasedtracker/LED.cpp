@@ -39,7 +39,7 @@ namespace vbtracker {
 
     void Led::addMeasurement(cv::Point2f loc, Brightness brightness) {
         m_location = loc;
-        m_brightnessHistory.push_back(brightness);
+        m_brightnessHistory.push(brightness);
 
         // If we don't have an identifier, then our ID is unknown.
         // Otherwise, try and find it.
@@ -50,42 +50,5 @@ namespace vbtracker {
         }
     }
 
-    KeyPointIterator Led::nearest(KeyPointList &keypoints,
-                                  double threshold) const {
-        // If we have no elements in the vector, return the end().
-        if (keypoints.empty()) {
-            return end(keypoints);
-        }
-
-        auto location = m_location;
-        /// @todo can we use squared-norm instead of doing a square-root inside
-        /// of a tight loop like this?
-        auto computeDist = [location](KeyPointIterator it) {
-            return sqrt(norm(location - it->pt));
-        };
-
-        // Find the distance to the first point and record it as the
-        // current minimum distance;
-        auto ret = begin(keypoints);
-        auto minDist = computeDist(ret);
-
-        // Search the rest of the elements to see if we can find a
-        // better one.
-        for (auto it = begin(keypoints), e = end(keypoints); it != e; ++it) {
-            auto dist = computeDist(it);
-            if (dist < minDist) {
-                minDist = dist;
-                ret = it;
-            }
-        }
-
-        // If the closest is within the threshold, return it.  Otherwise,
-        // return the end.
-        if (minDist <= threshold) {
-            return ret;
-        }
-        return end(keypoints);
-    }
-
 } // End namespace vbtracker
 } // End namespace osvr
@@ -82,16 +82,9 @@ namespace vbtracker {
         /// @brief Reports the most-recently-added position.
         cv::Point2f getLocation() const { return m_location; }
 
-        /// @brief Find the nearest KeyPoint from a container of points to me,
-        /// if there is one within the specified threshold.
-        /// @return end() if there is not a nearest within threshold (or an
-        /// empty container).
-        KeyPointIterator nearest(KeyPointList &keypoints,
-                                 double threshold) const;
-
       private:
-        /// Starting from current frame going backwards
-        BrightnessList m_brightnessHistory;
+        /// @brief Brightness in the most recent frames
+        BrightnessHistory m_brightnessHistory;
 
         /// @brief Which LED am I? Non-negative are indices, negative are
         /// sentinels
@@ -0,0 +1,228 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "LedBlobExtractor.h"
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace osvr {
+namespace vbtracker {
+    namespace {
+        /// @brief Fewest rows worth scanning as a band of their own.
+        static const int MIN_BAND_ROWS = 32;
+
+        template <typename ParentOf>
+        inline int findRoot(ParentOf &&parentOf, int i) {
+            while (parentOf(i) != i) {
+                parentOf(i) = parentOf(parentOf(i));
+                i = parentOf(i);
+            }
+            return i;
+        }
+
+        /// @brief Joins two sets, keeping the lower index as the root so that
+        /// a blob's root is its first run.
+        template <typename ParentOf>
+        inline void unite(ParentOf &&parentOf, int a, int b) {
+            a = findRoot(parentOf, a);
+            b = findRoot(parentOf, b);
+            if (a < b) {
+                parentOf(b) = a;
+            } else if (b < a) {
+                parentOf(a) = b;
+            }
+        }
+
+        /// @brief Calls @p join on each pair of runs, one from each of two
+        /// consecutive rows, that touch (including diagonally).
+        template <typename RunType, typename Join>
+        inline void joinRows(RunType const *prev, int numPrev,
+                             RunType const *cur, int numCur, Join &&join) {
+            int first = 0;
+            for (int i = 0; i < numCur; ++i) {
+                while (first < numPrev && prev[first].end < cur[i].begin) {
+                    ++first;
+                }
+                for (int j = first; j < numPrev && prev[j].begin <= cur[i].end;
+                     ++j) {
+                    join(i, j);
+                }
+            }
+        }
+    } // namespace
+
+    class LedBlobExtractor::BandScanner : public cv::ParallelLoopBody {
+      public:
+        BandScanner(LedBlobExtractor &extractor, cv::Mat const &gray)
+            : m_extractor(extractor), m_gray(gray) {}
+
+        void operator()(cv::Range const &range) const override {
+            for (int i = range.start; i < range.end; ++i) {
+                m_extractor.m_scanBand(m_gray, m_extractor.m_bands[i]);
+            }
+        }
+
+      private:
+        BandScanner &operator=(BandScanner const &);
+        LedBlobExtractor &m_extractor;
+        cv::Mat const &m_gray;
+    };
+
+    LedBlobExtractor::LedBlobExtractor(uchar threshold, int minArea)
+        : m_threshold(std::max<uchar>(threshold, 1)), m_minArea(minArea) {}
+
+    void LedBlobExtractor::extract(cv::Mat const &gray, KeyPointList &blobs) {
+        blobs.clear();
+        BOOST_ASSERT_MSG(gray.type() == CV_8UC1,
+                         "Expected an 8-bit, single-channel image");
+        if (gray.type() != CV_8UC1 || gray.empty()) {
+            return;
+        }
+
+        // Find the runs in each band of rows, in parallel.
+        auto numBands = std::max(
+            1, std::min(cv::getNumberOfCPUs(), gray.rows / MIN_BAND_ROWS));
+        m_bands.resize(numBands);
+        for (int i = 0; i < numBands; ++i) {
+            m_bands[i].beginRow = gray.rows * i / numBands;
+            m_bands[i].endRow = gray.rows * (i + 1) / numBands;
+        }
+        cv::parallel_for_(cv::Range(0, numBands), BandScanner(*this, gray));
+
+        // Number the runs across all bands, then join the runs that touch
+        // across the edges between bands.
+        std::size_t numRuns = 0;
+        for (auto const &band : m_bands) {
+            numRuns += band.runs.size();
+        }
+        m_parents.resize(numRuns);
+        auto parentOf = [&](int i) -> int & { return m_parents[i]; };
+        int offset = 0;
+        for (int b = 0; b < numBands; ++b) {
+            auto const &runs = m_bands[b].runs;
+            auto numBandRuns = static_cast<int>(runs.size());
+            for (int i = 0; i < numBandRuns; ++i) {
+                m_parents[offset + i] = offset + runs[i].parent;
+            }
+            if (b > 0) {
+                auto const &prevRuns = m_bands[b - 1].runs;
+                auto lastRow = m_bands[b - 1].endRow - 1;
+                auto numPrev = static_cast<int>(prevRuns.size());
+                auto prevBegin = numPrev;
+                while (prevBegin > 0 &&
+                       prevRuns[prevBegin - 1].row == lastRow) {
+                    --prevBegin;
+                }
+                auto numCur = 0;
+                while (numCur < numBandRuns &&
+                       runs[numCur].row == m_bands[b].beginRow) {
+                    ++numCur;
+                }
+                auto prevOffset = offset - numPrev;
+                joinRows(prevRuns.data() + prevBegin, numPrev - prevBegin,
+                         runs.data(), numCur, [&](int cur, int prev) {
+                             unite(parentOf, offset + cur,
+                                   prevOffset + prevBegin + prev);
+                         });
+            }
+            offset += numBandRuns;
+        }
+
+        // Total up each blob: a blob's root is its first run, so the blobs
+        // come out in the order of their first pixel.
+        m_blobIndex.assign(numRuns, -1);
+        m_blobs.clear();
+        offset = 0;
+        for (auto const &band : m_bands) {
+            for (auto const &run : band.runs) {
+                auto &index = m_blobIndex[findRoot(parentOf, offset)];
+                if (index < 0) {
+                    index = static_cast<int>(m_blobs.size());
+                    m_blobs.push_back(Blob{0, 0, 0, 0});
+                }
+                auto &blob = m_blobs[index];
+                blob.count += run.count;
+                blob.sum += run.sum;
+                blob.sumX += run.sumX;
+                blob.sumY += run.sumY;
+                ++offset;
+            }
+        }
+
+        for (auto const &blob : m_blobs) {
+            if (blob.count < m_minArea) {
+                continue;
+            }
+            blobs.emplace_back(
+                cv::Point2f(static_cast<float>(blob.sumX / blob.sum),
+                            static_cast<float>(blob.sumY / blob.sum)),
+                static_cast<float>(2 * std::sqrt(blob.count / CV_PI)), -1.f,
+                static_cast<float>(blob.sum));
+        }
+    }
+
+    void LedBlobExtractor::m_scanBand(cv::Mat const &gray, Band &band) const {
+        auto &runs = band.runs;
+        runs.clear();
+        auto parentOf = [&](int i) -> int & { return runs[i].parent; };
+        int prevBegin = 0;
+        int prevEnd = 0;
+        for (int row = band.beginRow; row < band.endRow; ++row) {
+            auto pixels = gray.ptr<uchar>(row);
+            auto rowBegin = static_cast<int>(runs.size());
+            int x = 0;
+            while (x < gray.cols) {
+                if (pixels[x] < m_threshold) {
+                    ++x;
+                    continue;
+                }
+                Run run = {row, x, x, static_cast<int>(runs.size()), 0, 0, 0,
+                           0};
+                for (; x < gray.cols && pixels[x] >= m_threshold; ++x) {
+                    run.sum += pixels[x];
+                    run.sumX += double(pixels[x]) * x;
+                }
+                run.end = x;
+                run.count = x - run.begin;
+                run.sumY = run.sum * row;
+                runs.push_back(run);
+            }
+            auto rowEnd = static_cast<int>(runs.size());
+            joinRows(runs.data() + prevBegin, prevEnd - prevBegin,
+                     runs.data() + rowBegin, rowEnd - rowBegin,
+                     [&](int cur, int prev) {
+                         unite(parentOf, rowBegin + cur, prevBegin + prev);
+                     });
+            prevBegin = rowBegin;
+            prevEnd = rowEnd;
+        }
+    }
+} // namespace vbtracker
+} // namespace osvr
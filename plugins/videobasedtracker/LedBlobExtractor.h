@@ -0,0 +1,109 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+#ifndef INCLUDED_LedBlobExtractor_h_GUID_71A741BF_4045_4636_83F9_993198DB485E
+#define INCLUDED_LedBlobExtractor_h_GUID_71A741BF_4045_4636_83F9_993198DB485E
+
+// Internal Includes
+#include "Types.h"
+
+// Library/third-party includes
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <vector>
+
+namespace osvr {
+namespace vbtracker {
+    /// @brief Finds the bright blobs made by LEDs in a grayscale image: a
+    /// single threshold, then connected components (8-connected) found over
+    /// bands of rows in parallel and joined up across the band edges.
+    ///
+    /// Each blob is reported as a keypoint with an intensity-weighted
+    /// subpixel centroid, the diameter of a circle of the blob's area as its
+    /// size, and its summed brightness (total intensity of its pixels) as its
+    /// response.
+    ///
+    /// Keeps its working buffers between calls, so once they've grown to fit
+    /// the scene, extracting blobs doesn't allocate.
+    class LedBlobExtractor {
+      public:
+        /// @param threshold Pixels at least this bright are part of a blob.
+        /// @param minArea Blobs of fewer pixels are ignored.
+        explicit LedBlobExtractor(uchar threshold = 220, int minArea = 1);
+
+        /// @brief Finds the blobs in an 8-bit, single-channel image.
+        /// @param [out] blobs Replaced with the blobs found, in the order
+        /// of their first pixel in the image.
+        void extract(cv::Mat const &gray, KeyPointList &blobs);
+
+        uchar getThreshold() const { return m_threshold; }
+
+      private:
+        /// @brief A horizontal run of above-threshold pixels, with the sums
+        /// needed for its blob's centroid and brightness.
+        struct Run {
+            int row;
+            int begin;
+            /// @brief One past the last column.
+            int end;
+            /// @brief Union-find parent: an index within the band at first,
+            /// then across all bands.
+            int parent;
+            int count;
+            double sum;
+            double sumX;
+            double sumY;
+        };
+        struct Band {
+            int beginRow;
+            int endRow;
+            std::vector<Run> runs;
+        };
+        /// @brief Totals for one blob.
+        struct Blob {
+            int count;
+            double sum;
+            double sumX;
+            double sumY;
+        };
+        class BandScanner;
+
+        /// @brief Finds the runs in a band and joins those that touch.
+        void m_scanBand(cv::Mat const &gray, Band &band) const;
+
+        uchar m_threshold;
+        int m_minArea;
+        std::vector<Band> m_bands;
+        /// @brief Union-find parents of the runs of all bands.
+        std::vector<int> m_parents;
+        /// @brief For each run that is a blob's root, the blob's index.
+        std::vector<int> m_blobIndex;
+        std::vector<Blob> m_blobs;
+    };
+} // namespace vbtracker
+} // namespace osvr
+
+#endif // INCLUDED_LedBlobExtractor_h_GUID_71A741BF_4045_4636_83F9_993198DB485E
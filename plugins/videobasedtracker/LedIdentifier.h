@@ -26,6 +26,7 @@
 #define INCLUDED_LedIdentifier_h_GUID_674F7CDB_87AD_41AA_2475_134F2B4A3FF9
 
 // Internal Includes
+#include "BrightnessHistory.h"
 #include "Types.h"
 
 // Library/third-party includes
@@ -42,10 +43,6 @@ namespace vbtracker {
     /// derived classes encode the pattern-detection algorithm for specific
     /// devices.
     ///
-    /// NOTE: This class may modify the passed-in list, truncating it so that
-    /// old data points are removed once there are enough measurements to make
-    /// an estimate.
-    ///
     /// @todo Consider adding a distance estimator as a parameter throughout,
     /// which can be left alone for unknown or estimated based on a Kalman
     /// filter; it would be used to scale the expected brightness.
@@ -55,14 +52,13 @@ namespace vbtracker {
         virtual ~LedIdentifier();
         /// @brief Determine the identity of the LED whose brightness pattern is
         /// passed in.
-        /// Truncates the passed-in list to the length needed to look for a
-        /// pattern, so it does not grow too long and waste space and time,
-        /// and perhaps produce spurious Ids.
+        /// Only the most recent measurements, as many as the patterns are
+        /// long, are used, so that older ones can't produce spurious Ids.
         /// @return -1 for unknown (not enough information) and
         /// less than -1 for definitely not an LED (light sources will be
         /// constant, mis-tracked LEDs may produce spurious changes in the
         /// pattern for example).
-        virtual int getId(BrightnessList &brightnesses) const = 0;
+        virtual int getId(BrightnessHistory const &brightnesses) const = 0;
 
       protected:
     };
@@ -0,0 +1,153 @@
+/** @file
+    @brief Test Implementation: checks that the grid-based BlobAssociator
+    makes the same matches as a brute-force greedy matcher, on randomized
+    LEDs and blobs.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlobAssociator.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <opencv2/core/core.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+/// @brief The greedy matching, done the slow way for reference: repeatedly
+/// take the closest remaining LED-blob pair within the threshold, ties going
+/// to the lowest LED then blob index.
+inline void bruteForceAssociate(KeyPointList const &blobs, float threshold,
+                                std::vector<cv::Point2f> const &positions,
+                                std::vector<int> &ledToBlob,
+                                std::vector<int> &blobToLed) {
+    ledToBlob.assign(positions.size(), -1);
+    blobToLed.assign(blobs.size(), -1);
+    auto const thresholdSquared = threshold * threshold;
+    while (true) {
+        int bestLed = -1;
+        int bestBlob = -1;
+        float bestDistanceSquared = 0;
+        for (size_t led = 0; led < positions.size(); ++led) {
+            if (ledToBlob[led] >= 0) {
+                continue;
+            }
+            for (size_t blob = 0; blob < blobs.size(); ++blob) {
+                if (blobToLed[blob] >= 0) {
+                    continue;
+                }
+                auto offset = blobs[blob].pt - positions[led];
+                auto distanceSquared = offset.dot(offset);
+                if (distanceSquared <= thresholdSquared &&
+                    (bestLed < 0 || distanceSquared < bestDistanceSquared)) {
+                    bestLed = static_cast<int>(led);
+                    bestBlob = static_cast<int>(blob);
+                    bestDistanceSquared = distanceSquared;
+                }
+            }
+        }
+        if (bestLed < 0) {
+            return;
+        }
+        ledToBlob[bestLed] = bestBlob;
+        blobToLed[bestBlob] = bestLed;
+    }
+}
+
+/// @brief Associates with both, checking they agree.
+inline void checkAssociation(BlobAssociator &associator,
+                             KeyPointList const &blobs, float threshold,
+                             std::vector<cv::Point2f> const &positions) {
+    std::vector<int> ledToBlob;
+    std::vector<int> blobToLed;
+    associator.setBlobs(blobs, threshold);
+    associator.associate(positions, ledToBlob, blobToLed);
+
+    std::vector<int> expectedLedToBlob;
+    std::vector<int> expectedBlobToLed;
+    bruteForceAssociate(blobs, threshold, positions, expectedLedToBlob,
+                        expectedBlobToLed);
+    ASSERT_EQ(expectedLedToBlob, ledToBlob);
+    ASSERT_EQ(expectedBlobToLed, blobToLed);
+}
+} // namespace
+
+TEST(BlobAssociator, NoBlobs) {
+    BlobAssociator associator;
+    std::vector<cv::Point2f> positions(3, cv::Point2f(10, 10));
+    checkAssociation(associator, KeyPointList(), 10, positions);
+}
+
+TEST(BlobAssociator, NoLeds) {
+    BlobAssociator associator;
+    KeyPointList blobs(1, cv::KeyPoint(cv::Point2f(10, 10), 5));
+    checkAssociation(associator, blobs, 10, std::vector<cv::Point2f>());
+}
+
+TEST(BlobAssociator, CoincidentPoints) {
+    // Every pair at the same distance: ties go to the lowest indices.
+    BlobAssociator associator;
+    KeyPointList blobs(4, cv::KeyPoint(cv::Point2f(5, 5), 5));
+    std::vector<cv::Point2f> positions(3, cv::Point2f(5, 5));
+    checkAssociation(associator, blobs, 1, positions);
+}
+
+TEST(BlobAssociator, RandomTrials) {
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> count(0, 60);
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    // Reused across trials, as it is from frame to frame.
+    BlobAssociator associator;
+    for (int trial = 0; trial < 2000; ++trial) {
+        SCOPED_TRACE(trial);
+        // From a few pixels up to spreads that force larger grid cells.
+        auto extent = 20.f + unit(rng) * (trial % 4 == 0 ? 1e6f : 640.f);
+        auto threshold = 0.5f + unit(rng) * 120.f;
+        std::vector<cv::Point2f> positions(count(rng));
+        for (auto &position : positions) {
+            position = cv::Point2f(unit(rng) * extent, unit(rng) * extent);
+        }
+        KeyPointList blobs;
+        for (auto const &position : positions) {
+            // Most LEDs have a blob nearby, some several.
+            while (unit(rng) < 0.7f) {
+                auto offset = cv::Point2f((unit(rng) - 0.5f) * 2 * threshold,
+                                          (unit(rng) - 0.5f) * 2 * threshold);
+                blobs.emplace_back(cv::Point2f(position.x + offset.x,
+                                               position.y + offset.y),
+                                   5);
+            }
+        }
+        for (int i = count(rng) / 4; i > 0; --i) {
+            blobs.emplace_back(
+                cv::Point2f(unit(rng) * extent, unit(rng) * extent), 5);
+        }
+        std::shuffle(blobs.begin(), blobs.end(), rng);
+        checkAssociation(associator, blobs, threshold, positions);
+    }
+}
@@ -0,0 +1,275 @@
+/** @file
+    @brief Test Implementation: checks that the HDK LED identifier gives the
+    same IDs as the list-based implementation it replaced, on synthetic
+    brightness sequences and on the HDK_random_images.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "BlobAssociator.h"
+#include "HDKLedIdentifierFactory.h"
+#include "LED.h"
+#include "LedBlobExtractor.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cstdio>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+/// @brief The identification algorithm as it was, on lists, for reference.
+class ListLedIdentifier {
+  public:
+    explicit ListLedIdentifier(PatternStringList const &patterns)
+        : m_length(0) {
+        if (patterns.empty()) {
+            return;
+        }
+        m_length = patterns[0].size();
+        for (auto const &str : patterns) {
+            if (str.size() != m_length) {
+                m_patterns.clear();
+                m_length = 0;
+                return;
+            }
+            std::list<bool> pattern;
+            for (auto c : str) {
+                pattern.push_back(c != '.');
+            }
+            m_patterns.push_back(pattern);
+        }
+    }
+
+    int getId(std::list<float> &brightnesses) const {
+        if (brightnesses.size() < m_length) {
+            return -1;
+        }
+        while (brightnesses.size() > m_length) {
+            brightnesses.pop_front();
+        }
+        auto extrema =
+            std::minmax_element(begin(brightnesses), end(brightnesses));
+        const auto minVal = *extrema.first;
+        const auto maxVal = *extrema.second;
+        if (maxVal - minVal <= 0.5) {
+            return -2;
+        }
+        const auto threshold = (minVal + maxVal) / 2;
+        std::list<bool> bits;
+        for (auto val : brightnesses) {
+            bits.push_back(val >= threshold);
+        }
+        for (size_t i = 0; i < m_patterns.size(); i++) {
+            for (size_t j = 0; j < bits.size(); j++) {
+                if (bits == m_patterns[i]) {
+                    return static_cast<int>(i);
+                }
+                auto mid = bits.begin();
+                std::rotate(bits.begin(), ++mid, bits.end());
+            }
+        }
+        return -3;
+    }
+
+  private:
+    size_t m_length;
+    std::vector<std::list<bool> > m_patterns;
+};
+
+/// @brief An LED followed by both identifiers.
+class LedPair {
+  public:
+    LedPair(LedIdentifier *identifier, ListLedIdentifier const &reference,
+            cv::Point2f loc, Brightness brightness)
+        : m_led(identifier, loc, brightness), m_reference(&reference),
+          m_history(1, brightness) {}
+
+    void addMeasurement(cv::Point2f loc, Brightness brightness) {
+        m_led.addMeasurement(loc, brightness);
+        m_history.push_back(brightness);
+    }
+
+    int getID() const { return m_led.getID(); }
+    int getReferenceID() { return m_reference->getId(m_history); }
+    cv::Point2f getLocation() const { return m_led.getLocation(); }
+
+  private:
+    Led m_led;
+    ListLedIdentifier const *m_reference;
+    std::list<float> m_history;
+};
+
+/// @brief Feeds @p brightnesses to both identifiers one at a time, checking
+/// they agree after each.
+/// @return the last ID
+inline int checkSequence(LedIdentifier *identifier,
+                         ListLedIdentifier const &reference,
+                         std::vector<Brightness> const &brightnesses) {
+    LedPair led(identifier, reference, cv::Point2f(), brightnesses.front());
+    EXPECT_EQ(led.getReferenceID(), led.getID()) << "at frame 0";
+    for (size_t i = 1; i < brightnesses.size(); ++i) {
+        led.addMeasurement(cv::Point2f(), brightnesses[i]);
+        EXPECT_EQ(led.getReferenceID(), led.getID()) << "at frame " << i;
+    }
+    return led.getID();
+}
+
+/// @brief The HDK identifiers, with the patterns they use.
+struct IdentifierCase {
+    const char *name;
+    LedIdentifierPtr identifier;
+    PatternStringList const *patterns;
+};
+
+inline std::vector<IdentifierCase> getIdentifierCases() {
+    std::vector<IdentifierCase> ret;
+    ret.push_back(IdentifierCase{"sensor 0", createHDKLedIdentifier(0),
+                                 &getHDKLedPatterns(0)});
+    ret.push_back(IdentifierCase{"sensor 1", createHDKLedIdentifier(1),
+                                 &getHDKLedPatterns(1)});
+    ret.push_back(IdentifierCase{"random images",
+                                 createRandomHDKLedIdentifier(),
+                                 &getRandomHDKLedPatterns()});
+    return ret;
+}
+} // namespace
+
+TEST(HDKLedIdentifier, EveryRotationOfEveryPattern) {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<Brightness> noise(-1.f, 1.f);
+    for (auto const &c : getIdentifierCases()) {
+        SCOPED_TRACE(c.name);
+        ListLedIdentifier reference(*c.patterns);
+        auto const &patterns = *c.patterns;
+        for (size_t i = 0; i < patterns.size(); ++i) {
+            auto const &pattern = patterns[i];
+            for (size_t start = 0; start < pattern.size(); ++start) {
+                // Long enough to wrap around the brightness history.
+                std::vector<Brightness> brightnesses;
+                for (size_t frame = 0;
+                     frame < BrightnessHistory::CAPACITY + 2 * pattern.size();
+                     ++frame) {
+                    auto bright =
+                        pattern[(start + frame) % pattern.size()] != '.';
+                    brightnesses.push_back((bright ? 20.f : 10.f) +
+                                           noise(rng));
+                }
+                auto id = checkSequence(c.identifier.get(), reference,
+                                        brightnesses);
+                if (pattern.find('.') == std::string::npos ||
+                    pattern.find('*') == std::string::npos) {
+                    // A steady pattern can't be told from noise.
+                    continue;
+                }
+                // Patterns may repeat, or be rotations of one another, but
+                // the first one of them is found.
+                ASSERT_GE(id, 0);
+                ASSERT_LE(id, int(i));
+            }
+        }
+    }
+}
+
+TEST(HDKLedIdentifier, RandomSequences) {
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<Brightness> brightness(0.f, 4.f);
+    for (auto const &c : getIdentifierCases()) {
+        SCOPED_TRACE(c.name);
+        ListLedIdentifier reference(*c.patterns);
+        for (int trial = 0; trial < 200; ++trial) {
+            std::vector<Brightness> brightnesses(100);
+            std::generate(begin(brightnesses), end(brightnesses),
+                          [&] { return brightness(rng); });
+            checkSequence(c.identifier.get(), reference, brightnesses);
+        }
+    }
+}
+
+TEST(HDKLedIdentifier, SteadyLight) {
+    auto identifier = createHDKLedIdentifier(0);
+    ListLedIdentifier reference(getHDKLedPatterns(0));
+    ASSERT_EQ(-2, checkSequence(identifier.get(), reference,
+                                std::vector<Brightness>(40, 10.f)));
+}
+
+TEST(HDKLedIdentifier, RandomImages) {
+    // Track the blobs from frame to frame the way VideoBasedTracker does.
+    auto identifier = createRandomHDKLedIdentifier();
+    ListLedIdentifier reference(getRandomHDKLedPatterns());
+    LedBlobExtractor extractor;
+    BlobAssociator associator;
+    KeyPointList keyPoints;
+    std::vector<LedPair> leds;
+    std::vector<cv::Point2f> positions;
+    std::vector<int> ledToBlob;
+    std::vector<int> blobToLed;
+    int frames = 0;
+    for (int i = 1;; ++i) {
+        char name[16];
+        std::sprintf(name, "/%04d.tif", i);
+        auto image = cv::imread(std::string(VBTRACKER_HDK_RANDOM_IMAGES) + name,
+                                cv::IMREAD_GRAYSCALE);
+        if (!image.data) {
+            break;
+        }
+        ++frames;
+        extractor.extract(image, keyPoints);
+        associator.setBlobs(keyPoints, 100);
+        positions.clear();
+        for (auto const &led : leds) {
+            positions.push_back(led.getLocation());
+        }
+        associator.associate(positions, ledToBlob, blobToLed);
+
+        std::vector<LedPair> tracked;
+        for (size_t j = 0; j < leds.size(); ++j) {
+            if (ledToBlob[j] < 0) {
+                continue;
+            }
+            auto const &keyPoint = keyPoints[ledToBlob[j]];
+            leds[j].addMeasurement(keyPoint.pt, keyPoint.size);
+            tracked.push_back(leds[j]);
+        }
+        for (size_t j = 0; j < keyPoints.size(); ++j) {
+            if (blobToLed[j] < 0) {
+                tracked.emplace_back(identifier.get(), reference,
+                                     keyPoints[j].pt, keyPoints[j].size);
+            }
+        }
+        leds.swap(tracked);
+        for (auto &led : leds) {
+            ASSERT_EQ(led.getReferenceID(), led.getID()) << "in image " << i;
+        }
+    }
+    ASSERT_GT(frames, 0) << "No images found in "
+                         << VBTRACKER_HDK_RANDOM_IMAGES;
+}
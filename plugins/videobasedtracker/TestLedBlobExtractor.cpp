@@ -0,0 +1,219 @@
+/** @file
+    @brief Test Implementation: checks that LedBlobExtractor finds the same
+    blobs as a brute-force flood fill, on the HDK_random_images and on
+    random images.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "LedBlobExtractor.h"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <opencv2/core/core.hpp>
+#include <opencv2/highgui/highgui.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osvr::vbtracker;
+
+namespace {
+/// @brief Totals for one blob found by flood fill.
+struct ReferenceBlob {
+    int count;
+    double sum;
+    double sumX;
+    double sumY;
+};
+
+/// @brief Finds the 8-connected blobs of pixels at least @p threshold, the
+/// slow way, in the order of their first pixel.
+inline std::vector<ReferenceBlob> floodFill(cv::Mat const &gray,
+                                            uchar threshold, int minArea) {
+    std::vector<ReferenceBlob> ret;
+    std::vector<bool> visited(gray.rows * gray.cols, false);
+    std::vector<std::pair<int, int> > stack;
+    auto bright = [&](int row, int col) {
+        return gray.ptr<uchar>(row)[col] >= threshold;
+    };
+    for (int row = 0; row < gray.rows; ++row) {
+        for (int col = 0; col < gray.cols; ++col) {
+            if (visited[row * gray.cols + col] || !bright(row, col)) {
+                continue;
+            }
+            ReferenceBlob blob = {0, 0, 0, 0};
+            visited[row * gray.cols + col] = true;
+            stack.push_back(std::make_pair(row, col));
+            while (!stack.empty()) {
+                auto y = stack.back().first;
+                auto x = stack.back().second;
+                stack.pop_back();
+                double value = gray.ptr<uchar>(y)[x];
+                ++blob.count;
+                blob.sum += value;
+                blob.sumX += value * x;
+                blob.sumY += value * y;
+                for (int ny = std::max(y - 1, 0);
+                     ny < std::min(y + 2, gray.rows); ++ny) {
+                    for (int nx = std::max(x - 1, 0);
+                         nx < std::min(x + 2, gray.cols); ++nx) {
+                        if (!visited[ny * gray.cols + nx] && bright(ny, nx)) {
+                            visited[ny * gray.cols + nx] = true;
+                            stack.push_back(std::make_pair(ny, nx));
+                        }
+                    }
+                }
+            }
+            if (blob.count >= minArea) {
+                ret.push_back(blob);
+            }
+        }
+    }
+    return ret;
+}
+
+/// @brief Extracts blobs with both, checking they agree.
+inline void checkImage(LedBlobExtractor &extractor, cv::Mat const &gray,
+                       int minArea = 1) {
+    KeyPointList blobs;
+    extractor.extract(gray, blobs);
+    auto expected = floodFill(gray, extractor.getThreshold(), minArea);
+    ASSERT_EQ(expected.size(), blobs.size());
+    for (std::size_t i = 0; i < blobs.size(); ++i) {
+        SCOPED_TRACE(i);
+        auto const &blob = expected[i];
+        ASSERT_NEAR(blob.sumX / blob.sum, blobs[i].pt.x, 1e-3);
+        ASSERT_NEAR(blob.sumY / blob.sum, blobs[i].pt.y, 1e-3);
+        ASSERT_FLOAT_EQ(static_cast<float>(2 * std::sqrt(blob.count / CV_PI)),
+                        blobs[i].size);
+        ASSERT_FLOAT_EQ(static_cast<float>(blob.sum), blobs[i].response);
+    }
+}
+
+/// @brief An image of @p rows by @p cols with every pixel from @p f.
+template <typename F> inline cv::Mat makeImage(int rows, int cols, F &&f) {
+    cv::Mat ret(rows, cols, CV_8UC1);
+    for (int row = 0; row < rows; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            ret.at<uchar>(row, col) = f(row, col);
+        }
+    }
+    return ret;
+}
+} // namespace
+
+TEST(LedBlobExtractor, EmptyImage) {
+    LedBlobExtractor extractor;
+    KeyPointList blobs(1, cv::KeyPoint(cv::Point2f(), 1));
+    extractor.extract(cv::Mat(), blobs);
+    ASSERT_TRUE(blobs.empty());
+}
+
+TEST(LedBlobExtractor, HDKRandomImages) {
+    // The default threshold, as VideoBasedTracker uses, and a lower one
+    // giving larger blobs that reach across more rows.
+    LedBlobExtractor extractors[] = {LedBlobExtractor(),
+                                     LedBlobExtractor(100, 2)};
+    int frames = 0;
+    for (int i = 1;; ++i) {
+        char name[16];
+        std::sprintf(name, "/%04d.tif", i);
+        auto image = cv::imread(std::string(VBTRACKER_HDK_RANDOM_IMAGES) + name,
+                                cv::IMREAD_GRAYSCALE);
+        if (!image.data) {
+            break;
+        }
+        ++frames;
+        SCOPED_TRACE(name);
+        checkImage(extractors[0], image);
+        checkImage(extractors[1], image, 2);
+    }
+    ASSERT_GT(frames, 0) << "No images found in "
+                         << VBTRACKER_HDK_RANDOM_IMAGES;
+}
+
+TEST(LedBlobExtractor, RandomNoise) {
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int> size(1, 300);
+    std::uniform_int_distribution<int> pixel(0, 255);
+    std::uniform_int_distribution<int> minArea(1, 4);
+    for (int trial = 0; trial < 200; ++trial) {
+        SCOPED_TRACE(trial);
+        auto threshold = static_cast<uchar>(pixel(rng));
+        auto area = minArea(rng);
+        LedBlobExtractor extractor(threshold, area);
+        auto image = makeImage(size(rng), size(rng), [&](int, int) {
+            return static_cast<uchar>(pixel(rng));
+        });
+        checkImage(extractor, image, area);
+    }
+}
+
+TEST(LedBlobExtractor, RandomSpots) {
+    // LED-like spots of all sizes, some merging, over a dim background.
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> unit(0, 1);
+    LedBlobExtractor extractor;
+    for (int trial = 0; trial < 50; ++trial) {
+        SCOPED_TRACE(trial);
+        auto rows = 100 + static_cast<int>(unit(rng) * 400);
+        auto cols = 100 + static_cast<int>(unit(rng) * 400);
+        struct Spot {
+            double x;
+            double y;
+            double radius;
+        };
+        std::vector<Spot> spots(1 + static_cast<int>(unit(rng) * 40));
+        for (auto &spot : spots) {
+            spot = Spot{unit(rng) * cols, unit(rng) * rows,
+                        0.5 + unit(rng) * 15};
+        }
+        auto image = makeImage(rows, cols, [&](int row, int col) {
+            double value = unit(rng) * 40;
+            for (auto const &spot : spots) {
+                auto dx = (col - spot.x) / spot.radius;
+                auto dy = (row - spot.y) / spot.radius;
+                value += 255 * std::exp(-(dx * dx + dy * dy));
+            }
+            return static_cast<uchar>(std::min(value, 255.));
+        });
+        checkImage(extractor, image);
+    }
+}
+
+TEST(LedBlobExtractor, Submatrix) {
+    // Rows of a region of interest aren't contiguous.
+    std::mt19937 rng(6);
+    std::uniform_int_distribution<int> pixel(0, 255);
+    auto image = makeImage(200, 150, [&](int, int) {
+        return static_cast<uchar>(pixel(rng));
+    });
+    LedBlobExtractor extractor(200);
+    checkImage(extractor, image(cv::Rect(17, 9, 101, 180)));
+}
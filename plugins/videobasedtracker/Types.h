@@ -32,6 +32,7 @@
 #include <opencv2/features2d/features2d.hpp>
 
 // Standard includes
+#include <stdint.h>
 #include <vector>
 #include <list>
 #include <string>
@@ -50,17 +51,14 @@ namespace vbtracker {
 
     typedef std::vector<std::string> PatternStringList;
 
-    /// @todo std::list used here for ease of rotate, but has terrible data
-    /// locality - consider changing when a more efficient rotation-invariant
-    /// string match algorithm is used.
-    typedef std::list<bool> LedPattern;
-    typedef std::vector<LedPattern> PatternList;
+    /// @brief A blink pattern packed into bits, the earliest frame in the
+    /// most significant bit in use: so at most 64 frames long.
+    typedef uint64_t LedPattern;
 
     typedef std::vector<cv::KeyPoint> KeyPointList;
     typedef KeyPointList::iterator KeyPointIterator;
 
     typedef float Brightness;
-    typedef std::list<Brightness> BrightnessList;
     typedef std::pair<Brightness, Brightness> BrightnessMinMax;
 
     typedef std::unique_ptr<BeaconBasedPoseEstimator> EstimatorPtr;
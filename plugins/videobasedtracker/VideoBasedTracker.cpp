@@ -26,13 +26,20 @@
 #include "VideoBasedTracker.h"
 
 // Library/third-party includes
-#include <opencv2/core/version.hpp>
+// - none
 
 // Standard includes
 // - none
 
 namespace osvr {
 namespace vbtracker {
+    /// @brief How far in pixels a blob may be from an LED's location in the
+    /// previous frame and still be taken for it.
+    ///
+    /// @todo Tune this: it was 10, but compared against the square root of the
+    /// distance, so 100 pixels is the radius tracking has been using.
+    static const float BLOB_MOVE_THRESHOLD = 100;
+
     void VideoBasedTracker::addOculusSensor() {
         /// @todo this clearly violates what I expected was the invariant - not
         /// sure if it's because of incomplete Oculus information, or due to a
@@ -71,63 +78,24 @@ namespace vbtracker {
         //================================================================
         // Tracking the points
 
-        // Threshold the image based on the brightness value that is between
-        // the darkest and brightest pixel in the image.
-        // @todo Make this a parameter.
-        double minVal, maxVal;
-        cv::minMaxLoc(m_imageGray, &minVal, &maxVal);
-        double thresholdValue = 220;
-        cv::threshold(m_imageGray, m_thresholdImage, thresholdValue, 255,
-                      CV_THRESH_BINARY);
-
-        // @todo are any of the above steps already being performed in the blob
-        // detector (if configured in a given way?)
-        // http://docs.opencv.org/master/d0/d7a/classcv_1_1SimpleBlobDetector.html#details
-
-        // Construct a blob detector and find the blobs in the image.
-        // This set of parameters is optimized for the OSVR HDK prototype
-        // that has exposed LEDs.
-        /// @todo: Make a different set of parameters optimized for the
-        /// Oculus Dk2.
+        // Find the LED blobs: their locations are intensity-weighted
+        // centroids.
+        /// @todo: Make the threshold a parameter, with a different value
+        /// optimized for the Oculus DK2.
         /// @todo: Determine the maximum size of a trackable blob by seeing
         /// when we're so close that we can't view at least four in the
         /// camera.
-        cv::SimpleBlobDetector::Params params;
-        params.minThreshold = static_cast<float>(thresholdValue);
-        params.maxThreshold = static_cast<float>(
-            thresholdValue + (maxVal - thresholdValue) * 0.3);
-        params.thresholdStep = (params.maxThreshold - params.minThreshold) / 10;
-        params.blobColor = static_cast<uchar>(255);
-        params.filterByColor =
-            false; // Look for bright blobs: there is a bug in this code
-        params.minInertiaRatio = 0.5;
-        params.maxInertiaRatio = 1.0;
-        params.filterByInertia = false;   // Do we test for non-elongated blobs?
-        params.minArea = 1;               // How small can the blobs be?
-        params.filterByConvexity = false; // Test for convexity?
-        params.filterByCircularity = false; // Test for circularity?
-        params.minDistBetweenBlobs = 3;
-#if CV_MAJOR_VERSION == 2
-        cv::Ptr<cv::SimpleBlobDetector> detector =
-            new cv::SimpleBlobDetector(params);
-#elif CV_MAJOR_VERSION == 3
-        auto detector = cv::SimpleBlobDetector::create(params);
-#else
-#error "Unrecognized OpenCV version!"
+        m_blobExtractor.extract(m_imageGray, m_foundKeyPoints);
+        m_blobAssociator.setBlobs(m_foundKeyPoints, BLOB_MOVE_THRESHOLD);
+#ifdef VBHMD_DEBUG
+        // Only needed to be shown.
+        cv::threshold(m_imageGray, m_thresholdImage,
+                      m_blobExtractor.getThreshold(), 255, CV_THRESH_BINARY);
 #endif
-        /// @todo this variable is a candidate for hoisting to member
-        std::vector<cv::KeyPoint> foundKeyPoints;
-        detector->detect(m_imageGray, foundKeyPoints);
-
-        // @todo: Consider computing the center of mass of a dilated bounding
-        // rectangle around each keypoint to produce a more precise subpixel
-        // localization of each LED.  The moments() function may be helpful
-        // with this.
 
-        // @todo: Estimate the summed brightness of each blob so that we can
-        // detect when they are getting brighter and dimmer.  Pass this as
-        // the brightness parameter to the Led class when adding a new one
-        // or augmenting with a new frame.
+        // @todo: Each blob's summed brightness is in its response: pass it as
+        // the brightness parameter to the Led class once the identifiers'
+        // thresholds are tuned for it, rather than the blob size.
 
         // We allow multiple sets of LEDs, each corresponding to a different
         // sensor, to be located in the same image.  We construct a new set
@@ -135,43 +103,41 @@ namespace vbtracker {
         // have unique ID patterns across all sensors.
         for (size_t sensor = 0; sensor < m_identifiers.size(); sensor++) {
             osvrPose3SetIdentity(&m_pose);
-            std::vector<cv::KeyPoint> keyPoints = foundKeyPoints;
+            auto &leds = m_led_groups[sensor];
 
-            // Locate the closest blob from this frame to each LED found
-            // in the previous frame.  If it is close enough to the nearest
-            // neighbor from last time, we assume that it is the same LED and
-            // update it.  If not, we delete the LED from the list.  Once we
-            // have matched a blob to an LED, we remove it from the list.  If
-            // there are any blobs leftover, we create new LEDs from them.
+            // Match each LED found in the previous frame to a blob from this
+            // frame close enough to it, closest pairs first: we assume that
+            // such a blob is the same LED and update it. LEDs with no blob are
+            // deleted, and blobs left over become new LEDs.
             // @todo: Include motion estimate based on Kalman filter along with
-            // model of the projection once we have one built.  Note that this
-            // will require handling the lens distortion appropriately.
-            auto led = begin(m_led_groups[sensor]);
-            auto e = end(m_led_groups[sensor]);
-            while (led != e) {
-                double TODO_BLOB_MOVE_THRESHOLD = 10;
-                auto nearest =
-                    led->nearest(keyPoints, TODO_BLOB_MOVE_THRESHOLD);
-                if (nearest == keyPoints.end()) {
+            // model of the projection once we have one built, and pass the
+            // predicted positions here.  Note that this will require handling
+            // the lens distortion appropriately.
+            m_ledPositions.clear();
+            for (auto const &led : leds) {
+                m_ledPositions.push_back(led.getLocation());
+            }
+            m_blobAssociator.associate(m_ledPositions, m_ledToBlob,
+                                       m_blobToLed);
+            std::size_t ledIndex = 0;
+            for (auto led = begin(leds); led != end(leds); ++ledIndex) {
+                auto blob = m_ledToBlob[ledIndex];
+                if (blob < 0) {
                     // We have no blob corresponding to this LED, so we need
                     // to delete this LED.
-                    led = m_led_groups[sensor].erase(led);
+                    led = leds.erase(led);
                 } else {
-                    // Update the values in this LED and then go on to the
-                    // next one.  Remove this blob from the list of potential
-                    // matches.
-                    led->addMeasurement(nearest->pt, nearest->size);
-                    keyPoints.erase(nearest);
+                    auto const &keyPoint = m_foundKeyPoints[blob];
+                    led->addMeasurement(keyPoint.pt, keyPoint.size);
                     ++led;
                 }
             }
-            // If we have any blobs that have not been associated with an
-            // LED, then we add a new LED for each of them.
-            // std::cout << "Had " << Leds.size() << " LEDs, " <<
-            // keyPoints.size() << " new ones available" << std::endl;
-            for (auto &keypoint : keyPoints) {
-                m_led_groups[sensor].emplace_back(m_identifiers[sensor].get(),
-                                                  keypoint.pt, keypoint.size);
+            for (std::size_t i = 0; i < m_foundKeyPoints.size(); ++i) {
+                if (m_blobToLed[i] < 0) {
+                    auto const &keyPoint = m_foundKeyPoints[i];
+                    leds.emplace_back(m_identifiers[sensor].get(),
+                                      keyPoint.pt, keyPoint.size);
+                }
             }
 
             //==================================================================
@@ -209,7 +175,7 @@ namespace vbtracker {
             static int count = 0;
             if (++count == 11) {
                 // Draw detected blobs as red circles.
-                cv::drawKeypoints(m_frame, keyPoints, m_imageWithBlobs,
+                cv::drawKeypoints(m_frame, m_foundKeyPoints, m_imageWithBlobs,
                                   cv::Scalar(0, 0, 255),
                                   cv::DrawMatchesFlags::DRAW_RICH_KEYPOINTS);
 
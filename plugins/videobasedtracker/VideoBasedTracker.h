@@ -29,6 +29,8 @@
 #include "Types.h"
 #include "LED.h"
 #include "LedIdentifier.h"
+#include "LedBlobExtractor.h"
+#include "BlobAssociator.h"
 #include "BeaconBasedPoseEstimator.h"
 #include <osvr/Util/ChannelCountC.h>
 
@@ -98,6 +100,19 @@ namespace vbtracker {
 #endif
         /// @}
 
+        /// @name Blob extraction and association, kept between frames to
+        /// reuse the buffers.
+        /// @{
+        LedBlobExtractor m_blobExtractor;
+        /// @brief All the blobs found in the current frame.
+        KeyPointList m_foundKeyPoints;
+        BlobAssociator m_blobAssociator;
+        /// @brief Where the LEDs of the sensor being processed are expected.
+        std::vector<cv::Point2f> m_ledPositions;
+        std::vector<int> m_ledToBlob;
+        std::vector<int> m_blobToLed;
+        /// @}
+
         /// @brief Test (with asserts) what Ryan thinks are the invariants. Will
         /// inline right out of existence in non-debug builds.
         void m_assertInvariants() const {
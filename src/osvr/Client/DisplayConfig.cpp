@@ -160,5 +160,12 @@ namespace client {
         }
         return true;
     }
+
+    void DisplayConfig::setPoseTime(
+        boost::optional<util::time::TimeValue> const &when) {
+        for (auto &viewer : container()) {
+            viewer.setPoseTime(when);
+        }
+    }
 } // namespace client
 } // namespace osvr
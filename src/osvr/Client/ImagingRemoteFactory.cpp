@@ -45,16 +45,32 @@
 namespace osvr {
 namespace client {
 
+    /// @brief Number of imaging sensors a device has, from its descriptor
+    /// (one unless it says otherwise), and enough for the routed sensor.
+    static OSVR_ChannelCount
+    getImagingSensorCount(common::OriginalSource const &source) {
+        auto count = source.getDeviceElement()
+                         .getDescriptor()["interfaces"]["imaging"]
+                         .get("count", 1);
+        OSVR_ChannelCount ret = count.isUInt() ? count.asUInt() : 1;
+        auto sensor = source.getSensorNumberAsChannelCount();
+        if (sensor && *sensor >= ret) {
+            ret = *sensor + 1;
+        }
+        return ret;
+    }
+
     class NetworkImagingRemoteHandler : public RemoteHandler {
       public:
         NetworkImagingRemoteHandler(vrpn_ConnectionPtr const &conn,
                                     std::string const &deviceName,
                                     boost::optional<OSVR_ChannelCount> sensor,
+                                    OSVR_ChannelCount numSensors,
                                     common::InterfaceList &ifaces)
             : m_dev(common::createClientDevice(deviceName, conn)),
               m_interfaces(ifaces), m_all(!sensor.is_initialized()),
               m_sensor(sensor) {
-            auto imaging = common::ImagingComponent::create();
+            auto imaging = common::ImagingComponent::create(numSensors);
             m_dev->addComponent(imaging);
             imaging->registerImageHandler(
                 [&](common::ImageData const &data,
@@ -120,7 +136,8 @@ namespace client {
         /// @todo find out why make_shared causes a crash here
         ret.reset(new NetworkImagingRemoteHandler(
             m_conns.getConnection(devElt), devElt.getFullDeviceName(),
-            source.getSensorNumberAsChannelCount(), ifaces));
+            source.getSensorNumberAsChannelCount(),
+            getImagingSensorCount(source), ifaces));
         return ret;
     }
 
@@ -30,6 +30,8 @@
 #include <osvr/Common/BaseDevicePtr.h>
 #include <osvr/Common/SystemComponent_fwd.h>
 #include <osvr/Common/PathTree.h>
+#include <osvr/Common/PathTreeDelta.h>
+#include <osvr/Common/ResolvedRouteCache.h>
 #include <osvr/Common/NetworkingSupport.h>
 #include <osvr/Util/TimeValue_fwd.h>
 #include <osvr/Util/DefaultBool.h>
@@ -40,6 +42,7 @@
 // Library/third-party includes
 #include <vrpn_ConnectionPtr.h>
 #include <json/value.h>
+#include <boost/optional.hpp>
 
 // Standard includes
 #include <string>
@@ -85,14 +88,21 @@ namespace client {
         /// both the handler container and the interface tree.
         void m_removeCallbacksOnPath(std::string const &path);
 
-        /// @brief Given a JSON array of nodes representing a path tree, wipe
-        /// out existing path tree and remote handlers, build new path tree, and
-        /// set up new remote handlers for all known interfaces.
-        void m_handleReplaceTree(Json::Value const &nodes);
+        /// @brief Given a snapshot of the server's path tree (from the JSON or
+        /// binary form), update the path tree to match it, and set up new
+        /// remote handlers for the interfaces whose source changed as a
+        /// result.
+        void m_handleReplaceTree(common::PathTreeSnapshot &&snapshot);
 
-        /// @brief Calls m_connectCallbacksOnPath() for every path that has one
-        /// or more interface objects but no remote handler.
-        void m_connectNeededCallbacks();
+        /// @brief Given a JSON object describing changes to the path tree,
+        /// apply them if they apply to the version of the tree we have,
+        /// otherwise request the full tree.
+        void m_handleTreeDelta(Json::Value const &json);
+
+        /// @brief Apply node changes to the path tree, reconnecting only
+        /// those interfaces whose resolved source changed (or that have no
+        /// handler).
+        void m_applyTreeChanges(common::PathTreeDelta const &delta);
 
         /// @brief The main OSVR server host: usually localhost
         std::string m_host;
@@ -113,6 +123,20 @@ namespace client {
         /// @brief Path tree
         common::PathTree m_pathTree;
 
+        /// @brief Cache of the sources that interface paths resolve to in
+        /// m_pathTree: invalidated whenever the tree changes.
+        common::ResolvedRouteCache m_routes;
+
+        /// @brief Path tree as sent by the server (before localhost
+        /// replacement), for computing and applying changes.
+        common::PathTreeSnapshot m_treeSnapshot;
+
+        /// @brief Version of the path tree we have, if known.
+        boost::optional<common::PathTreeDelta::version_type> m_treeVersion;
+
+        /// @brief Have we asked for a full tree and not yet gotten one?
+        util::DefaultBool<false> m_requestedFullTree;
+
         /// @brief Tree parallel to path tree for holding interface objects and
         /// remote handlers.
         InterfaceTree m_interfaces;
@@ -31,13 +31,16 @@
 #include <osvr/Common/PathTreeFull.h>
 #include <osvr/Util/ChannelCountC.h>
 #include <osvr/Util/UniquePtr.h>
-#include <osvr/Common/Transform.h>
+#include <osvr/Common/CompiledTransform.h>
 #include <osvr/Common/OriginalSource.h>
 #include <osvr/Common/JSONTransformVisitor.h>
 #include "PureClientContext.h"
 #include <osvr/Client/InterfaceTree.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Common/Tracing.h>
+#include <osvr/Common/TrackerPoseBatch.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Buffer.h>
 
 // Library/third-party includes
 #include <vrpn_Tracker.h>
@@ -63,18 +66,28 @@ namespace client {
             bool reportOrientation;
         };
         VRPNTrackerHandler(vrpn_ConnectionPtr const &conn, const char *src,
-                           Options const &options, common::Transform const &t,
+                           const char *deviceName, Options const &options,
+                           common::CompiledTransform const &t,
                            boost::optional<int> sensor,
                            common::InterfaceList &ifaces)
             : m_remote(new vrpn_Tracker_Remote(src, conn.get())),
-              m_transform(t), m_interfaces(ifaces), m_opts(options),
-              m_sensor(sensor) {
+              m_conn(conn), m_transform(t), m_interfaces(ifaces),
+              m_opts(options), m_sensor(sensor) {
             m_remote->register_change_handler(this, &VRPNTrackerHandler::handle,
                                               sensor.get_value_or(-1));
+            m_poseBatchMessage = m_conn->register_message_type(
+                common::messages::TrackerPoseBatch::identifier());
+            m_sender = m_conn->register_sender(deviceName);
+            m_conn->register_handler(m_poseBatchMessage,
+                                     &VRPNTrackerHandler::handleBatch, this,
+                                     m_sender);
             OSVR_DEV_VERBOSE("Constructed a TrackerHandler for "
                              << src << " sensor " << sensor.get_value_or(-1));
         }
         virtual ~VRPNTrackerHandler() {
+            m_conn->unregister_handler(m_poseBatchMessage,
+                                       &VRPNTrackerHandler::handleBatch, this,
+                                       m_sender);
             m_remote->unregister_change_handler(
                 this, &VRPNTrackerHandler::handle, m_sensor.get_value_or(-1));
         }
@@ -85,20 +98,51 @@ namespace client {
             auto self = static_cast<VRPNTrackerHandler *>(userdata);
             self->m_handle(info);
         }
+        static int VRPN_CALLBACK handleBatch(void *userdata,
+                                             vrpn_HANDLERPARAM p) {
+            auto self = static_cast<VRPNTrackerHandler *>(userdata);
+            self->m_handleBatch(p);
+            return 0;
+        }
         virtual void update() { m_remote->mainloop(); }
 
       private:
         void m_handle(vrpn_TRACKERCB const &info) {
             common::tracing::markNewTrackerData();
-            OSVR_PoseReport report;
-            report.sensor = info.sensor;
             OSVR_TimeValue timestamp;
             osvrStructTimevalToTimeValue(&timestamp, &(info.msg_time));
-            osvrQuatFromQuatlib(&(report.pose.rotation), info.quat);
-            osvrVec3FromQuatlib(&(report.pose.translation), info.pos);
-            Eigen::Matrix4d pose =
-                m_transform.transform(util::fromPose(report.pose).matrix());
-            util::toPose(pose, report.pose);
+            OSVR_PoseState pose;
+            osvrQuatFromQuatlib(&(pose.rotation), info.quat);
+            osvrVec3FromQuatlib(&(pose.translation), info.pos);
+            m_report(info.sensor, pose, timestamp);
+        }
+
+        /// @brief Decodes a whole batch of poses in one pass, then reports
+        /// the ones this handler is interested in.
+        void m_handleBatch(vrpn_HANDLERPARAM const &p) {
+            common::tracing::markNewTrackerData();
+            auto bufReader =
+                common::readExternalBuffer(p.buffer, p.payload_len);
+            common::messages::TrackerPoseBatch::MessageSerialization msg(
+                m_poses);
+            common::deserialize(bufReader, msg);
+            OSVR_TimeValue timestamp;
+            osvrStructTimevalToTimeValue(&timestamp, &(p.msg_time));
+            for (auto const &entry : m_poses) {
+                auto sensor = static_cast<int32_t>(entry.sensor);
+                if (m_sensor && *m_sensor != sensor) {
+                    continue;
+                }
+                m_report(sensor, entry.pose, timestamp);
+            }
+        }
+
+        void m_report(int32_t sensor, OSVR_PoseState const &pose,
+                      OSVR_TimeValue const &timestamp) {
+            OSVR_PoseReport report;
+            report.sensor = sensor;
+            report.pose = pose;
+            m_transform.apply(report.pose);
 
             if (m_opts.reportPose) {
                 for (auto &iface : m_interfaces) {
@@ -108,7 +152,7 @@ namespace client {
 
             if (m_opts.reportPosition) {
                 OSVR_PositionReport positionReport;
-                positionReport.sensor = info.sensor;
+                positionReport.sensor = sensor;
                 positionReport.xyz = report.pose.translation;
                 for (auto &iface : m_interfaces) {
                     iface->triggerCallbacks(timestamp, positionReport);
@@ -117,7 +161,7 @@ namespace client {
 
             if (m_opts.reportOrientation) {
                 OSVR_OrientationReport oriReport;
-                oriReport.sensor = info.sensor;
+                oriReport.sensor = sensor;
                 oriReport.rotation = report.pose.rotation;
 
                 for (auto &iface : m_interfaces) {
@@ -126,7 +170,12 @@ namespace client {
             }
         }
         unique_ptr<vrpn_Tracker_Remote> m_remote;
-        common::Transform m_transform;
+        vrpn_ConnectionPtr m_conn;
+        vrpn_int32 m_poseBatchMessage;
+        vrpn_int32 m_sender;
+        /// @brief Reused between batches to avoid reallocating.
+        common::SensorPoseList m_poses;
+        common::CompiledTransform m_transform;
         common::InterfaceList &m_interfaces;
         Options m_opts;
         boost::optional<int> m_sensor;
@@ -160,16 +209,17 @@ namespace client {
 
         auto const &devElt = source.getDeviceElement();
 
-        common::Transform xform{};
+        common::CompiledTransform xform;
         if (source.hasTransform()) {
             common::JSONTransformVisitor xformParse(source.getTransformJson());
-            xform = xformParse.getTransform();
+            xform = common::CompiledTransform(xformParse.getTransform());
         }
 
         /// @todo find out why make_shared causes a crash here
         ret.reset(new VRPNTrackerHandler(
             m_conns.getConnection(devElt), devElt.getFullDeviceName().c_str(),
-            opts, xform, source.getSensorNumber(), ifaces));
+            devElt.getDeviceName().c_str(), opts, xform,
+            source.getSensorNumber(), ifaces));
         return ret;
     }
 
@@ -36,12 +36,17 @@
 namespace osvr {
 namespace client {
     Viewer::Viewer(OSVR_ClientContext ctx, const char path[])
-        : m_head(ctx, path) {}
+        : m_head(ctx, path) {
+        m_head->setPoseHistoryCapacity(common::PoseHistory::DEFAULT_CAPACITY);
+    }
 
     OSVR_Pose3 Viewer::getPose() const {
         OSVR_TimeValue timestamp;
         OSVR_Pose3 pose;
-        bool hasState = m_head->getState<OSVR_PoseReport>(timestamp, pose);
+        bool hasState = m_poseTime && m_head->getPoseAt(*m_poseTime, pose);
+        if (!hasState) {
+            hasState = m_head->getState<OSVR_PoseReport>(timestamp, pose);
+        }
         if (!hasState) {
             throw NoPoseYet();
         }
@@ -52,5 +57,13 @@ namespace client {
         return m_head->hasStateForReportType<OSVR_PoseReport>();
     }
 
+    void
+    Viewer::setPoseTime(boost::optional<util::time::TimeValue> const &when) {
+        m_poseTime = when;
+        for (auto &eye : container()) {
+            eye.setPoseTime(when);
+        }
+    }
+
 } // namespace client
 } // namespace osvr
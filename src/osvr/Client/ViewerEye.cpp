@@ -41,7 +41,10 @@ namespace client {
     Eigen::Isometry3d ViewerEye::getPoseIsometry() const {
         OSVR_TimeValue timestamp;
         OSVR_Pose3 pose;
-        bool hasState = m_pose->getState<OSVR_PoseReport>(timestamp, pose);
+        bool hasState = m_poseTime && m_pose->getPoseAt(*m_poseTime, pose);
+        if (!hasState) {
+            hasState = m_pose->getState<OSVR_PoseReport>(timestamp, pose);
+        }
         if (!hasState) {
             throw NoPoseYet();
         }
@@ -187,7 +190,9 @@ namespace client {
         boost::optional<OSVR_RadialDistortionParameters> radDistortParams)
         : m_pose(ctx, path), m_offset(offset), m_viewport(viewport),
           m_unitBounds(unitBounds), m_rot180(rot180), m_pitchTilt(pitchTilt),
-          m_radDistortParams(radDistortParams) {}
+          m_radDistortParams(radDistortParams) {
+        m_pose->setPoseHistoryCapacity(common::PoseHistory::DEFAULT_CAPACITY);
+    }
 
 } // namespace client
 } // namespace osvr
@@ -136,6 +136,17 @@ osvrClientCheckDisplayStartup(OSVR_DisplayConfig disp) {
     return disp->cfg->isStartupComplete() ? OSVR_RETURN_SUCCESS : OSVR_RETURN_FAILURE;
 }
 
+OSVR_ReturnCode osvrClientSetDisplayPoseTime(OSVR_DisplayConfig disp,
+                                             const OSVR_TimeValue *when) {
+    OSVR_VALIDATE_DISPLAY_CONFIG;
+    if (nullptr == when) {
+        disp->cfg->setPoseTime(boost::none);
+    } else {
+        disp->cfg->setPoseTime(*when);
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrClientGetNumViewers(OSVR_DisplayConfig disp,
                                         OSVR_ViewerCount *viewers) {
     OSVR_VALIDATE_DISPLAY_CONFIG;
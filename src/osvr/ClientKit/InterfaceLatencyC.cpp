@@ -0,0 +1,101 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/ClientKit/InterfaceLatencyC.h>
+#include <osvr/Common/ClientInterface.h>
+#include <osvr/Common/InterfaceLatency.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+/// @brief Gets the histogram for a stage, or nullptr if there isn't one.
+static osvr::common::LatencyHistogram const *
+getHistogram(OSVR_ClientInterface iface, OSVR_LatencyStage stage) {
+    if (nullptr == iface) {
+        return nullptr;
+    }
+    auto latency = iface->getLatencyStatistics();
+    if (nullptr == latency) {
+        return nullptr;
+    }
+    switch (stage) {
+    case OSVR_LATENCY_STAGE_RECEIVED:
+        return &latency->get(osvr::common::LatencyStage::Received);
+    case OSVR_LATENCY_STAGE_DISPATCHED:
+        return &latency->get(osvr::common::LatencyStage::Dispatched);
+    }
+    return nullptr;
+}
+
+OSVR_ReturnCode
+osvrClientSetLatencyStatisticsEnabled(OSVR_ClientInterface iface,
+                                      OSVR_CBool enable) {
+    if (nullptr == iface) {
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->enableLatencyStatistics(enable != OSVR_FALSE);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetLatencyStatistics(OSVR_ClientInterface iface,
+                                               OSVR_LatencyStage stage,
+                                               OSVR_LatencyStatistics *stats) {
+    auto hist = getHistogram(iface, stage);
+    if (nullptr == hist || nullptr == stats) {
+        return OSVR_RETURN_FAILURE;
+    }
+    stats->count = hist->getCount();
+    stats->minimum = hist->getMin();
+    stats->mean = hist->getMean();
+    stats->median = hist->getValueAtPercentile(50);
+    stats->percentile90 = hist->getValueAtPercentile(90);
+    stats->percentile99 = hist->getValueAtPercentile(99);
+    stats->percentile999 = hist->getValueAtPercentile(99.9);
+    stats->maximum = hist->getMax();
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientGetLatencyPercentile(OSVR_ClientInterface iface,
+                                               OSVR_LatencyStage stage,
+                                               double percentile,
+                                               uint64_t *microseconds) {
+    auto hist = getHistogram(iface, stage);
+    if (nullptr == hist || nullptr == microseconds) {
+        return OSVR_RETURN_FAILURE;
+    }
+    *microseconds = hist->getValueAtPercentile(percentile);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrClientResetLatencyStatistics(OSVR_ClientInterface iface) {
+    if (nullptr == iface || nullptr == iface->getLatencyStatistics()) {
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->getLatencyStatistics()->reset();
+    return OSVR_RETURN_SUCCESS;
+}
@@ -53,3 +53,22 @@ OSVR_CALLBACK_METHODS(EyeTracker3D)
 OSVR_CALLBACK_METHODS(EyeTrackerBlink)
 
 #undef OSVR_CALLBACK_METHODS
+
+OSVR_ReturnCode osvrClientSetPoseHistoryCapacity(OSVR_ClientInterface iface,
+                                                 uint32_t capacity) {
+    if (nullptr == iface) {
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->setPoseHistoryCapacity(capacity);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrGetPoseStateAtTime(OSVR_ClientInterface iface,
+                                       const struct OSVR_TimeValue *when,
+                                       OSVR_PoseState *state) {
+    if (nullptr == iface || nullptr == when || nullptr == state) {
+        return OSVR_RETURN_FAILURE;
+    }
+    return iface->getPoseAt(*when, *state) ? OSVR_RETURN_SUCCESS
+                                           : OSVR_RETURN_FAILURE;
+}
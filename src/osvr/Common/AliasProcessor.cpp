@@ -60,17 +60,15 @@ namespace common {
             auto startingPath = pathWithWildcard;
             boost::algorithm::erase_tail(startingPath, WILDCARD_SUFFIX_LEN);
             auto &startingNode = treePathRetrieve(node, startingPath);
-            auto absoluteStartingPath = getFullPath(startingNode);
-            auto absoluteStartingPathLen = absoluteStartingPath.length();
+            auto absoluteStartingPathLen = getFullPath(startingNode).length();
             util::traverseWith(startingNode, [&](PathNode &node) {
                 // Don't visit null nodes
                 if (elements::isNull(node.value())) {
                     return;
                 }
-                auto visitPath = getFullPath(node);
                 /// This is relative to the initial starting path stem: where we
                 /// started the traversal.
-                auto relPath = visitPath;
+                auto relPath = getFullPath(node);
                 boost::algorithm::erase_head(relPath,
                                              absoluteStartingPathLen + 1);
                 functor(node, relPath);
@@ -151,8 +149,7 @@ namespace common {
                 }
                 if (!doesPathContainWildcard(leaf)) {
                     /// Handle the simple ones first.
-                    m_processSingleEntry(path, parsedSource.getAlias(),
-                                         priority);
+                    m_processSingleEntry(path, parsedSource, priority);
                     return;
                 }
 
@@ -167,9 +164,10 @@ namespace common {
                     applyWildcard(
                         m_devNode, leaf,
                         [&](PathNode &node, std::string const &relPath) {
-                            m_processSingleEntry(path + getPathSeparator() +
-                                                     relPath,
-                                                 getFullPath(node), priority);
+                            m_processSingleEntry(
+                                path + getPathSeparator() + relPath,
+                                ParsedAlias(Json::Value(getFullPath(node))),
+                                priority);
                         });
                     return;
                 }
@@ -178,14 +176,14 @@ namespace common {
                                                    std::string const &relPath) {
                     parsedSource.setLeaf(getFullPath(node));
                     m_processSingleEntry(path + getPathSeparator() + relPath,
-                                         parsedSource.getAlias(), priority);
+                                         parsedSource, priority);
                 });
             }
 
             /// @brief Called for each individual alias path to be processed for
             /// (and potentially added to/updated in) the path tree.
             void m_processSingleEntry(std::string const &path,
-                                      std::string const &source,
+                                      ParsedAlias const &source,
                                       AliasPriority priority) {
                 m_flag += addAliasFromSourceAndRelativeDest(m_devNode, source,
                                                             path, priority);
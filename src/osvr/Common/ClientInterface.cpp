@@ -44,3 +44,19 @@ std::string const &OSVR_ClientInterfaceObject::getPath() const {
 }
 
 void OSVR_ClientInterfaceObject::update() {}
+
+void OSVR_ClientInterfaceObject::enableLatencyStatistics(bool enable) {
+    if (enable) {
+        m_latency.reset(new osvr::common::InterfaceLatency);
+    } else {
+        m_latency.reset();
+    }
+}
+
+void OSVR_ClientInterfaceObject::setPoseHistoryCapacity(std::size_t capacity) {
+    if (0 == capacity) {
+        m_poseHistory.reset();
+    } else if (!m_poseHistory || m_poseHistory->capacity() != capacity) {
+        m_poseHistory.reset(new osvr::common::PoseHistory(capacity));
+    }
+}
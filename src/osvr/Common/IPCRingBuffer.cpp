@@ -26,6 +26,7 @@
 #include <osvr/Common/IPCRingBuffer.h>
 #include "IPCRingBufferResults.h"
 #include "IPCRingBufferSharedObjects.h"
+#include "IPCRingBufferSeqlock.h"
 #include "SharedMemory.h"
 #include "SharedMemoryObjectWithMutex.h"
 #include <osvr/Util/ImagingReportTypesC.h>
@@ -35,6 +36,7 @@
 #include <boost/version.hpp>
 
 // Standard includes
+#include <cstring>
 #include <stdexcept>
 #include <utility>
 #include <type_traits>
@@ -49,6 +51,12 @@ namespace common {
     /// that would interfere with communication.
     static IPCRingBuffer::abi_level_type SHM_SOURCE_ABI_LEVEL = 0;
 
+    /// @brief the ABI level of the seqlock-synchronized layout
+    /// (SeqlockBookkeeping, SeqlockElementData): same rules as above, but kept
+    /// in a separate range so the two can never be confused.
+    static IPCRingBuffer::abi_level_type SHM_SEQLOCK_SOURCE_ABI_LEVEL =
+        0x00010000;
+
 /// Some tests that can be automated for ensuring validity of the ABI level
 /// number.
 #if (BOOST_VERSION > 105800)
@@ -98,33 +106,36 @@ namespace common {
 
     namespace {
 
+        template <typename BookkeepingType>
         static size_t computeRequiredSpace(IPCRingBuffer::Options const &opts) {
             size_t alignedEntrySize = opts.getEntrySize() + opts.getAlignment();
             size_t dataSize = alignedEntrySize * (opts.getEntries() + 1);
             // Give 33% overhead on the raw bookkeeping data
             static const size_t BOOKKEEPING_SIZE =
-                (sizeof(detail::Bookkeeping) +
-                 (sizeof(detail::ElementData) * opts.getEntries())) *
+                (sizeof(BookkeepingType) +
+                 (sizeof(typename BookkeepingType::element_type) *
+                  opts.getEntries())) *
                 4 / 3;
             return dataSize + BOOKKEEPING_SIZE;
         }
 
-        class SharedMemorySegmentHolder {
+        template <typename BookkeepingType> class SharedMemorySegmentHolder {
           public:
             SharedMemorySegmentHolder() : m_bookkeeping(nullptr) {}
             virtual ~SharedMemorySegmentHolder(){};
 
-            detail::Bookkeeping *getBookkeeping() { return m_bookkeeping; }
+            BookkeepingType *getBookkeeping() { return m_bookkeeping; }
 
             virtual uint64_t getSize() const = 0;
             virtual uint64_t getFreeMemory() const = 0;
 
           protected:
-            detail::Bookkeeping *m_bookkeeping;
+            BookkeepingType *m_bookkeeping;
         };
 
-        template <typename ManagedMemory>
-        class SegmentHolderBase : public SharedMemorySegmentHolder {
+        template <typename ManagedMemory, typename BookkeepingType>
+        class SegmentHolderBase
+            : public SharedMemorySegmentHolder<BookkeepingType> {
           public:
             typedef ManagedMemory managed_memory_type;
 
@@ -136,36 +147,39 @@ namespace common {
           protected:
             unique_ptr<managed_memory_type> m_shm;
         };
-        template <typename ManagedMemory>
+        template <typename ManagedMemory, typename BookkeepingType>
         class ServerSharedMemorySegmentHolder
-            : public SegmentHolderBase<ManagedMemory> {
+            : public SegmentHolderBase<ManagedMemory, BookkeepingType> {
           public:
-            typedef SegmentHolderBase<ManagedMemory> Base;
+            typedef SegmentHolderBase<ManagedMemory, BookkeepingType> Base;
             ServerSharedMemorySegmentHolder(IPCRingBuffer::Options const &opts)
                 : m_name(opts.getName()) {
-                OSVR_SHM_VERBOSE("Creating segment, name "
-                                 << opts.getName() << ", size "
-                                 << computeRequiredSpace(opts));
+                OSVR_SHM_VERBOSE(
+                    "Creating segment, name "
+                    << opts.getName() << ", size "
+                    << computeRequiredSpace<BookkeepingType>(opts));
                 try {
                     removeSharedMemory();
                     /// @todo Some shared memory types (specifically, Windows),
                     /// don't have a remove, so we should re-open.
                     Base::m_shm.reset(new ManagedMemory(
                         bip::create_only, opts.getName().c_str(),
-                        computeRequiredSpace(opts)));
+                        computeRequiredSpace<BookkeepingType>(opts)));
                 } catch (bip::interprocess_exception &e) {
                     OSVR_SHM_VERBOSE("Failed to create shared memory segment "
                                      << opts.getName()
                                      << " with exception: " << e.what());
                     return;
                 }
-                // detail::Bookkeeping::destroy(*Base::m_shm);
+                // BookkeepingType::destroy(*Base::m_shm);
                 Base::m_bookkeeping =
-                    detail::Bookkeeping::construct(*Base::m_shm, opts);
+                    BookkeepingType::construct(*Base::m_shm, opts);
             }
 
             virtual ~ServerSharedMemorySegmentHolder() {
-                detail::Bookkeeping::destroy(*Base::m_shm);
+                if (Base::m_shm) {
+                    BookkeepingType::destroy(*Base::m_shm);
+                }
                 removeSharedMemory();
             }
 
@@ -177,11 +191,11 @@ namespace common {
             std::string m_name;
         };
 
-        template <typename ManagedMemory>
+        template <typename ManagedMemory, typename BookkeepingType>
         class ClientSharedMemorySegmentHolder
-            : public SegmentHolderBase<ManagedMemory> {
+            : public SegmentHolderBase<ManagedMemory, BookkeepingType> {
           public:
-            typedef SegmentHolderBase<ManagedMemory> Base;
+            typedef SegmentHolderBase<ManagedMemory, BookkeepingType> Base;
             ClientSharedMemorySegmentHolder(
                 IPCRingBuffer::Options const &opts) {
                 OSVR_SHM_VERBOSE("Finding segment, name " << opts.getName());
@@ -194,7 +208,7 @@ namespace common {
                                      << " with exception: " << e.what());
                     return;
                 }
-                Base::m_bookkeeping = detail::Bookkeeping::find(*Base::m_shm);
+                Base::m_bookkeeping = BookkeepingType::find(*Base::m_shm);
             }
 
             virtual ~ClientSharedMemorySegmentHolder() {}
@@ -203,17 +217,17 @@ namespace common {
         };
 
         /// @brief Factory function for constructing a memory segment holder.
-        template <typename ManagedMemory>
-        inline unique_ptr<SharedMemorySegmentHolder>
+        template <typename ManagedMemory, typename BookkeepingType>
+        inline unique_ptr<SharedMemorySegmentHolder<BookkeepingType> >
         constructMemorySegment(IPCRingBuffer::Options const &opts,
                                bool doCreate) {
-            unique_ptr<SharedMemorySegmentHolder> ret;
+            unique_ptr<SharedMemorySegmentHolder<BookkeepingType> > ret;
             if (doCreate) {
-                ret.reset(
-                    new ServerSharedMemorySegmentHolder<ManagedMemory>(opts));
+                ret.reset(new ServerSharedMemorySegmentHolder<
+                    ManagedMemory, BookkeepingType>(opts));
             } else {
-                ret.reset(
-                    new ClientSharedMemorySegmentHolder<ManagedMemory>(opts));
+                ret.reset(new ClientSharedMemorySegmentHolder<
+                    ManagedMemory, BookkeepingType>(opts));
             }
             if (nullptr == ret->getBookkeeping()) {
                 ret.reset();
@@ -223,6 +237,183 @@ namespace common {
             }
             return ret;
         }
+
+        /// @brief Factory function for constructing a memory segment holder
+        /// using the shared memory backend requested in the options.
+        template <typename BookkeepingType>
+        inline unique_ptr<SharedMemorySegmentHolder<BookkeepingType> >
+        constructMemorySegmentForBackend(IPCRingBuffer::Options const &opts,
+                                         bool doCreate) {
+            unique_ptr<SharedMemorySegmentHolder<BookkeepingType> > ret;
+            switch (opts.getBackend()) {
+
+            case ipc::BASIC_MANAGED_SHM_ID:
+                ret = constructMemorySegment<ipc::basic_managed_shm,
+                                             BookkeepingType>(opts, doCreate);
+                break;
+
+#ifdef OSVR_HAVE_WINDOWS_SHM
+            case ipc::WINDOWS_MANAGED_SHM_ID:
+                ret = constructMemorySegment<ipc::windows_managed_shm,
+                                             BookkeepingType>(opts, doCreate);
+                break;
+#endif
+
+#ifdef OSVR_HAVE_XSI_SHM
+            case ipc::SYSV_MANAGED_SHM_ID:
+                ret = constructMemorySegment<ipc::sysv_managed_shm,
+                                             BookkeepingType>(opts, doCreate);
+                break;
+#endif
+
+            default:
+                OSVR_SHM_VERBOSE(
+                    "Unsupported/unrecognized shared memory backend: "
+                    << int(opts.getBackend()));
+                break;
+            }
+            return ret;
+        }
+
+        /// @brief Interface to the operations that differ between
+        /// synchronization schemes.
+        class RingBufferAccess {
+          public:
+            virtual ~RingBufferAccess() {}
+            virtual uint16_t getCapacity() = 0;
+            virtual uint32_t getBufferLength() = 0;
+            virtual detail::IPCPutResultPtr put() = 0;
+            virtual detail::IPCGetResultPtr get(sequence_type num) = 0;
+            virtual detail::IPCGetResultPtr getLatest() = 0;
+            virtual bool copy(sequence_type num,
+                              IPCRingBuffer::pointer_type dest) = 0;
+        };
+
+        /// @brief Access using interprocess mutexes on the bookkeeping and
+        /// each element.
+        class MutexRingBufferAccess : public RingBufferAccess {
+          public:
+            typedef detail::Bookkeeping bookkeeping_type;
+            MutexRingBufferAccess(
+                unique_ptr<SharedMemorySegmentHolder<bookkeeping_type> > &&
+                    segment)
+                : m_seg(std::move(segment)),
+                  m_bookkeeping(m_seg->getBookkeeping()) {}
+
+            virtual uint16_t getCapacity() {
+                return m_bookkeeping->getCapacity();
+            }
+
+            virtual uint32_t getBufferLength() {
+                return m_bookkeeping->getBufferLength();
+            }
+
+            virtual detail::IPCPutResultPtr put() {
+                return m_bookkeeping->produceElement();
+            }
+
+            virtual detail::IPCGetResultPtr get(sequence_type num) {
+                detail::IPCGetResultPtr ret;
+                auto boundsLock = m_bookkeeping->getSharableLock();
+                auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
+                if (nullptr != elt) {
+                    auto readerLock = elt->getSharableLock();
+                    auto buf = elt->getBuf(readerLock);
+                    /// The shared memory pointer will be filled in by the
+                    /// main object.
+                    ret.reset(new detail::IPCMutexGetResult(
+                        buf, std::move(readerLock), num));
+                }
+                return ret;
+            }
+
+            virtual detail::IPCGetResultPtr getLatest() {
+                detail::IPCGetResultPtr ret;
+                auto boundsLock = m_bookkeeping->getSharableLock();
+                auto elt = m_bookkeeping->back(boundsLock);
+                if (nullptr != elt) {
+                    auto readerLock = elt->getSharableLock();
+                    auto buf = elt->getBuf(readerLock);
+                    /// The shared memory pointer will be filled in by the
+                    /// main object.
+                    ret.reset(new detail::IPCMutexGetResult(
+                        buf, std::move(readerLock),
+                        m_bookkeeping->backSequenceNumber(boundsLock)));
+                }
+                return ret;
+            }
+
+            virtual bool copy(sequence_type num,
+                              IPCRingBuffer::pointer_type dest) {
+                auto boundsLock = m_bookkeeping->getSharableLock();
+                auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
+                if (nullptr == elt) {
+                    return false;
+                }
+                auto readerLock = elt->getSharableLock();
+                std::memcpy(dest, elt->getBuf(readerLock),
+                            m_bookkeeping->getBufferLength());
+                return true;
+            }
+
+          private:
+            unique_ptr<SharedMemorySegmentHolder<bookkeeping_type> > m_seg;
+            bookkeeping_type *m_bookkeeping;
+        };
+
+        /// @brief Access using per-element generation counters: no locks.
+        class SeqlockRingBufferAccess : public RingBufferAccess {
+          public:
+            typedef detail::SeqlockBookkeeping bookkeeping_type;
+            SeqlockRingBufferAccess(
+                unique_ptr<SharedMemorySegmentHolder<bookkeeping_type> > &&
+                    segment)
+                : m_seg(std::move(segment)),
+                  m_bookkeeping(m_seg->getBookkeeping()) {}
+
+            virtual uint16_t getCapacity() {
+                return m_bookkeeping->getCapacity();
+            }
+
+            virtual uint32_t getBufferLength() {
+                return m_bookkeeping->getBufferLength();
+            }
+
+            virtual detail::IPCPutResultPtr put() {
+                return m_bookkeeping->produceElement();
+            }
+
+            virtual detail::IPCGetResultPtr get(sequence_type num) {
+                return m_bookkeeping->consumeElement(num);
+            }
+
+            virtual detail::IPCGetResultPtr getLatest() {
+                return m_bookkeeping->consumeLatest();
+            }
+
+            virtual bool copy(sequence_type num,
+                              IPCRingBuffer::pointer_type dest) {
+                return m_bookkeeping->copyElement(num, dest);
+            }
+
+          private:
+            unique_ptr<SharedMemorySegmentHolder<bookkeeping_type> > m_seg;
+            bookkeeping_type *m_bookkeeping;
+        };
+
+        /// @brief Factory function for the access object of a given
+        /// synchronization scheme, creating or finding the segment.
+        template <typename AccessType>
+        inline unique_ptr<RingBufferAccess>
+        constructAccess(IPCRingBuffer::Options const &opts, bool doCreate) {
+            unique_ptr<RingBufferAccess> ret;
+            auto segment = constructMemorySegmentForBackend<
+                typename AccessType::bookkeeping_type>(opts, doCreate);
+            if (segment) {
+                ret.reset(new AccessType(std::move(segment)));
+            }
+            return ret;
+        }
     } // namespace
 
     IPCRingBuffer::BufferWriteProxy::BufferWriteProxy(
@@ -235,6 +426,15 @@ namespace common {
         }
     }
 
+    void IPCRingBuffer::BufferWriteProxy::cancel() {
+        if (m_data) {
+            m_data->cancel();
+            m_data.reset();
+        }
+        m_buf = nullptr;
+        m_seq = 0;
+    }
+
     IPCRingBuffer::BufferReadProxy::BufferReadProxy(
         detail::IPCGetResultPtr &&data, IPCRingBufferPtr &&shm)
         : m_buf(nullptr), m_seq(0), m_data(std::move(data)) {
@@ -285,54 +485,37 @@ namespace common {
         m_entrySize = entrySize;
         return *this;
     }
+
+    IPCRingBuffer::Options &
+    IPCRingBuffer::Options::setSynchronization(Synchronization sync) {
+        m_sync = sync;
+        return *this;
+    }
+
     class IPCRingBuffer::Impl {
       public:
-        Impl(unique_ptr<SharedMemorySegmentHolder> &&segment,
-             Options const &opts)
-            : m_seg(std::move(segment)), m_bookkeeping(nullptr), m_opts(opts) {
-            m_bookkeeping = m_seg->getBookkeeping();
-            m_opts.setEntries(m_bookkeeping->getCapacity());
-            m_opts.setEntrySize(m_bookkeeping->getBufferLength());
+        Impl(unique_ptr<RingBufferAccess> &&access, Options const &opts)
+            : m_access(std::move(access)), m_opts(opts) {
+            m_opts.setEntries(m_access->getCapacity());
+            m_opts.setEntrySize(m_access->getBufferLength());
         }
 
-        detail::IPCPutResultPtr put() {
-            return m_bookkeeping->produceElement();
-        }
+        detail::IPCPutResultPtr put() { return m_access->put(); }
 
         detail::IPCGetResultPtr get(sequence_type num) {
-            detail::IPCGetResultPtr ret;
-            auto boundsLock = m_bookkeeping->getSharableLock();
-            auto elt = m_bookkeeping->getBySequenceNumber(num, boundsLock);
-            if (nullptr != elt) {
-                auto readerLock = elt->getSharableLock();
-                auto buf = elt->getBuf(readerLock);
-                /// The nullptr will be filled in by the main object.
-                ret.reset(new detail::IPCGetResult{buf, std::move(readerLock),
-                                                   num, nullptr});
-            }
-            return ret;
+            return m_access->get(num);
         }
 
-        detail::IPCGetResultPtr getLatest() {
-            detail::IPCGetResultPtr ret;
-            auto boundsLock = m_bookkeeping->getSharableLock();
-            auto elt = m_bookkeeping->back(boundsLock);
-            if (nullptr != elt) {
-                auto readerLock = elt->getSharableLock();
-                auto buf = elt->getBuf(readerLock);
-                /// The nullptr will be filled in by the main object.
-                ret.reset(new detail::IPCGetResult{
-                    buf, std::move(readerLock),
-                    m_bookkeeping->backSequenceNumber(boundsLock), nullptr});
-            }
-            return ret;
+        detail::IPCGetResultPtr getLatest() { return m_access->getLatest(); }
+
+        bool copy(sequence_type num, pointer_type dest) {
+            return m_access->copy(num, dest);
         }
 
         Options const &getOpts() const { return m_opts; }
 
       private:
-        unique_ptr<SharedMemorySegmentHolder> m_seg;
-        detail::Bookkeeping *m_bookkeeping;
+        unique_ptr<RingBufferAccess> m_access;
 
         Options m_opts;
     };
@@ -341,39 +524,25 @@ namespace common {
                                                         bool doCreate) {
 
         IPCRingBufferPtr ret;
-        unique_ptr<SharedMemorySegmentHolder> segment;
-
-        switch (opts.getBackend()) {
+        unique_ptr<RingBufferAccess> access;
 
-        case ipc::BASIC_MANAGED_SHM_ID:
-            segment =
-                constructMemorySegment<ipc::basic_managed_shm>(opts, doCreate);
-            break;
-
-#ifdef OSVR_HAVE_WINDOWS_SHM
-        case ipc::WINDOWS_MANAGED_SHM_ID:
-            segment = constructMemorySegment<ipc::windows_managed_shm>(
-                opts, doCreate);
+        switch (opts.getSynchronization()) {
+        case Synchronization::Mutex:
+            access = constructAccess<MutexRingBufferAccess>(opts, doCreate);
             break;
-#endif
-
-#ifdef OSVR_HAVE_XSI_SHM
-        case ipc::SYSV_MANAGED_SHM_ID:
-            segment =
-                constructMemorySegment<ipc::sysv_managed_shm>(opts, doCreate);
+        case Synchronization::Seqlock:
+            access = constructAccess<SeqlockRingBufferAccess>(opts, doCreate);
             break;
-#endif
-
         default:
-            OSVR_SHM_VERBOSE("Unsupported/unrecognized shared memory backend: "
-                             << int(opts.getBackend()));
+            OSVR_SHM_VERBOSE("Unrecognized synchronization scheme: "
+                             << int(opts.getSynchronization()));
             break;
         }
 
-        if (!segment) {
+        if (!access) {
             return ret;
         }
-        unique_ptr<Impl> impl(new Impl(std::move(segment), opts));
+        unique_ptr<Impl> impl(new Impl(std::move(access), opts));
         ret.reset(new IPCRingBuffer(std::move(impl)));
         return ret;
     }
@@ -382,6 +551,12 @@ namespace common {
         return SHM_SOURCE_ABI_LEVEL;
     }
 
+    IPCRingBuffer::abi_level_type
+    IPCRingBuffer::getABILevel(Synchronization sync) {
+        return sync == Synchronization::Seqlock ? SHM_SEQLOCK_SOURCE_ABI_LEVEL
+                                                : SHM_SOURCE_ABI_LEVEL;
+    }
+
     IPCRingBufferPtr IPCRingBuffer::create(Options const &opts) {
         return m_constructorHelper(opts, true);
     }
@@ -398,6 +573,10 @@ namespace common {
         return m_impl->getOpts().getBackend();
     }
 
+    IPCRingBuffer::Synchronization IPCRingBuffer::getSynchronization() const {
+        return m_impl->getOpts().getSynchronization();
+    }
+
     std::string const &IPCRingBuffer::getName() const {
         return m_impl->getOpts().getName();
     }
@@ -429,5 +608,9 @@ namespace common {
         return BufferReadProxy(m_impl->getLatest(), shared_from_this());
     }
 
+    bool IPCRingBuffer::copy(sequence_type num, pointer_type dest) {
+        return m_impl->copy(num, dest);
+    }
+
 } // namespace common
 } // namespace osvr
@@ -34,14 +34,52 @@
 // - none
 
 // Standard includes
-// - none
+#include <utility>
 
 namespace osvr {
 namespace common {
 
     namespace detail {
+        class Bookkeeping;
+
+        /// @brief Base of the objects kept alive by a BufferWriteProxy: the
+        /// derived type holds whatever keeps the entry reserved for writing,
+        /// and releases it on destruction.
         struct IPCPutResult {
-            ~IPCPutResult() {
+            IPCPutResult(IPCRingBuffer::value_type *buf,
+                         IPCRingBuffer::sequence_type sequence)
+                : buffer(buf), seq(sequence) {}
+            virtual ~IPCPutResult() {}
+            /// @brief Give the entry back unpublished, before destruction.
+            virtual void cancel() = 0;
+            IPCRingBuffer::value_type *buffer;
+            IPCRingBuffer::sequence_type seq;
+            IPCRingBufferPtr shm;
+        };
+
+        /// @brief Base of the objects kept alive by a BufferReadProxy (and
+        /// the smart pointers it hands out).
+        struct IPCGetResult {
+            IPCGetResult(IPCRingBuffer::value_type *buf,
+                         IPCRingBuffer::sequence_type sequence)
+                : buffer(buf), seq(sequence) {}
+            virtual ~IPCGetResult() {}
+            IPCRingBuffer::value_type *buffer;
+            IPCRingBuffer::sequence_type seq;
+            IPCRingBufferPtr shm;
+        };
+
+        /// @brief Put result for the mutex-synchronized ring buffer: holds
+        /// exclusive locks on the bookkeeping and the element.
+        struct IPCMutexPutResult : IPCPutResult {
+            IPCMutexPutResult(IPCRingBuffer::value_type *buf,
+                              IPCRingBuffer::sequence_type sequence,
+                              ipc::exclusive_lock_type &&element,
+                              ipc::exclusive_lock_type &&bounds,
+                              Bookkeeping &bk)
+                : IPCPutResult(buf, sequence), elementLock(std::move(element)),
+                  boundsLock(std::move(bounds)), bookkeeping(bk) {}
+            virtual ~IPCMutexPutResult() {
 #ifdef OSVR_SHM_LOCK_DEBUGGING
                 OSVR_DEV_VERBOSE("Releasing exclusive lock on sequence "
                                  << seq);
@@ -49,25 +87,27 @@ namespace common {
                 elementLock.unlock();
                 boundsLock.unlock();
             }
-            IPCRingBuffer::value_type *buffer;
-            IPCRingBuffer::sequence_type seq;
+            inline virtual void cancel();
             ipc::exclusive_lock_type elementLock;
             ipc::exclusive_lock_type boundsLock;
-            IPCRingBufferPtr shm;
+            Bookkeeping &bookkeeping;
         };
 
-        struct IPCGetResult {
-
-            ~IPCGetResult() {
+        /// @brief Get result for the mutex-synchronized ring buffer: holds a
+        /// sharable lock on the element.
+        struct IPCMutexGetResult : IPCGetResult {
+            IPCMutexGetResult(IPCRingBuffer::value_type *buf,
+                              ipc::sharable_lock_type &&element,
+                              IPCRingBuffer::sequence_type sequence)
+                : IPCGetResult(buf, sequence), elementLock(std::move(element)) {
+            }
+            virtual ~IPCMutexGetResult() {
 #ifdef OSVR_SHM_LOCK_DEBUGGING
                 OSVR_DEV_VERBOSE("Releasing shared lock on sequence " << seq);
 #endif
                 elementLock.unlock();
             }
-            IPCRingBuffer::value_type *buffer;
             ipc::sharable_lock_type elementLock;
-            IPCRingBuffer::sequence_type seq;
-            IPCRingBufferPtr shm;
         };
     } // namespace detail
 
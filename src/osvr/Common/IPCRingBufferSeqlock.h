@@ -0,0 +1,336 @@
+/** @file
+    @brief Header containing the shared-memory objects and results for the
+    seqlock-synchronized IPC ring buffer.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_IPCRingBufferSeqlock_h_GUID_6F8B8AA5_FA0F_4F18_A5C7_46FC5ECA8661
+#define INCLUDED_IPCRingBufferSeqlock_h_GUID_6F8B8AA5_FA0F_4F18_A5C7_46FC5ECA8661
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+#include "IPCRingBufferResults.h"
+#include "SharedMemory.h"
+#include <osvr/Util/StdInt.h>
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace osvr {
+namespace common {
+
+    namespace detail {
+        namespace bip = boost::interprocess;
+
+        static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_BOOL_LOCK_FREE == 2,
+                      "The seqlock ring buffer places atomics in shared "
+                      "memory, so they must be always lock-free.");
+
+        /// @brief An entry in the seqlock ring buffer: the buffer itself, the
+        /// sequence number it holds, and a generation counter that is odd
+        /// while the producer is writing the entry.
+        class SeqlockElementData : boost::noncopyable {
+          public:
+            typedef IPCRingBuffer::value_type BufferType;
+            typedef IPCRingBuffer::sequence_type sequence_type;
+            typedef uint32_t generation_type;
+
+            SeqlockElementData() : m_generation(0), m_seq(0), m_buf(nullptr) {}
+
+            BufferType *getBuf() const { return m_buf.get(); }
+
+            template <typename ManagedMemory>
+            void allocateBuf(ManagedMemory &shm,
+                             IPCRingBuffer::Options const &opts) {
+                freeBuf(shm);
+                m_buf = static_cast<BufferType *>(shm.allocate_aligned(
+                    opts.getEntrySize(), opts.getAlignment()));
+            }
+
+            template <typename ManagedMemory> void freeBuf(ManagedMemory &shm) {
+                if (nullptr != m_buf) {
+                    shm.deallocate(m_buf.get());
+                }
+                m_buf = nullptr;
+            }
+
+            /// @brief Producer: mark the entry as being written with the given
+            /// sequence number.
+            void beginWrite(sequence_type seq) {
+                auto gen = m_generation.load(std::memory_order_relaxed);
+                m_generation.store(gen + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                m_seq.store(seq, std::memory_order_relaxed);
+            }
+
+            /// @brief Producer: mark the entry as complete.
+            void endWrite() {
+                auto gen = m_generation.load(std::memory_order_relaxed);
+                m_generation.store(gen + 1, std::memory_order_release);
+            }
+
+            /// @brief Reader: copy the entry, if it holds the given sequence
+            /// number and wasn't touched by the producer during the copy.
+            ///
+            /// @returns true if @p dest holds a consistent copy.
+            bool copyOut(sequence_type seq, BufferType *dest,
+                         size_t len) const {
+                auto gen = m_generation.load(std::memory_order_acquire);
+                if (gen & 0x1) {
+                    // Being written right now.
+                    return false;
+                }
+                if (m_seq.load(std::memory_order_relaxed) != seq) {
+                    return false;
+                }
+                std::memcpy(dest, m_buf.get(), len);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return m_generation.load(std::memory_order_relaxed) == gen;
+            }
+
+          private:
+            std::atomic<generation_type> m_generation;
+            std::atomic<sequence_type> m_seq;
+            ipc_offset_ptr<BufferType> m_buf;
+        };
+
+        class SeqlockBookkeeping;
+
+        /// @brief Put result for the seqlock ring buffer: publishes the entry
+        /// on destruction, unless cancelled.
+        struct IPCSeqlockPutResult : IPCPutResult {
+            IPCSeqlockPutResult(IPCRingBuffer::value_type *buf,
+                                IPCRingBuffer::sequence_type sequence,
+                                SeqlockBookkeeping &bk,
+                                SeqlockElementData &elt)
+                : IPCPutResult(buf, sequence), bookkeeping(bk), element(elt),
+                  cancelled(false) {}
+            inline virtual ~IPCSeqlockPutResult();
+            inline virtual void cancel();
+            SeqlockBookkeeping &bookkeeping;
+            SeqlockElementData &element;
+            bool cancelled;
+        };
+
+        /// @brief Get result for the seqlock ring buffer: owns a validated
+        /// private copy of the entry, so it never holds up the producer.
+        struct IPCSeqlockGetResult : IPCGetResult {
+            IPCSeqlockGetResult(
+                std::unique_ptr<IPCRingBuffer::value_type[]> &&copy,
+                IPCRingBuffer::sequence_type sequence)
+                : IPCGetResult(copy.get(), sequence), data(std::move(copy)) {}
+            std::unique_ptr<IPCRingBuffer::value_type[]> data;
+        };
+
+        /// @brief Shared-memory bookkeeping for the seqlock ring buffer.
+        ///
+        /// Only the (single) producer writes; it never waits on readers, it
+        /// just bumps the generation counter of the entry it overwrites.
+        /// Readers copy an entry out and check that its generation didn't
+        /// change meanwhile, failing the read if it did.
+        class SeqlockBookkeeping : boost::noncopyable {
+          public:
+            typedef SeqlockElementData element_type;
+            typedef IPCRingBuffer::sequence_type sequence_type;
+            typedef uint16_t raw_index_type;
+            typedef IPCRingBuffer::value_type BufferType;
+
+            template <typename ManagedMemory>
+            static SeqlockBookkeeping *find(ManagedMemory &shm) {
+                auto self =
+                    shm.template find<SeqlockBookkeeping>(bip::unique_instance);
+                return self.first;
+            }
+
+            template <typename ManagedMemory>
+            static SeqlockBookkeeping *
+            construct(ManagedMemory &shm, IPCRingBuffer::Options const &opts) {
+                return shm.template construct<SeqlockBookkeeping>(
+                    bip::unique_instance)(shm, opts);
+            }
+
+            template <typename ManagedMemory>
+            static void destroy(ManagedMemory &shm) {
+                auto self = find(shm);
+                if (nullptr == self) {
+                    return;
+                }
+                self->freeBufs(shm);
+                shm.template destroy<SeqlockBookkeeping>(bip::unique_instance);
+            }
+
+            template <typename ManagedMemory>
+            SeqlockBookkeeping(ManagedMemory &shm,
+                               IPCRingBuffer::Options const &opts)
+                : m_capacity(opts.getEntries()),
+                  elementArray(shm.template construct<SeqlockElementData>(
+                      bip::unique_instance)[m_capacity]()),
+                  m_bufLen(opts.getEntrySize()), m_nextSequenceNumber(0),
+                  m_latestSequenceNumber(0), m_anyPublished(false) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    try {
+                        getByRawIndex(i).allocateBuf(shm, opts);
+                    } catch (std::bad_alloc &) {
+                        OSVR_DEV_VERBOSE("Couldn't allocate buffer #"
+                                         << i
+                                         << ", truncating the ring buffer");
+                        m_capacity = i;
+                        break;
+                    }
+                }
+            }
+
+            template <typename ManagedMemory>
+            void freeBufs(ManagedMemory &shm) {
+                for (raw_index_type i = 0; i < m_capacity; ++i) {
+                    getByRawIndex(i).freeBuf(shm);
+                }
+                shm.template destroy<SeqlockElementData>(bip::unique_instance);
+            }
+
+            /// @brief Get number of elements.
+            raw_index_type getCapacity() const { return m_capacity; }
+
+            /// @brief Get capacity of elements.
+            uint32_t getBufferLength() const { return m_bufLen; }
+
+            /// @brief Producer: start writing the next element. Never blocks.
+            IPCPutResultPtr produceElement() {
+                auto sequenceNumber = m_nextSequenceNumber++;
+                auto &elt = getBySequenceNumber(sequenceNumber);
+                elt.beginWrite(sequenceNumber);
+                /// shared memory pointer filled in by outer class
+                IPCPutResultPtr ret(new IPCSeqlockPutResult(
+                    elt.getBuf(), sequenceNumber, *this, elt));
+                return ret;
+            }
+
+            /// @brief Producer: finish writing an element and make it the
+            /// latest.
+            void publish(SeqlockElementData &elt, sequence_type seq) {
+                elt.endWrite();
+                m_latestSequenceNumber.store(seq, std::memory_order_release);
+                m_anyPublished.store(true, std::memory_order_release);
+            }
+
+            /// @brief Producer: finish writing an element without publishing
+            /// it, so the next one reuses its sequence number. Whatever the
+            /// entry held before stays unavailable, since its sequence number
+            /// no longer matches.
+            void cancel(SeqlockElementData &elt) {
+                elt.endWrite();
+                m_nextSequenceNumber--;
+            }
+
+            /// @brief Reader: copy the element with the given sequence number
+            /// into @p dest (of getBufferLength() bytes), if it is (still)
+            /// available.
+            bool copyElement(sequence_type seq, BufferType *dest) {
+                if (!isAvailable(seq)) {
+                    return false;
+                }
+                return getBySequenceNumber(seq).copyOut(seq, dest, m_bufLen);
+            }
+
+            /// @brief Reader: get a copy of the element with the given sequence
+            /// number, if it is (still) available.
+            IPCGetResultPtr consumeElement(sequence_type seq) {
+                IPCGetResultPtr ret;
+                if (!isAvailable(seq)) {
+                    return ret;
+                }
+                std::unique_ptr<BufferType[]> copy(new BufferType[m_bufLen]);
+                if (getBySequenceNumber(seq).copyOut(seq, copy.get(),
+                                                     m_bufLen)) {
+                    ret.reset(new IPCSeqlockGetResult(std::move(copy), seq));
+                }
+                return ret;
+            }
+
+            /// @brief Reader: get a copy of the most recently published
+            /// element, retrying if the producer overwrites it while copying.
+            IPCGetResultPtr consumeLatest() {
+                IPCGetResultPtr ret;
+                for (raw_index_type attempt = 0; attempt < m_capacity && !ret;
+                     ++attempt) {
+                    if (!m_anyPublished.load(std::memory_order_acquire)) {
+                        break;
+                    }
+                    ret = consumeElement(m_latestSequenceNumber.load(
+                        std::memory_order_acquire));
+                }
+                return ret;
+            }
+
+          private:
+            /// @brief Has the element with this sequence number been
+            /// published and not yet overwritten?
+            bool isAvailable(sequence_type seq) const {
+                if (!m_anyPublished.load(std::memory_order_acquire)) {
+                    return false;
+                }
+                auto latest =
+                    m_latestSequenceNumber.load(std::memory_order_acquire);
+                // Otherwise, either already overwritten or not yet
+                // published.
+                return sequence_type(latest - seq) < m_capacity;
+            }
+
+            SeqlockElementData &getByRawIndex(raw_index_type index) {
+                return *(elementArray + (index % m_capacity));
+            }
+            SeqlockElementData &getBySequenceNumber(sequence_type num) {
+                return getByRawIndex(raw_index_type(num % m_capacity));
+            }
+
+            raw_index_type m_capacity;
+            ipc_offset_ptr<SeqlockElementData> elementArray;
+            uint32_t m_bufLen;
+            /// @brief Only touched by the producer.
+            sequence_type m_nextSequenceNumber;
+            std::atomic<sequence_type> m_latestSequenceNumber;
+            std::atomic<bool> m_anyPublished;
+        };
+
+        inline IPCSeqlockPutResult::~IPCSeqlockPutResult() {
+            if (!cancelled) {
+                bookkeeping.publish(element, seq);
+            }
+        }
+
+        inline void IPCSeqlockPutResult::cancel() {
+            bookkeeping.cancel(element);
+            cancelled = true;
+        }
+    } // namespace detail
+
+} // namespace common
+} // namespace osvr
+#endif // INCLUDED_IPCRingBufferSeqlock_h_GUID_6F8B8AA5_FA0F_4F18_A5C7_46FC5ECA8661
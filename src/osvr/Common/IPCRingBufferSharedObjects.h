@@ -78,6 +78,7 @@ namespace common {
 
         class Bookkeeping : public ipc::ObjectWithMutex, boost::noncopyable {
           public:
+            typedef ElementData element_type;
             typedef IPCRingBuffer::sequence_type sequence_type;
             typedef uint16_t raw_index_type;
 
@@ -198,13 +199,24 @@ namespace common {
                     << sequenceNumber << " aka index " << back(lock));
 #endif
                 auto elementLock = back(lock)->getExclusiveLock();
-                /// shared memory nullptr filled in by outer class
-                IPCPutResultPtr ret(new IPCPutResult{
-                    back(lock)->getBuf(elementLock), sequenceNumber,
-                    std::move(elementLock), std::move(lock), nullptr});
+                /// shared memory pointer filled in by outer class
+                auto buf = back(lock)->getBuf(elementLock);
+                IPCPutResultPtr ret(new IPCMutexPutResult(
+                    buf, sequenceNumber, std::move(elementLock),
+                    std::move(lock), *this));
                 return ret;
             }
 
+            /// @brief Take back the element from produceElement(), whose lock
+            /// is passed, without publishing it: the next one reuses its
+            /// sequence number. If it took the place of the oldest element,
+            /// that one stays dropped, since it may have been written over.
+            void cancelElement(ipc::exclusive_lock_type &lock) {
+                verifyWriterLock(lock);
+                m_nextSequenceNumber--;
+                m_size--;
+            }
+
           private:
             raw_index_type m_capacity;
             ipc_offset_ptr<ElementData> elementArray;
@@ -214,6 +226,10 @@ namespace common {
             raw_index_type m_size;
             uint32_t m_bufLen;
         };
+
+        inline void IPCMutexPutResult::cancel() {
+            bookkeeping.cancelElement(boundsLock);
+        }
     } // namespace detail
 
 } // namespace common
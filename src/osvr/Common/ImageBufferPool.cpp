@@ -0,0 +1,72 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageBufferPool.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <atomic>
+#include <memory>
+
+namespace osvr {
+namespace common {
+    struct ImageBufferPool::Entry {
+        explicit Entry(std::size_t bytes)
+            : data(new OSVR_ImageBufferElement[bytes]) {}
+        std::unique_ptr<OSVR_ImageBufferElement[]> data;
+    };
+
+    ImageBufferPool::ImageBufferPool()
+        : m_lastBucket(nullptr), m_lastBytes(0) {}
+
+    ImageBufferPtr ImageBufferPool::acquire(std::size_t bytes) {
+        if (nullptr == m_lastBucket || m_lastBytes != bytes) {
+            m_lastBucket = &m_buckets[bytes];
+            m_lastBytes = bytes;
+        }
+        auto &bucket = *m_lastBucket;
+        for (auto const &entry : bucket) {
+            if (entry.use_count() == 1) {
+                // Nobody else holds it, so nobody else can start to: make
+                // sure their last accesses happen before we reuse it.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                return ImageBufferPtr(entry, entry->data.get());
+            }
+        }
+        bucket.push_back(make_shared<Entry>(bytes));
+        return ImageBufferPtr(bucket.back(), bucket.back()->data.get());
+    }
+
+    std::size_t ImageBufferPool::size() const {
+        std::size_t ret = 0;
+        for (auto const &bucket : m_buckets) {
+            ret += bucket.second.size();
+        }
+        return ret;
+    }
+} // namespace common
+} // namespace osvr
@@ -0,0 +1,233 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageCodec.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    /// @brief Longest literal run following a single count byte.
+    static const std::size_t MAX_LITERAL = 128;
+    /// @brief Shortest run of equal bytes worth encoding as a run.
+    static const std::size_t MIN_RUN = 3;
+    /// @brief Longest run of equal bytes following a single count byte.
+    static const std::size_t MAX_RUN = MIN_RUN + 127;
+
+    /// @brief Frames a sensor may send between keyframes by default.
+    static const uint32_t DEFAULT_KEYFRAME_INTERVAL = 30;
+
+    std::size_t runLengthEncode(OSVR_ImageBufferElement const *data,
+                                std::size_t size, OSVR_ImageBufferElement *out,
+                                std::size_t capacity) {
+        std::size_t written = 0;
+        std::size_t i = 0;
+        while (i < size) {
+            std::size_t run = 1;
+            while (i + run < size && run < MAX_RUN &&
+                   data[i + run] == data[i]) {
+                ++run;
+            }
+            if (run >= MIN_RUN) {
+                if (written + 2 > capacity) {
+                    return 0;
+                }
+                out[written++] =
+                    static_cast<OSVR_ImageBufferElement>(128 + run - MIN_RUN);
+                out[written++] = data[i];
+                i += run;
+                continue;
+            }
+            // Gather literals until the next worthwhile run.
+            auto start = i;
+            while (i < size && i - start < MAX_LITERAL) {
+                if (i + 2 < size && data[i] == data[i + 1] &&
+                    data[i] == data[i + 2]) {
+                    break;
+                }
+                ++i;
+            }
+            auto literal = i - start;
+            if (written + 1 + literal > capacity) {
+                return 0;
+            }
+            out[written++] = static_cast<OSVR_ImageBufferElement>(literal - 1);
+            std::memcpy(out + written, data + start, literal);
+            written += literal;
+        }
+        return written;
+    }
+
+    bool runLengthDecode(OSVR_ImageBufferElement const *data, std::size_t size,
+                         OSVR_ImageBufferElement *out, std::size_t outSize) {
+        std::size_t in = 0;
+        std::size_t written = 0;
+        while (in < size) {
+            std::size_t count = data[in++];
+            if (count >= 128) {
+                auto run = count - 128 + MIN_RUN;
+                if (in >= size || written + run > outSize) {
+                    return false;
+                }
+                std::memset(out + written, data[in++], run);
+                written += run;
+            } else {
+                auto literal = count + 1;
+                if (in + literal > size || written + literal > outSize) {
+                    return false;
+                }
+                std::memcpy(out + written, data + in, literal);
+                in += literal;
+                written += literal;
+            }
+        }
+        return written == outSize;
+    }
+
+    ImageEncoder::ImageEncoder()
+        : m_encoding(ImageEncoding::Raw),
+          m_keyframeInterval(DEFAULT_KEYFRAME_INTERVAL) {}
+
+    void ImageEncoder::setEncoding(ImageEncoding encoding,
+                                   uint32_t keyframeInterval) {
+        m_encoding = encoding;
+        m_keyframeInterval = std::max<uint32_t>(keyframeInterval, 1);
+        m_sensors.clear();
+        m_stats = ImageCodecStats();
+    }
+
+    ImageEncodingInfo
+    ImageEncoder::encode(OSVR_ImagingMetadata const &metadata,
+                         OSVR_ImageBufferElement const *&data,
+                         OSVR_ChannelCount sensor, uint32_t frame) {
+        typedef std::chrono::steady_clock clock;
+        auto start = clock::now();
+        auto bytes = getImageBufferSize(metadata);
+        ImageEncodingInfo info = {ImageEncoding::Raw, 0, bytes};
+        if (m_encoding != ImageEncoding::Raw && bytes > 0) {
+            if (sensor >= m_sensors.size()) {
+                m_sensors.resize(sensor + 1);
+            }
+            auto &state = m_sensors[sensor];
+            bool delta = m_encoding == ImageEncoding::DeltaRunLength &&
+                         state.valid &&
+                         sameImageMetadata(metadata, state.metadata) &&
+                         state.sinceKeyframe + 1 < m_keyframeInterval;
+            auto source = data;
+            if (delta) {
+                m_delta.resize(bytes);
+                auto previous = state.previous.data();
+                for (uint32_t i = 0; i < bytes; ++i) {
+                    m_delta[i] = data[i] ^ previous[i];
+                }
+                source = m_delta.data();
+            }
+            // Only worth it if it comes out smaller.
+            m_output.resize(bytes);
+            auto size =
+                runLengthEncode(source, bytes, m_output.data(), bytes - 1);
+            if (size != 0) {
+                info.encoding = delta ? ImageEncoding::DeltaRunLength
+                                      : ImageEncoding::RunLength;
+                info.reference = delta ? state.frame : 0;
+                info.size = static_cast<uint32_t>(size);
+            }
+            if (m_encoding == ImageEncoding::DeltaRunLength) {
+                state.valid = true;
+                state.metadata = metadata;
+                state.frame = frame;
+                state.previous.assign(data, data + bytes);
+                state.sinceKeyframe =
+                    info.encoding == ImageEncoding::DeltaRunLength
+                        ? state.sinceKeyframe + 1
+                        : 0;
+            }
+            if (size != 0) {
+                data = m_output.data();
+            }
+        }
+        ++m_stats.frames;
+        if (info.encoding != ImageEncoding::DeltaRunLength) {
+            ++m_stats.keyframes;
+        }
+        m_stats.rawBytes += bytes;
+        m_stats.encodedBytes += info.size;
+        m_stats.encodeSeconds +=
+            std::chrono::duration<double>(clock::now() - start).count();
+        return info;
+    }
+
+    bool ImageDecoder::decode(uint32_t frame, ImageEncodingInfo const &info,
+                              ImageData &image) {
+        if (image.sensor >= m_references.size()) {
+            return false;
+        }
+        auto &ref = m_references[image.sensor];
+        auto bytes = getImageBufferSize(image.metadata);
+        bool delta = info.encoding == ImageEncoding::DeltaRunLength;
+        if (info.encoding == ImageEncoding::Raw) {
+            if (info.size != bytes) {
+                return false;
+            }
+        } else if (info.encoding == ImageEncoding::RunLength || delta) {
+            if (delta &&
+                (!ref.valid || ref.frame != info.reference ||
+                 !sameImageMetadata(ref.metadata, image.metadata))) {
+                // Missed the frame this one is relative to: wait for the next
+                // keyframe.
+                ref.valid = false;
+                return false;
+            }
+            auto decoded = m_pool.acquire(bytes);
+            if (!runLengthDecode(image.buffer.get(), info.size, decoded.get(),
+                                 bytes)) {
+                ref.valid = false;
+                return false;
+            }
+            if (delta) {
+                auto previous = ref.data.data();
+                auto out = decoded.get();
+                for (uint32_t i = 0; i < bytes; ++i) {
+                    out[i] ^= previous[i];
+                }
+            }
+            image.buffer = decoded;
+        } else {
+            return false;
+        }
+        ref.valid = true;
+        ref.frame = frame;
+        ref.metadata = image.metadata;
+        ref.data.assign(image.buffer.get(), image.buffer.get() + bytes);
+        return true;
+    }
+} // namespace common
+} // namespace osvr
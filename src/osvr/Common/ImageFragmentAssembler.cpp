@@ -0,0 +1,99 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageFragmentAssembler.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    static inline bool sameEncoding(ImageEncodingInfo const &a,
+                                    ImageEncodingInfo const &b) {
+        return a.encoding == b.encoding && a.reference == b.reference &&
+               a.size == b.size;
+    }
+
+    bool ImageFragmentAssembler::addFragment(
+        ImageFragmentHeader const &header, OSVR_ImageBufferElement const *data,
+        ImageData &completed) {
+        if (header.sensor >= m_frames.size()) {
+            return false;
+        }
+        auto &partial = m_frames[header.sensor];
+        if (!partial.active || partial.frame != header.frame) {
+            if (partial.active &&
+                static_cast<int32_t>(header.frame - partial.frame) < 0) {
+                // Left over from a frame we already gave up on.
+                return false;
+            }
+            // Start a new frame, dropping any incomplete one.
+            auto bytes = getImageBufferSize(header.metadata);
+            auto size = header.encoding.size;
+            if (0 == size || size > bytes ||
+                (header.encoding.encoding == ImageEncoding::Raw &&
+                 size != bytes)) {
+                partial.active = false;
+                partial.image.buffer.reset();
+                return false;
+            }
+            partial.active = true;
+            partial.frame = header.frame;
+            partial.received = 0;
+            partial.image.sensor = header.sensor;
+            partial.image.metadata = header.metadata;
+            partial.encoding = header.encoding;
+            // Release first, so an abandoned frame's buffer can be reused.
+            // Always a full-size buffer, so encoded frames of varying sizes
+            // reuse the same buffers.
+            partial.image.buffer.reset();
+            partial.image.buffer = m_pool.acquire(bytes);
+        }
+        auto total = partial.encoding.size;
+        if (!sameImageMetadata(header.metadata, partial.image.metadata) ||
+            !sameEncoding(header.encoding, partial.encoding) ||
+            header.offset != partial.received ||
+            uint64_t(header.offset) + header.length > total) {
+            // Not the next piece of this frame: give up on it.
+            partial.active = false;
+            partial.image.buffer.reset();
+            return false;
+        }
+        std::memcpy(partial.image.buffer.get() + header.offset, data,
+                    header.length);
+        partial.received += header.length;
+        if (partial.received < total) {
+            return false;
+        }
+        completed = partial.image;
+        partial.active = false;
+        partial.image.buffer.reset();
+        return true;
+    }
+} // namespace common
+} // namespace osvr
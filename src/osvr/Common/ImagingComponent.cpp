@@ -31,14 +31,21 @@
 #include <osvr/Util/Verbosity.h>
 
 // Standard includes
+#include <algorithm>
+#include <cstring>
 #include <sstream>
 #include <utility>
 
 namespace osvr {
 namespace common {
     static inline uint32_t getBufferSize(OSVR_ImagingMetadata const &meta) {
-        return meta.height * meta.width * meta.depth * meta.channels;
+        return getImageBufferSize(meta);
     }
+
+    /// @brief Image data per fragment message: with the message headers,
+    /// fits in a typical 1500-byte MTU.
+    static const uint32_t FRAGMENT_DATA_BYTES = 1300;
+
     namespace messages {
         namespace {
             template <typename T>
@@ -61,13 +68,16 @@ namespace common {
                   m_imgBuf(imageData,
                            [](OSVR_ImageBufferElement *) {
                            }), // That's a null-deleter right there for you.
-                  m_sensor(sensor) {}
+                  m_sensor(sensor), m_pool(nullptr) {}
 
-            MessageSerialization() : m_imgBuf(nullptr) {}
+            /// @brief Constructor for deserializing, into a buffer from the
+            /// pool.
+            explicit MessageSerialization(ImageBufferPool &pool)
+                : m_imgBuf(nullptr), m_sensor(0), m_pool(&pool) {}
 
             template <typename T>
             void allocateBuffer(T &, size_t bytes, std::true_type const &) {
-                m_imgBuf.reset(reinterpret_cast<OSVR_ImageBufferElement *>(malloc(bytes)));
+                m_imgBuf = m_pool->acquire(bytes);
             }
 
             template <typename T>
@@ -97,6 +107,7 @@ namespace common {
             OSVR_ImagingMetadata m_meta;
             ImageBufferPtr m_imgBuf;
             OSVR_ChannelCount m_sensor;
+            ImageBufferPool *m_pool;
         };
         const char *ImageRegion::identifier() {
             return "com.osvr.imaging.imageregion";
@@ -147,6 +158,54 @@ namespace common {
         const char *ImagePlacedInSharedMemory::identifier() {
             return "com.osvr.imaging.imageplacedinsharedmemory";
         }
+
+        class ImageFragment::MessageSerialization {
+          public:
+            /// @brief Constructor for serializing a fragment with the given
+            /// data.
+            MessageSerialization(ImageFragmentHeader const &header,
+                                 OSVR_ImageBufferElement const *data)
+                : m_header(header), m_data(data) {}
+
+            /// @brief Constructor for deserializing: only the header is read,
+            /// since the data that follows it is best copied straight into
+            /// the frame being reassembled.
+            MessageSerialization() : m_data(nullptr) {}
+
+            template <typename T> void processMessage(T &p) {
+                process(m_header.metadata, p);
+                p(m_header.sensor);
+                p(m_header.frame);
+                p(m_header.encoding.encoding,
+                  serialization::EnumAsIntegerTag<ImageEncoding, uint8_t>());
+                p(m_header.encoding.reference);
+                p(m_header.encoding.size);
+                p(m_header.offset);
+                p(m_header.length);
+                processData(p, p.isDeserialize());
+            }
+
+            ImageFragmentHeader const &getHeader() const { return m_header; }
+
+          private:
+            template <typename T>
+            void processData(T &p, std::false_type const &) {
+                p(m_data, serialization::AlignedDataBufferTag(
+                              m_header.length, m_header.metadata.depth));
+            }
+
+            template <typename T>
+            void processData(T &, std::true_type const &) {
+                // Left for the caller to read.
+            }
+
+            ImageFragmentHeader m_header;
+            OSVR_ImageBufferElement const *m_data;
+        };
+
+        const char *ImageFragment::identifier() {
+            return "com.osvr.imaging.imagefragment";
+        }
     } // namespace messages
 
     shared_ptr<ImagingComponent>
@@ -155,7 +214,30 @@ namespace common {
         return ret;
     }
     ImagingComponent::ImagingComponent(OSVR_ChannelCount numChan)
-        : m_numSensor(numChan) {}
+        : m_numSensor(numChan), m_assembler(m_bufferPool, numChan),
+          m_decoder(m_bufferPool, numChan), m_nextFragmentedFrame(0),
+          m_networkFragments(false),
+          m_shmSync(IPCRingBuffer::Synchronization::Mutex),
+          m_lastDelivered(numChan) {}
+
+    void ImagingComponent::setSharedMemorySynchronization(
+        IPCRingBuffer::Synchronization sync) {
+        m_shmSync = sync;
+    }
+
+    void ImagingComponent::setNetworkFragments(bool enable) {
+        m_networkFragments = enable;
+    }
+
+    void
+    ImagingComponent::setNetworkOptions(ImagingNetworkOptions const &opts) {
+        m_networkOptions = opts;
+    }
+
+    void ImagingComponent::setNetworkEncoding(ImageEncoding encoding,
+                                              uint32_t keyframeInterval) {
+        m_encoder.setEncoding(encoding, keyframeInterval);
+    }
 
     void ImagingComponent::sendImageData(OSVR_ImagingMetadata metadata,
                                          OSVR_ImageBufferElement *imageData,
@@ -172,14 +254,69 @@ namespace common {
         }
     }
 
+    IPCRingBuffer::BufferWriteProxy
+    ImagingComponent::reserveImageBuffer(OSVR_ImagingMetadata const &metadata,
+                                         OSVR_ChannelCount sensor) {
+        auto shm = m_getShmBuf(metadata, sensor);
+        if (!shm) {
+            return IPCRingBuffer::BufferWriteProxy();
+        }
+        return shm->put();
+    }
+
+    bool ImagingComponent::sendReservedImageData(
+        OSVR_ImagingMetadata metadata, IPCRingBuffer::BufferWriteProxy &&frame,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        m_growShmVecIfRequired(sensor);
+        auto shm = m_shmBuf[sensor];
+        if (!frame || !shm || shm->getEntrySize() != getBufferSize(metadata)) {
+            /// Empty, or not reserved with this metadata and sensor.
+            return false;
+        }
+        IPCRingBuffer::sequence_type seq = 0;
+        OSVR_ImageBufferElement *imageData = nullptr;
+        {
+            IPCRingBuffer::BufferWriteProxy entry(std::move(frame));
+            seq = entry.getSequenceNumber();
+            imageData = entry.get();
+            /// Entry released to readers at the end of this scope, before we
+            /// tell anyone about it.
+        }
+        /// Local clients take the first of the two copies of a frame they
+        /// get, so tell them about the full frame in shared memory first.
+        m_sendSharedMemoryNotice(metadata, *shm, seq, sensor, timestamp);
+        /// Pack for the network straight out of shared memory: only we write
+        /// to it, so the entry stays as it is until our next frame.
+        auto sendOnWire =
+            m_packImageDataForWire(metadata, imageData, sensor, timestamp);
+        if (sendOnWire) {
+            m_getParent().sendPending();
+        }
+        m_checkFirst(metadata);
+        return true;
+    }
+
     bool ImagingComponent::m_sendImageDataViaSharedMemory(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
         OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
 
+        auto shm = m_getShmBuf(metadata, sensor);
+        if (!shm) {
+            return false;
+        }
+        auto seq = shm->put(imageData, getBufferSize(metadata));
+        m_sendSharedMemoryNotice(metadata, *shm, seq, sensor, timestamp);
+        return true;
+    }
+
+    IPCRingBuffer *
+    ImagingComponent::m_getShmBuf(OSVR_ImagingMetadata const &metadata,
+                                  OSVR_ChannelCount sensor) {
         m_growShmVecIfRequired(sensor);
         uint32_t imageBufferSize = getBufferSize(metadata);
         if (!m_shmBuf[sensor] ||
-            m_shmBuf[sensor]->getEntrySize() != imageBufferSize) {
+            m_shmBuf[sensor]->getEntrySize() != imageBufferSize ||
+            m_shmBuf[sensor]->getSynchronization() != m_shmSync) {
             // create or replace the shared memory ring buffer.
             auto makeName =
                 [](OSVR_ChannelCount sensor, std::string const &devName) {
@@ -190,66 +327,151 @@ namespace common {
             m_shmBuf[sensor] = IPCRingBuffer::create(
                 IPCRingBuffer::Options(
                     makeName(sensor, m_getParent().getDeviceName()))
-                    .setEntrySize(imageBufferSize));
+                    .setEntrySize(imageBufferSize)
+                    .setSynchronization(m_shmSync));
         }
         if (!m_shmBuf[sensor]) {
             OSVR_DEV_VERBOSE(
                 "Some issue creating shared memory for imaging, skipping out.");
-            return false;
+            return nullptr;
         }
-        auto &shm = *(m_shmBuf[sensor]);
-        auto seq = shm.put(imageData, imageBufferSize);
+        return m_shmBuf[sensor].get();
+    }
 
+    void ImagingComponent::m_sendSharedMemoryNotice(
+        OSVR_ImagingMetadata const &metadata, IPCRingBuffer &shm,
+        IPCRingBuffer::sequence_type seq, OSVR_ChannelCount sensor,
+        OSVR_TimeValue const &timestamp) {
         Buffer<> buf;
         messages::ImagePlacedInSharedMemory::MessageSerialization serialization(
-            messages::SharedMemoryMessage{metadata, seq, sensor,
-                                          IPCRingBuffer::getABILevel(),
-                                          shm.getBackend(), shm.getName()});
+            messages::SharedMemoryMessage{
+                metadata, seq, sensor,
+                IPCRingBuffer::getABILevel(shm.getSynchronization()),
+                shm.getBackend(), shm.getName()});
         serialize(buf, serialization);
         m_getParent().packMessage(
             buf, imagePlacedInSharedMemory.getMessageType(), timestamp);
+    }
 
+    bool ImagingComponent::m_sendImageDataOnTheWire(
+        OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
+        OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
+        if (!m_packImageDataForWire(metadata, imageData, sensor, timestamp)) {
+            return false;
+        }
+        m_getParent().sendPending();
         return true;
     }
 
-    bool ImagingComponent::m_sendImageDataOnTheWire(
+    bool ImagingComponent::m_packImageDataForWire(
         OSVR_ImagingMetadata metadata, OSVR_ImageBufferElement *imageData,
         OSVR_ChannelCount sensor, OSVR_TimeValue const &timestamp) {
-        /// @todo currently only handle 8bit data over network
-        if (metadata.depth != 1) {
+        imageData = m_applyNetworkOptions(metadata, imageData);
+        if (nullptr == imageData) {
             return false;
         }
-        Buffer<> buf;
-        messages::ImageRegion::MessageSerialization msg(metadata, imageData,
-                                                        sensor);
-        serialize(buf, msg);
-        if (buf.size() > vrpn_CONNECTION_TCP_BUFLEN) {
-#if 0
-            OSVR_DEV_VERBOSE("Skipping imaging message: size is "
-                             << buf.size() << " vs the maximum of "
-                             << vrpn_CONNECTION_TCP_BUFLEN);
-#endif
+        auto bytes = getBufferSize(metadata);
+        if ((!m_networkFragments ||
+             m_encoder.getEncoding() == ImageEncoding::Raw) &&
+            bytes < vrpn_CONNECTION_TCP_BUFLEN) {
+            /// Small enough that it might fit in one message, which clients
+            /// predating fragments also understand.
+            Buffer<> buf;
+            messages::ImageRegion::MessageSerialization msg(
+                metadata, imageData, sensor);
+            serialize(buf, msg);
+            /// The sensor comes after the image, where clients that predate
+            /// it don't look.
+            serialization::serializeRaw(buf, sensor);
+            if (buf.size() <= vrpn_CONNECTION_TCP_BUFLEN) {
+                m_getParent().packMessage(buf, imageRegion.getMessageType(),
+                                          timestamp);
+                return true;
+            }
+        }
+        if (!m_networkFragments) {
+            /// Too big, and the device hasn't asked for it to be sent anyway.
             return false;
         }
-        m_getParent().packMessage(buf, imageRegion.getMessageType(), timestamp);
-        m_getParent().sendPending();
+        ImageFragmentHeader header;
+        header.metadata = metadata;
+        header.sensor = sensor;
+        header.frame = m_nextFragmentedFrame++;
+        OSVR_ImageBufferElement const *data = imageData;
+        header.encoding =
+            m_encoder.encode(metadata, data, sensor, header.frame);
+        auto size = header.encoding.size;
+        for (uint32_t offset = 0; offset < size;
+             offset += FRAGMENT_DATA_BYTES) {
+            header.offset = offset;
+            header.length = std::min(FRAGMENT_DATA_BYTES, size - offset);
+            Buffer<> buf;
+            messages::ImageFragment::MessageSerialization msg(header,
+                                                              data + offset);
+            serialize(buf, msg);
+            m_getParent().packMessage(buf, imageFragment.getMessageType(),
+                                      timestamp);
+        }
         return true;
     }
 
+    OSVR_ImageBufferElement *ImagingComponent::m_applyNetworkOptions(
+        OSVR_ImagingMetadata &metadata, OSVR_ImageBufferElement *imageData) {
+        auto const &opts = m_networkOptions;
+        if (0 == opts.left && 0 == opts.top && 0 == opts.width &&
+            0 == opts.height && opts.rowStep <= 1) {
+            return imageData;
+        }
+        if (opts.left >= metadata.width || opts.top >= metadata.height) {
+            return nullptr;
+        }
+        auto width = metadata.width - opts.left;
+        if (opts.width != 0) {
+            width = std::min(width, opts.width);
+        }
+        auto height = metadata.height - opts.top;
+        if (opts.height != 0) {
+            height = std::min(height, opts.height);
+        }
+        auto rowStep = std::max<OSVR_ImageDimension>(opts.rowStep, 1);
+        auto rows = (height + rowStep - 1) / rowStep;
+
+        auto pixelBytes = uint32_t(metadata.channels) * metadata.depth;
+        auto rowBytes = width * pixelBytes;
+        auto sourceRowBytes = metadata.width * pixelBytes;
+        m_networkFrame.resize(rows * rowBytes);
+        auto source = imageData + opts.top * sourceRowBytes +
+                      opts.left * pixelBytes;
+        for (OSVR_ImageDimension row = 0; row < rows; ++row) {
+            std::memcpy(m_networkFrame.data() + row * rowBytes,
+                        source + row * rowStep * sourceRowBytes, rowBytes);
+        }
+        metadata.width = width;
+        metadata.height = rows;
+        return m_networkFrame.data();
+    }
+
     int VRPN_CALLBACK
     ImagingComponent::m_handleImageRegion(void *userdata, vrpn_HANDLERPARAM p) {
         auto self = static_cast<ImagingComponent *>(userdata);
         auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
 
-        messages::ImageRegion::MessageSerialization msg;
+        messages::ImageRegion::MessageSerialization msg(self->m_bufferPool);
         deserialize(bufReader, msg);
         auto data = msg.getData();
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
-
-        self->m_checkFirst(data.metadata);
-        for (auto const &cb : self->m_cb) {
-            cb(data, timestamp);
+        /// Servers that predate sending the sensor leave it out: take
+        /// those frames as sensor 0's.
+        if (bufReader.bytesRemaining() > 0) {
+            serialization::deserializeRaw(bufReader, data.sensor);
+        }
+        if (data.sensor >= self->m_numSensor) {
+            OSVR_DEV_VERBOSE("Ignoring frame for unknown sensor "
+                             << data.sensor);
+            return 0;
         }
+
+        self->m_deliver(data, timestamp);
         return 0;
     }
 
@@ -264,22 +486,37 @@ namespace common {
         auto &msg = msgSerialize.getMessage();
         auto timestamp = util::time::fromStructTimeval(p.msg_time);
 
-        if (IPCRingBuffer::getABILevel() != msg.abiLevel) {
+        IPCRingBuffer::Synchronization sync;
+        if (IPCRingBuffer::getABILevel(
+                IPCRingBuffer::Synchronization::Seqlock) == msg.abiLevel) {
+            sync = IPCRingBuffer::Synchronization::Seqlock;
+        } else if (IPCRingBuffer::getABILevel(
+                       IPCRingBuffer::Synchronization::Mutex) ==
+                   msg.abiLevel) {
+            sync = IPCRingBuffer::Synchronization::Mutex;
+        } else {
             /// Can't interoperate with this server over shared memory
             OSVR_DEV_VERBOSE("Can't handle SHM ABI level " << msg.abiLevel);
             return 0;
         }
+        if (msg.sensor >= self->m_numSensor) {
+            OSVR_DEV_VERBOSE("Ignoring frame for unknown sensor "
+                             << msg.sensor);
+            return 0;
+        }
         self->m_growShmVecIfRequired(msg.sensor);
-        auto checkSameRingBuf = [](messages::SharedMemoryMessage const &msg,
-                                   IPCRingBufferPtr &ringbuf) {
+        auto checkSameRingBuf = [sync](messages::SharedMemoryMessage const &msg,
+                                       IPCRingBufferPtr &ringbuf) {
             return (msg.backend == ringbuf->getBackend()) &&
+                   (sync == ringbuf->getSynchronization()) &&
                    (ringbuf->getEntrySize() == getBufferSize(msg.metadata)) &&
                    (ringbuf->getName() == msg.shmName);
         };
         if (!self->m_shmBuf[msg.sensor] ||
             !checkSameRingBuf(msg, self->m_shmBuf[msg.sensor])) {
             self->m_shmBuf[msg.sensor] = IPCRingBuffer::find(
-                IPCRingBuffer::Options(msg.shmName, msg.backend));
+                IPCRingBuffer::Options(msg.shmName, msg.backend)
+                    .setSynchronization(sync));
         }
         if (!self->m_shmBuf[msg.sensor]) {
             /// Can't find the shared memory referred to - possibly not a local
@@ -290,19 +527,58 @@ namespace common {
         }
 
         auto &shm = self->m_shmBuf[msg.sensor];
-        auto getResult = shm->get(msg.seqNum);
-        if (getResult) {
-            auto bufptr = getResult.getBufferSmartPointer();
-            self->m_checkFirst(msg.metadata);
-            auto data = ImageData{msg.sensor, msg.metadata, bufptr};
-
-            for (auto const &cb : self->m_cb) {
-                cb(data, timestamp);
-            }
+        /// Copy the frame out into a recycled buffer, rather than getting a
+        /// freshly allocated copy (or, with mutex synchronization, holding a
+        /// lock on the entry for as long as the app holds the frame).
+        auto bufptr = self->m_bufferPool.acquire(shm->getEntrySize());
+        if (shm->copy(msg.seqNum, bufptr.get())) {
+            self->m_deliver(ImageData{msg.sensor, msg.metadata, bufptr},
+                            timestamp);
         }
         return 0;
     }
 
+    int VRPN_CALLBACK
+    ImagingComponent::m_handleImageFragment(void *userdata,
+                                            vrpn_HANDLERPARAM p) {
+        auto self = static_cast<ImagingComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+
+        messages::ImageFragment::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto const &header = msg.getHeader();
+        auto fragmentData =
+            bufReader.readBytesAligned(header.length, header.metadata.depth);
+
+        ImageData data;
+        if (!self->m_assembler.addFragment(
+                header,
+                reinterpret_cast<OSVR_ImageBufferElement const *>(
+                    fragmentData),
+                data)) {
+            return 0;
+        }
+        if (!self->m_decoder.decode(header.frame, header.encoding, data)) {
+            return 0;
+        }
+        self->m_deliver(data, util::time::fromStructTimeval(p.msg_time));
+        return 0;
+    }
+
+    void ImagingComponent::m_deliver(ImageData const &data,
+                                     util::time::TimeValue const &timestamp) {
+        auto &last = m_lastDelivered[data.sensor];
+        if (last && last->seconds == timestamp.seconds &&
+            last->microseconds == timestamp.microseconds) {
+            return;
+        }
+        last = timestamp;
+        m_checkFirst(data.metadata);
+        for (auto const &cb : m_cb) {
+            cb(data, timestamp);
+        }
+    }
+
     void ImagingComponent::registerImageHandler(ImageHandler handler) {
         if (m_cb.empty()) {
             m_registerHandler(&ImagingComponent::m_handleImageRegion, this,
@@ -311,12 +587,16 @@ namespace common {
             m_registerHandler(
                 &ImagingComponent::m_handleImagePlacedInSharedMemory, this,
                 imagePlacedInSharedMemory.getMessageType());
+
+            m_registerHandler(&ImagingComponent::m_handleImageFragment, this,
+                              imageFragment.getMessageType());
         }
         m_cb.push_back(handler);
     }
     void ImagingComponent::m_parentSet() {
         m_getParent().registerMessageType(imageRegion);
         m_getParent().registerMessageType(imagePlacedInSharedMemory);
+        m_getParent().registerMessageType(imageFragment);
     }
 
     void ImagingComponent::m_checkFirst(OSVR_ImagingMetadata const &metadata) {
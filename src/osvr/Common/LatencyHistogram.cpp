@@ -0,0 +1,126 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/LatencyHistogram.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+
+namespace osvr {
+namespace common {
+    LatencyHistogram::LatencyHistogram() { reset(); }
+
+    void LatencyHistogram::record(int64_t microseconds) {
+        auto value = microseconds < 0 ? value_type(0)
+                                      : static_cast<value_type>(microseconds);
+        m_buckets[m_getBucket(value)]++;
+        if (0 == m_count || value < m_min) {
+            m_min = value;
+        }
+        m_max = (std::max)(m_max, value);
+        m_sum += double(value);
+        ++m_count;
+    }
+
+    void LatencyHistogram::reset() {
+        m_buckets.fill(0);
+        m_count = 0;
+        m_min = 0;
+        m_max = 0;
+        m_sum = 0;
+    }
+
+    double LatencyHistogram::getMean() const {
+        return m_count ? m_sum / double(m_count) : 0.;
+    }
+
+    LatencyHistogram::value_type
+    LatencyHistogram::getValueAtPercentile(double percentile) const {
+        if (0 == m_count) {
+            return 0;
+        }
+        percentile = (std::min)((std::max)(percentile, 0.), 100.);
+        auto target = static_cast<count_type>(
+            std::ceil(percentile / 100. * double(m_count)));
+        target = (std::max)(target, count_type(1));
+        count_type seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            seen += m_buckets[i];
+            if (seen >= target) {
+                return (std::min)(m_getBucketUpperBound(i), m_max);
+            }
+        }
+        return m_max;
+    }
+
+    void LatencyHistogram::add(LatencyHistogram const &other) {
+        if (0 == other.m_count) {
+            return;
+        }
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            m_buckets[i] += other.m_buckets[i];
+        }
+        m_min = m_count ? (std::min)(m_min, other.m_min) : other.m_min;
+        m_max = (std::max)(m_max, other.m_max);
+        m_sum += other.m_sum;
+        m_count += other.m_count;
+    }
+
+    /// @brief Index of the highest set bit of a non-zero value.
+    static inline std::size_t highestBit(uint64_t value) {
+        std::size_t ret = 0;
+        while (value >>= 1) {
+            ++ret;
+        }
+        return ret;
+    }
+
+    std::size_t LatencyHistogram::m_getBucket(value_type value) {
+        if (value < LINEAR_BUCKETS) {
+            return static_cast<std::size_t>(value);
+        }
+        // Keep the top SUB_BUCKET_BITS + 1 bits: the leading one selects the
+        // power of two, the rest the sub-bucket within it.
+        auto shift = highestBit(value) - SUB_BUCKET_BITS;
+        auto subBucket = static_cast<std::size_t>(value >> shift) - SUB_BUCKETS;
+        return LINEAR_BUCKETS + (shift - 1) * SUB_BUCKETS + subBucket;
+    }
+
+    LatencyHistogram::value_type
+    LatencyHistogram::m_getBucketUpperBound(std::size_t bucket) {
+        if (bucket < LINEAR_BUCKETS) {
+            return bucket;
+        }
+        auto shift = (bucket - LINEAR_BUCKETS) / SUB_BUCKETS + 1;
+        auto subBucket = (bucket - LINEAR_BUCKETS) % SUB_BUCKETS;
+        auto lower = value_type(SUB_BUCKETS + subBucket) << shift;
+        return lower + ((value_type(1) << shift) - 1);
+    }
+} // namespace common
+} // namespace osvr
@@ -55,14 +55,26 @@ namespace common {
             f("descriptor", value.getDescriptor());
         }
 
-        /// @brief Description for AliasElement
-        template <typename Functor, typename ValType>
-        inline enable_if_element_type<ValType, elements::AliasElement>
-        serializationDescription(Functor &f, ValType &value) {
+        /// @brief Description for AliasElement, when serializing
+        template <typename Functor>
+        inline void
+        serializationDescription(Functor &f,
+                                 elements::AliasElement const &value) {
             f("source", value.getSource());
             f("priority", value.priority());
         }
 
+        /// @brief Description for AliasElement, when deserializing: the source
+        /// is parsed as it is set.
+        template <typename Functor>
+        inline void serializationDescription(Functor &f,
+                                             elements::AliasElement &value) {
+            std::string source;
+            f("source", source);
+            value.setSource(source);
+            f("priority", value.priority());
+        }
+
         /// @brief Description for StringElement
         template <typename Functor, typename ValType>
         inline enable_if_element_type<ValType, elements::StringElement>
@@ -61,19 +61,37 @@ namespace common {
 
         AliasElement::AliasElement(std::string const &source,
                                    AliasPriority priority)
-            : m_source(source), m_priority(priority) {}
+            : m_source(source), m_parsedSource(source), m_priority(priority) {}
 
         AliasElement::AliasElement(std::string const &source)
             : AliasElement(source, ALIASPRIORITY_MINIMUM) {}
 
+        AliasElement::AliasElement(ParsedAlias const &source,
+                                   AliasPriority priority)
+            : m_source(source.getAlias()), m_parsedSource(source),
+              m_priority(priority) {}
+
+        AliasElement::AliasElement()
+            : AliasElement(ParsedAlias(Json::Value("")),
+                           ALIASPRIORITY_MINIMUM) {}
+
         void AliasElement::setSource(std::string const &source) {
             /// @todo validation?
             m_source = source;
+            m_parsedSource = ParsedAlias(source);
+        }
+
+        void AliasElement::setSource(ParsedAlias const &source) {
+            m_source = source.getAlias();
+            m_parsedSource = source;
         }
 
-        std::string &AliasElement::getSource() { return m_source; }
         std::string const &AliasElement::getSource() const { return m_source; }
 
+        ParsedAlias const &AliasElement::getParsedSource() const {
+            return m_parsedSource;
+        }
+
         AliasPriority &AliasElement::priority() { return m_priority; }
         AliasPriority AliasElement::priority() const { return m_priority; }
 
@@ -67,7 +67,7 @@ namespace common {
     /// @brief Determine if the node needs updating given that we want to add an
     /// alias there pointing to source with the given automatic status.
     static inline bool aliasNeedsUpdate(PathNode &node,
-                                        std::string const &source,
+                                        ParsedAlias const &source,
                                         AliasPriority priority) {
         elements::AliasElement *elt =
             boost::get<elements::AliasElement>(&node.value());
@@ -80,23 +80,22 @@ namespace common {
             /// override
             return true;
         }
-        if (priority == elt->priority() && source != elt->getSource()) {
+        if (priority == elt->priority() &&
+            source.getAliasValue() !=
+                elt->getParsedSource().getAliasValue()) {
             /// Same automatic status, different source: replace/update
             return true;
         }
         return false;
     }
 
-    static inline bool addAliasImpl(PathNode &node, std::string const &source,
+    static inline bool addAliasImpl(PathNode &node, ParsedAlias const &source,
                                     AliasPriority priority) {
 
         if (!aliasNeedsUpdate(node, source, priority)) {
             return false;
         }
-        elements::AliasElement elt;
-        elt.setSource(source);
-        elt.priority() = priority;
-        node.value() = elt;
+        node.value() = elements::AliasElement(source, priority);
         return true;
     }
 
@@ -114,7 +113,7 @@ namespace common {
                 "Source contains a relative path, not permitted: " << source);
             return false;
         }
-        return addAliasImpl(node, newSource.getAlias(), priority);
+        return addAliasImpl(node, newSource, priority);
     }
 
     bool addAliasFromRoute(PathNode &node, std::string const &route,
@@ -136,16 +135,27 @@ namespace common {
                                            std::string const &source,
                                            std::string const &dest,
                                            AliasPriority priority) {
-        auto &aliasNode = treePathRetrieve(node, dest);
-        ParsedAlias newSource(source);
-        if (!newSource.isValid()) {
+        return addAliasFromSourceAndRelativeDest(node, ParsedAlias(source),
+                                                 dest, priority);
+    }
+
+    bool addAliasFromSourceAndRelativeDest(PathNode &node,
+                                           ParsedAlias const &source,
+                                           std::string const &dest,
+                                           AliasPriority priority) {
+        if (!source.isValid()) {
             /// @todo signify invalid route in some other way?
-            OSVR_DEV_VERBOSE("Could not parse source: " << source);
+            OSVR_DEV_VERBOSE("Could not parse source: " << source.getAlias());
             return false;
         }
-        auto absSource = getAbsolutePath(node, newSource.getLeaf());
-        newSource.setLeaf(absSource);
-        return addAliasImpl(aliasNode, newSource.getAlias(), priority);
+        auto &aliasNode = treePathRetrieve(node, dest);
+        auto leaf = source.getLeaf();
+        if (isPathAbsolute(leaf)) {
+            return addAliasImpl(aliasNode, source, priority);
+        }
+        ParsedAlias absSource(source);
+        absSource.setLeaf(getAbsolutePath(node, leaf));
+        return addAliasImpl(aliasNode, absSource, priority);
     }
 
     bool isPathAbsolute(std::string const &source) {
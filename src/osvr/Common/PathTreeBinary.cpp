@@ -0,0 +1,367 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/PathTreeBinary.h>
+#include "PathElementSerialization.h"
+#include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathElementTools.h>
+#include <osvr/Common/PathNode.h>
+#include <osvr/Common/RoutingConstants.h>
+#include <osvr/Common/Serialization.h>
+
+// Library/third-party includes
+#include <json/value.h>
+#include <json/reader.h>
+#include <json/writer.h>
+#include <boost/variant.hpp>
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace osvr {
+namespace common {
+    namespace {
+        typedef uint32_t StringIndex;
+        typedef uint32_t NodeIndex;
+
+        /// @brief Parent index of the nodes directly under the root, which
+        /// itself isn't encoded.
+        static const NodeIndex NO_PARENT = 0xffffffff;
+
+        /// @brief Element types as encoded: independent of the order of
+        /// types in the PathElement variant.
+        enum class BinaryElementType : uint8_t {
+            Null,
+            Plugin,
+            Device,
+            Interface,
+            Sensor,
+            Alias,
+            String
+        };
+
+        /// @brief A node as encoded, with its strings replaced by indices
+        /// into the string table.
+        struct BinaryNode {
+            BinaryNode()
+                : parent(NO_PARENT), name(0), type(BinaryElementType::Null),
+                  priority(0) {
+                fields[0] = fields[1] = fields[2] = 0;
+            }
+            NodeIndex parent;
+            StringIndex name;
+            BinaryElementType type;
+            /// @brief Element strings: device name, server, and descriptor;
+            /// alias source; or string value.
+            StringIndex fields[3];
+            AliasPriority priority;
+        };
+
+        /// @brief Number of string fields used by each type of element.
+        inline std::size_t getFieldCount(BinaryElementType type) {
+            switch (type) {
+            case BinaryElementType::Device:
+                return 3;
+            case BinaryElementType::Alias:
+            case BinaryElementType::String:
+                return 1;
+            default:
+                return 0;
+            }
+        }
+
+        /// @brief The whole encoding, for use with serialize() and
+        /// deserialize().
+        class BinaryTreeMessage {
+          public:
+            BinaryTreeMessage(std::vector<std::string> &strings,
+                              std::vector<BinaryNode> &nodes)
+                : m_strings(strings), m_nodes(nodes) {}
+
+            template <typename T> void processMessage(T &p) {
+                uint32_t version = PATH_TREE_BINARY_VERSION;
+                p(version);
+                if (version != PATH_TREE_BINARY_VERSION) {
+                    throw std::runtime_error(
+                        "Unsupported binary path tree version!");
+                }
+                m_processList(p, m_strings, [&](std::string &str) { p(str); });
+                m_processList(p, m_nodes, [&](BinaryNode &node) {
+                    p(node.parent);
+                    p(node.name);
+                    p(node.type,
+                      serialization::EnumAsIntegerTag<BinaryElementType,
+                                                      uint8_t>());
+                    if (node.type > BinaryElementType::String) {
+                        throw std::runtime_error(
+                            "Unknown element type in binary path tree!");
+                    }
+                    for (std::size_t i = 0; i < getFieldCount(node.type);
+                         ++i) {
+                        p(node.fields[i]);
+                    }
+                    if (node.type == BinaryElementType::Alias) {
+                        p(node.priority);
+                    }
+                });
+            }
+
+          private:
+            /// @brief Count-prefixed list. When deserializing, entries are
+            /// added as they are read, so a corrupt count runs out of data
+            /// rather than allocating a huge list up front.
+            template <typename T, typename U, typename F>
+            static void m_processList(T &p, std::vector<U> &list,
+                                      F processEntry) {
+                uint32_t count = static_cast<uint32_t>(list.size());
+                p(count);
+                if (p.isDeserialize()) {
+                    list.clear();
+                    for (uint32_t i = 0; i < count; ++i) {
+                        list.emplace_back();
+                        processEntry(list.back());
+                    }
+                } else {
+                    for (auto &entry : list) {
+                        processEntry(entry);
+                    }
+                }
+            }
+
+            std::vector<std::string> &m_strings;
+            std::vector<BinaryNode> &m_nodes;
+        };
+
+        /// @brief Builds the string table and node list from a tree.
+        class BinaryTreeBuilder : public boost::static_visitor<> {
+          public:
+            BinaryTreeBuilder(std::vector<std::string> &strings,
+                              std::vector<BinaryNode> &nodes)
+                : m_strings(strings), m_nodes(nodes), m_current(nullptr) {}
+
+            /// @brief Add the descendants of @p node, whose own index is
+            /// @p index.
+            void addChildren(PathNode const &node, NodeIndex index) {
+                auto visitor = [&](PathNode const &child) {
+                    BinaryNode entry;
+                    entry.parent = index;
+                    entry.name = m_getString(child.getName());
+                    m_current = &entry;
+                    boost::apply_visitor(*this, child.value());
+                    auto childIndex = static_cast<NodeIndex>(m_nodes.size());
+                    m_nodes.push_back(entry);
+                    addChildren(child, childIndex);
+                };
+                node.visitConstChildren(visitor);
+            }
+
+            void operator()(elements::NullElement const &) {
+                m_current->type = BinaryElementType::Null;
+            }
+            void operator()(elements::PluginElement const &) {
+                m_current->type = BinaryElementType::Plugin;
+            }
+            void operator()(elements::DeviceElement const &elt) {
+                m_current->type = BinaryElementType::Device;
+                m_current->fields[0] = m_getString(elt.getDeviceName());
+                m_current->fields[1] = m_getString(elt.getServer());
+                m_current->fields[2] =
+                    m_getString(m_writer.write(elt.getDescriptor()));
+            }
+            void operator()(elements::InterfaceElement const &) {
+                m_current->type = BinaryElementType::Interface;
+            }
+            void operator()(elements::SensorElement const &) {
+                m_current->type = BinaryElementType::Sensor;
+            }
+            void operator()(elements::AliasElement const &elt) {
+                m_current->type = BinaryElementType::Alias;
+                m_current->fields[0] = m_getString(elt.getSource());
+                m_current->priority = elt.priority();
+            }
+            void operator()(elements::StringElement const &elt) {
+                m_current->type = BinaryElementType::String;
+                m_current->fields[0] = m_getString(elt.getString());
+            }
+
+          private:
+            StringIndex m_getString(std::string const &str) {
+                auto it = m_indices.find(str);
+                if (it != end(m_indices)) {
+                    return it->second;
+                }
+                auto index = static_cast<StringIndex>(m_strings.size());
+                m_indices.emplace(str, index);
+                m_strings.push_back(str);
+                return index;
+            }
+
+            std::vector<std::string> &m_strings;
+            std::vector<BinaryNode> &m_nodes;
+            std::unordered_map<std::string, StringIndex> m_indices;
+            BinaryNode *m_current;
+            Json::FastWriter m_writer;
+        };
+
+        /// @brief Decodes and validates an encoded tree.
+        class BinaryTreeContents {
+          public:
+            BinaryTreeContents(const char *buf, std::size_t len) {
+                auto reader = readExternalBuffer(buf, len);
+                BinaryTreeMessage msg(m_strings, m_nodes);
+                deserialize(reader, msg);
+                for (NodeIndex i = 0; i < m_nodes.size(); ++i) {
+                    auto const &node = m_nodes[i];
+                    if (node.parent != NO_PARENT && node.parent >= i) {
+                        throw std::runtime_error(
+                            "Binary path tree node precedes its parent!");
+                    }
+                    m_checkString(node.name);
+                    for (std::size_t j = 0; j < getFieldCount(node.type);
+                         ++j) {
+                        m_checkString(node.fields[j]);
+                    }
+                }
+            }
+
+            std::vector<BinaryNode> const &getNodes() const {
+                return m_nodes;
+            }
+
+            std::string const &getString(StringIndex index) const {
+                return m_strings[index];
+            }
+
+            /// @brief Creates the element for a node, leaving a device's
+            /// descriptor empty.
+            elements::PathElement getElement(BinaryNode const &node) const {
+                switch (node.type) {
+                case BinaryElementType::Plugin:
+                    return elements::PluginElement();
+                case BinaryElementType::Device:
+                    return elements::DeviceElement(getString(node.fields[0]),
+                                                   getString(node.fields[1]));
+                case BinaryElementType::Interface:
+                    return elements::InterfaceElement();
+                case BinaryElementType::Sensor:
+                    return elements::SensorElement();
+                case BinaryElementType::Alias:
+                    return elements::AliasElement(getString(node.fields[0]),
+                                                  node.priority);
+                case BinaryElementType::String:
+                    return elements::StringElement(getString(node.fields[0]));
+                case BinaryElementType::Null:
+                default:
+                    return elements::NullElement();
+                }
+            }
+
+          private:
+            void m_checkString(StringIndex index) const {
+                if (index >= m_strings.size()) {
+                    throw std::runtime_error(
+                        "Binary path tree refers to a missing string!");
+                }
+            }
+            std::vector<std::string> m_strings;
+            std::vector<BinaryNode> m_nodes;
+        };
+
+        /// @brief Visitor turning an element into its JSON form, as from
+        /// pathTreeToJson().
+        class ElementToJsonVisitor
+            : public boost::static_visitor<Json::Value> {
+          public:
+            template <typename T> Json::Value operator()(T const &elt) const {
+                auto ret = pathElementToJson(elt);
+                ret["type"] = getTypeName<T>();
+                return ret;
+            }
+        };
+    } // namespace
+
+    void pathTreeToBinary(PathTree const &tree, Buffer<> &buf) {
+        std::vector<std::string> strings;
+        std::vector<BinaryNode> nodes;
+        BinaryTreeBuilder builder(strings, nodes);
+        builder.addChildren(tree.getRoot(), NO_PARENT);
+        BinaryTreeMessage msg(strings, nodes);
+        serialize(buf, msg);
+    }
+
+    void binaryToPathTree(PathTree &tree, const char *buf, std::size_t len) {
+        BinaryTreeContents contents(buf, len);
+        auto const &nodes = contents.getNodes();
+        std::vector<PathNode *> treeNodes;
+        treeNodes.reserve(nodes.size());
+        Json::Reader reader;
+        for (auto const &node : nodes) {
+            auto &parent = (node.parent == NO_PARENT)
+                               ? tree.getRoot()
+                               : *treeNodes[node.parent];
+            auto &treeNode =
+                parent.getOrCreateChildByName(contents.getString(node.name));
+            auto elt = contents.getElement(node);
+            if (node.type == BinaryElementType::Device) {
+                reader.parse(contents.getString(node.fields[2]),
+                             boost::get<elements::DeviceElement>(elt)
+                                 .getDescriptor());
+            }
+            treeNode.value() = elt;
+            treeNodes.push_back(&treeNode);
+        }
+    }
+
+    PathTreeSnapshot pathTreeSnapshotFromBinary(const char *buf,
+                                                std::size_t len) {
+        BinaryTreeContents contents(buf, len);
+        auto const &nodes = contents.getNodes();
+        std::vector<std::string> paths;
+        paths.reserve(nodes.size());
+        PathTreeSnapshot ret;
+        for (auto const &node : nodes) {
+            auto path = (node.parent == NO_PARENT ? std::string()
+                                                  : paths[node.parent]) +
+                        getPathSeparator() + contents.getString(node.name);
+            if (node.type != BinaryElementType::Null) {
+                auto elt = contents.getElement(node);
+                auto val = boost::apply_visitor(ElementToJsonVisitor(), elt);
+                if (node.type == BinaryElementType::Device) {
+                    // Left as text: parsed only if it's applied to a tree.
+                    val["descriptor"] = contents.getString(node.fields[2]);
+                }
+                val["path"] = path;
+                ret[path] = val;
+            }
+            paths.push_back(std::move(path));
+        }
+        return ret;
+    }
+} // namespace common
+} // namespace osvr
@@ -0,0 +1,195 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PathTreeDelta.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <cstring>
+
+namespace osvr {
+namespace common {
+    static const char PATH_KEY[] = "path";
+    static const char VERSION_KEY[] = "version";
+    static const char BASE_KEY[] = "base";
+    static const char CHANGED_KEY[] = "changed";
+    static const char REMOVED_KEY[] = "removed";
+
+    PathTreeSnapshot pathTreeSnapshotFromJson(Json::Value const &nodes) {
+        PathTreeSnapshot ret;
+        for (auto const &node : nodes) {
+            ret[node[PATH_KEY].asString()] = node;
+        }
+        return ret;
+    }
+
+    namespace {
+        /// @brief 64-bit FNV-1a hash, fed a piece at a time.
+        class JsonHasher {
+          public:
+            JsonHasher() : m_hash(UINT64_C(14695981039346656037)) {}
+
+            void add(Json::Value const &val) {
+                addByte(static_cast<unsigned char>(val.type()));
+                switch (val.type()) {
+                case Json::intValue:
+                    addInteger(static_cast<uint64_t>(val.asLargestInt()));
+                    break;
+                case Json::uintValue:
+                    addInteger(val.asLargestUInt());
+                    break;
+                case Json::realValue: {
+                    auto real = val.asDouble();
+                    uint64_t bits;
+                    std::memcpy(&bits, &real, sizeof(bits));
+                    addInteger(bits);
+                } break;
+                case Json::stringValue:
+                    addString(val.asString());
+                    break;
+                case Json::booleanValue:
+                    addByte(val.asBool() ? 1 : 0);
+                    break;
+                case Json::arrayValue:
+                    addInteger(val.size());
+                    for (auto const &elt : val) {
+                        add(elt);
+                    }
+                    break;
+                case Json::objectValue:
+                    // Members are iterated in key order.
+                    addInteger(val.size());
+                    for (auto it = val.begin(), e = val.end(); it != e; ++it) {
+                        addString(it.key().asString());
+                        add(*it);
+                    }
+                    break;
+                case Json::nullValue:
+                    break;
+                }
+            }
+
+            uint64_t get() const { return m_hash; }
+
+          private:
+            void addByte(unsigned char byte) {
+                m_hash = (m_hash ^ byte) * UINT64_C(1099511628211);
+            }
+            void addInteger(uint64_t v) {
+                for (int i = 0; i < 8; ++i) {
+                    addByte(static_cast<unsigned char>(v >> (i * 8)));
+                }
+            }
+            /// @brief Length-prefixed, so adjacent strings can't run
+            /// together.
+            void addString(std::string const &str) {
+                addInteger(str.size());
+                for (auto c : str) {
+                    addByte(static_cast<unsigned char>(c));
+                }
+            }
+            uint64_t m_hash;
+        };
+    } // namespace
+
+    uint64_t hashPathTreeJson(Json::Value const &nodes) {
+        JsonHasher hasher;
+        hasher.add(nodes);
+        return hasher.get();
+    }
+
+    std::size_t PathTreeDelta::size() const {
+        return changed.size() + removed.size();
+    }
+
+    PathTreeDelta diffPathTreeSnapshots(PathTreeSnapshot const &from,
+                                        PathTreeSnapshot const &to) {
+        PathTreeDelta ret;
+        // Both are sorted by path, so walk them together.
+        auto fromIt = begin(from);
+        auto toIt = begin(to);
+        while (fromIt != end(from) || toIt != end(to)) {
+            if (toIt == end(to) ||
+                (fromIt != end(from) && fromIt->first < toIt->first)) {
+                ret.removed.push_back(fromIt->first);
+                ++fromIt;
+            } else if (fromIt == end(from) || toIt->first < fromIt->first) {
+                ret.changed.append(toIt->second);
+                ++toIt;
+            } else {
+                if (fromIt->second != toIt->second) {
+                    ret.changed.append(toIt->second);
+                }
+                ++fromIt;
+                ++toIt;
+            }
+        }
+        return ret;
+    }
+
+    void applyPathTreeDelta(PathTreeSnapshot &snapshot,
+                            PathTreeDelta const &delta) {
+        for (auto const &path : delta.removed) {
+            snapshot.erase(path);
+        }
+        for (auto const &node : delta.changed) {
+            snapshot[node[PATH_KEY].asString()] = node;
+        }
+    }
+
+    Json::Value pathTreeDeltaToJson(PathTreeDelta const &delta) {
+        Json::Value ret(Json::objectValue);
+        ret[VERSION_KEY] = delta.version;
+        if (delta.base) {
+            ret[BASE_KEY] = *delta.base;
+        }
+        ret[CHANGED_KEY] = delta.changed;
+        Json::Value removed(Json::arrayValue);
+        for (auto const &path : delta.removed) {
+            removed.append(path);
+        }
+        ret[REMOVED_KEY] = removed;
+        return ret;
+    }
+
+    PathTreeDelta pathTreeDeltaFromJson(Json::Value const &json) {
+        PathTreeDelta ret;
+        ret.version = json[VERSION_KEY].asUInt();
+        if (json.isMember(BASE_KEY)) {
+            ret.base = json[BASE_KEY].asUInt();
+        }
+        auto const &changed = json[CHANGED_KEY];
+        if (changed.isArray()) {
+            ret.changed = changed;
+        }
+        for (auto const &path : json[REMOVED_KEY]) {
+            ret.removed.push_back(path.asString());
+        }
+        return ret;
+    }
+} // namespace common
+} // namespace osvr
@@ -0,0 +1,141 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PoseHistory.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace common {
+    /// @brief Seconds from @p b to @p a
+    static inline double secondsBetween(util::time::TimeValue const &a,
+                                        util::time::TimeValue const &b) {
+        return double(a.seconds - b.seconds) +
+               double(a.microseconds - b.microseconds) * 1e-6;
+    }
+
+    PoseHistory::PoseHistory(std::size_t capacity)
+        : m_entries((std::max)(capacity, std::size_t(1))) {}
+
+    void PoseHistory::add(util::time::TimeValue const &timestamp,
+                          OSVR_Pose3 const &pose) {
+        Entry entry;
+        entry.timestamp = timestamp;
+        entry.pose = pose;
+        if (m_entries.empty() ||
+            !osvrTimeValueGreater(m_entries.back().timestamp, timestamp)) {
+            // The usual case: in order.
+            m_entries.push_back(entry);
+            return;
+        }
+        auto it = std::upper_bound(
+            m_entries.begin(), m_entries.end(), entry,
+            [](Entry const &a, Entry const &b) {
+                return osvrTimeValueGreater(b.timestamp, a.timestamp);
+            });
+        if (it == m_entries.begin() && m_entries.full()) {
+            // Older than everything we have room for.
+            return;
+        }
+        // When full, this drops the oldest entry to make room.
+        m_entries.insert(it, entry);
+    }
+
+    bool PoseHistory::getPoseAt(util::time::TimeValue const &when,
+                                OSVR_Pose3 &pose) const {
+        if (m_entries.empty() ||
+            osvrTimeValueGreater(m_entries.front().timestamp, when)) {
+            return false;
+        }
+        auto const &newest = m_entries.back();
+        if (!osvrTimeValueGreater(when, newest.timestamp)) {
+            // Within the history: find the first entry after the time, and
+            // interpolate between it and the one before.
+            auto after = std::find_if(
+                m_entries.begin(), m_entries.end(), [&](Entry const &e) {
+                    return osvrTimeValueGreater(e.timestamp, when);
+                });
+            if (after == m_entries.end() || after == m_entries.begin()) {
+                // Exactly the newest, or the oldest.
+                pose = (after == m_entries.end() ? newest : *after).pose;
+                return true;
+            }
+            auto before = after - 1;
+            auto span = secondsBetween(after->timestamp, before->timestamp);
+            if (span <= 0) {
+                pose = before->pose;
+                return true;
+            }
+            auto t = secondsBetween(when, before->timestamp) / span;
+            auto rot = util::fromQuat(before->pose.rotation)
+                           .slerp(t, util::fromQuat(after->pose.rotation));
+            util::vecMap(pose.translation) =
+                util::vecMap(before->pose.translation) +
+                t * (util::vecMap(after->pose.translation) -
+                     util::vecMap(before->pose.translation));
+            util::toQuat(rot.normalized(), pose.rotation);
+            return true;
+        }
+
+        // Prediction: extrapolate the motion between the newest two entries.
+        if (m_entries.size() < 2) {
+            pose = newest.pose;
+            return true;
+        }
+        auto const &previous = m_entries[m_entries.size() - 2];
+        auto span = secondsBetween(newest.timestamp, previous.timestamp);
+        if (span <= 0) {
+            pose = newest.pose;
+            return true;
+        }
+        auto scale = secondsBetween(when, newest.timestamp) / span;
+
+        Eigen::Quaterniond newestRot = util::fromQuat(newest.pose.rotation);
+        Eigen::Quaterniond delta =
+            newestRot * util::fromQuat(previous.pose.rotation).inverse();
+        if (delta.w() < 0) {
+            // Take the short way around.
+            delta.coeffs() *= -1;
+        }
+        Eigen::AngleAxisd angularStep(delta);
+        Eigen::Quaterniond rot =
+            Eigen::Quaterniond(Eigen::AngleAxisd(
+                angularStep.angle() * scale, angularStep.axis())) *
+            newestRot;
+
+        util::vecMap(pose.translation) =
+            util::vecMap(newest.pose.translation) +
+            scale * (util::vecMap(newest.pose.translation) -
+                     util::vecMap(previous.pose.translation));
+        util::toQuat(rot.normalized(), pose.rotation);
+        return true;
+    }
+} // namespace common
+} // namespace osvr
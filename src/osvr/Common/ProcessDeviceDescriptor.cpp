@@ -35,6 +35,7 @@
 #include <osvr/Util/TreeTraversalVisitor.h>
 #include <osvr/Common/AliasProcessor.h>
 #include <osvr/Common/NormalizeDeviceDescriptor.h>
+#include <osvr/Common/ParseAlias.h>
 
 #include "PathParseAndRetrieve.h"
 
@@ -95,8 +96,8 @@ namespace common {
             bool m_add(Json::Value const &currentLevel,
                        std::string const &relativeSemanticPath) {
                 return addAliasFromSourceAndRelativeDest(
-                    m_devNode, currentLevel.toStyledString(),
-                    relativeSemanticPath, ALIASPRIORITY_SEMANTICROUTE);
+                    m_devNode, ParsedAlias(currentLevel), relativeSemanticPath,
+                    ALIASPRIORITY_SEMANTICROUTE);
             }
             void m_recurse(Json::Value const &currentLevel,
                            std::string const &relativeSemanticPath) {
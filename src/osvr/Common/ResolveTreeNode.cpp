@@ -89,12 +89,11 @@ namespace common {
         /// @brief Handle an alias element
         void operator()(elements::AliasElement const &elt) {
             // This is an alias.
-            ParsedAlias parsed(elt.getSource());
+            auto &parsed = elt.getParsedSource();
             if (!parsed.isValid()) {
                 OSVR_DEV_VERBOSE("Couldn't parse alias: " << elt.getSource());
                 return;
             }
-            /// @todo update the element with the normalized source?
             if (!parsed.isSimple()) {
                 // Not simple: store the full string as a transform.
                 m_source.nestTransform(parsed.getAliasValue());
@@ -0,0 +1,54 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ResolvedRouteCache.h>
+#include <osvr/Common/ResolveTreeNode.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace common {
+    // Generation 0 is reserved for default-constructed (never resolved)
+    // entries.
+    ResolvedRouteCache::ResolvedRouteCache() : m_generation(1) {}
+
+    ResolvedRouteCache::result_type const &
+    ResolvedRouteCache::resolve(PathTree &tree, std::string const &path) {
+        auto &entry = m_entries[path];
+        if (entry.generation != m_generation) {
+            entry.source = resolveTreeNode(tree, path);
+            entry.generation = m_generation;
+        }
+        return entry.source;
+    }
+
+    void ResolvedRouteCache::invalidate() { ++m_generation; }
+
+} // namespace common
+} // namespace osvr
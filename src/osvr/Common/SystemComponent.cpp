@@ -30,6 +30,7 @@
 #include <osvr/Common/JSONSerializationTags.h>
 #include <osvr/Common/Buffer.h>
 #include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/PathTreeBinary.h>
 
 // Library/third-party includes
 #include <json/value.h>
@@ -93,6 +94,95 @@ namespace common {
         const char *ReplacementTreeFromServer::identifier() {
             return "com.osvr.system.ReplacementTreeFromServer";
         }
+
+        class TreeStampFromServer::MessageSerialization {
+          public:
+            MessageSerialization(PathTreeStamp const &stamp = PathTreeStamp())
+                : m_stamp(stamp) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_stamp.generation);
+                p(m_stamp.hash);
+            }
+
+            PathTreeStamp const &getStamp() const { return m_stamp; }
+
+          private:
+            PathTreeStamp m_stamp;
+        };
+        const char *TreeStampFromServer::identifier() {
+            return "com.osvr.system.TreeStampFromServer";
+        }
+
+        class TreeDeltaFromServer::MessageSerialization {
+          public:
+            MessageSerialization(Json::Value const &msg = Json::objectValue)
+                : m_msg(msg) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_msg, serialization::JsonOnlyMessageTag());
+            }
+
+            Json::Value const &getValue() const { return m_msg; }
+
+          private:
+            Json::Value m_msg;
+        };
+        const char *TreeDeltaFromServer::identifier() {
+            return "com.osvr.system.TreeDeltaFromServer";
+        }
+
+        const char *FullTreeRequestToServer::identifier() {
+            return "com.osvr.system.FullTreeRequestToServer";
+        }
+
+        const char *BinaryTreeFromServer::identifier() {
+            return "com.osvr.system.BinaryTreeFromServer";
+        }
+
+        class TreeFormatQueryFromServer::MessageSerialization {
+          public:
+            MessageSerialization(uint32_t query = 0) : m_query(query) {}
+
+            template <typename T> void processMessage(T &p) { p(m_query); }
+
+            uint32_t getQuery() const { return m_query; }
+
+          private:
+            uint32_t m_query;
+        };
+        const char *TreeFormatQueryFromServer::identifier() {
+            return "com.osvr.system.TreeFormatQueryFromServer";
+        }
+
+        class TreeFormatReplyToServer::MessageSerialization {
+          public:
+            MessageSerialization(uint32_t query = 0,
+                                 uint32_t binaryVersion = 0,
+                                 uint32_t deltaVersion = 0)
+                : m_query(query), m_binaryVersion(binaryVersion),
+                  m_deltaVersion(deltaVersion) {}
+
+            template <typename T> void processMessage(T &p) {
+                p(m_query);
+                p(m_binaryVersion);
+                p(m_deltaVersion);
+            }
+
+            uint32_t getQuery() const { return m_query; }
+            uint32_t getBinaryVersion() const { return m_binaryVersion; }
+            uint32_t getDeltaVersion() const { return m_deltaVersion; }
+
+          private:
+            uint32_t m_query;
+            /// @brief Binary path tree version understood, 0 for none.
+            uint32_t m_binaryVersion;
+            /// @brief Tree delta version understood, 0 for none.
+            uint32_t m_deltaVersion;
+        };
+        const char *TreeFormatReplyToServer::identifier() {
+            return "com.osvr.system.TreeFormatReplyToServer";
+        }
     } // namespace messages
 
     const char *SystemComponent::deviceName() {
@@ -104,7 +194,9 @@ namespace common {
         return ret;
     }
 
-    SystemComponent::SystemComponent() {}
+    SystemComponent::SystemComponent()
+        : m_treeFormatQuery(0), m_clients(0), m_binaryTreeClients(0),
+          m_treeDeltaClients(0) {}
 
     void SystemComponent::sendRoutes(std::string const &routes) {
         Buffer<> buf;
@@ -131,33 +223,170 @@ namespace common {
     }
 
     void SystemComponent::sendReplacementTree(PathTree &tree) {
-        auto config = pathTreeToJson(tree);
+        if (m_clientsSupportBinaryTree()) {
+            m_sendBinaryTree(tree);
+        } else {
+            sendReplacementTree(pathTreeToJson(tree));
+        }
+    }
+
+    void SystemComponent::sendReplacementTree(PathTree &tree,
+                                              Json::Value const &nodes) {
+        if (m_clientsSupportBinaryTree()) {
+            m_sendBinaryTree(tree);
+        } else {
+            sendReplacementTree(nodes);
+        }
+    }
+
+    void SystemComponent::sendReplacementTree(Json::Value const &nodes) {
         Buffer<> buf;
-        messages::ReplacementTreeFromServer::MessageSerialization msg(config);
+        messages::ReplacementTreeFromServer::MessageSerialization msg(nodes);
         serialize(buf, msg);
         m_getParent().packMessage(buf, treeOut.getMessageType());
 
         m_getParent().sendPending(); // forcing this since it will cause
                                      // shuffling of remotes on the client.
     }
+    void SystemComponent::sendReplacementTree(PathTree &tree,
+                                              Json::Value const &nodes,
+                                              PathTreeStamp const &stamp) {
+        Buffer<> buf;
+        messages::TreeStampFromServer::MessageSerialization msg(stamp);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, treeStampOut.getMessageType());
+        sendReplacementTree(tree, nodes);
+    }
+
     void SystemComponent::registerReplaceTreeHandler(JsonHandler cb) {
         if (m_replaceTreeHandlers.empty()) {
+            m_registerTreeStampHandler();
             m_registerHandler(&SystemComponent::m_handleReplaceTree, this,
                               treeOut.getMessageType());
         }
         m_replaceTreeHandlers.push_back(cb);
     }
 
+    void SystemComponent::sendTreeDelta(Json::Value const &delta) {
+        Buffer<> buf;
+        messages::TreeDeltaFromServer::MessageSerialization msg(delta);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, treeDeltaOut.getMessageType());
+
+        m_getParent().sendPending(); // as with a replacement tree.
+    }
+
+    void SystemComponent::registerTreeDeltaHandler(JsonHandler cb) {
+        if (m_treeDeltaHandlers.empty()) {
+            m_registerTreeFormatQueryHandler();
+            m_registerHandler(&SystemComponent::m_handleTreeDelta, this,
+                              treeDeltaOut.getMessageType());
+        }
+        m_treeDeltaHandlers.push_back(cb);
+    }
+
+    bool SystemComponent::clientsSupportTreeDeltas() const {
+        // As with binary trees, local listeners that never answer might be
+        // all there is.
+        return m_clients > 0 && m_treeDeltaClients >= m_clients;
+    }
+
+    void SystemComponent::sendFullTreeRequest() {
+        // Whatever tree comes next must be handled.
+        m_treeStamp.reset();
+        Buffer<> buf;
+        m_getParent().packMessage(buf, fullTreeRequestIn.getMessageType());
+    }
+
+    void SystemComponent::registerFullTreeRequestHandler(RequestHandler cb) {
+        if (m_fullTreeRequestHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleFullTreeRequest, this,
+                              fullTreeRequestIn.getMessageType());
+        }
+        m_fullTreeRequestHandlers.push_back(cb);
+    }
+
+    void SystemComponent::registerBinaryTreeHandler(BinaryTreeHandler cb) {
+        if (m_binaryTreeHandlers.empty()) {
+            m_registerTreeStampHandler();
+            m_registerTreeFormatQueryHandler();
+            m_registerHandler(&SystemComponent::m_handleBinaryTree, this,
+                              binaryTreeOut.getMessageType());
+        }
+        m_binaryTreeHandlers.push_back(cb);
+    }
+
+    void SystemComponent::queryTreeFormats(std::size_t clients) {
+        if (0 == m_treeFormatQuery) {
+            m_registerHandler(&SystemComponent::m_handleTreeFormatReply, this,
+                              treeFormatReplyIn.getMessageType());
+        }
+        m_clients = clients;
+        m_binaryTreeClients = 0;
+        m_treeDeltaClients = 0;
+        Buffer<> buf;
+        messages::TreeFormatQueryFromServer::MessageSerialization msg(
+            ++m_treeFormatQuery);
+        serialize(buf, msg);
+        m_getParent().packMessage(buf, treeFormatQueryOut.getMessageType());
+    }
+
+    void SystemComponent::m_sendBinaryTree(PathTree &tree) {
+        Buffer<> buf;
+        pathTreeToBinary(tree, buf);
+        m_getParent().packMessage(buf, binaryTreeOut.getMessageType());
+
+        m_getParent().sendPending(); // as with a JSON tree.
+    }
+
+    void SystemComponent::m_registerTreeFormatQueryHandler() {
+        if (m_binaryTreeHandlers.empty() && m_treeDeltaHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeFormatQuery, this,
+                              treeFormatQueryOut.getMessageType());
+        }
+    }
+
+    void SystemComponent::m_registerTreeStampHandler() {
+        if (m_replaceTreeHandlers.empty() && m_binaryTreeHandlers.empty()) {
+            m_registerHandler(&SystemComponent::m_handleTreeStamp, this,
+                              treeStampOut.getMessageType());
+        }
+    }
+
+    bool SystemComponent::m_isRepeatedTree() {
+        // A stamp applies only to the tree right after it.
+        auto stamp = m_nextTreeStamp;
+        m_nextTreeStamp.reset();
+        auto repeated = stamp && m_treeStamp && *stamp == *m_treeStamp;
+        m_treeStamp = stamp;
+        return repeated;
+    }
+
+    bool SystemComponent::m_clientsSupportBinaryTree() const {
+        // With no clients connected, the only listeners might be local ones
+        // that never answer.
+        return m_clients > 0 && m_binaryTreeClients >= m_clients;
+    }
+
     void SystemComponent::m_parentSet() {
         m_getParent().registerMessageType(routesOut);
         m_getParent().registerMessageType(appStartup);
         m_getParent().registerMessageType(routeIn);
         m_getParent().registerMessageType(treeOut);
+        m_getParent().registerMessageType(treeStampOut);
+        m_getParent().registerMessageType(treeDeltaOut);
+        m_getParent().registerMessageType(fullTreeRequestIn);
+        m_getParent().registerMessageType(binaryTreeOut);
+        m_getParent().registerMessageType(treeFormatQueryOut);
+        m_getParent().registerMessageType(treeFormatReplyIn);
     }
 
     int SystemComponent::m_handleReplaceTree(void *userdata,
                                              vrpn_HANDLERPARAM p) {
         auto self = static_cast<SystemComponent *>(userdata);
+        if (self->m_isRepeatedTree()) {
+            return 0;
+        }
         auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
         messages::ReplacementTreeFromServer::MessageSerialization msg;
         deserialize(bufReader, msg);
@@ -169,5 +398,88 @@ namespace common {
         }
         return 0;
     }
+
+    int SystemComponent::m_handleTreeStamp(void *userdata,
+                                           vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeStampFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        self->m_nextTreeStamp = msg.getStamp();
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeDelta(void *userdata,
+                                           vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeDeltaFromServer::MessageSerialization msg;
+        deserialize(bufReader, msg);
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        BOOST_ASSERT_MSG(msg.getValue().isObject(),
+                         "tree delta message must be an object!");
+        for (auto const &cb : self->m_treeDeltaHandlers) {
+            cb(msg.getValue(), timestamp);
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleFullTreeRequest(void *userdata,
+                                                 vrpn_HANDLERPARAM) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        for (auto const &cb : self->m_fullTreeRequestHandlers) {
+            cb();
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleBinaryTree(void *userdata,
+                                            vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        if (self->m_isRepeatedTree()) {
+            return 0;
+        }
+        auto timestamp = util::time::fromStructTimeval(p.msg_time);
+        for (auto const &cb : self->m_binaryTreeHandlers) {
+            cb(p.buffer, p.payload_len, timestamp);
+        }
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeFormatQuery(void *userdata,
+                                                 vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeFormatQueryFromServer::MessageSerialization query;
+        deserialize(bufReader, query);
+
+        Buffer<> buf;
+        messages::TreeFormatReplyToServer::MessageSerialization reply(
+            query.getQuery(),
+            self->m_binaryTreeHandlers.empty() ? 0 : PATH_TREE_BINARY_VERSION,
+            self->m_treeDeltaHandlers.empty() ? 0 : PATH_TREE_DELTA_VERSION);
+        serialize(buf, reply);
+        self->m_getParent().packMessage(
+            buf, self->treeFormatReplyIn.getMessageType());
+        return 0;
+    }
+
+    int SystemComponent::m_handleTreeFormatReply(void *userdata,
+                                                 vrpn_HANDLERPARAM p) {
+        auto self = static_cast<SystemComponent *>(userdata);
+        auto bufReader = readExternalBuffer(p.buffer, p.payload_len);
+        messages::TreeFormatReplyToServer::MessageSerialization reply;
+        deserialize(bufReader, reply);
+        if (reply.getQuery() != self->m_treeFormatQuery) {
+            return 0;
+        }
+        if (reply.getBinaryVersion() == PATH_TREE_BINARY_VERSION) {
+            ++self->m_binaryTreeClients;
+        }
+        if (reply.getDeltaVersion() == PATH_TREE_DELTA_VERSION) {
+            ++self->m_treeDeltaClients;
+        }
+        return 0;
+    }
 } // namespace common
 } // namespace osvr
@@ -26,6 +26,10 @@
 #include <osvr/Common/Tracing.h>
 
 #ifdef OSVR_COMMON_TRACING_ENABLED
+#if OSVR_COMMON_TRACING_RINGLOG
+#include "TracingRingLog.h"
+#endif
+
 // Library/third-party includes
 #if OSVR_COMMON_TRACING_ETW
 #include <vrpn_WindowsH.h>
@@ -58,6 +62,44 @@ namespace common {
 
         void WorkerTracePolicy::mark(const char *text) { ETWWorkerMark(text); }
 #endif
+
+#if OSVR_COMMON_TRACING_RINGLOG
+        using ringlog::EventType;
+        using ringlog::Category;
+        TraceBeginStamp MainTracePolicy::begin(const char *text) {
+            auto stamp = ringlog::now();
+            ringlog::record(EventType::Begin, Category::Main, text, stamp);
+            return static_cast<TraceBeginStamp>(stamp);
+        }
+        void MainTracePolicy::end(const char *text, TraceBeginStamp) {
+            ringlog::record(EventType::End, Category::Main, text,
+                            ringlog::now());
+        }
+
+        void MainTracePolicy::mark(const char *text) {
+            ringlog::record(EventType::Mark, Category::Main, text,
+                            ringlog::now());
+        }
+
+        TraceBeginStamp WorkerTracePolicy::begin(const char *text) {
+            auto stamp = ringlog::now();
+            ringlog::record(EventType::Begin, Category::Worker, text, stamp);
+            return static_cast<TraceBeginStamp>(stamp);
+        }
+        void WorkerTracePolicy::end(const char *text, TraceBeginStamp) {
+            ringlog::record(EventType::End, Category::Worker, text,
+                            ringlog::now());
+        }
+
+        void WorkerTracePolicy::mark(const char *text) {
+            ringlog::record(EventType::Mark, Category::Worker, text,
+                            ringlog::now());
+        }
+
+        void writeChromeTrace(std::ostream &os) {
+            ringlog::writeChromeTrace(os);
+        }
+#endif
     } // namespace tracing
 } // namespace common
 } // namespace osvr
@@ -0,0 +1,305 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "TracingRingLog.h"
+
+#ifdef OSVR_COMMON_TRACING_RINGLOG
+#include <osvr/Common/GetEnvironmentVariable.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define OSVR_TRACING_HAVE_RDTSC
+#endif
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace osvr {
+namespace common {
+    namespace tracing {
+        namespace ringlog {
+            namespace {
+                /// @brief Events kept per thread: older ones are overwritten.
+                static const std::size_t EVENTS_PER_THREAD = 16384;
+
+                /// @brief Environment variable naming a file to write the
+                /// trace to at exit.
+                static const char TRACE_FILE_VARIABLE[] = "OSVR_TRACE_FILE";
+
+                /// @brief One cache line per event.
+                struct Event {
+                    Timestamp stamp;
+                    EventType type;
+                    Category category;
+                    char text[64 - sizeof(Timestamp) - 2];
+                };
+
+                inline uint64_t getCurrentThreadId() {
+#ifdef __linux__
+                    // Matches what perf and top show.
+                    return static_cast<uint64_t>(::syscall(SYS_gettid));
+#else
+                    static std::atomic<uint64_t> nextId(1);
+                    return nextId++;
+#endif
+                }
+
+                /// @brief A single thread's ring buffer: written only by
+                /// that thread, read by whoever writes the trace.
+                class ThreadLog : boost::noncopyable {
+                  public:
+                    ThreadLog()
+                        : m_threadId(getCurrentThreadId()),
+                          m_events(EVENTS_PER_THREAD), m_head(0) {}
+
+                    void record(EventType type, Category category,
+                                const char *text, Timestamp stamp) {
+                        auto head = m_head.load(std::memory_order_relaxed);
+                        auto &evt = m_events[head % m_events.size()];
+                        evt.stamp = stamp;
+                        evt.type = type;
+                        evt.category = category;
+                        std::strncpy(evt.text, text, sizeof(evt.text) - 1);
+                        evt.text[sizeof(evt.text) - 1] = '\0';
+                        m_head.store(head + 1, std::memory_order_release);
+                    }
+
+                    /// @brief Copy out the events, oldest first, leaving out
+                    /// any that the thread may have overwritten meanwhile.
+                    ///
+                    /// Doesn't synchronize with the thread beyond the head
+                    /// index: an event copied while being overwritten is
+                    /// discarded afterwards rather than prevented.
+                    std::vector<Event> snapshot() const {
+                        std::vector<Event> ret;
+                        auto const capacity = m_events.size();
+                        auto head = m_head.load(std::memory_order_acquire);
+                        auto begin = head > capacity ? head - capacity : 0;
+                        for (auto i = begin; i < head; ++i) {
+                            ret.push_back(m_events[i % capacity]);
+                        }
+                        auto newHead = m_head.load(std::memory_order_acquire);
+                        if (newHead > capacity &&
+                            newHead - capacity > begin) {
+                            auto overwritten = std::min<uint64_t>(
+                                newHead - capacity - begin, ret.size());
+                            ret.erase(ret.begin(),
+                                      ret.begin() + overwritten);
+                        }
+                        return ret;
+                    }
+
+                    uint64_t getThreadId() const { return m_threadId; }
+
+                  private:
+                    const uint64_t m_threadId;
+                    std::vector<Event> m_events;
+                    std::atomic<uint64_t> m_head;
+                };
+
+                inline void writeEscaped(std::ostream &os, const char *text) {
+                    for (; *text != '\0'; ++text) {
+                        auto c = *text;
+                        if (c == '"' || c == '\\') {
+                            os << '\\' << c;
+                        } else if (static_cast<unsigned char>(c) < 0x20) {
+                            os << ' ';
+                        } else {
+                            os << c;
+                        }
+                    }
+                }
+
+                /// @brief Owns all threads' logs, so that events from
+                /// threads that have exited can still be written out.
+                class Registry : boost::noncopyable {
+                  public:
+                    /// @brief Never destroyed, so that threads still
+                    /// running at exit can't record into freed memory.
+                    static Registry &instance() {
+                        static Registry *registry = new Registry;
+                        return *registry;
+                    }
+
+                    ThreadLog &getThreadLog() {
+                        static thread_local ThreadLog *log = nullptr;
+                        if (nullptr == log) {
+                            std::unique_ptr<ThreadLog> newLog(new ThreadLog);
+                            log = newLog.get();
+                            std::lock_guard<std::mutex> lock(m_mutex);
+                            m_logs.push_back(std::move(newLog));
+                        }
+                        return *log;
+                    }
+
+                    void writeChromeTrace(std::ostream &os) {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        auto ticksPerMicrosecond = m_calibrate();
+                        auto pid = m_getProcessId();
+                        os << "{\"traceEvents\":[";
+                        bool first = true;
+                        os << std::fixed << std::setprecision(3);
+                        for (auto const &log : m_logs) {
+                            unsigned depth = 0;
+                            for (auto const &evt : log->snapshot()) {
+                                const char *phase = "i";
+                                if (evt.type == EventType::Begin) {
+                                    phase = "B";
+                                    ++depth;
+                                } else if (evt.type == EventType::End) {
+                                    if (depth == 0) {
+                                        // Its begin was overwritten.
+                                        continue;
+                                    }
+                                    phase = "E";
+                                    --depth;
+                                }
+                                os << (first ? "\n" : ",\n");
+                                first = false;
+                                os << "{\"name\":\"";
+                                writeEscaped(os, evt.text);
+                                os << "\",\"cat\":\""
+                                   << (evt.category == Category::Main
+                                           ? "main"
+                                           : "worker")
+                                   << "\",\"ph\":\"" << phase
+                                   << "\",\"ts\":"
+                                   << m_toMicroseconds(evt.stamp,
+                                                       ticksPerMicrosecond)
+                                   << ",\"pid\":" << pid
+                                   << ",\"tid\":" << log->getThreadId();
+                                if (evt.type == EventType::Mark) {
+                                    os << ",\"s\":\"t\"";
+                                }
+                                os << "}";
+                            }
+                        }
+                        os << "\n],\"displayTimeUnit\":\"ns\"}\n";
+                    }
+
+                  private:
+                    typedef std::chrono::steady_clock clock;
+                    Registry()
+                        : m_startStamp(now()), m_startTime(clock::now()) {
+                        std::atexit(&Registry::writeTraceFileAtExit);
+                    }
+
+                    static void writeTraceFileAtExit() {
+                        auto filename =
+                            getEnvironmentVariable(TRACE_FILE_VARIABLE);
+                        if (!filename || filename->empty()) {
+                            return;
+                        }
+                        std::ofstream file(*filename);
+                        if (file) {
+                            instance().writeChromeTrace(file);
+                        }
+                    }
+
+                    /// @brief Work out the timestamp rate from the time
+                    /// elapsed since startup.
+                    double m_calibrate() {
+                        static const auto MIN_ELAPSED =
+                            std::chrono::milliseconds(10);
+                        if (clock::now() - m_startTime < MIN_ELAPSED) {
+                            std::this_thread::sleep_for(MIN_ELAPSED);
+                        }
+                        auto stamp = now();
+                        typedef std::chrono::duration<double, std::micro>
+                            microseconds;
+                        auto elapsed = std::chrono::duration_cast<
+                            microseconds>(clock::now() - m_startTime);
+                        return double(stamp - m_startStamp) / elapsed.count();
+                    }
+
+                    /// @brief Signed, since the first event is stamped
+                    /// before the registry exists.
+                    double m_toMicroseconds(Timestamp stamp,
+                                            double ticksPerMicrosecond) const {
+                        return double(static_cast<int64_t>(stamp -
+                                                           m_startStamp)) /
+                               ticksPerMicrosecond;
+                    }
+
+                    static uint64_t m_getProcessId() {
+#ifdef __linux__
+                        return static_cast<uint64_t>(::getpid());
+#else
+                        return 1;
+#endif
+                    }
+
+                    std::mutex m_mutex;
+                    std::vector<std::unique_ptr<ThreadLog> > m_logs;
+                    const Timestamp m_startStamp;
+                    const clock::time_point m_startTime;
+                };
+            } // namespace
+
+            Timestamp now() {
+#ifdef OSVR_TRACING_HAVE_RDTSC
+                return __rdtsc();
+#else
+                auto sinceEpoch =
+                    std::chrono::steady_clock::now().time_since_epoch();
+                return static_cast<Timestamp>(sinceEpoch.count());
+#endif
+            }
+
+            void record(EventType type, Category category, const char *text,
+                        Timestamp stamp) {
+                Registry::instance().getThreadLog().record(type, category,
+                                                           text, stamp);
+            }
+
+            void writeChromeTrace(std::ostream &os) {
+                Registry::instance().writeChromeTrace(os);
+            }
+        } // namespace ringlog
+    }     // namespace tracing
+} // namespace common
+} // namespace osvr
+
+#endif // OSVR_COMMON_TRACING_RINGLOG
@@ -0,0 +1,69 @@
+/** @file
+    @brief Header for the tracing backend that records events into per-thread
+    in-memory ring buffers.
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_TracingRingLog_h_GUID_76C3E912_BAB0_4A0B_9D8B_157DB84B978D
+#define INCLUDED_TracingRingLog_h_GUID_76C3E912_BAB0_4A0B_9D8B_157DB84B978D
+
+// Internal Includes
+#include <osvr/Common/TracingConfig.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#include <iosfwd>
+
+#ifdef OSVR_COMMON_TRACING_RINGLOG
+namespace osvr {
+namespace common {
+    namespace tracing {
+        namespace ringlog {
+            enum class EventType : uint8_t { Begin, End, Mark };
+            enum class Category : uint8_t { Main, Worker };
+
+            /// @brief Raw timestamp: the CPU timestamp counter where
+            /// available, otherwise steady_clock ticks.
+            typedef uint64_t Timestamp;
+
+            Timestamp now();
+
+            /// @brief Record an event in the calling thread's ring buffer.
+            ///
+            /// Never blocks or allocates, except the first time a thread
+            /// records an event. The text is copied (and possibly truncated).
+            void record(EventType type, Category category, const char *text,
+                        Timestamp stamp);
+
+            /// @brief Write the events still in all threads' ring buffers as
+            /// Chrome trace-event JSON.
+            void writeChromeTrace(std::ostream &os);
+        } // namespace ringlog
+    }     // namespace tracing
+} // namespace common
+} // namespace osvr
+#endif // OSVR_COMMON_TRACING_RINGLOG
+
+#endif // INCLUDED_TracingRingLog_h_GUID_76C3E912_BAB0_4A0B_9D8B_157DB84B978D
@@ -0,0 +1,60 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/ActivitySignal.h>
+
+// Library/third-party includes
+#include <boost/thread/locks.hpp>
+#include <boost/chrono/duration.hpp>
+
+// Standard includes
+// - none
+
+namespace osvr {
+namespace connection {
+    ActivitySignal::ActivitySignal() : m_pending(false) {}
+
+    void ActivitySignal::signal() {
+        {
+            boost::lock_guard<boost::mutex> lock(m_mutex);
+            m_pending = true;
+        }
+        m_cond.notify_one();
+    }
+
+    bool ActivitySignal::wait(int timeoutMicroseconds) {
+        boost::unique_lock<boost::mutex> lock(m_mutex);
+        if (!m_pending && timeoutMicroseconds > 0) {
+            m_cond.wait_for(lock,
+                            boost::chrono::microseconds(timeoutMicroseconds),
+                            [&] { return m_pending; });
+        }
+        auto ret = m_pending;
+        m_pending = false;
+        return ret;
+    }
+
+} // namespace connection
+} // namespace osvr
@@ -80,6 +80,9 @@ namespace connection {
             m_sharedRts = true;
             m_sharedDone = false;
             m_calledRequest = true;
+            if (m_control.m_notifier) {
+                m_control.m_notifier();
+            }
             /// Take the main thread "free to go" status lock.
             {
                 m_lockDone.lock();
@@ -106,8 +109,9 @@ namespace connection {
         }
     }
 
-    AsyncAccessControl::AsyncAccessControl()
-        : m_rts(false), m_done(false), m_mainMessage(MTM_WAIT) {}
+    AsyncAccessControl::AsyncAccessControl(RequestNotifier const &notifier)
+        : m_notifier(notifier), m_rts(false), m_done(false),
+          m_mainMessage(MTM_WAIT) {}
 
     bool AsyncAccessControl::mainThreadCTS() {
         MainLockType lock(m_mut);
@@ -26,7 +26,7 @@
 #define INCLUDED_AsyncAccessControl_h_GUID_4255BCEE_826C_4DB4_9368_9457ADBF9456
 
 // Internal Includes
-// - none
+#include <osvr/Util/GuardInterface.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -34,7 +34,7 @@
 #include <boost/optional/optional.hpp>
 
 // Standard includes
-// - none
+#include <functional>
 
 namespace osvr {
 namespace connection {
@@ -44,8 +44,13 @@ namespace connection {
     /// bus.
     class AsyncAccessControl : boost::noncopyable {
       public:
+        /// @brief Function called from the async thread once it has raised
+        /// a request to send, so the main thread can be woken to service it.
+        typedef std::function<void()> RequestNotifier;
+
         /// @brief Constructor
-        AsyncAccessControl();
+        explicit AsyncAccessControl(
+            RequestNotifier const &notifier = RequestNotifier());
 
         /// @name
         /// @brief Check for waiting async thread, and give it permission to
@@ -82,6 +87,8 @@ namespace connection {
         typedef boost::unique_lock<MainMutexType> MainLockType;
         MainMutexType m_mut;
 
+        RequestNotifier m_notifier;
+
         /// @brief Shared code to handle an RTS and send a message.
         ///
         /// Blocks until the message is handled (the RTS object is destroyed),
@@ -173,6 +180,18 @@ namespace connection {
         boost::condition_variable_any &m_condAsyncThread;
         /// @}
     };
+
+    /// @brief Send guard for a device whose thread must request to send
+    /// through an AsyncAccessControl.
+    class AsyncSendGuard : public util::GuardInterface {
+      public:
+        AsyncSendGuard(AsyncAccessControl &control) : m_rts(control) {}
+        virtual bool lock() { return m_rts.request(); }
+        virtual ~AsyncSendGuard() {}
+
+      private:
+        RequestToSend m_rts;
+    };
 } // namespace connection
 } // namespace osvr
 
@@ -27,6 +27,7 @@
 // Internal Includes
 #include "AsyncDeviceToken.h"
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/Connection.h>
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -40,8 +41,10 @@ namespace connection {
     using boost::unique_lock;
     using boost::mutex;
 
-    AsyncDeviceToken::AsyncDeviceToken(std::string const &name)
-        : OSVR_DeviceTokenObject(name) {}
+    AsyncDeviceToken::AsyncDeviceToken(std::string const &name,
+                                       AsyncQueueOptions const &queueOpts)
+        : OSVR_DeviceTokenObject(name), m_queue(queueOpts),
+          m_accessControl([this] { m_signalActivity(); }) {}
 
     AsyncDeviceToken::~AsyncDeviceToken() {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
@@ -54,6 +57,7 @@ namespace connection {
         OSVR_DEV_VERBOSE("AsyncDeviceToken\t"
                          "In signalShutdown");
         m_run.signalShutdown();
+        m_queue.close();
         m_accessControl.mainThreadDenyPermanently();
     }
 
@@ -105,33 +109,23 @@ namespace connection {
     void AsyncDeviceToken::m_sendData(util::time::TimeValue const &timestamp,
                                       MessageType *type, const char *bytestream,
                                       size_t len) {
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "about to create RTS object");
-        RequestToSend rts(m_accessControl);
-
-        bool clear = rts.request();
-        if (!clear) {
+        bool queued = m_queue.push(timestamp, type, bytestream, len);
+        if (!queued) {
             OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                             "RTS request responded with not clear to send.");
+                             "Report dropped: queue full or closed.");
             return;
         }
-
-        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "Have CTS!");
-        m_getConnectionDevice()->sendData(timestamp, type, bytestream, len);
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_sendData\t"
-                         "done!");
+                         "Report queued.");
+        m_signalActivity();
     }
 
-    class AsyncSendGuard : public util::GuardInterface {
-      public:
-        AsyncSendGuard(AsyncAccessControl &control) : m_rts(control) {}
-        virtual bool lock() { return m_rts.request(); }
-        virtual ~AsyncSendGuard() {}
-
-      private:
-        RequestToSend m_rts;
-    };
+    void AsyncDeviceToken::m_signalActivity() {
+        auto conn = m_getConnection();
+        if (conn) {
+            conn->signalActivity();
+        }
+    }
 
     util::GuardPtr AsyncDeviceToken::m_getSendGuard() {
         util::GuardPtr ret(new AsyncSendGuard(m_accessControl));
@@ -140,6 +134,15 @@ namespace connection {
 
     void AsyncDeviceToken::m_connectionInteract() {
         m_ensureThreadStarted();
+        auto dev = m_getConnectionDevice();
+        auto sent = m_queue.drain([&](QueuedReport const &report) {
+            dev->sendData(report.timestamp, report.type,
+                          report.data.empty() ? nullptr : report.data.data(),
+                          report.data.size());
+        });
+        OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
+                         "Sent " << sent << " queued reports");
+        (void)sent;
         OSVR_DEV_VERBOSE("AsyncDeviceToken::m_connectionInteract\t"
                          "Going to send a CTS if waiting");
         bool handled = m_accessControl.mainThreadCTS();
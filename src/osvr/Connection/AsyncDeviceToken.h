@@ -28,7 +28,9 @@
 // Internal Includes
 #include <osvr/Connection/DeviceToken.h>
 #include <osvr/Util/CallbackWrapper.h>
+#include <osvr/Connection/AsyncQueueOptions.h>
 #include "AsyncAccessControl.h"
+#include "AsyncReportQueue.h"
 
 // Library/third-party includes
 #include <boost/thread.hpp>
@@ -41,7 +43,8 @@ namespace osvr {
 namespace connection {
     class AsyncDeviceToken : public OSVR_DeviceTokenObject {
       public:
-        AsyncDeviceToken(std::string const &name);
+        AsyncDeviceToken(std::string const &name,
+                         AsyncQueueOptions const &queueOpts);
         virtual ~AsyncDeviceToken();
 
         void signalShutdown();
@@ -52,23 +55,33 @@ namespace connection {
         /// The thread will be launched as soon as the first connection
         /// interaction occurs.
         void m_setUpdateCallback(DeviceUpdateCallback const &cb) override;
-        /// Called from the async thread - only permitted to actually
-        /// send data when m_connectionInteract says so.
+        /// Called from the async thread - copies the data into the report
+        /// queue for m_connectionInteract to send.
         void m_sendData(util::time::TimeValue const &timestamp,
                         MessageType *type, const char *bytestream,
                         size_t len) override;
         util::GuardPtr m_getSendGuard() override;
 
-        /// Called from the main thread - services requests to send from
-        /// the async thread.
+        /// Called from the main thread - sends all queued reports, then
+        /// services requests to send from the async thread.
         void m_connectionInteract() override;
 
         void m_stopThreads() override;
 
         void m_ensureThreadStarted();
+
+        /// @brief Called from the async thread - wakes the main loop if it is
+        /// waiting for activity, since we have something for it.
+        void m_signalActivity();
+
         DeviceUpdateCallback m_cb;
         unique_ptr<boost::thread> m_callbackThread;
 
+        /// @brief Reports sent through m_sendData
+        AsyncReportQueue m_queue;
+
+        /// @brief Handshake still used for send guards, since those let the
+        /// device thread call directly into the connection.
         AsyncAccessControl m_accessControl;
 
         ::util::RunLoopManagerBoost m_run;
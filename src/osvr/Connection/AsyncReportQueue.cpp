@@ -0,0 +1,151 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "AsyncReportQueue.h"
+
+// Library/third-party includes
+#include <boost/assert.hpp>
+
+// Standard includes
+#include <algorithm>
+
+namespace osvr {
+namespace connection {
+    const AsyncReportQueue::index_type AsyncReportQueue::NOT_READING;
+
+    AsyncReportQueue::AsyncReportQueue(AsyncQueueOptions const &opts)
+        : m_capacity((std::max)(opts.capacity, std::size_t(1))),
+          m_policy(opts.policy), m_slots(m_capacity + 1), m_head(0),
+          m_tail(0), m_reading(NOT_READING), m_currentRead(NOT_READING),
+          m_dropped(0), m_closed(false), m_producerWaiting(false) {}
+
+    bool AsyncReportQueue::push(util::time::TimeValue const &timestamp,
+                                MessageType *type, const char *bytestream,
+                                size_t len) {
+        if (m_closed) {
+            return false;
+        }
+        auto head = m_head.load(std::memory_order_relaxed);
+        while (true) {
+            auto tail = m_tail.load();
+            if (head - tail < m_capacity) {
+                break;
+            }
+            // Full.
+            switch (m_policy) {
+            case AsyncQueueFullPolicy::DropNewest:
+                ++m_dropped;
+                return false;
+            case AsyncQueueFullPolicy::Block:
+                if (!m_waitForSpace()) {
+                    return false;
+                }
+                break;
+            case AsyncQueueFullPolicy::DropOldest:
+                // Might lose the race against the consumer retiring this
+                // one, which is just as good.
+                if (m_tail.compare_exchange_strong(tail, tail + 1)) {
+                    ++m_dropped;
+                }
+                break;
+            }
+        }
+
+        /// Having dropped older reports, the slot we want to write could be
+        /// one the consumer was already reading when it got dropped: if so,
+        /// our only choice is to drop this report instead.
+        auto reading = m_reading.load();
+        if (reading != NOT_READING &&
+            (reading % m_slots.size()) == (head % m_slots.size())) {
+            ++m_dropped;
+            return false;
+        }
+
+        QueuedReport &slot = m_slot(head);
+        slot.timestamp = timestamp;
+        slot.type = type;
+        slot.data.assign(bytestream, bytestream + len);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    void AsyncReportQueue::close() {
+        m_closed = true;
+        boost::lock_guard<boost::mutex> lock(m_waitMutex);
+        m_spaceAvailable.notify_all();
+    }
+
+    std::size_t AsyncReportQueue::size() const {
+        auto tail = m_tail.load();
+        auto head = m_head.load();
+        return head > tail ? static_cast<std::size_t>(head - tail) : 0;
+    }
+
+    bool AsyncReportQueue::m_waitForSpace() {
+        boost::unique_lock<boost::mutex> lock(m_waitMutex);
+        m_producerWaiting = true;
+        auto head = m_head.load(std::memory_order_relaxed);
+        while (!m_closed && head - m_tail.load() >= m_capacity) {
+            m_spaceAvailable.wait(lock);
+        }
+        m_producerWaiting = false;
+        return !m_closed;
+    }
+
+    void AsyncReportQueue::m_notifySpace() {
+        if (m_producerWaiting) {
+            boost::lock_guard<boost::mutex> lock(m_waitMutex);
+            m_spaceAvailable.notify_one();
+        }
+    }
+
+    QueuedReport const *AsyncReportQueue::m_beginRead() {
+        BOOST_ASSERT_MSG(m_currentRead == NOT_READING,
+                         "Can't begin a read while one is in progress!");
+        while (true) {
+            auto tail = m_tail.load();
+            if (tail == m_head.load(std::memory_order_acquire)) {
+                m_reading = NOT_READING;
+                return nullptr;
+            }
+            // Announce, then confirm the producer didn't drop it first.
+            m_reading = tail;
+            if (m_tail.load() == tail) {
+                m_currentRead = tail;
+                return &m_slot(tail);
+            }
+        }
+    }
+
+    void AsyncReportQueue::m_endRead() {
+        auto expected = m_currentRead;
+        // Fails harmlessly if the producer dropped this one while we read it.
+        m_tail.compare_exchange_strong(expected, m_currentRead + 1);
+        m_reading = NOT_READING;
+        m_currentRead = NOT_READING;
+    }
+
+} // namespace connection
+} // namespace osvr
@@ -0,0 +1,160 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_AsyncReportQueue_h_GUID_5C0E7D0B_4D8A_4F6B_9E55_2B3F1E0A7C41
+#define INCLUDED_AsyncReportQueue_h_GUID_5C0E7D0B_4D8A_4F6B_9E55_2B3F1E0A7C41
+
+// Internal Includes
+#include <osvr/Connection/AsyncQueueOptions.h>
+#include <osvr/Connection/MessageTypePtr.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// Standard includes
+#include <atomic>
+#include <vector>
+#include <cstddef>
+
+namespace osvr {
+namespace connection {
+    /// @brief A report serialized by an async device thread, waiting to be
+    /// sent by the main thread.
+    struct QueuedReport {
+        QueuedReport() : type(nullptr) {}
+        util::time::TimeValue timestamp;
+        MessageType *type;
+        /// @brief Serialized message - capacity is retained when the slot is
+        /// reused, so steady-state operation does not allocate.
+        std::vector<char> data;
+    };
+
+    /// @brief Bounded, lock-free, single-producer/single-consumer queue of
+    /// reports from an async device thread (producer) to the server main
+    /// thread (consumer).
+    ///
+    /// Indices are monotonically increasing 64-bit counters, mapped into a
+    /// slot array one larger than the capacity. To support dropping the
+    /// oldest report, the producer may advance the read index itself, so the
+    /// consumer announces the index it is reading before touching a slot,
+    /// and the producer will never write over an announced slot.
+    class AsyncReportQueue : boost::noncopyable {
+      public:
+        explicit AsyncReportQueue(
+            AsyncQueueOptions const &opts = AsyncQueueOptions());
+
+        /// @brief Called from the device thread: copy a report into the queue.
+        ///
+        /// Only blocks if the policy is AsyncQueueFullPolicy::Block and the
+        /// queue is full.
+        ///
+        /// @returns true if this report was queued, false if it was dropped
+        /// or the queue has been closed.
+        bool push(util::time::TimeValue const &timestamp, MessageType *type,
+                  const char *bytestream, size_t len);
+
+        /// @brief Called from the main thread: invoke @p f on every report
+        /// currently queued, oldest first, removing each once handled.
+        ///
+        /// @returns the number of reports handled.
+        template <typename F> std::size_t drain(F &&f) {
+            std::size_t handled = 0;
+            QueuedReport const *report = nullptr;
+            while (nullptr != (report = m_beginRead())) {
+                f(*report);
+                m_endRead();
+                ++handled;
+            }
+            if (handled > 0) {
+                m_notifySpace();
+            }
+            return handled;
+        }
+
+        /// @brief Close the queue: future pushes fail, and a device thread
+        /// blocked in push() is released.
+        void close();
+
+        /// @brief Number of reports currently pending (approximate if called
+        /// during a push or drain).
+        std::size_t size() const;
+
+        /// @brief Total number of reports discarded due to a full queue.
+        ///
+        /// Approximate: with the drop-oldest policy, a report that the main
+        /// thread was already sending when it was dropped is counted too.
+        uint64_t droppedCount() const { return m_dropped.load(); }
+
+        std::size_t capacity() const { return m_capacity; }
+
+      private:
+        typedef uint64_t index_type;
+        static const index_type NOT_READING = ~index_type(0);
+
+        QueuedReport &m_slot(index_type i) {
+            return m_slots[static_cast<std::size_t>(i % m_slots.size())];
+        }
+
+        /// @brief Wait until there is space or the queue is closed.
+        /// @returns false if the queue was closed.
+        bool m_waitForSpace();
+        void m_notifySpace();
+
+        /// @brief Announce and return the oldest report, or nullptr if empty.
+        QueuedReport const *m_beginRead();
+        /// @brief Retire the report returned by m_beginRead()
+        void m_endRead();
+
+        std::size_t const m_capacity;
+        AsyncQueueFullPolicy const m_policy;
+        std::vector<QueuedReport> m_slots;
+
+        /// @brief Next index to write - only modified by the producer.
+        std::atomic<index_type> m_head;
+        /// @brief Next index to read - advanced by the consumer, or by the
+        /// producer when dropping the oldest report.
+        std::atomic<index_type> m_tail;
+        /// @brief Index the consumer is currently reading, or NOT_READING
+        std::atomic<index_type> m_reading;
+        /// @brief Consumer-private copy of the index being read.
+        index_type m_currentRead;
+
+        std::atomic<uint64_t> m_dropped;
+        std::atomic<bool> m_closed;
+
+        /// @name Slow path used only by the blocking policy
+        /// @{
+        std::atomic<bool> m_producerWaiting;
+        boost::mutex m_waitMutex;
+        boost::condition_variable m_spaceAvailable;
+        /// @}
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_AsyncReportQueue_h_GUID_5C0E7D0B_4D8A_4F6B_9E55_2B3F1E0A7C41
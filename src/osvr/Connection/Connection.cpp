@@ -30,6 +30,7 @@
 #include <osvr/Connection/MessageType.h>
 #include "VrpnBasedConnection.h"
 #include "GenericConnectionDevice.h"
+#include "SyncDeviceWorkers.h"
 #include <osvr/Util/Verbosity.h>
 
 // Library/third-party includes
@@ -37,7 +38,7 @@
 #include <boost/assert.hpp>
 
 // Standard includes
-// - none
+#include <stdexcept>
 
 namespace osvr {
 namespace connection {
@@ -161,7 +162,34 @@ namespace connection {
         }
     }
 
-    Connection::Connection() {}
+    void Connection::signalActivity() { m_activity->signal(); }
+
+    bool Connection::waitForActivity(int timeoutMicroseconds) {
+        return m_activity->wait(timeoutMicroseconds);
+    }
+
+    ActivitySignalPtr Connection::getActivitySignal() const {
+        return m_activity;
+    }
+
+    void Connection::setSyncDeviceThreadOptions(
+        SyncDeviceThreadOptions const &opts) {
+        if (m_syncDeviceWorkers) {
+            throw std::logic_error("Can't change sync device threading once "
+                                   "sync devices have started running!");
+        }
+        m_syncDeviceThreadOptions = opts;
+    }
+
+    SyncDeviceWorkers &Connection::getSyncDeviceWorkers() {
+        if (!m_syncDeviceWorkers) {
+            m_syncDeviceWorkers.reset(
+                new SyncDeviceWorkers(m_syncDeviceThreadOptions));
+        }
+        return *m_syncDeviceWorkers;
+    }
+
+    Connection::Connection() : m_activity(make_shared<ActivitySignal>()) {}
 
     Connection::~Connection() {}
 
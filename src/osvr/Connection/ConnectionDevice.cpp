@@ -30,10 +30,13 @@
 #include <boost/assert.hpp>
 
 // Standard includes
-// - none
+#include <atomic>
 
 namespace osvr {
 namespace connection {
+    /// @brief Source of descriptor revisions, shared by all devices so that
+    /// a revision identifies one descriptor of one device.
+    static std::atomic<uint64_t> lastDescriptorRevision(0);
 
     ConnectionDevice::~ConnectionDevice() {}
 
@@ -46,10 +49,10 @@ namespace connection {
     }
 
     ConnectionDevice::ConnectionDevice(std::string const &name)
-        : m_names(1, name), m_token(nullptr) {}
+        : m_names(1, name), m_token(nullptr), m_descriptorRevision(0) {}
 
     ConnectionDevice::ConnectionDevice(ConnectionDevice::NameList const &names)
-        : m_names(names), m_token(nullptr) {}
+        : m_names(names), m_token(nullptr), m_descriptorRevision(0) {}
 
     void ConnectionDevice::process() { m_process(); }
 
@@ -67,13 +70,21 @@ namespace connection {
 
     void ConnectionDevice::setDeviceDescriptor(std::string const &jsonString) {
         /// @todo validate descriptor here
+        if (jsonString == m_descriptor && m_descriptorRevision != 0) {
+            return;
+        }
         m_descriptor = jsonString;
+        m_descriptorRevision = ++lastDescriptorRevision;
     }
 
     std::string const &ConnectionDevice::getDeviceDescriptor() const {
         return m_descriptor;
     }
 
+    uint64_t ConnectionDevice::getDeviceDescriptorRevision() const {
+        return m_descriptorRevision;
+    }
+
     bool ConnectionDevice::m_hasDeviceToken() const {
         return m_token != nullptr;
     }
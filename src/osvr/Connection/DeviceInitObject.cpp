@@ -110,6 +110,11 @@ void OSVR_DeviceInitObject::addComponent(
     osvr::common::DeviceComponentPtr const &comp) {
     m_components.push_back(comp);
 }
+void OSVR_DeviceInitObject::setAsyncQueueOptions(
+    osvr::connection::AsyncQueueOptions const &opts) {
+    m_asyncQueueOptions = opts;
+}
+
 void OSVR_DeviceInitObject::returnTrackerInterface(
     osvr::connection::TrackerServerInterface &iface) {
     *m_trackerIface = &iface;
@@ -49,14 +49,16 @@ using osvr::util::GuardPtr;
 
 DeviceTokenPtr
 OSVR_DeviceTokenObject::createAsyncDevice(DeviceInitObject &init) {
-    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName()));
+    DeviceTokenPtr ret(new AsyncDeviceToken(init.getQualifiedName(),
+                                            init.getAsyncQueueOptions()));
     ret->m_sharedInit(init);
     return ret;
 }
 
 DeviceTokenPtr
 OSVR_DeviceTokenObject::createSyncDevice(DeviceInitObject &init) {
-    DeviceTokenPtr ret(new SyncDeviceToken(init.getQualifiedName()));
+    DeviceTokenPtr ret(new SyncDeviceToken(init.getQualifiedName(),
+                                           init.getAsyncQueueOptions()));
     ret->m_sharedInit(init);
     return ret;
 }
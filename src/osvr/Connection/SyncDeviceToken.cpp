@@ -27,6 +27,7 @@
 // Internal Includes
 #include "SyncDeviceToken.h"
 #include <osvr/Connection/ConnectionDevice.h>
+#include <osvr/Connection/Connection.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Util/GuardInterfaceDummy.h>
 
@@ -39,10 +40,13 @@
 namespace osvr {
 namespace connection {
 
-    SyncDeviceToken::SyncDeviceToken(std::string const &name)
-        : OSVR_DeviceTokenObject(name) {}
+    SyncDeviceToken::SyncDeviceToken(std::string const &name,
+                                     AsyncQueueOptions const &queueOpts)
+        : OSVR_DeviceTokenObject(name), m_checkedForWorker(false),
+          m_pooled(false), m_queue(queueOpts),
+          m_accessControl([this] { m_signalActivity(); }) {}
 
-    SyncDeviceToken::~SyncDeviceToken() {}
+    SyncDeviceToken::~SyncDeviceToken() { m_stopThreads(); }
 
     void SyncDeviceToken::m_setUpdateCallback(DeviceUpdateCallback const &cb) {
         OSVR_DEV_VERBOSE("In SyncDeviceToken::m_setUpdateCallback");
@@ -52,16 +56,77 @@ namespace connection {
     void SyncDeviceToken::m_sendData(util::time::TimeValue const &timestamp,
                                      MessageType *type, const char *bytestream,
                                      size_t len) {
-        m_getConnectionDevice()->sendData(timestamp, type, bytestream, len);
+        if (!m_onWorkerThread()) {
+            m_getConnectionDevice()->sendData(timestamp, type, bytestream,
+                                              len);
+            return;
+        }
+        bool queued = m_queue.push(timestamp, type, bytestream, len);
+        if (!queued) {
+            OSVR_DEV_VERBOSE("SyncDeviceToken::m_sendData\t"
+                             "Report dropped: queue full or closed.");
+            return;
+        }
+        m_signalActivity();
     }
 
     util::GuardPtr SyncDeviceToken::m_getSendGuard() {
+        if (m_onWorkerThread()) {
+            return util::GuardPtr(new AsyncSendGuard(m_accessControl));
+        }
         return util::GuardPtr(new util::DummyGuard);
     }
 
     void SyncDeviceToken::m_connectionInteract() {
-        if (m_cb) {
-            m_cb();
+        if (!m_checkedForWorker) {
+            m_checkedForWorker = true;
+            m_mainThread = boost::this_thread::get_id();
+            auto &workers = m_getConnection()->getSyncDeviceWorkers();
+            // Must be set before the worker might call back.
+            m_pooled = workers.size() > 0;
+            m_worker = workers.add(
+                getName(), [this] {
+                    if (m_cb) {
+                        m_cb();
+                    }
+                });
+        }
+        if (!m_worker) {
+            if (m_cb) {
+                m_cb();
+            }
+            return;
+        }
+
+        // Send what the worker queued since last time, then have it run the
+        // callback again.
+        auto dev = m_getConnectionDevice();
+        m_queue.drain([&](QueuedReport const &report) {
+            dev->sendData(report.timestamp, report.type,
+                          report.data.empty() ? nullptr : report.data.data(),
+                          report.data.size());
+        });
+        m_worker->kick();
+        m_accessControl.mainThreadCTS();
+    }
+
+    void SyncDeviceToken::m_stopThreads() {
+        if (m_worker) {
+            m_queue.close();
+            // So a callback waiting to send doesn't keep us waiting forever.
+            m_accessControl.mainThreadDenyPermanently();
+            m_worker.reset();
+        }
+    }
+
+    bool SyncDeviceToken::m_onWorkerThread() const {
+        return m_pooled && boost::this_thread::get_id() != m_mainThread;
+    }
+
+    void SyncDeviceToken::m_signalActivity() {
+        auto conn = m_getConnection();
+        if (conn) {
+            conn->signalActivity();
         }
     }
 
@@ -27,18 +27,30 @@
 
 // Internal Includes
 #include <osvr/Connection/DeviceToken.h>
+#include <osvr/Connection/AsyncQueueOptions.h>
+#include "AsyncAccessControl.h"
+#include "AsyncReportQueue.h"
+#include "SyncDeviceWorkers.h"
 
 // Library/third-party includes
-// - none
+#include <boost/thread/thread.hpp>
 
 // Standard includes
 // - none
 
 namespace osvr {
 namespace connection {
+    /// @brief Device token whose update callback is called once per
+    /// server main loop iteration.
+    ///
+    /// Normally the callback runs in the main loop itself. If the connection
+    /// has sync device worker threads, it runs on one of those instead:
+    /// reports are then queued for the main thread to send (as with async
+    /// devices), and send guards request to send from the main thread.
     class SyncDeviceToken : public OSVR_DeviceTokenObject {
       public:
-        SyncDeviceToken(std::string const &name);
+        SyncDeviceToken(std::string const &name,
+                        AsyncQueueOptions const &queueOpts);
         virtual ~SyncDeviceToken();
 
       protected:
@@ -48,9 +60,30 @@ namespace connection {
                         size_t len) override;
         util::GuardPtr m_getSendGuard() override;
         void m_connectionInteract() override;
+        void m_stopThreads() override;
 
       private:
+        /// @brief Are we running on a worker, and called from its thread?
+        bool m_onWorkerThread() const;
+        void m_signalActivity();
+
         DeviceUpdateCallback m_cb;
+
+        /// @brief Whether we've asked the connection for a worker yet.
+        bool m_checkedForWorker;
+        /// @brief Whether we've been given a worker - unlike m_worker, not
+        /// reset when stopping, so safe to check from the worker thread.
+        bool m_pooled;
+        /// @brief Our place on a worker thread, if any.
+        SyncDeviceWorkers::RegistrationPtr m_worker;
+        /// @brief The main thread, known once we have a worker.
+        boost::thread::id m_mainThread;
+
+        /// @name Only used when on a worker thread
+        /// @{
+        AsyncReportQueue m_queue;
+        AsyncAccessControl m_accessControl;
+        /// @}
     };
 } // namespace connection
 } // namespace osvr
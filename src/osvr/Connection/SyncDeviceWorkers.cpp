@@ -0,0 +1,195 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "SyncDeviceWorkers.h"
+#include <osvr/Util/Verbosity.h>
+
+// Library/third-party includes
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+
+namespace osvr {
+namespace connection {
+    namespace detail {
+        /// @brief A device on a worker.
+        struct SyncDeviceWorkerEntry {
+            explicit SyncDeviceWorkerEntry(std::function<void()> const &f)
+                : update(f), removed(false) {}
+            std::function<void()> update;
+            std::atomic<bool> removed;
+            /// @brief Held by the worker while calling update.
+            boost::mutex running;
+        };
+        typedef shared_ptr<SyncDeviceWorkerEntry> SyncDeviceWorkerEntryPtr;
+
+        class SyncDeviceWorker : boost::noncopyable {
+          public:
+            SyncDeviceWorker()
+                : m_pending(false), m_stop(false),
+                  m_thread([&] { m_run(); }) {}
+
+            ~SyncDeviceWorker() {
+                {
+                    boost::lock_guard<boost::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                m_cond.notify_one();
+                m_thread.join();
+            }
+
+            void add(SyncDeviceWorkerEntryPtr const &entry) {
+                boost::lock_guard<boost::mutex> lock(m_mutex);
+                m_entries.push_back(entry);
+            }
+
+            void kick() {
+                {
+                    boost::lock_guard<boost::mutex> lock(m_mutex);
+                    m_pending = true;
+                }
+                m_cond.notify_one();
+            }
+
+          private:
+            void m_run() {
+                std::vector<SyncDeviceWorkerEntryPtr> entries;
+                while (true) {
+                    {
+                        boost::unique_lock<boost::mutex> lock(m_mutex);
+                        while (!m_pending && !m_stop) {
+                            m_cond.wait(lock);
+                        }
+                        if (m_stop) {
+                            return;
+                        }
+                        m_pending = false;
+                        m_entries.erase(
+                            std::remove_if(begin(m_entries), end(m_entries),
+                                           [](SyncDeviceWorkerEntryPtr const &
+                                                  entry) {
+                                               return bool(entry->removed);
+                                           }),
+                            end(m_entries));
+                        entries = m_entries;
+                    }
+                    /// Each entry is locked separately, so removing one device
+                    /// never waits on another device's update (which might be
+                    /// waiting on the main thread).
+                    for (auto &entry : entries) {
+                        boost::lock_guard<boost::mutex> lock(entry->running);
+                        if (!entry->removed) {
+                            entry->update();
+                        }
+                    }
+                    entries.clear();
+                }
+            }
+
+            boost::mutex m_mutex;
+            boost::condition_variable m_cond;
+            bool m_pending;
+            bool m_stop;
+            std::vector<SyncDeviceWorkerEntryPtr> m_entries;
+            /// @brief Last, so everything else is initialized before the
+            /// thread starts.
+            boost::thread m_thread;
+        };
+    } // namespace detail
+
+    SyncDeviceWorkers::Registration::Registration(
+        detail::SyncDeviceWorker &worker, EntryPtr const &entry)
+        : m_worker(worker), m_entry(entry) {}
+
+    SyncDeviceWorkers::Registration::~Registration() {
+        m_entry->removed = true;
+        // Wait out an update in progress: the worker prunes the entry later.
+        boost::lock_guard<boost::mutex> lock(m_entry->running);
+    }
+
+    void SyncDeviceWorkers::Registration::kick() { m_worker.kick(); }
+
+    SyncDeviceWorkers::SyncDeviceWorkers(SyncDeviceThreadOptions const &opts)
+        : m_opts(opts) {
+        for (std::size_t i = 0; i < m_opts.threads; ++i) {
+            m_workers.emplace_back(new detail::SyncDeviceWorker);
+        }
+    }
+
+    SyncDeviceWorkers::~SyncDeviceWorkers() {}
+
+    SyncDeviceWorkers::RegistrationPtr
+    SyncDeviceWorkers::add(std::string const &deviceName,
+                           std::function<void()> const &update) {
+        RegistrationPtr ret;
+        if (m_workers.empty()) {
+            return ret;
+        }
+        auto index = getWorkerIndex(deviceName);
+        OSVR_DEV_VERBOSE("Running sync device "
+                         << deviceName << " in group " << getGroup(deviceName)
+                         << " on worker thread " << index);
+        auto &worker = *m_workers[index];
+        auto entry = make_shared<detail::SyncDeviceWorkerEntry>(update);
+        worker.add(entry);
+        ret.reset(new Registration(worker, entry));
+        return ret;
+    }
+
+    std::string
+    SyncDeviceWorkers::getGroup(std::string const &deviceName) const {
+        auto it = m_opts.groups.find(deviceName);
+        if (it != end(m_opts.groups)) {
+            return it->second;
+        }
+        auto pluginName = deviceName.substr(0, deviceName.find('/'));
+        it = m_opts.groups.find(pluginName);
+        if (it != end(m_opts.groups)) {
+            return it->second;
+        }
+        return pluginName;
+    }
+
+    std::size_t
+    SyncDeviceWorkers::getWorkerIndex(std::string const &deviceName) {
+        if (m_workers.empty()) {
+            return 0;
+        }
+        auto group = getGroup(deviceName);
+        auto it = m_groupWorkers.find(group);
+        if (it == end(m_groupWorkers)) {
+            // Spread the groups round-robin in order of first appearance.
+            auto index = m_groupWorkers.size() % m_workers.size();
+            it = m_groupWorkers.insert(std::make_pair(group, index)).first;
+        }
+        return it->second;
+    }
+
+} // namespace connection
+} // namespace osvr
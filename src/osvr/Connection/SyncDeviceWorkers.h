@@ -0,0 +1,110 @@
+/** @file
+    @brief Header
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef INCLUDED_SyncDeviceWorkers_h_GUID_1D7FB83B_4DE2_4E2D_80E7_D332FAF5FC95
+#define INCLUDED_SyncDeviceWorkers_h_GUID_1D7FB83B_4DE2_4E2D_80E7_D332FAF5FC95
+
+// Internal Includes
+#include <osvr/Connection/SyncDeviceThreadOptions.h>
+#include <osvr/Util/UniquePtr.h>
+#include <osvr/Util/SharedPtr.h>
+
+// Library/third-party includes
+#include <boost/noncopyable.hpp>
+
+// Standard includes
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace osvr {
+namespace connection {
+    namespace detail {
+        class SyncDeviceWorker;
+        struct SyncDeviceWorkerEntry;
+    } // namespace detail
+
+    /// @brief A small pool of threads that run the update callbacks of sync
+    /// devices, as configured by SyncDeviceThreadOptions.
+    ///
+    /// Each worker waits to be kicked by the main loop, then calls the update
+    /// callback of each of its devices once.
+    class SyncDeviceWorkers : boost::noncopyable {
+      public:
+        explicit SyncDeviceWorkers(SyncDeviceThreadOptions const &opts);
+        /// @brief Stops and joins the worker threads.
+        ~SyncDeviceWorkers();
+
+        /// @brief A device's place on a worker: destroying it removes the
+        /// device, waiting for its update callback to return if running.
+        class Registration : boost::noncopyable {
+          public:
+            ~Registration();
+            /// @brief Have the worker run an update pass. Passes requested
+            /// while one is running are coalesced into one more pass.
+            void kick();
+
+          private:
+            friend class SyncDeviceWorkers;
+            typedef shared_ptr<detail::SyncDeviceWorkerEntry> EntryPtr;
+            Registration(detail::SyncDeviceWorker &worker,
+                         EntryPtr const &entry);
+            detail::SyncDeviceWorker &m_worker;
+            EntryPtr m_entry;
+        };
+        typedef unique_ptr<Registration> RegistrationPtr;
+
+        /// @brief Assign a device to a worker. Call from the main thread
+        /// only.
+        ///
+        /// @param deviceName Fully-qualified device name, used to find its
+        /// group.
+        /// @param update Update callback, to be called on the worker thread.
+        /// @returns the registration, or a null pointer if sync devices run
+        /// in the main loop.
+        RegistrationPtr add(std::string const &deviceName,
+                            std::function<void()> const &update);
+
+        /// @brief Get the name of the group a device belongs to.
+        std::string getGroup(std::string const &deviceName) const;
+
+        /// @brief Get the index of the worker a device would be assigned to,
+        /// assigning its group a worker if it doesn't have one yet. Call
+        /// from the main thread only.
+        std::size_t getWorkerIndex(std::string const &deviceName);
+
+        /// @brief Number of worker threads.
+        std::size_t size() const { return m_workers.size(); }
+
+      private:
+        SyncDeviceThreadOptions const m_opts;
+        std::vector<unique_ptr<detail::SyncDeviceWorker> > m_workers;
+        /// @brief Worker index assigned to each group seen so far.
+        std::map<std::string, std::size_t> m_groupWorkers;
+    };
+} // namespace connection
+} // namespace osvr
+
+#endif // INCLUDED_SyncDeviceWorkers_h_GUID_1D7FB83B_4DE2_4E2D_80E7_D332FAF5FC95
@@ -28,6 +28,9 @@
 // Internal Includes
 #include "DeviceConstructionData.h"
 #include <osvr/Connection/TrackerServerInterface.h>
+#include <osvr/Common/Buffer.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/TrackerPoseBatch.h>
 #include <osvr/Util/QuatlibInteropC.h>
 
 // Library/third-party includes
@@ -48,6 +51,8 @@ namespace connection {
             // Initialize data
             m_resetPos();
             m_resetQuat();
+            m_poseBatchMessage = d_connection->register_message_type(
+                common::messages::TrackerPoseBatch::identifier());
             // Report interface out.
             init.obj.returnTrackerInterface(*this);
         }
@@ -77,6 +82,42 @@ namespace connection {
             m_sendPose(chan, timestamp);
         }
 
+        virtual bool sendReports(OSVR_PoseState const *poses,
+                                 OSVR_ChannelCount const *sensors,
+                                 OSVR_ChannelCount count,
+                                 util::time::TimeValue const &timestamp) {
+            typedef common::messages::TrackerPoseBatch TrackerPoseBatch;
+            /// Low-latency messages go over UDP when the connection has it,
+            /// so each message must fit in a datagram.
+            static const OSVR_ChannelCount POSES_PER_MESSAGE =
+                TrackerPoseBatch::getMaxPoses(vrpn_CONNECTION_UDP_BUFLEN);
+            util::time::toStructTimeval(Base::timestamp, timestamp);
+            OSVR_ChannelCount offset = 0;
+            do {
+                OSVR_ChannelCount n = count - offset;
+                if (n > POSES_PER_MESSAGE) {
+                    n = POSES_PER_MESSAGE;
+                }
+                m_poses.resize(n);
+                for (OSVR_ChannelCount i = 0; i < n; ++i) {
+                    m_poses[i].sensor = sensors[offset + i];
+                    m_poses[i].pose = poses[offset + i];
+                }
+                common::Buffer<> buf;
+                TrackerPoseBatch::MessageSerialization msg(m_poses);
+                common::serialize(buf, msg);
+                auto ret = d_connection->pack_message(
+                    static_cast<vrpn_uint32>(buf.size()), Base::timestamp,
+                    m_poseBatchMessage, Base::d_sender_id, buf.data(),
+                    CLASS_OF_SERVICE);
+                if (ret != 0) {
+                    return false;
+                }
+                offset += n;
+            } while (offset < count);
+            return true;
+        }
+
       private:
         void m_resetVec3(vrpn_float64 vec[3]) {
             vec[0] = 0;
@@ -102,6 +143,9 @@ namespace connection {
                                        Base::position_m_id, Base::d_sender_id,
                                        msgbuf, CLASS_OF_SERVICE);
         }
+        vrpn_int32 m_poseBatchMessage;
+        /// @brief Reused between batches to avoid reallocating.
+        common::SensorPoseList m_poses;
     };
 
 } // namespace connection
@@ -31,11 +31,10 @@
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/ClientInterface.h>
 #include <osvr/Common/ApplyPathNodeVisitor.h>
-#include <osvr/Common/ResolveTreeNode.h>
+#include <osvr/Common/ResolvedRouteCache.h>
 #include <osvr/Common/PathTreeSerialization.h>
 #include <osvr/Util/Verbosity.h>
 #include <osvr/Util/TreeTraversalVisitor.h>
-#include <osvr/Common/DeduplicatingFunctionWrapper.h>
 #include <osvr/Connection/Connection.h>
 #include <osvr/Server/Server.h>
 
@@ -43,12 +42,34 @@
 #include <json/reader.h>
 
 // Standard includes
-#include <unordered_set>
+#include <map>
 #include <thread>
 
 namespace osvr {
 namespace client {
 
+    /// @brief Summarizes what a path resolves to, so we can tell whether a
+    /// path tree change requires a new remote handler for it: null if the
+    /// path doesn't resolve.
+    static Json::Value
+    getSourceKey(common::ResolvedRouteCache::result_type const &source) {
+        Json::Value ret;
+        if (!source.is_initialized()) {
+            return ret;
+        }
+        auto const &dev = source->getDeviceElement();
+        ret["device"] = dev.getFullDeviceName();
+        ret["server"] = dev.getServer();
+        ret["descriptor"] = dev.getDescriptor();
+        ret["interface"] = source->getInterfaceName();
+        auto sensor = source->getSensorNumber();
+        if (sensor) {
+            ret["sensor"] = *sensor;
+        }
+        ret["transform"] = source->getTransformJson();
+        return ret;
+    }
+
     static const std::chrono::milliseconds STARTUP_CONNECT_TIMEOUT(200);
     static const std::chrono::milliseconds STARTUP_TREE_TIMEOUT(1000);
     static const std::chrono::milliseconds STARTUP_LOOP_SLEEP(1);
@@ -77,10 +98,16 @@ namespace client {
         m_systemDevice = common::createClientDevice(sysDeviceName, m_mainConn);
         m_systemComponent =
             m_systemDevice->addComponent(common::SystemComponent::create());
-        typedef common::DeduplicatingFunctionWrapper<Json::Value const &>
-            DedupJsonFunction;
-        m_systemComponent->registerReplaceTreeHandler(DedupJsonFunction(
-            [&](Json::Value const &nodes) { m_handleReplaceTree(nodes); }));
+        // Repeated identical trees are skipped by the system component
+        // before being decoded; otherwise only changes are applied.
+        m_systemComponent->registerReplaceTreeHandler(
+            [&](Json::Value const &nodes, util::time::TimeValue const &) {
+                m_handleReplaceTree(common::pathTreeSnapshotFromJson(nodes));
+            });
+        m_systemComponent->registerTreeDeltaHandler(
+            [&](Json::Value const &json, util::time::TimeValue const &) {
+                m_handleTreeDelta(json);
+            });
     }
 
     JointClientContext::~JointClientContext() {}
@@ -129,7 +156,7 @@ namespace client {
         /// up a handler) we don't have a leftover one still active.
         m_interfaces.eraseHandlerForPath(path);
 
-        auto source = common::resolveTreeNode(m_pathTree, path);
+        auto const &source = m_routes.resolve(m_pathTree, path);
         if (!source.is_initialized()) {
             OSVR_DEV_VERBOSE("Could not resolve source for " << path);
             return false;
@@ -154,41 +181,92 @@ namespace client {
         m_interfaces.eraseHandlerForPath(path);
     }
 
-    void JointClientContext::m_connectNeededCallbacks() {
-        std::unordered_set<std::string> failedPaths;
-        size_t successfulPaths{0};
-        for (auto const &iface : getInterfaces()) {
-            /// @todo slightly overkill, but it works - tree traversal would be
-            /// better.
-            auto path = iface->getPath();
-            /// For every interface, if there's no handler at that path on the
-            /// interface tree, try to set one up.
-            if (!m_interfaces.getHandlerForPath(path)) {
-                auto success = m_connectCallbacksOnPath(path);
-                if (success) {
-                    successfulPaths++;
-                } else {
-                    failedPaths.insert(path);
-                }
+    void JointClientContext::m_handleReplaceTree(
+        common::PathTreeSnapshot &&snapshot) {
+        OSVR_DEV_VERBOSE("Got updated path tree, processing");
+        if (!m_gotTree) {
+            // Wipe out anything left from resolving paths before we had a
+            // tree.
+            m_routes.invalidate();
+            m_pathTree.reset();
+            m_interfaces.clearHandlers();
+            m_treeSnapshot.clear();
+        }
+        m_gotTree = true;
+        // The server announces the version of this tree right after it.
+        m_treeVersion.reset();
+        m_requestedFullTree = false;
+
+        m_applyTreeChanges(
+            common::diffPathTreeSnapshots(m_treeSnapshot, snapshot));
+        m_treeSnapshot = std::move(snapshot);
+    }
+
+    void JointClientContext::m_handleTreeDelta(Json::Value const &json) {
+        auto delta = common::pathTreeDeltaFromJson(json);
+        if (!delta.base) {
+            // Version announcement for the full tree just sent.
+            if (m_gotTree) {
+                m_treeVersion = delta.version;
             }
+            return;
         }
-        OSVR_DEV_VERBOSE("Connected " << successfulPaths << " of "
-                                      << successfulPaths + failedPaths.size()
-                                      << " unconnected paths successfully");
+        if (!m_treeVersion || *m_treeVersion != *delta.base) {
+            OSVR_DEV_VERBOSE("Got path tree changes for a version we don't "
+                             "have, requesting full tree");
+            m_treeVersion.reset();
+            if (!m_requestedFullTree) {
+                m_requestedFullTree = true;
+                m_systemComponent->sendFullTreeRequest();
+            }
+            return;
+        }
+        OSVR_DEV_VERBOSE("Got path tree changes, processing");
+        m_applyTreeChanges(delta);
+        common::applyPathTreeDelta(m_treeSnapshot, delta);
+        m_treeVersion = delta.version;
     }
 
-    void JointClientContext::m_handleReplaceTree(Json::Value const &nodes) {
-        OSVR_DEV_VERBOSE("Got updated path tree, processing");
-        // reset path tree
-        m_pathTree.reset();
-        // wipe out handlers in the interface tree
-        m_interfaces.clearHandlers();
+    void
+    JointClientContext::m_applyTreeChanges(common::PathTreeDelta const &delta) {
+        if (delta.empty()) {
+            OSVR_DEV_VERBOSE("No path tree changes to apply.");
+            return;
+        }
+        // Record what each interface path resolves to now.
+        std::map<std::string, Json::Value> oldSources;
+        for (auto const &iface : getInterfaces()) {
+            auto path = iface->getPath();
+            if (oldSources.find(path) == end(oldSources)) {
+                oldSources[path] =
+                    getSourceKey(m_routes.resolve(m_pathTree, path));
+            }
+        }
 
-        // populate path tree from message
-        common::jsonToPathTree(m_pathTree, nodes);
+        // update path tree from message
+        m_routes.invalidate();
+        common::jsonToPathTree(m_pathTree, delta.changed);
+        for (auto const &path : delta.removed) {
+            m_pathTree.getNodeByPath(path).value() =
+                common::elements::NullElement();
+        }
 
-        // re-connect handlers.
-        m_connectNeededCallbacks();
+        // re-connect handlers whose source changed.
+        std::size_t reconnected = 0;
+        for (auto const &entry : oldSources) {
+            auto const &path = entry.first;
+            if (m_interfaces.getHandlerForPath(path) &&
+                getSourceKey(m_routes.resolve(m_pathTree, path)) ==
+                    entry.second) {
+                continue;
+            }
+            m_connectCallbacksOnPath(path);
+            ++reconnected;
+        }
+        OSVR_DEV_VERBOSE("Applied " << delta.size()
+                                    << " path tree node changes, reconnected "
+                                    << reconnected << " of "
+                                    << oldSources.size() << " paths");
     }
 
 } // namespace client
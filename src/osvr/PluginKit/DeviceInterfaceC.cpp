@@ -210,6 +210,33 @@ osvrDeviceAsyncInitWithOptions(OSVR_IN_PTR OSVR_PluginRegContext,
                                  OSVR_DeviceTokenObject::createAsyncDevice);
 }
 
+OSVR_ReturnCode
+osvrDeviceAsyncQueueOptions(OSVR_INOUT_PTR OSVR_DeviceInitOptions options,
+                            OSVR_IN size_t capacity,
+                            OSVR_IN OSVR_AsyncQueueFullPolicy policy) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceAsyncQueueOptions", options);
+    using osvr::connection::AsyncQueueFullPolicy;
+    osvr::connection::AsyncQueueOptions opts;
+    opts.capacity = capacity;
+    switch (policy) {
+    case OSVR_ASYNC_QUEUE_DROP_OLDEST:
+        opts.policy = AsyncQueueFullPolicy::DropOldest;
+        break;
+    case OSVR_ASYNC_QUEUE_DROP_NEWEST:
+        opts.policy = AsyncQueueFullPolicy::DropNewest;
+        break;
+    case OSVR_ASYNC_QUEUE_BLOCK:
+        opts.policy = AsyncQueueFullPolicy::Block;
+        break;
+    default:
+        OSVR_DEV_VERBOSE("osvrDeviceAsyncQueueOptions: unrecognized policy "
+                         << policy);
+        return OSVR_RETURN_FAILURE;
+    }
+    options->setAsyncQueueOptions(opts);
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode osvrDeviceMicrosleep(OSVR_IN uint64_t microseconds) {
     boost::this_thread::sleep(boost::posix_time::microseconds(microseconds));
     return OSVR_RETURN_SUCCESS;
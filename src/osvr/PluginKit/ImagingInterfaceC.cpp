@@ -37,13 +37,20 @@
 // - none
 
 // Standard includes
-// - none
+#include <memory>
+#include <utility>
 
 struct OSVR_ImagingDeviceInterfaceObject
     : public osvr::connection::DeviceInterfaceBase {
     osvr::common::ImagingComponent *imaging;
 };
 
+struct OSVR_ImagingFrameBufferObject {
+    OSVR_ImagingMetadata metadata;
+    OSVR_ChannelCount sensor;
+    osvr::common::IPCRingBuffer::BufferWriteProxy proxy;
+};
+
 OSVR_ReturnCode
 osvrDeviceImagingConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
                            OSVR_OUT_PTR OSVR_ImagingDeviceInterface *iface,
@@ -61,6 +68,104 @@ osvrDeviceImagingConfigure(OSVR_INOUT_PTR OSVR_DeviceInitOptions opts,
     return OSVR_RETURN_SUCCESS;
 }
 
+OSVR_ReturnCode osvrDeviceImagingConfigureNetwork(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImageDimension left, OSVR_IN OSVR_ImageDimension top,
+    OSVR_IN OSVR_ImageDimension width, OSVR_IN OSVR_ImageDimension height,
+    OSVR_IN OSVR_ImageDimension rowStep) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingConfigureNetwork",
+                                    iface);
+    if (0 == rowStep) {
+        OSVR_DEV_VERBOSE("osvrDeviceImagingConfigureNetwork: rowStep must be "
+                         "at least 1.");
+        return OSVR_RETURN_FAILURE;
+    }
+    osvr::common::ImagingNetworkOptions opts;
+    opts.left = left;
+    opts.top = top;
+    opts.width = width;
+    opts.height = height;
+    opts.rowStep = rowStep;
+    iface->imaging->setNetworkOptions(opts);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrDeviceImagingConfigureSharedMemory(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingSharedMemorySync sync) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingConfigureSharedMemory",
+                                    iface);
+    typedef osvr::common::IPCRingBuffer::Synchronization Synchronization;
+    switch (sync) {
+    case OSVR_ISMS_MUTEX:
+        iface->imaging->setSharedMemorySynchronization(
+            Synchronization::Mutex);
+        break;
+    case OSVR_ISMS_SEQLOCK:
+        iface->imaging->setSharedMemorySynchronization(
+            Synchronization::Seqlock);
+        break;
+    default:
+        OSVR_DEV_VERBOSE("osvrDeviceImagingConfigureSharedMemory: unknown "
+                         "synchronization "
+                         << int(sync));
+        return OSVR_RETURN_FAILURE;
+    }
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrDeviceImagingConfigureNetworkFragments(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_CBool enable) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(
+        "osvrDeviceImagingConfigureNetworkFragments", iface);
+    iface->imaging->setNetworkFragments(enable != OSVR_FALSE);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrDeviceImagingConfigureNetworkEncoding(
+    OSVR_INOUT_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_IN OSVR_ImagingNetworkEncoding encoding,
+    OSVR_IN uint32_t keyframeInterval) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(
+        "osvrDeviceImagingConfigureNetworkEncoding", iface);
+    osvr::common::ImageEncoding enc;
+    switch (encoding) {
+    case OSVR_INE_RAW:
+        enc = osvr::common::ImageEncoding::Raw;
+        break;
+    case OSVR_INE_RUN_LENGTH:
+        enc = osvr::common::ImageEncoding::RunLength;
+        break;
+    case OSVR_INE_DELTA_RUN_LENGTH:
+        enc = osvr::common::ImageEncoding::DeltaRunLength;
+        break;
+    default:
+        OSVR_DEV_VERBOSE("osvrDeviceImagingConfigureNetworkEncoding: unknown "
+                         "encoding "
+                         << int(encoding));
+        return OSVR_RETURN_FAILURE;
+    }
+    iface->imaging->setNetworkEncoding(enc, keyframeInterval);
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode osvrDeviceImagingGetNetworkEncodingStats(
+    OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+    OSVR_OUT_PTR OSVR_ImagingNetworkEncodingStats *stats) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingGetNetworkEncodingStats",
+                                    iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingGetNetworkEncodingStats",
+                                    stats);
+    auto const &s = iface->imaging->getNetworkEncodingStats();
+    stats->frames = s.frames;
+    stats->keyframes = s.keyframes;
+    stats->rawBytes = s.rawBytes;
+    stats->encodedBytes = s.encodedBytes;
+    stats->encodeSeconds = s.encodeSeconds;
+    return OSVR_RETURN_SUCCESS;
+}
+
 OSVR_ReturnCode
 osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
                              OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
@@ -76,3 +181,59 @@ osvrDeviceImagingReportFrame(OSVR_IN_PTR OSVR_DeviceToken,
 
     return OSVR_RETURN_FAILURE;
 }
+
+OSVR_ReturnCode
+osvrDeviceImagingBeginFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                            OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                            OSVR_IN OSVR_ImagingMetadata metadata,
+                            OSVR_IN OSVR_ChannelCount sensor,
+                            OSVR_OUT_PTR OSVR_ImagingFrameBuffer *frame,
+                            OSVR_OUT_PTR OSVR_ImageBufferElement **buffer) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingBeginFrame", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingBeginFrame", frame);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingBeginFrame", buffer);
+    /// Only touches the shared memory, which belongs to the device's own
+    /// thread, so no send guard needed yet.
+    auto proxy = iface->imaging->reserveImageBuffer(metadata, sensor);
+    if (!proxy) {
+        OSVR_DEV_VERBOSE("osvrDeviceImagingBeginFrame: could not reserve a "
+                         "frame buffer.");
+        return OSVR_RETURN_FAILURE;
+    }
+    *buffer = proxy.get();
+    *frame = new OSVR_ImagingFrameBufferObject{metadata, sensor,
+                                                std::move(proxy)};
+    return OSVR_RETURN_SUCCESS;
+}
+
+OSVR_ReturnCode
+osvrDeviceImagingSendFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                           OSVR_IN_PTR OSVR_ImagingDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_ImagingFrameBuffer frame,
+                           OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingSendFrame", frame);
+    std::unique_ptr<OSVR_ImagingFrameBufferObject> frameHolder(frame);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingSendFrame", iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingSendFrame", timestamp);
+    auto guard = iface->getSendGuard();
+    if (guard->lock() &&
+        iface->imaging->sendReservedImageData(frame->metadata,
+                                              std::move(frame->proxy),
+                                              frame->sensor, *timestamp)) {
+        return OSVR_RETURN_SUCCESS;
+    }
+
+    return OSVR_RETURN_FAILURE;
+}
+
+OSVR_ReturnCode
+osvrDeviceImagingAbandonFrame(OSVR_IN_PTR OSVR_DeviceToken,
+                              OSVR_IN_PTR OSVR_ImagingDeviceInterface,
+                              OSVR_IN_PTR OSVR_ImagingFrameBuffer frame) {
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT("osvrDeviceImagingAbandonFrame", frame);
+    /// Cancel rather than just release the entry, which would publish it as
+    /// the latest frame.
+    frame->proxy.cancel();
+    delete frame;
+    return OSVR_RETURN_SUCCESS;
+}
@@ -91,6 +91,44 @@ OSVR_ReturnCode osvrDeviceTrackerSendPoseTimestamped(
                            val, chan, timestamp);
 }
 
+OSVR_ReturnCode
+osvrDeviceTrackerSendPoses(OSVR_IN_PTR OSVR_DeviceToken dev,
+                           OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+                           OSVR_IN_PTR OSVR_PoseState const *poses,
+                           OSVR_IN_PTR OSVR_ChannelCount const *sensors,
+                           OSVR_IN OSVR_ChannelCount count) {
+    OSVR_TimeValue now;
+    osvrTimeValueGetNow(&now);
+
+    return osvrDeviceTrackerSendPosesTimestamped(dev, iface, poses, sensors,
+                                                 count, &now);
+}
+
+OSVR_ReturnCode osvrDeviceTrackerSendPosesTimestamped(
+    OSVR_IN_PTR OSVR_DeviceToken,
+    OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
+    OSVR_IN_PTR OSVR_PoseState const *poses,
+    OSVR_IN_PTR OSVR_ChannelCount const *sensors,
+    OSVR_IN OSVR_ChannelCount count,
+    OSVR_IN_PTR OSVR_TimeValue const *timestamp) {
+    static const char METHOD[] = "osvrDeviceTrackerSendPosesTimestamped";
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(METHOD, iface);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(METHOD, poses);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(METHOD, sensors);
+    OSVR_PLUGIN_HANDLE_NULL_CONTEXT(METHOD, timestamp);
+    auto guard = iface->getSendGuard();
+    if (guard->lock()) {
+        if (!iface->tracker->sendReports(poses, sensors, count, *timestamp)) {
+            std::cerr << "ERROR (" << METHOD << "): could not send " << count
+                      << " poses!" << std::endl;
+            return OSVR_RETURN_FAILURE;
+        }
+        return OSVR_RETURN_SUCCESS;
+    }
+
+    return OSVR_RETURN_FAILURE;
+}
+
 OSVR_ReturnCode
 osvrDeviceTrackerSendPosition(OSVR_IN_PTR OSVR_DeviceToken dev,
                               OSVR_IN_PTR OSVR_TrackerDeviceInterface iface,
@@ -99,6 +99,15 @@ namespace server {
     static const char LOCAL_KEY[] = "local";
     static const char PORT_KEY[] = "port"; // not the triwizard cup.
     static const char SLEEP_KEY[] = "sleep";
+    /// If true, the server loop blocks between iterations until an async
+    /// device reports or another thread calls into the server, rather than
+    /// sleeping for "sleep" or yielding. This trades network latency for
+    /// idle CPU. Nothing wakes the loop for messages from clients or for
+    /// sync devices, so they can wait up to the full "sleep" time (1 ms if
+    /// not set) to be handled.
+    static const char WAIT_KEY[] = "waitForActivity";
+    static const char SYNC_THREADS_KEY[] = "syncDeviceThreads";
+    static const char SYNC_GROUPS_KEY[] = "syncDeviceGroups";
 
     ServerPtr ConfigureServer::constructServer() {
         Json::Value const &root(m_data->root);
@@ -106,6 +115,8 @@ namespace server {
         std::string iface;
         boost::optional<int> port;
         int sleepTime = 1000; // microseconds
+        bool waitForActivity = false;
+        connection::SyncDeviceThreadOptions syncThreadOpts;
 
         /// Extract data from the JSON structure.
         if (root.isMember(SERVER_KEY)) {
@@ -137,6 +148,32 @@ namespace server {
                 // Convert to microseconds for internal use.
                 sleepTime = static_cast<int>(jsonSleepTime.asDouble() * 1000.0);
             }
+
+            Json::Value jsonWait = jsonServer[WAIT_KEY];
+            if (jsonWait.isBool()) {
+                waitForActivity = jsonWait.asBool();
+            }
+
+            Json::Value jsonSyncThreads = jsonServer[SYNC_THREADS_KEY];
+            if (jsonSyncThreads.isInt()) {
+                int threads = jsonSyncThreads.asInt();
+                if (threads < 0) {
+                    throw std::out_of_range("Invalid number of sync device "
+                                            "threads: must be >= 0");
+                }
+                syncThreadOpts.threads = threads;
+            }
+
+            /// Object mapping device or plugin names to group names.
+            Json::Value const &jsonSyncGroups = jsonServer[SYNC_GROUPS_KEY];
+            if (jsonSyncGroups.isObject()) {
+                for (auto const &name : jsonSyncGroups.getMemberNames()) {
+                    Json::Value const &group = jsonSyncGroups[name];
+                    if (group.isString()) {
+                        syncThreadOpts.groups[name] = group.asString();
+                    }
+                }
+            }
         }
 
         /// Construct a server, or a connection then a server, based on the
@@ -151,6 +188,8 @@ namespace server {
 
         if (sleepTime > 0.0)
             m_server->setSleepTime(sleepTime);
+        m_server->setWaitForActivity(waitForActivity);
+        m_server->setSyncDeviceThreadOptions(syncThreadOpts);
 
         return m_server;
     }
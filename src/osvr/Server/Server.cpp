@@ -113,6 +113,19 @@ namespace server {
 
     int Server::getSleepTime() const { return m_impl->getSleepTime(); }
 
+    void Server::setWaitForActivity(bool wait) {
+        m_impl->setWaitForActivity(wait);
+    }
+
+    bool Server::getWaitForActivity() const {
+        return m_impl->getWaitForActivity();
+    }
+
+    void Server::setSyncDeviceThreadOptions(
+        connection::SyncDeviceThreadOptions const &opts) {
+        m_impl->setSyncDeviceThreadOptions(opts);
+    }
+
     Server::Server(connection::ConnectionPtr const &conn,
                    private_constructor const &)
         : m_impl(new ServerImpl(conn)) {}
@@ -25,6 +25,7 @@
 // Internal Includes
 #include "ServerImpl.h"
 #include <osvr/Connection/Connection.h>
+#include <osvr/Connection/ActivitySignal.h>
 #include <osvr/Connection/ConnectionDevice.h>
 #include <osvr/PluginHost/RegistrationContext.h>
 #include <osvr/Util/MessageKeys.h>
@@ -35,6 +36,8 @@
 #include <osvr/Common/SystemComponent.h>
 #include <osvr/Common/CommonComponent.h>
 #include <osvr/Common/PathTreeFull.h>
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/PathTreeDelta.h>
 #include <osvr/Common/PathElementTypes.h>
 #include <osvr/Common/ProcessDeviceDescriptor.h>
 #include <osvr/Common/AliasProcessor.h>
@@ -54,6 +57,19 @@
 
 namespace osvr {
 namespace server {
+    /// @brief Longest time (in microseconds) the loop waits for activity when
+    /// no sleep time is set.
+    static const int DEFAULT_ACTIVITY_WAIT_TIME = 1000;
+
+    /// @brief A path tree change touching more than 1/this of the nodes is
+    /// sent as a full tree instead of a delta.
+    static const std::size_t MAX_DELTA_FRACTION_INVERSE = 2;
+
+    /// @brief Shortest time between hardware detections requested by client
+    /// connections: requests in the meantime are coalesced into one run once
+    /// it has passed.
+    static const std::chrono::milliseconds MIN_HARDWARE_DETECT_INTERVAL(1000);
+
     static vrpn_ConnectionPtr
     getVRPNConnection(connection::ConnectionPtr const &conn) {
         vrpn_ConnectionPtr ret;
@@ -66,11 +82,14 @@ namespace server {
     }
     ServerImpl::ServerImpl(connection::ConnectionPtr const &conn)
         : m_conn(conn), m_ctx(make_shared<pluginhost::RegistrationContext>()),
-          m_systemComponent(nullptr), m_running(false), m_sleepTime(0) {
+          m_systemComponent(nullptr), m_clients(0), m_treeVersion(0),
+          m_sentTreeHash(0), m_running(false), m_sleepTime(0),
+          m_waitForActivity(false) {
         if (!m_conn) {
             throw std::logic_error(
                 "Can't pass a null ConnectionPtr into Server constructor!");
         }
+        m_activity = m_conn->getActivitySignal();
         osvr::connection::Connection::storeConnection(*m_ctx, m_conn);
 
         // Get the underlying VRPN connection, and make sure it's OK.
@@ -89,12 +108,24 @@ namespace server {
         m_systemComponent->registerClientRouteUpdateHandler(
             &ServerImpl::m_handleUpdatedRoute, this);
 
+        // Keep track of the clients, so the path tree is only sent in the
+        // binary format, or as deltas, once they all accept it.
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_got_connection),
+            &ServerImpl::m_handleGotConnection, this);
+        vrpnConn->register_handler(
+            vrpnConn->register_message_type(vrpn_dropped_connection),
+            &ServerImpl::m_handleDroppedConnection, this);
+
         // Things to do when we get a new incoming connection
         m_commonComponent =
             m_systemDevice->addComponent(common::CommonComponent::create());
+        // Each remote pings, so one client connecting can ask several times.
         m_commonComponent->registerPingHandler(
-            [&] { triggerHardwareDetect(); });
+            [&] { m_hardwareDetectRequested.set(); });
         m_commonComponent->registerPingHandler([&] { m_sendTree(); });
+        m_systemComponent->registerFullTreeRequestHandler(
+            [&] { m_fullTreeRequested.set(); });
 
         // Set up the default display descriptor.
         m_tree.getNodeByPath("/display").value() =
@@ -138,6 +169,8 @@ namespace server {
     void ServerImpl::stop() {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_everStarted) {
+            m_run.signalShutdown();
+            m_activity->signal();
             m_run.signalAndWaitForShutdown();
             m_thread.join();
             m_thread = boost::thread();
@@ -149,6 +182,7 @@ namespace server {
     void ServerImpl::signalStop() {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         m_run.signalShutdown();
+        m_activity->signal();
     }
 
     void ServerImpl::loadPlugin(std::string const &pluginName) {
@@ -164,11 +198,7 @@ namespace server {
     }
 
     void ServerImpl::triggerHardwareDetect() {
-        OSVR_DEV_VERBOSE("Performing hardware auto-detection.");
-        m_callControlled([&] {
-            common::tracing::markHardwareDetect();
-            m_ctx->triggerHardwareDetect();
-        });
+        m_callControlled([&] { m_detectHardware(); });
     }
 
     void ServerImpl::registerMainloopMethod(MainloopMethod f) {
@@ -188,9 +218,19 @@ namespace server {
     void ServerImpl::m_update() {
         osvr::common::tracing::ServerUpdate trace;
         m_conn->process();
-        if (m_treeDirty) {
-            OSVR_DEV_VERBOSE("Path tree updated");
+        if (m_hardwareDetectRequested &&
+            hardware_detect_clock::now() >= m_nextHardwareDetect) {
+            m_detectHardware();
+        }
+        m_processDeviceDescriptors();
+        if (m_fullTreeRequested) {
+            OSVR_DEV_VERBOSE("Client requested full path tree");
             m_sendTree();
+            m_fullTreeRequested.reset();
+            m_treeDirty.reset();
+        } else if (m_treeDirty) {
+            OSVR_DEV_VERBOSE("Path tree updated");
+            m_sendTreeChanges();
             m_treeDirty.reset();
         }
         m_systemDevice->update();
@@ -209,7 +249,16 @@ namespace server {
             shouldContinue = m_run.shouldContinue();
         }
 
-        if (m_sleepTime > 0) {
+        if (m_waitForActivity) {
+            // Network traffic and sync devices don't signal activity, so
+            // still wake up at least every m_sleepTime to poll them: the
+            // VRPN connection doesn't expose its sockets to wait on, and
+            // its own timed mainloop() can't be woken by m_activity.
+            /// @todo Wait on the connection's sockets as well, if VRPN
+            /// exposes them.
+            m_activity->wait(m_sleepTime > 0 ? m_sleepTime
+                                             : DEFAULT_ACTIVITY_WAIT_TIME);
+        } else if (m_sleepTime > 0) {
             osvr::util::time::microsleep(m_sleepTime);
         } else {
             m_thread.yield();
@@ -253,6 +302,7 @@ namespace server {
             return;
         }
         m_callControlled([&] {
+            m_processDeviceDescriptors();
             /// Get the node
             auto &node = m_tree.getNodeByPath(path);
 
@@ -273,6 +323,7 @@ namespace server {
         auto newElement =
             common::PathElement{common::elements::StringElement{value}};
         m_callControlled([&] {
+            m_processDeviceDescriptors();
             auto &node = m_tree.getNodeByPath(path);
             if (!(newElement == node.value())) {
                 m_treeDirty.set();
@@ -291,6 +342,15 @@ namespace server {
     }
 
     void ServerImpl::m_orderedDestruction() {
+        auto vrpnConn = getVRPNConnection(m_conn);
+        if (vrpnConn) {
+            vrpnConn->unregister_handler(
+                vrpnConn->register_message_type(vrpn_got_connection),
+                &ServerImpl::m_handleGotConnection, this);
+            vrpnConn->unregister_handler(
+                vrpnConn->register_message_type(vrpn_dropped_connection),
+                &ServerImpl::m_handleDroppedConnection, this);
+        }
         m_ctx.reset();
         m_systemComponent = nullptr; // non-owning pointer
         m_systemDevice.reset();
@@ -304,7 +364,25 @@ namespace server {
         return 0;
     }
 
+    int ServerImpl::m_handleGotConnection(void *userdata, vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        self->m_clients++;
+        self->m_systemComponent->queryTreeFormats(self->m_clients);
+        return 0;
+    }
+
+    int ServerImpl::m_handleDroppedConnection(void *userdata,
+                                              vrpn_HANDLERPARAM) {
+        auto self = static_cast<ServerImpl *>(userdata);
+        if (self->m_clients > 0) {
+            self->m_clients--;
+        }
+        self->m_systemComponent->queryTreeFormats(self->m_clients);
+        return 0;
+    }
+
     bool ServerImpl::m_addRoute(std::string const &routingDirective) {
+        m_processDeviceDescriptors();
         bool change =
             common::addAliasFromRoute(m_tree.getRoot(), routingDirective);
         m_treeDirty += change;
@@ -315,6 +393,7 @@ namespace server {
                                 std::string const &source,
                                 common::AliasPriority priority) {
         /// @todo Handle this one with AliasProcessor.
+        m_processDeviceDescriptors();
         auto &node = m_tree.getNodeByPath(path);
         bool change = common::addAlias(node, source, priority);
         m_treeDirty += change;
@@ -323,6 +402,7 @@ namespace server {
 
     bool ServerImpl::m_addAliases(Json::Value const &aliases,
                                   common::AliasPriority priority) {
+        m_processDeviceDescriptors();
         bool change = common::AliasProcessor()
                           .setDefaultPriority(priority)
                           .enableWildcard()
@@ -331,10 +411,70 @@ namespace server {
         return change;
     }
 
+    void ServerImpl::m_detectHardware() {
+        OSVR_DEV_VERBOSE("Performing hardware auto-detection.");
+        common::tracing::markHardwareDetect();
+        m_hardwareDetectRequested.reset();
+        m_ctx->triggerHardwareDetect();
+        m_nextHardwareDetect =
+            hardware_detect_clock::now() + MIN_HARDWARE_DETECT_INTERVAL;
+    }
+
     void ServerImpl::m_sendTree() {
+        m_processDeviceDescriptors();
+        auto nodes = common::pathTreeToJson(m_tree);
+        m_sendFullTree(nodes, common::pathTreeSnapshotFromJson(nodes));
+    }
+
+    void ServerImpl::m_sendFullTree(Json::Value const &nodes,
+                                    common::PathTreeSnapshot &&snapshot) {
         OSVR_DEV_VERBOSE("Sending path tree to clients.");
         common::tracing::markPathTreeBroadcast();
-        m_systemComponent->sendReplacementTree(m_tree);
+        auto hash = common::hashPathTreeJson(nodes);
+        if (0 == m_treeVersion || hash != m_sentTreeHash) {
+            ++m_treeVersion;
+        }
+        m_sentTreeHash = hash;
+        m_systemComponent->sendReplacementTree(
+            m_tree, nodes, common::PathTreeStamp(m_treeVersion, hash));
+
+        // Tell clients the version of the tree they now have, so they can
+        // apply later deltas.
+        common::PathTreeDelta announcement;
+        announcement.version = m_treeVersion;
+        m_systemComponent->sendTreeDelta(
+            common::pathTreeDeltaToJson(announcement));
+        m_sentTree = std::move(snapshot);
+    }
+
+    void ServerImpl::m_sendTreeChanges() {
+        auto nodes = common::pathTreeToJson(m_tree);
+        auto snapshot = common::pathTreeSnapshotFromJson(nodes);
+        if (0 == m_treeVersion ||
+            !m_systemComponent->clientsSupportTreeDeltas()) {
+            // Clients that don't know deltas would never see the changes.
+            m_sendFullTree(nodes, std::move(snapshot));
+            return;
+        }
+        auto delta = common::diffPathTreeSnapshots(m_sentTree, snapshot);
+        if (delta.empty()) {
+            OSVR_DEV_VERBOSE("Path tree unchanged since last sent.");
+            return;
+        }
+        if (delta.size() * MAX_DELTA_FRACTION_INVERSE > snapshot.size()) {
+            // So much changed that the full tree is about as cheap.
+            m_sendFullTree(nodes, std::move(snapshot));
+            return;
+        }
+        OSVR_DEV_VERBOSE("Sending path tree changes to clients: "
+                         << delta.changed.size() << " changed, "
+                         << delta.removed.size() << " removed.");
+        common::tracing::markPathTreeBroadcast();
+        delta.base = m_treeVersion;
+        delta.version = ++m_treeVersion;
+        m_sentTreeHash = common::hashPathTreeJson(nodes);
+        m_systemComponent->sendTreeDelta(common::pathTreeDeltaToJson(delta));
+        m_sentTree = std::move(snapshot);
     }
 
     void ServerImpl::setSleepTime(int microseconds) {
@@ -343,8 +483,32 @@ namespace server {
 
     int ServerImpl::getSleepTime() const { return m_sleepTime; }
 
-    void ServerImpl::m_handleDeviceDescriptors() {
+    void ServerImpl::setWaitForActivity(bool wait) { m_waitForActivity = wait; }
+
+    bool ServerImpl::getWaitForActivity() const { return m_waitForActivity; }
+
+    void ServerImpl::setSyncDeviceThreadOptions(
+        connection::SyncDeviceThreadOptions const &opts) {
+        m_callControlled([&] { m_conn->setSyncDeviceThreadOptions(opts); });
+    }
+
+    void ServerImpl::m_handleDeviceDescriptors() { m_descriptorsPending.set(); }
+
+    void ServerImpl::m_processDeviceDescriptors() {
+        if (!m_descriptorsPending) {
+            return;
+        }
+        m_descriptorsPending.reset();
         for (auto const &dev : m_conn->getDevices()) {
+            // Only devices that are new or have a new descriptor need work.
+            auto revision = dev->getDeviceDescriptorRevision();
+            auto processed = m_descriptorRevisions.find(dev->getName());
+            if (processed != end(m_descriptorRevisions) &&
+                processed->second == revision) {
+                continue;
+            }
+            m_descriptorRevisions[dev->getName()] = revision;
+
             auto const &descriptor = dev->getDeviceDescriptor();
             if (descriptor.empty()) {
                 OSVR_DEV_VERBOSE("Developer Warning: No device descriptor for "
@@ -29,6 +29,7 @@
 #include <osvr/Server/Server.h>
 #include <osvr/Common/RouteContainer.h>
 #include <osvr/Connection/ConnectionPtr.h>
+#include <osvr/Connection/ActivitySignal.h>
 #include <osvr/Util/SharedPtr.h>
 #include <osvr/PluginHost/RegistrationContext_fwd.h>
 #include <osvr/Connection/MessageTypePtr.h>
@@ -37,7 +38,9 @@
 #include <osvr/Common/SystemComponent_fwd.h>
 #include <osvr/Common/CommonComponent_fwd.h>
 #include <osvr/Common/PathTree.h>
+#include <osvr/Common/PathTreeDelta.h>
 #include <osvr/Util/Flag.h>
+#include <osvr/Util/StdInt.h>
 
 // Library/third-party includes
 #include <boost/noncopyable.hpp>
@@ -47,7 +50,9 @@
 #include <json/value.h>
 
 // Standard includes
-// - none
+#include <chrono>
+#include <string>
+#include <unordered_map>
 
 namespace osvr {
 namespace server {
@@ -119,6 +124,16 @@ namespace server {
         /// @copydoc Server::getSleepTime()
         int getSleepTime() const;
 
+        /// @copydoc Server::setWaitForActivity()
+        void setWaitForActivity(bool wait);
+
+        /// @copydoc Server::getWaitForActivity()
+        bool getWaitForActivity() const;
+
+        /// @copydoc Server::setSyncDeviceThreadOptions()
+        void setSyncDeviceThreadOptions(
+            connection::SyncDeviceThreadOptions const &opts);
+
         /// @copydoc Server::instantiateDriver()
         void instantiateDriver(std::string const &plugin,
                                std::string const &driver,
@@ -149,13 +164,38 @@ namespace server {
         /// @brief sends route message.
         void m_sendRoutes();
 
+        /// @brief runs every plugin's hardware detection callbacks now -
+        /// assumes that you've handled ensuring this is the main server
+        /// thread.
+        void m_detectHardware();
+
         /// @brief sends full path tree contents
         void m_sendTree();
 
+        /// @brief sends full path tree contents, already serialized, and
+        /// records them as the last tree sent.
+        void m_sendFullTree(Json::Value const &nodes,
+                            common::PathTreeSnapshot &&snapshot);
+
+        /// @brief sends what changed in the path tree since it was last sent,
+        /// as a delta, or as a full tree if most of it changed or some
+        /// client can't apply deltas.
+        void m_sendTreeChanges();
+
         /// @brief handles updated route message from client
         static int VRPN_CALLBACK m_handleUpdatedRoute(void *userdata,
                                                       vrpn_HANDLERPARAM p);
 
+        /// @brief counts a newly connected client and asks the clients
+        /// which path tree formats they accept
+        static int VRPN_CALLBACK m_handleGotConnection(void *userdata,
+                                                       vrpn_HANDLERPARAM p);
+
+        /// @brief forgets a disconnected client and asks the remaining
+        /// clients which path tree formats they accept
+        static int VRPN_CALLBACK
+        m_handleDroppedConnection(void *userdata, vrpn_HANDLERPARAM p);
+
         /// @brief adds a route - assumes that you've handled ensuring this is
         /// the main server thread.
         bool m_addRoute(std::string const &routingDirective);
@@ -170,12 +210,25 @@ namespace server {
         bool m_addAliases(Json::Value const &aliases,
                           common::AliasPriority priority);
 
-        /// @brief Handle new or updated device descriptors.
+        /// @brief Handle new or updated device descriptors: notes that there
+        /// are some to process, so a burst of them (as during plugin loading
+        /// or hardware detection) is processed at once.
         void m_handleDeviceDescriptors();
 
+        /// @brief Processes the descriptors of devices whose descriptor
+        /// changed since last processed, if any were signalled.
+        ///
+        /// Called before anything else touches the path tree, so descriptors
+        /// still apply in order with other changes to it.
+        void m_processDeviceDescriptors();
+
         /// @brief Connection ownership.
         connection::ConnectionPtr m_conn;
 
+        /// @brief The connection's activity signal, held separately so other
+        /// threads can wake the loop regardless of the connection lifetime.
+        connection::ActivitySignalPtr m_activity;
+
         /// @brief Context ownership.
         shared_ptr<pluginhost::RegistrationContext> m_ctx;
 
@@ -191,6 +244,9 @@ namespace server {
         /// @brief Common component for system device
         common::CommonComponent *m_commonComponent;
 
+        /// @brief Number of clients currently connected.
+        std::size_t m_clients;
+
         /// @brief JSON routing directives
         common::RouteContainer m_routes;
 
@@ -198,6 +254,28 @@ namespace server {
         common::PathTree m_tree;
         util::Flag m_treeDirty;
 
+        /// @brief Set when device descriptors may have changed.
+        util::Flag m_descriptorsPending;
+        /// @brief Revision of the descriptor last processed for each device,
+        /// by device name.
+        std::unordered_map<std::string, uint64_t> m_descriptorRevisions;
+
+        /// @brief Path tree as last sent to clients.
+        common::PathTreeSnapshot m_sentTree;
+        /// @brief Version of the path tree last sent to clients, 0 if none.
+        common::PathTreeDelta::version_type m_treeVersion;
+        /// @brief Hash of the path tree last sent to clients, so that
+        /// sending it again unchanged keeps the same version.
+        uint64_t m_sentTreeHash;
+        /// @brief Set when a client asks for the full path tree.
+        util::Flag m_fullTreeRequested;
+
+        typedef std::chrono::steady_clock hardware_detect_clock;
+        /// @brief Set when a client connection asks for hardware detection.
+        util::Flag m_hardwareDetectRequested;
+        /// @brief Earliest time a requested hardware detection may run.
+        hardware_detect_clock::time_point m_nextHardwareDetect;
+
         /// @brief Mutex held by anything executing in the main thread.
         mutable boost::mutex m_mainThreadMutex;
 
@@ -215,14 +293,22 @@ namespace server {
         /// @brief Number of microseconds to sleep after each loop
         /// iteration.
         int m_sleepTime;
+
+        /// @brief Whether to wait for activity (up to m_sleepTime) instead of
+        /// sleeping or yielding after each loop iteration.
+        bool m_waitForActivity;
     };
 
     template <typename Callable>
     inline void ServerImpl::m_callControlled(Callable f) {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_running && boost::this_thread::get_id() != m_thread.get_id()) {
-            boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
-            f();
+            {
+                boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
+                f();
+            }
+            // Let the loop act on whatever we just did right away.
+            m_activity->signal();
         } else {
             f();
         }
@@ -232,8 +318,12 @@ namespace server {
     inline void ServerImpl::m_callControlled(Callable f) const {
         boost::unique_lock<boost::mutex> lock(m_runControl);
         if (m_running && boost::this_thread::get_id() != m_thread.get_id()) {
-            boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
-            f();
+            {
+                boost::unique_lock<boost::mutex> lock(m_mainThreadMutex);
+                f();
+            }
+            // Let the loop act on whatever we just did right away.
+            m_activity->signal();
         } else {
             f();
         }
@@ -24,22 +24,63 @@
 
 // Internal Includes
 #include <osvr/USBSerial/USBSerialEnum.h>
+#include <osvr/Util/DeviceChangeMonitor.h>
 #include "USBSerialEnumImpl.h"
 #include "USBSerialDevInfo.h"
 
 // Library/third-party includes
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
 
 // Standard includes
 #include <memory>
 #include <iostream>
+#include <mutex>
 
 namespace osvr {
 namespace usbserial {
 
-    EnumeratorImpl::EnumeratorImpl() : devices(getSerialDeviceList()) {}
+    namespace {
+        /// @brief All USB serial devices present, shared by every
+        /// enumeration in the process and only enumerated again once devices
+        /// may have been plugged in or removed.
+        class DeviceListCache : boost::noncopyable {
+          public:
+            static DeviceListCache &instance() {
+                static DeviceListCache cache;
+                return cache;
+            }
+
+            DeviceList get(boost::optional<uint16_t> vendorID,
+                           boost::optional<uint16_t> productID) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (m_monitor.checkForChanges()) {
+                    m_devices = getSerialDeviceList();
+                }
+                DeviceList ret;
+                for (auto const &dev : m_devices) {
+                    if ((!vendorID || *vendorID == dev.getVID()) &&
+                        (!productID || *productID == dev.getPID())) {
+                        ret.push_back(dev);
+                    }
+                }
+                return ret;
+            }
+
+          private:
+            DeviceListCache() {}
+            std::mutex m_mutex;
+            util::DeviceChangeMonitor m_monitor;
+            DeviceList m_devices;
+        };
+    } // namespace
+
+    EnumeratorImpl::EnumeratorImpl()
+        : devices(DeviceListCache::instance().get(boost::none, boost::none)) {
+    }
 
     EnumeratorImpl::EnumeratorImpl(uint16_t vendorID, uint16_t productID)
-        : devices(getSerialDeviceList(vendorID, productID)) {}
+        : devices(DeviceListCache::instance().get(vendorID, productID)) {}
 
     EnumeratorImpl::~EnumeratorImpl() {}
 
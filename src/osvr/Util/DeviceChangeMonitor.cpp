@@ -0,0 +1,85 @@
+/** @file
+    @brief Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Util/DeviceChangeMonitor.h>
+#include <osvr/Util/PlatformConfig.h>
+
+// Library/third-party includes
+// - none
+
+// Standard includes
+#if defined(OSVR_LINUX) || defined(OSVR_ANDROID)
+#include <sys/inotify.h>
+#include <unistd.h>
+#define OSVR_HAVE_INOTIFY
+#endif
+
+namespace osvr {
+namespace util {
+#ifdef OSVR_HAVE_INOTIFY
+    DeviceChangeMonitor::DeviceChangeMonitor()
+        : m_fd(::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), m_checked(false) {
+        if (-1 == m_fd) {
+            return;
+        }
+        // Device nodes are created and removed as devices come and go, and
+        // have their permissions set once they're ready.
+        if (-1 == ::inotify_add_watch(m_fd, "/dev",
+                                      IN_CREATE | IN_DELETE | IN_ATTRIB |
+                                          IN_MOVED_FROM | IN_MOVED_TO)) {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    DeviceChangeMonitor::~DeviceChangeMonitor() {
+        if (-1 != m_fd) {
+            ::close(m_fd);
+        }
+    }
+
+    bool DeviceChangeMonitor::checkForChanges() {
+        if (-1 == m_fd) {
+            return true;
+        }
+        // Drain all pending events: any at all (including a queue overflow)
+        // means a change.
+        bool changed = !m_checked;
+        m_checked = true;
+        char buf[4096];
+        while (::read(m_fd, buf, sizeof(buf)) > 0) {
+            changed = true;
+        }
+        return changed;
+    }
+#else
+    DeviceChangeMonitor::DeviceChangeMonitor() : m_fd(-1), m_checked(false) {}
+
+    DeviceChangeMonitor::~DeviceChangeMonitor() {}
+
+    bool DeviceChangeMonitor::checkForChanges() { return true; }
+#endif
+} // namespace util
+} // namespace osvr
@@ -0,0 +1,147 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/CompiledTransform.h>
+#include <osvr/Common/JSONTransformVisitor.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+#include <json/reader.h>
+
+// Standard includes
+#include <string>
+
+namespace common = osvr::common;
+namespace util = osvr::util;
+using common::CompiledTransform;
+typedef CompiledTransform::Kind Kind;
+
+namespace {
+inline common::Transform parseTransform(std::string const &json) {
+    Json::Value val;
+    Json::Reader reader;
+    if (!reader.parse(json, val)) {
+        throw std::runtime_error("Could not parse test JSON: " + json);
+    }
+    return common::JSONTransformVisitor(val).getTransform();
+}
+
+inline OSVR_Pose3 makePose(double angle, Eigen::Vector3d const &axis,
+                           Eigen::Vector3d const &pos) {
+    OSVR_Pose3 ret;
+    util::toQuat(
+        Eigen::Quaterniond(Eigen::AngleAxisd(angle, axis.normalized())),
+        ret.rotation);
+    util::vecMap(ret.translation) = pos;
+    return ret;
+}
+
+/// @brief Check that the compiled transform gives the same results as the
+/// general matrix path did.
+inline void checkMatchesMatrix(std::string const &json, Kind kind) {
+    auto xform = parseTransform(json);
+    CompiledTransform compiled(xform);
+    ASSERT_EQ(int(kind), int(compiled.getKind())) << json;
+    OSVR_Pose3 poses[] = {
+        makePose(0, Eigen::Vector3d::UnitX(), Eigen::Vector3d::Zero()),
+        makePose(0.5, Eigen::Vector3d(1, 2, 3), Eigen::Vector3d(1, -2, 3)),
+        makePose(2.8, Eigen::Vector3d(-1, 0.1, 0), Eigen::Vector3d(0, 0, 5))};
+    for (auto const &input : poses) {
+        OSVR_Pose3 expected = input;
+        util::toPose(xform.transform(util::fromPose(expected).matrix()),
+                     expected);
+        OSVR_Pose3 actual = input;
+        compiled.apply(actual);
+        ASSERT_NEAR(0, (util::vecMap(expected.translation) -
+                        util::vecMap(actual.translation)).norm(),
+                    1e-6)
+            << json;
+        auto expectedRot = util::fromQuat(expected.rotation);
+        auto actualRot = util::fromQuat(actual.rotation);
+        ASSERT_NEAR(1, std::abs(expectedRot.dot(actualRot)), 1e-6) << json;
+    }
+}
+} // namespace
+
+TEST(CompiledTransform, DefaultIsIdentity) {
+    CompiledTransform compiled;
+    ASSERT_EQ(int(Kind::Identity), int(compiled.getKind()));
+    auto pose = makePose(1, Eigen::Vector3d::UnitY(), Eigen::Vector3d(1, 2, 3));
+    auto copy = pose;
+    compiled.apply(copy);
+    ASSERT_EQ(util::vecMap(pose.translation), util::vecMap(copy.translation));
+}
+
+TEST(CompiledTransform, Identity) {
+    checkMatchesMatrix("{}", Kind::Identity);
+    checkMatchesMatrix(
+        R"({"rotate": {"axis": "x", "degrees": 0}, "child": "/a"})",
+        Kind::Identity);
+}
+
+TEST(CompiledTransform, Rotation) {
+    checkMatchesMatrix(
+        R"({"rotate": {"axis": "x", "degrees": 90}, "child": "/a"})",
+        Kind::Rotation);
+    checkMatchesMatrix(
+        R"({"postrotate": {"axis": "-z", "degrees": 45}, "child": "/a"})",
+        Kind::Rotation);
+}
+
+TEST(CompiledTransform, ChangeOfBasis) {
+    // Proper rotation
+    checkMatchesMatrix(
+        R"({"changeBasis": {"x": "x", "y": "z", "z": "-y"}, "child": "/a"})",
+        Kind::Rotation);
+    // Flips handedness
+    checkMatchesMatrix(
+        R"({"changeBasis": {"x": "x", "y": "y", "z": "-z"}, "child": "/a"})",
+        Kind::Rotation);
+    checkMatchesMatrix(
+        R"({"changeBasis": {"x": "-x", "y": "-y", "z": "-z"}, "child": "/a"})",
+        Kind::Rotation);
+}
+
+TEST(CompiledTransform, Rigid) {
+    checkMatchesMatrix(
+        R"({"translate": [0, 0.1, 0], "child": "/a"})", Kind::Rigid);
+    checkMatchesMatrix(R"({"posttranslate": [1, 0, -1],
+            "rotate": {"axis": "y", "degrees": 30},
+            "child": {"changeBasis": {"x": "x", "y": "y", "z": "-z"},
+                "child": {"translate": [0, 0.1, 0.2],
+                    "postrotate": {"axis": "z", "radians": 1.2},
+                    "child": "/a"}}})",
+                       Kind::Rigid);
+}
+
+TEST(CompiledTransform, NonRigidFallsBackToMatrix) {
+    checkMatchesMatrix(
+        R"({"changeBasis": {"x": [2, 0, 0], "y": "y", "z": "z"},
+            "child": "/a"})",
+        Kind::Matrix);
+}
@@ -0,0 +1,371 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/IPCRingBuffer.h>
+#include <osvr/Util/StdInt.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using osvr::common::IPCRingBuffer;
+using osvr::common::IPCRingBufferPtr;
+typedef IPCRingBuffer::Synchronization Sync;
+typedef IPCRingBuffer::sequence_type sequence_type;
+
+namespace {
+static const uint16_t ENTRIES = 4;
+/// @brief Big enough that a torn copy is likely to be noticed.
+static const uint32_t ENTRY_SIZE = 64 * 1024;
+
+inline std::string makeTestName(const char *base) {
+    std::ostringstream os;
+    os << "com.osvr.test.IPCRingBuffer." << base << "."
+#ifdef _WIN32
+       << ::GetCurrentProcessId();
+#else
+       << ::getpid();
+#endif
+    return os.str();
+}
+
+inline IPCRingBuffer::Options makeOptions(const char *base, Sync sync) {
+    return IPCRingBuffer::Options(makeTestName(base))
+        .setEntries(ENTRIES)
+        .setEntrySize(ENTRY_SIZE)
+        .setSynchronization(sync);
+}
+
+/// @brief Fill an entry with a pattern derived from the sequence number.
+inline void fillEntry(IPCRingBuffer::pointer_type buf, sequence_type seq) {
+    for (uint32_t i = 0; i < ENTRY_SIZE / sizeof(sequence_type); ++i) {
+        std::memcpy(buf + i * sizeof(sequence_type), &seq, sizeof(seq));
+    }
+}
+
+/// @brief Check that every word of an entry matches its sequence number.
+inline bool checkEntry(IPCRingBuffer::pointer_to_const_type buf,
+                       sequence_type seq) {
+    for (uint32_t i = 0; i < ENTRY_SIZE / sizeof(sequence_type); ++i) {
+        sequence_type val;
+        std::memcpy(&val, buf + i * sizeof(sequence_type), sizeof(val));
+        if (val != seq) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline void putEntry(IPCRingBuffer &ringBuf) {
+    auto proxy = ringBuf.put();
+    fillEntry(proxy.get(), proxy.getSequenceNumber());
+}
+
+/// @brief Reads until the producer has reported it is done, checking every
+/// successful read. Returns the number of good reads, or -1 if a read
+/// returned inconsistent data.
+inline int64_t readUntilDone(IPCRingBuffer &ringBuf,
+                             std::atomic<bool> const &done) {
+    int64_t good = 0;
+    while (!done) {
+        sequence_type seq = 0;
+        {
+            auto latest = ringBuf.getLatest();
+            if (!latest) {
+                continue;
+            }
+            seq = latest.getSequenceNumber();
+            if (!checkEntry(latest.get(), seq)) {
+                return -1;
+            }
+            ++good;
+        }
+        // Also try an older one, which the producer is likely to be
+        // overwriting. (Not while holding another entry: with the mutex
+        // scheme, that can deadlock against the producer.)
+        auto older = ringBuf.get(seq - ENTRIES + 1);
+        if (older && !checkEntry(older.get(), older.getSequenceNumber())) {
+            return -1;
+        }
+    }
+    return good;
+}
+} // namespace
+
+class IPCRingBufferSync : public ::testing::TestWithParam<Sync> {};
+
+TEST_P(IPCRingBufferSync, PutAndGet) {
+    auto server = IPCRingBuffer::create(makeOptions("PutAndGet", GetParam()));
+    ASSERT_TRUE(bool(server));
+    ASSERT_EQ(GetParam(), server->getSynchronization());
+    ASSERT_EQ(ENTRIES, server->getEntries());
+    ASSERT_EQ(ENTRY_SIZE, server->getEntrySize());
+    ASSERT_FALSE(bool(server->getLatest()));
+
+    auto client = IPCRingBuffer::find(makeOptions("PutAndGet", GetParam()));
+    ASSERT_TRUE(bool(client));
+    ASSERT_EQ(ENTRY_SIZE, client->getEntrySize());
+
+    for (sequence_type i = 0; i < ENTRIES * 3; ++i) {
+        putEntry(*server);
+        auto res = client->get(i);
+        ASSERT_TRUE(bool(res));
+        ASSERT_EQ(i, res.getSequenceNumber());
+        ASSERT_TRUE(checkEntry(res.get(), i));
+
+        auto latest = client->getLatest();
+        ASSERT_TRUE(bool(latest));
+        ASSERT_EQ(i, latest.getSequenceNumber());
+    }
+    // Overwritten
+    ASSERT_FALSE(bool(client->get(0)));
+    // Not yet written
+    ASSERT_FALSE(bool(client->get(ENTRIES * 3)));
+}
+
+TEST_P(IPCRingBufferSync, Copy) {
+    auto server = IPCRingBuffer::create(makeOptions("Copy", GetParam()));
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(makeOptions("Copy", GetParam()));
+    ASSERT_TRUE(bool(client));
+
+    std::vector<IPCRingBuffer::value_type> dest(ENTRY_SIZE);
+    ASSERT_FALSE(client->copy(0, dest.data())) << "Not yet written";
+    for (sequence_type i = 0; i < ENTRIES * 3; ++i) {
+        putEntry(*server);
+        ASSERT_TRUE(client->copy(i, dest.data()));
+        ASSERT_TRUE(checkEntry(dest.data(), i));
+    }
+    ASSERT_FALSE(client->copy(0, dest.data())) << "Overwritten";
+    ASSERT_FALSE(client->copy(ENTRIES * 3, dest.data())) << "Not yet written";
+}
+
+namespace {
+inline void cancelEntry(IPCRingBuffer &ringBuf, sequence_type expectedSeq) {
+    auto proxy = ringBuf.put();
+    ASSERT_TRUE(bool(proxy));
+    ASSERT_EQ(expectedSeq, proxy.getSequenceNumber());
+    // Partly written, as an abandoned frame might be.
+    std::memset(proxy.get(), 0xff, ENTRY_SIZE / 2);
+    proxy.cancel();
+    ASSERT_FALSE(bool(proxy));
+}
+
+inline void checkLatest(IPCRingBuffer &ringBuf, sequence_type expectedSeq) {
+    auto latest = ringBuf.getLatest();
+    ASSERT_TRUE(bool(latest));
+    ASSERT_EQ(expectedSeq, latest.getSequenceNumber());
+    ASSERT_TRUE(checkEntry(latest.get(), expectedSeq));
+}
+} // namespace
+
+TEST_P(IPCRingBufferSync, CancelledPutIsNotPublished) {
+    auto server = IPCRingBuffer::create(makeOptions("Cancel", GetParam()));
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(makeOptions("Cancel", GetParam()));
+    ASSERT_TRUE(bool(client));
+
+    cancelEntry(*server, 0);
+    ASSERT_FALSE(bool(client->getLatest()));
+
+    putEntry(*server);
+    putEntry(*server);
+    cancelEntry(*server, 2);
+    checkLatest(*client, 1);
+    ASSERT_FALSE(bool(client->get(2)));
+    ASSERT_TRUE(bool(client->get(0)));
+
+    // The next put reuses the sequence number.
+    putEntry(*server);
+    checkLatest(*client, 2);
+
+    // With the buffer full, the oldest entry's storage gets handed out, so it
+    // is gone, but the rest are untouched.
+    putEntry(*server);
+    cancelEntry(*server, ENTRIES);
+    checkLatest(*client, ENTRIES - 1);
+    ASSERT_FALSE(bool(client->get(0)));
+    for (sequence_type i = 1; i < ENTRIES; ++i) {
+        auto res = client->get(i);
+        ASSERT_TRUE(bool(res));
+        ASSERT_TRUE(checkEntry(res.get(), i));
+    }
+    putEntry(*server);
+    checkLatest(*client, ENTRIES);
+}
+
+TEST_P(IPCRingBufferSync, FindWithOtherSynchronizationFails) {
+    auto server = IPCRingBuffer::create(makeOptions("Mismatch", GetParam()));
+    ASSERT_TRUE(bool(server));
+    auto other = GetParam() == Sync::Mutex ? Sync::Seqlock : Sync::Mutex;
+    ASSERT_FALSE(bool(IPCRingBuffer::find(makeOptions("Mismatch", other))));
+}
+
+TEST_P(IPCRingBufferSync, ThreadedStress) {
+    auto server = IPCRingBuffer::create(makeOptions("Threaded", GetParam()));
+    ASSERT_TRUE(bool(server));
+    auto client = IPCRingBuffer::find(makeOptions("Threaded", GetParam()));
+    ASSERT_TRUE(bool(client));
+    std::atomic<bool> done(false);
+    int64_t good = 0;
+    std::thread reader([&] { good = readUntilDone(*client, done); });
+    for (int i = 0; i < 2000; ++i) {
+        putEntry(*server);
+    }
+    done = true;
+    reader.join();
+    ASSERT_GE(good, 0) << "Reader saw an inconsistent entry!";
+}
+
+INSTANTIATE_TEST_CASE_P(BothSchemes, IPCRingBufferSync,
+                        ::testing::Values(Sync::Mutex, Sync::Seqlock));
+
+TEST(IPCRingBuffer, ABILevelsDiffer) {
+    ASSERT_EQ(IPCRingBuffer::getABILevel(),
+              IPCRingBuffer::getABILevel(Sync::Mutex));
+    ASSERT_NE(IPCRingBuffer::getABILevel(Sync::Mutex),
+              IPCRingBuffer::getABILevel(Sync::Seqlock));
+}
+
+TEST(IPCRingBufferSeqlock, ProducerNotBlockedByReader) {
+    auto server =
+        IPCRingBuffer::create(makeOptions("NotBlocked", Sync::Seqlock));
+    ASSERT_TRUE(bool(server));
+    putEntry(*server);
+    auto held = server->get(0);
+    ASSERT_TRUE(bool(held));
+    // Would deadlock with the mutex scheme.
+    for (sequence_type i = 1; i < ENTRIES * 4; ++i) {
+        putEntry(*server);
+    }
+    // The reader's copy is unaffected by the overwrite...
+    ASSERT_TRUE(checkEntry(held.get(), 0));
+    // ...but the entry itself is gone.
+    ASSERT_FALSE(bool(server->get(0)));
+    auto latest = server->getLatest();
+    ASSERT_TRUE(bool(latest));
+    ASSERT_EQ(ENTRIES * 4 - 1, latest.getSequenceNumber());
+}
+
+TEST(IPCRingBufferSeqlock, EntryBeingWrittenIsUnavailable) {
+    auto server =
+        IPCRingBuffer::create(makeOptions("BeingWritten", Sync::Seqlock));
+    ASSERT_TRUE(bool(server));
+    for (sequence_type i = 0; i < ENTRIES; ++i) {
+        putEntry(*server);
+    }
+    {
+        // Overwriting entry 0.
+        auto proxy = server->put();
+        ASSERT_EQ(ENTRIES, proxy.getSequenceNumber());
+        ASSERT_FALSE(bool(server->get(0)));
+        ASSERT_FALSE(bool(server->get(ENTRIES)));
+        auto latest = server->getLatest();
+        ASSERT_TRUE(bool(latest));
+        ASSERT_EQ(ENTRIES - 1, latest.getSequenceNumber());
+        fillEntry(proxy.get(), proxy.getSequenceNumber());
+    }
+    auto res = server->get(ENTRIES);
+    ASSERT_TRUE(bool(res));
+    ASSERT_TRUE(checkEntry(res.get(), ENTRIES));
+}
+
+#ifndef _WIN32
+TEST(IPCRingBufferSeqlock, MultiProcessStress) {
+    static const int READERS = 3;
+    static const int FRAMES = 5000;
+    auto opts = makeOptions("MultiProcess", Sync::Seqlock);
+    auto server = IPCRingBuffer::create(opts);
+    ASSERT_TRUE(bool(server));
+    // So readers don't start out empty.
+    putEntry(*server);
+
+    pid_t children[READERS];
+    for (int i = 0; i < READERS; ++i) {
+        children[i] = ::fork();
+        ASSERT_NE(-1, children[i]);
+        if (children[i] == 0) {
+            // Reader process: open our own mapping, read until the producer
+            // is done (signalled by a sentinel sequence number), exit with a
+            // nonzero status on inconsistent data.
+            auto client = IPCRingBuffer::find(opts);
+            if (!client) {
+                ::_exit(2);
+            }
+            int64_t good = 0;
+            while (true) {
+                sequence_type seq = 0;
+                {
+                    auto latest = client->getLatest();
+                    if (!latest) {
+                        continue;
+                    }
+                    seq = latest.getSequenceNumber();
+                    if (!checkEntry(latest.get(), seq)) {
+                        ::_exit(1);
+                    }
+                    ++good;
+                }
+                if (seq >= FRAMES) {
+                    break;
+                }
+                auto older = client->get(seq - ENTRIES + 1);
+                if (older &&
+                    !checkEntry(older.get(), older.getSequenceNumber())) {
+                    ::_exit(1);
+                }
+            }
+            ::_exit(good > 0 ? 0 : 3);
+        }
+    }
+
+    for (int i = 0; i < FRAMES; ++i) {
+        putEntry(*server);
+    }
+    for (int i = 0; i < READERS; ++i) {
+        int status = 0;
+        ASSERT_EQ(children[i], ::waitpid(children[i], &status, 0));
+        ASSERT_TRUE(WIFEXITED(status));
+        ASSERT_EQ(0, WEXITSTATUS(status))
+            << "Reader process " << i << " failed";
+    }
+}
+#endif
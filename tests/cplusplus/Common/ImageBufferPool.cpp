@@ -0,0 +1,108 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImageBufferPool.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <cstring>
+#include <thread>
+
+using osvr::common::ImageBufferPool;
+using osvr::common::ImageBufferPtr;
+
+static const std::size_t FRAME_SIZE = 640 * 480;
+
+TEST(ImageBufferPool, ReusesReleasedBuffers) {
+    ImageBufferPool pool;
+    OSVR_ImageBufferElement *first = nullptr;
+    {
+        auto buf = pool.acquire(FRAME_SIZE);
+        ASSERT_TRUE(bool(buf));
+        first = buf.get();
+        // Must be writable over the whole size.
+        std::memset(buf.get(), 0xff, FRAME_SIZE);
+    }
+    for (int i = 0; i < 100; ++i) {
+        auto buf = pool.acquire(FRAME_SIZE);
+        ASSERT_EQ(first, buf.get());
+    }
+    ASSERT_EQ(1, pool.size());
+}
+
+TEST(ImageBufferPool, HeldBuffersAreNotShared) {
+    ImageBufferPool pool;
+    auto a = pool.acquire(FRAME_SIZE);
+    auto b = pool.acquire(FRAME_SIZE);
+    ASSERT_NE(a.get(), b.get());
+    ASSERT_EQ(2, pool.size());
+
+    // Copies keep it in use.
+    auto aCopy = a;
+    a.reset();
+    auto c = pool.acquire(FRAME_SIZE);
+    ASSERT_NE(aCopy.get(), c.get());
+    ASSERT_NE(b.get(), c.get());
+    ASSERT_EQ(3, pool.size());
+
+    auto former = b.get();
+    b.reset();
+    ASSERT_EQ(former, pool.acquire(FRAME_SIZE).get());
+    ASSERT_EQ(3, pool.size());
+}
+
+TEST(ImageBufferPool, SeparateSizes) {
+    ImageBufferPool pool;
+    auto small = pool.acquire(16);
+    auto smallAddress = small.get();
+    small.reset();
+    auto large = pool.acquire(FRAME_SIZE);
+    ASSERT_NE(smallAddress, large.get())
+        << "A buffer too small must not be reused";
+    ASSERT_EQ(smallAddress, pool.acquire(16).get());
+    ASSERT_EQ(2, pool.size());
+}
+
+TEST(ImageBufferPool, ReleasedOnOtherThreads) {
+    ImageBufferPool pool;
+    for (int i = 0; i < 100; ++i) {
+        auto buf = pool.acquire(FRAME_SIZE);
+        std::thread([](ImageBufferPtr held) { held.reset(); },
+                    std::move(buf)).join();
+    }
+    ASSERT_EQ(1, pool.size());
+}
+
+TEST(ImageBufferPool, OutlivesPool) {
+    ImageBufferPtr buf;
+    {
+        ImageBufferPool pool;
+        buf = pool.acquire(FRAME_SIZE);
+    }
+    // Still valid to write to.
+    std::memset(buf.get(), 0, FRAME_SIZE);
+}
@@ -0,0 +1,297 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/ImageCodec.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using osvr::common::ImageBufferPool;
+using osvr::common::ImageCodecStats;
+using osvr::common::ImageData;
+using osvr::common::ImageDecoder;
+using osvr::common::ImageEncoder;
+using osvr::common::ImageEncoding;
+using osvr::common::ImageEncodingInfo;
+typedef std::vector<OSVR_ImageBufferElement> Bytes;
+
+static Bytes runLengthRoundTrip(Bytes const &data) {
+    Bytes encoded(data.size() + data.size() / 128 + 1);
+    auto size = osvr::common::runLengthEncode(data.data(), data.size(),
+                                              encoded.data(), encoded.size());
+    Bytes decoded(data.size());
+    EXPECT_TRUE(osvr::common::runLengthDecode(encoded.data(), size,
+                                              decoded.data(), decoded.size()));
+    return decoded;
+}
+
+static Bytes randomBytes(std::size_t size, unsigned seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int> dist(0, 255);
+    Bytes ret(size);
+    for (auto &b : ret) {
+        b = static_cast<OSVR_ImageBufferElement>(dist(gen));
+    }
+    return ret;
+}
+
+TEST(RunLength, RoundTrip) {
+    ASSERT_EQ(Bytes(1000, 7), runLengthRoundTrip(Bytes(1000, 7)));
+    auto noise = randomBytes(1000, 1);
+    ASSERT_EQ(noise, runLengthRoundTrip(noise));
+
+    // Mixed runs of every length around the limits.
+    Bytes mixed;
+    for (std::size_t len = 1; len < 300; len += 7) {
+        mixed.insert(mixed.end(), len,
+                     static_cast<OSVR_ImageBufferElement>(len));
+        mixed.push_back(1);
+        mixed.push_back(2);
+    }
+    ASSERT_EQ(mixed, runLengthRoundTrip(mixed));
+}
+
+TEST(RunLength, Compresses) {
+    Bytes data(10000, 0);
+    Bytes encoded(data.size());
+    auto size = osvr::common::runLengthEncode(data.data(), data.size(),
+                                              encoded.data(), encoded.size());
+    ASSERT_GT(size, 0u);
+    ASSERT_LT(size, 200u);
+}
+
+TEST(RunLength, CapacityExceeded) {
+    auto noise = randomBytes(1000, 2);
+    Bytes encoded(noise.size());
+    ASSERT_EQ(0u, osvr::common::runLengthEncode(noise.data(), noise.size(),
+                                                encoded.data(),
+                                                noise.size() - 1));
+}
+
+TEST(RunLength, RejectsBadData) {
+    Bytes data(500, 3);
+    Bytes encoded(data.size());
+    auto size = osvr::common::runLengthEncode(data.data(), data.size(),
+                                              encoded.data(), encoded.size());
+    Bytes decoded(data.size());
+    ASSERT_FALSE(osvr::common::runLengthDecode(encoded.data(), size,
+                                               decoded.data(), 499))
+        << "Too long for the output";
+    ASSERT_FALSE(osvr::common::runLengthDecode(encoded.data(), size,
+                                               decoded.data(), 501))
+        << "Too short for the output";
+    ASSERT_FALSE(osvr::common::runLengthDecode(encoded.data(), size - 1,
+                                               decoded.data(), 500))
+        << "Truncated";
+}
+
+static OSVR_ImagingMetadata makeMetadata() {
+    OSVR_ImagingMetadata meta;
+    meta.width = 64;
+    meta.height = 48;
+    meta.channels = 1;
+    meta.depth = 1;
+    meta.type = OSVR_IVT_UNSIGNED_INT;
+    return meta;
+}
+
+/// @brief A mostly dark image with a bright spot that moves with the frame
+/// number, like an IR camera looking at LEDs.
+static Bytes makeFrame(OSVR_ImagingMetadata const &meta, uint32_t frame) {
+    Bytes ret(osvr::common::getImageBufferSize(meta), 10);
+    auto x = (frame * 3) % (meta.width - 4);
+    for (uint32_t row = 20; row < 24; ++row) {
+        std::fill_n(ret.begin() + row * meta.width + x, 4, 250);
+    }
+    return ret;
+}
+
+/// @brief Encodes and decodes a frame as if sent over the network.
+static bool sendFrame(ImageEncoder &encoder, ImageDecoder &decoder,
+                      ImageBufferPool &pool, Bytes const &frameData,
+                      uint32_t frame, ImageEncodingInfo &info,
+                      ImageData &received) {
+    auto meta = makeMetadata();
+    OSVR_ImageBufferElement const *data = frameData.data();
+    info = encoder.encode(meta, data, 0, frame);
+    received.sensor = 0;
+    received.metadata = meta;
+    received.buffer = pool.acquire(frameData.size());
+    std::copy(data, data + info.size, received.buffer.get());
+    return decoder.decode(frame, info, received);
+}
+
+TEST(ImageCodec, RawByDefault) {
+    ImageEncoder encoder;
+    auto meta = makeMetadata();
+    auto frameData = makeFrame(meta, 0);
+    OSVR_ImageBufferElement const *data = frameData.data();
+    auto info = encoder.encode(meta, data, 0, 0);
+    ASSERT_EQ(ImageEncoding::Raw, info.encoding);
+    ASSERT_EQ(frameData.size(), info.size);
+    ASSERT_EQ(frameData.data(), data);
+}
+
+TEST(ImageCodec, RunLength) {
+    ImageBufferPool pool;
+    ImageEncoder encoder;
+    ImageDecoder decoder(pool, 1);
+    encoder.setEncoding(ImageEncoding::RunLength, 30);
+    for (uint32_t frame = 0; frame < 10; ++frame) {
+        auto frameData = makeFrame(makeMetadata(), frame);
+        ImageEncodingInfo info;
+        ImageData received;
+        ASSERT_TRUE(sendFrame(encoder, decoder, pool, frameData, frame, info,
+                              received));
+        ASSERT_EQ(ImageEncoding::RunLength, info.encoding);
+        ASSERT_TRUE(std::equal(frameData.begin(), frameData.end(),
+                               received.buffer.get()));
+    }
+    auto const &stats = encoder.getStats();
+    ASSERT_EQ(10u, stats.frames);
+    ASSERT_EQ(10u, stats.keyframes);
+    ASSERT_GT(stats.getRatio(), 10.0);
+}
+
+TEST(ImageCodec, DeltaWithKeyframes) {
+    ImageBufferPool pool;
+    ImageEncoder encoder;
+    ImageDecoder decoder(pool, 1);
+    encoder.setEncoding(ImageEncoding::DeltaRunLength, 5);
+    for (uint32_t frame = 0; frame < 20; ++frame) {
+        auto frameData = makeFrame(makeMetadata(), frame);
+        ImageEncodingInfo info;
+        ImageData received;
+        ASSERT_TRUE(sendFrame(encoder, decoder, pool, frameData, frame, info,
+                              received));
+        if (frame % 5 == 0) {
+            ASSERT_EQ(ImageEncoding::RunLength, info.encoding);
+        } else {
+            ASSERT_EQ(ImageEncoding::DeltaRunLength, info.encoding);
+            ASSERT_EQ(frame - 1, info.reference);
+        }
+        ASSERT_TRUE(std::equal(frameData.begin(), frameData.end(),
+                               received.buffer.get()));
+    }
+    ASSERT_EQ(4u, encoder.getStats().keyframes);
+}
+
+TEST(ImageCodec, MissedFrameWaitsForKeyframe) {
+    ImageBufferPool pool;
+    ImageEncoder encoder;
+    ImageDecoder decoder(pool, 1);
+    encoder.setEncoding(ImageEncoding::DeltaRunLength, 4);
+    auto meta = makeMetadata();
+    ImageEncodingInfo info;
+    ImageData received;
+    ASSERT_TRUE(sendFrame(encoder, decoder, pool, makeFrame(meta, 0), 0, info,
+                          received));
+
+    // Frame 1 is lost on the way.
+    auto lost = makeFrame(meta, 1);
+    OSVR_ImageBufferElement const *data = lost.data();
+    encoder.encode(meta, data, 0, 1);
+
+    ASSERT_FALSE(sendFrame(encoder, decoder, pool, makeFrame(meta, 2), 2, info,
+                           received));
+    ASSERT_FALSE(sendFrame(encoder, decoder, pool, makeFrame(meta, 3), 3, info,
+                           received));
+    auto keyframe = makeFrame(meta, 4);
+    ASSERT_TRUE(sendFrame(encoder, decoder, pool, keyframe, 4, info, received));
+    ASSERT_EQ(ImageEncoding::RunLength, info.encoding);
+    ASSERT_TRUE(std::equal(keyframe.begin(), keyframe.end(),
+                           received.buffer.get()));
+    auto next = makeFrame(meta, 5);
+    ASSERT_TRUE(sendFrame(encoder, decoder, pool, next, 5, info, received));
+    ASSERT_EQ(ImageEncoding::DeltaRunLength, info.encoding);
+    ASSERT_TRUE(std::equal(next.begin(), next.end(), received.buffer.get()));
+}
+
+TEST(ImageCodec, DeltaUnaffectedByChangesToDeliveredFrames) {
+    ImageBufferPool pool;
+    ImageEncoder encoder;
+    ImageDecoder decoder(pool, 1);
+    encoder.setEncoding(ImageEncoding::DeltaRunLength, 30);
+    auto meta = makeMetadata();
+    for (uint32_t frame = 0; frame < 5; ++frame) {
+        auto frameData = makeFrame(meta, frame);
+        ImageEncodingInfo info;
+        ImageData received;
+        ASSERT_TRUE(sendFrame(encoder, decoder, pool, frameData, frame, info,
+                              received));
+        ASSERT_TRUE(std::equal(frameData.begin(), frameData.end(),
+                               received.buffer.get()));
+        // An app processing the frame in place.
+        std::fill_n(received.buffer.get(), frameData.size(), 0xaa);
+    }
+}
+
+TEST(ImageCodec, IncompressibleSentRaw) {
+    ImageBufferPool pool;
+    ImageEncoder encoder;
+    ImageDecoder decoder(pool, 1);
+    encoder.setEncoding(ImageEncoding::DeltaRunLength, 30);
+    auto meta = makeMetadata();
+    for (uint32_t frame = 0; frame < 3; ++frame) {
+        auto noise = randomBytes(osvr::common::getImageBufferSize(meta), frame);
+        ImageEncodingInfo info;
+        ImageData received;
+        ASSERT_TRUE(
+            sendFrame(encoder, decoder, pool, noise, frame, info, received));
+        ASSERT_EQ(ImageEncoding::Raw, info.encoding);
+        ASSERT_TRUE(std::equal(noise.begin(), noise.end(),
+                               received.buffer.get()));
+    }
+    // A static frame after raw ones can still be a delta from them.
+    auto noise = randomBytes(osvr::common::getImageBufferSize(meta), 2);
+    ImageEncodingInfo info;
+    ImageData received;
+    ASSERT_TRUE(sendFrame(encoder, decoder, pool, noise, 3, info, received));
+    ASSERT_EQ(ImageEncoding::DeltaRunLength, info.encoding);
+    ASSERT_TRUE(std::equal(noise.begin(), noise.end(), received.buffer.get()));
+}
+
+TEST(ImageCodec, RejectsUnknownSensors) {
+    ImageBufferPool pool;
+    ImageDecoder decoder(pool, 1);
+    auto meta = makeMetadata();
+    auto frameData = makeFrame(meta, 0);
+    ImageEncodingInfo info = {ImageEncoding::Raw, 0,
+                              uint32_t(frameData.size())};
+    for (OSVR_ChannelCount sensor : {OSVR_ChannelCount(1),
+                                     OSVR_ChannelCount(0xffffffff)}) {
+        ImageData received;
+        received.sensor = sensor;
+        received.metadata = meta;
+        received.buffer = pool.acquire(frameData.size());
+        ASSERT_FALSE(decoder.decode(0, info, received));
+    }
+}
@@ -0,0 +1,267 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+// Internal Includes
+#include <osvr/Common/ImageFragmentAssembler.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <algorithm>
+#include <vector>
+
+using osvr::common::ImageBufferPool;
+using osvr::common::ImageData;
+using osvr::common::ImageFragmentAssembler;
+using osvr::common::ImageFragmentHeader;
+
+static const uint32_t FRAGMENT_SIZE = 100;
+static const OSVR_ChannelCount NUM_SENSORS = 2;
+
+static OSVR_ImagingMetadata makeMetadata() {
+    OSVR_ImagingMetadata meta;
+    meta.width = 32;
+    meta.height = 20;
+    meta.channels = 1;
+    meta.depth = 2;
+    meta.type = OSVR_IVT_UNSIGNED_INT;
+    return meta;
+}
+
+/// @brief A frame's worth of data, different for each frame.
+static std::vector<OSVR_ImageBufferElement>
+makeFrameData(OSVR_ImagingMetadata const &meta, uint32_t frame) {
+    std::vector<OSVR_ImageBufferElement> ret(
+        osvr::common::getImageBufferSize(meta));
+    for (std::size_t i = 0; i < ret.size(); ++i) {
+        ret[i] = static_cast<OSVR_ImageBufferElement>(i * 7 + frame);
+    }
+    return ret;
+}
+
+static ImageFragmentHeader makeHeader(OSVR_ImagingMetadata const &meta,
+                                      OSVR_ChannelCount sensor,
+                                      uint32_t frame, uint32_t offset) {
+    ImageFragmentHeader header;
+    header.metadata = meta;
+    header.sensor = sensor;
+    header.frame = frame;
+    header.encoding.encoding = osvr::common::ImageEncoding::Raw;
+    header.encoding.reference = 0;
+    header.encoding.size = osvr::common::getImageBufferSize(meta);
+    header.offset = offset;
+    header.length = std::min(
+        FRAGMENT_SIZE, osvr::common::getImageBufferSize(meta) - offset);
+    return header;
+}
+
+/// @brief Feeds fragments of a frame starting at @p offset, stopping before
+/// @p end
+/// @returns the number of frames completed.
+static int addFragments(ImageFragmentAssembler &assembler,
+                        std::vector<OSVR_ImageBufferElement> const &frameData,
+                        OSVR_ChannelCount sensor, uint32_t frame,
+                        ImageData &completed, uint32_t offset = 0,
+                        uint32_t end = 0) {
+    auto meta = makeMetadata();
+    if (0 == end) {
+        end = uint32_t(frameData.size());
+    }
+    int ret = 0;
+    for (; offset < end; offset += FRAGMENT_SIZE) {
+        auto header = makeHeader(meta, sensor, frame, offset);
+        if (assembler.addFragment(header, frameData.data() + offset,
+                                  completed)) {
+            ++ret;
+        }
+    }
+    return ret;
+}
+
+static void expectFrame(ImageData const &completed,
+                        std::vector<OSVR_ImageBufferElement> const &frameData,
+                        OSVR_ChannelCount sensor) {
+    ASSERT_TRUE(bool(completed.buffer));
+    ASSERT_EQ(sensor, completed.sensor);
+    ASSERT_EQ(makeMetadata().width, completed.metadata.width);
+    ASSERT_EQ(makeMetadata().height, completed.metadata.height);
+    ASSERT_TRUE(std::equal(frameData.begin(), frameData.end(),
+                           completed.buffer.get()));
+}
+
+TEST(ImageFragmentAssembler, RoundTrip) {
+    ImageBufferPool pool;
+    ImageFragmentAssembler assembler(pool, NUM_SENSORS);
+    auto meta = makeMetadata();
+    for (uint32_t frame = 0; frame < 5; ++frame) {
+        auto frameData = makeFrameData(meta, frame);
+        ImageData completed;
+        ASSERT_EQ(1, addFragments(assembler, frameData, 0, frame, completed));
+        expectFrame(completed, frameData, 0);
+    }
+    ASSERT_EQ(1, pool.size()) << "Released frames should be recycled";
+}
+
+TEST(ImageFragmentAssembler, NewerFrameDropsIncompleteOne) {
+    ImageBufferPool pool;
+    ImageFragmentAssembler assembler(pool, NUM_SENSORS);
+    auto meta = makeMetadata();
+    auto first = makeFrameData(meta, 1);
+    auto second = makeFrameData(meta, 2);
+    ImageData completed;
+    ASSERT_EQ(0, addFragments(assembler, first, 0, 1, completed, 0, 300));
+    ASSERT_EQ(1, addFragments(assembler, second, 0, 2, completed));
+    expectFrame(completed, second, 0);
+
+    // The rest of the dropped frame must not be used.
+    ImageData stale;
+    ASSERT_EQ(0, addFragments(assembler, first, 0, 1, stale, 300));
+    ASSERT_FALSE(bool(stale.buffer));
+}
+
+TEST(ImageFragmentAssembler, FrameNumberWraparound) {
+    ImageBufferPool pool;
+    ImageFragmentAssembler assembler(pool, NUM_SENSORS);
+    auto meta = makeMetadata();
+    auto last = makeFrameData(meta, 0xffffffff);
+    auto wrapped = makeFrameData(meta, 0);
+    ImageData completed;
+    ASSERT_EQ(0, addFragments(assembler, last, 0, 0xffffffff, completed, 0,
+                              300));
+    ASSERT_EQ(1, addFragments(assembler, wrapped, 0, 0, completed));
+    expectFrame(completed, wrapped, 0);
+}
+
+TEST(ImageFragmentAssembler, EncodedFrame) {
+    ImageBufferPool pool;
+    ImageFragmentAssembler assembler(pool, NUM_SENSORS);
+    auto meta = makeMetadata();
+    auto frameData = makeFrameData(meta, 0);
+    // Stands in for encoded data: only its size matters here.
+    const uint32_t encodedSize = 250;
+    ImageData completed;
+    int count = 0;
+    for (uint32_t offset = 0; offset < encodedSize; offset += FRAGMENT_SIZE) {
+        auto header = makeHeader(meta, 0, 0, offset);
+        header.encoding.encoding = osvr::common::ImageEncoding::RunLength;
+        header.encoding.size = encodedSize;
+        header.length = std::min(FRAGMENT_SIZE, encodedSize - offset);
+        if (assembler.addFragment(header, frameData.data() + offset,
+                                  completed)) {
+            ++count;
+        }
+    }
+    ASSERT_EQ(1, count);
+    ASSERT_TRUE(std::equal(frameData.begin(), frameData.begin() + encodedSize,
+                           completed.buffer.get()));
+}
+
+TEST(ImageFragmentAssembler, InterleavedSensors) {
+    ImageBufferPool pool;
+    ImageFragmentAssembler assembler(pool, NUM_SENSORS);
+    auto meta = makeMetadata();
+    auto zero = makeFrameData(meta, 10);
+    auto one = makeFrameData(meta, 20);
+    ImageData completed[2];
+    int counts[2] = {0, 0};
+    for (uint32_t offset = 0; offset < zero.size(); offset += FRAGMENT_SIZE) {
+        if (assembler.addFragment(makeHeader(meta, 1, 7, offset),
+                                  one.data() + offset, completed[1])) {
+            ++counts[1];
+        }
+        if (assembler.addFragment(makeHeader(meta, 0, 3, offset),
+                                  zero.data() + offset, completed[0])) {
+            ++counts[0];
+        }
+    }
+    ASSERT_EQ(1, counts[0]);
+    ASSERT_EQ(1, counts[1]);
+    expectFrame(completed[0], zero, 0);
+    expectFrame(completed[1], one, 1);
+}
+
+TEST(ImageFragmentAssembler, RejectsBadFragments) {
+    ImageBufferPool pool;
+    ImageFragmentAssembler assembler(pool, NUM_SENSORS);
+    auto meta = makeMetadata();
+    auto frameData = makeFrameData(meta, 0);
+    ImageData completed;
+
+    // A gap abandons the frame.
+    ASSERT_EQ(0, addFragments(assembler, frameData, 0, 0, completed, 0, 100));
+    ASSERT_EQ(0, addFragments(assembler, frameData, 0, 0, completed, 200));
+    ASSERT_FALSE(bool(completed.buffer));
+
+    // Running past the end of the frame.
+    auto header = makeHeader(meta, 0, 1, 0);
+    header.length = uint32_t(frameData.size()) + 1;
+    std::vector<OSVR_ImageBufferElement> tooLong(header.length);
+    ASSERT_FALSE(assembler.addFragment(header, tooLong.data(), completed));
+
+    // Metadata changing partway through.
+    ASSERT_EQ(0, addFragments(assembler, frameData, 0, 2, completed, 0, 100));
+    header = makeHeader(meta, 0, 2, 100);
+    header.metadata.width = 16;
+    ASSERT_FALSE(
+        assembler.addFragment(header, frameData.data() + 100, completed));
+
+    // Empty frames.
+    header = makeHeader(meta, 0, 3, 0);
+    header.metadata.width = 0;
+    header.encoding.size = 0;
+    header.length = 0;
+    ASSERT_FALSE(assembler.addFragment(header, frameData.data(), completed));
+    ASSERT_FALSE(bool(completed.buffer));
+
+    // Raw frames of the wrong size.
+    header = makeHeader(meta, 0, 3, 0);
+    header.encoding.size = 100;
+    header.length = 100;
+    ASSERT_FALSE(assembler.addFragment(header, frameData.data(), completed));
+    ASSERT_FALSE(bool(completed.buffer));
+
+    // Still works afterwards.
+    ASSERT_EQ(1, addFragments(assembler, frameData, 0, 4, completed));
+    expectFrame(completed, frameData, 0);
+}
+
+TEST(ImageFragmentAssembler, RejectsUnknownSensors) {
+    ImageBufferPool pool;
+    ImageFragmentAssembler assembler(pool, NUM_SENSORS);
+    auto meta = makeMetadata();
+    auto frameData = makeFrameData(meta, 0);
+    ImageData completed;
+    ASSERT_EQ(0, addFragments(assembler, frameData, NUM_SENSORS, 0,
+                              completed));
+    ASSERT_EQ(0, addFragments(assembler, frameData, 0xffffffff, 0,
+                              completed));
+    ASSERT_FALSE(bool(completed.buffer));
+    ASSERT_EQ(0, pool.size());
+
+    ASSERT_EQ(1, addFragments(assembler, frameData, NUM_SENSORS - 1, 0,
+                              completed));
+    expectFrame(completed, frameData, NUM_SENSORS - 1);
+}
@@ -0,0 +1,155 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// 	http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/ImagingComponent.h>
+#include <osvr/Common/BaseDevice.h>
+#include <osvr/Common/CreateDevice.h>
+#include <osvr/Util/TimeValue.h>
+#include <osvr/Util/TimeValueC.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <vrpn_ConnectionPtr.h>
+
+// Standard includes
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+using osvr::common::BaseDevicePtr;
+using osvr::common::ImageData;
+using osvr::common::ImagingComponent;
+
+namespace {
+static const OSVR_ChannelCount NUM_SENSORS = 2;
+
+inline std::string makeDeviceName(const char *base) {
+    std::ostringstream os;
+    os << "ImagingComponentTest" << base
+#ifdef _WIN32
+       << ::GetCurrentProcessId();
+#else
+       << ::getpid();
+#endif
+    return os.str();
+}
+
+inline OSVR_ImagingMetadata makeMetadata() {
+    OSVR_ImagingMetadata meta;
+    meta.width = 16;
+    meta.height = 8;
+    meta.channels = 1;
+    meta.depth = 1;
+    meta.type = OSVR_IVT_UNSIGNED_INT;
+    return meta;
+}
+
+/// @brief A server and a client device of the same name on one loopback
+/// connection, so the client gets each frame both through shared memory and
+/// as a network message, the way a local client does.
+class LocalImaging : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        conn = vrpn_ConnectionPtr::create_server_connection("loopback:");
+        ASSERT_TRUE(conn);
+        auto name = makeDeviceName(
+            ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        server = osvr::common::createServerDevice(name, conn);
+        serverImaging =
+            server->addComponent(ImagingComponent::create(NUM_SENSORS));
+        client = osvr::common::createClientDevice(name, conn);
+        auto clientImaging =
+            client->addComponent(ImagingComponent::create(NUM_SENSORS));
+        clientImaging->registerImageHandler(
+            [&](ImageData const &data, osvr::util::time::TimeValue const &) {
+                frames.push_back(data);
+            });
+        meta = makeMetadata();
+        image.resize(osvr::common::getImageBufferSize(meta));
+        for (std::size_t i = 0; i < image.size(); ++i) {
+            image[i] = static_cast<OSVR_ImageBufferElement>(i);
+        }
+        osvrTimeValueGetNow(&timestamp);
+    }
+
+    void update() {
+        server->update();
+        client->update();
+        conn->mainloop();
+    }
+
+    void checkFrame(ImageData const &data, OSVR_ChannelCount sensor) {
+        ASSERT_EQ(sensor, data.sensor);
+        ASSERT_EQ(meta.width, data.metadata.width);
+        ASSERT_EQ(meta.height, data.metadata.height);
+        ASSERT_TRUE(std::equal(image.begin(), image.end(),
+                               data.buffer.get()));
+    }
+
+    vrpn_ConnectionPtr conn;
+    BaseDevicePtr server;
+    BaseDevicePtr client;
+    ImagingComponent *serverImaging = nullptr;
+    std::vector<ImageData> frames;
+    OSVR_ImagingMetadata meta;
+    std::vector<OSVR_ImageBufferElement> image;
+    OSVR_TimeValue timestamp;
+};
+} // namespace
+
+TEST_F(LocalImaging, SmallFrameDeliveredOnce) {
+    serverImaging->sendImageData(meta, image.data(), 0, timestamp);
+    update();
+    ASSERT_EQ(1, frames.size());
+    checkFrame(frames.front(), 0);
+}
+
+TEST_F(LocalImaging, ReservedFrameDeliveredOnce) {
+    auto entry = serverImaging->reserveImageBuffer(meta, 0);
+    ASSERT_TRUE(entry);
+    std::copy(image.begin(), image.end(), entry.get());
+    ASSERT_TRUE(serverImaging->sendReservedImageData(meta, std::move(entry),
+                                                     0, timestamp));
+    update();
+    ASSERT_EQ(1, frames.size());
+    checkFrame(frames.front(), 0);
+}
+
+TEST_F(LocalImaging, EachSensorDeliveredOnce) {
+    serverImaging->sendImageData(meta, image.data(), 1, timestamp);
+    serverImaging->sendImageData(meta, image.data(), 0, timestamp);
+    update();
+    ASSERT_EQ(2, frames.size());
+    checkFrame(frames[0], 1);
+    checkFrame(frames[1], 0);
+}
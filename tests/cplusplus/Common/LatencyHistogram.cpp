@@ -0,0 +1,122 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/LatencyHistogram.h>
+#include <osvr/Common/InterfaceLatency.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::LatencyHistogram;
+
+TEST(LatencyHistogram, Empty) {
+    LatencyHistogram hist;
+    ASSERT_EQ(0u, hist.getCount());
+    ASSERT_EQ(0u, hist.getMin());
+    ASSERT_EQ(0u, hist.getMax());
+    ASSERT_EQ(0., hist.getMean());
+    ASSERT_EQ(0u, hist.getValueAtPercentile(50));
+}
+
+TEST(LatencyHistogram, SmallValuesExact) {
+    LatencyHistogram hist;
+    for (int i = 1; i <= 50; ++i) {
+        hist.record(i);
+    }
+    ASSERT_EQ(50u, hist.getCount());
+    ASSERT_EQ(1u, hist.getMin());
+    ASSERT_EQ(50u, hist.getMax());
+    ASSERT_DOUBLE_EQ(25.5, hist.getMean());
+    ASSERT_EQ(25u, hist.getValueAtPercentile(50));
+    ASSERT_EQ(45u, hist.getValueAtPercentile(90));
+    ASSERT_EQ(1u, hist.getValueAtPercentile(0));
+    ASSERT_EQ(50u, hist.getValueAtPercentile(100));
+}
+
+TEST(LatencyHistogram, NegativeRecordedAsZero) {
+    LatencyHistogram hist;
+    hist.record(-250);
+    ASSERT_EQ(1u, hist.getCount());
+    ASSERT_EQ(0u, hist.getMax());
+}
+
+TEST(LatencyHistogram, LargeValuesWithinPrecision) {
+    LatencyHistogram hist;
+    const LatencyHistogram::value_type values[] = {
+        64, 100, 1000, 12345, 999999, 123456789, 1ull << 40};
+    for (auto value : values) {
+        hist.reset();
+        hist.record(static_cast<int64_t>(value));
+        // Ask for the low end so the max doesn't clamp the result.
+        hist.record(static_cast<int64_t>(value) * 2);
+        auto reported = hist.getValueAtPercentile(50);
+        ASSERT_GE(reported, value);
+        ASSERT_LE(double(reported - value), double(value) / 32.);
+    }
+}
+
+TEST(LatencyHistogram, PercentilesOfUniformValues) {
+    LatencyHistogram hist;
+    for (int i = 0; i < 100000; ++i) {
+        hist.record(1000 + i % 9000);
+    }
+    auto median = double(hist.getValueAtPercentile(50));
+    ASSERT_NEAR(5500., median, 5500. * 0.04);
+    auto p99 = double(hist.getValueAtPercentile(99));
+    ASSERT_NEAR(9910., p99, 9910. * 0.04);
+    ASSERT_EQ(9999u, hist.getValueAtPercentile(100));
+}
+
+TEST(LatencyHistogram, Add) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.record(10);
+    b.record(5);
+    b.record(1000);
+    a.add(b);
+    ASSERT_EQ(3u, a.getCount());
+    ASSERT_EQ(5u, a.getMin());
+    ASSERT_EQ(1000u, a.getMax());
+    ASSERT_EQ(10u, a.getValueAtPercentile(50));
+}
+
+TEST(InterfaceLatency, MeasuresFromDeviceTimestamp) {
+    using osvr::common::LatencyStage;
+    osvr::common::InterfaceLatency latency;
+    auto stamp = osvr::util::time::getNow();
+    stamp.seconds -= 1;
+    latency.record(LatencyStage::Received, stamp);
+    auto const &received = latency.get(LatencyStage::Received);
+    ASSERT_EQ(1u, received.getCount());
+    ASSERT_GE(received.getMax(), 1000000u);
+    ASSERT_LT(received.getMax(), 2000000u);
+    ASSERT_EQ(0u, latency.get(LatencyStage::Dispatched).getCount());
+    latency.reset();
+    ASSERT_EQ(0u, received.getCount());
+}
@@ -0,0 +1,143 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeBinary.h>
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/PathElementTypes.h>
+#include <osvr/Common/Serialization.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/writer.h>
+#include <boost/variant/get.hpp>
+
+// Standard includes
+#include <stdexcept>
+#include <string>
+
+namespace common = osvr::common;
+using osvr::common::Buffer;
+using osvr::common::PathTree;
+
+namespace {
+inline void setupTree(PathTree &tree) {
+    dummy::setupDummyTree(tree);
+    auto &device = boost::get<common::elements::DeviceElement>(
+        tree.getNodeByPath(dummy::getDevicePath()).value());
+    device.getDescriptor()["interfaces"]["tracker"]["count"] = 2;
+    tree.getNodeByPath("/display").value() =
+        common::elements::StringElement("{\"hmd\": {}}");
+    tree.getNodeByPath("/me/head").value() = common::elements::AliasElement(
+        dummy::getFullSourcePath(), common::ALIASPRIORITY_MANUAL);
+}
+
+inline Buffer<> toBinary(PathTree const &tree) {
+    Buffer<> buf;
+    common::pathTreeToBinary(tree, buf);
+    return buf;
+}
+} // namespace
+
+TEST(PathTreeBinary, RoundTrip) {
+    PathTree tree;
+    setupTree(tree);
+    auto buf = toBinary(tree);
+
+    PathTree decoded;
+    common::binaryToPathTree(decoded, buf.data(), buf.size());
+    ASSERT_EQ(common::pathTreeToJson(tree, true),
+              common::pathTreeToJson(decoded, true));
+}
+
+TEST(PathTreeBinary, SnapshotHasSameNodesAsJson) {
+    PathTree tree;
+    setupTree(tree);
+    auto buf = toBinary(tree);
+    auto fromJson =
+        common::pathTreeSnapshotFromJson(common::pathTreeToJson(tree));
+    auto fromBinary =
+        common::pathTreeSnapshotFromBinary(buf.data(), buf.size());
+
+    ASSERT_EQ(fromJson.size(), fromBinary.size());
+    Json::Value nodes(Json::arrayValue);
+    for (auto const &entry : fromBinary) {
+        ASSERT_EQ(1, fromJson.count(entry.first)) << entry.first;
+        nodes.append(entry.second);
+    }
+    // Descriptors are parsed once the nodes are applied.
+    PathTree applied;
+    common::jsonToPathTree(applied, nodes);
+    ASSERT_EQ(fromJson, common::pathTreeSnapshotFromJson(
+                            common::pathTreeToJson(applied)));
+}
+
+TEST(PathTreeBinary, SnapshotIsStable) {
+    PathTree tree;
+    setupTree(tree);
+    auto first = toBinary(tree);
+    auto second = toBinary(tree);
+    ASSERT_EQ(
+        common::pathTreeSnapshotFromBinary(first.data(), first.size()),
+        common::pathTreeSnapshotFromBinary(second.data(), second.size()));
+}
+
+TEST(PathTreeBinary, SmallerThanJson) {
+    PathTree tree;
+    for (int i = 0; i < 50; ++i) {
+        auto device = dummy::getPlugin() + "/Device" + std::to_string(i);
+        tree.getNodeByPath("/" + device,
+                           common::elements::DeviceElement::
+                               createVRPNDeviceElement(device, "localhost"));
+        for (int j = 0; j < 4; ++j) {
+            tree.getNodeByPath("/" + device + "/tracker/" + std::to_string(j),
+                               common::elements::SensorElement());
+        }
+    }
+    auto buf = toBinary(tree);
+    auto json = Json::FastWriter().write(common::pathTreeToJson(tree));
+    ASSERT_LT(buf.size() * 2, json.size());
+}
+
+TEST(PathTreeBinary, RejectsOtherVersions) {
+    Buffer<> buf;
+    uint32_t version = common::PATH_TREE_BINARY_VERSION + 1;
+    common::serialization::serializeRaw(buf, version);
+    uint32_t count = 0;
+    common::serialization::serializeRaw(buf, count);
+    common::serialization::serializeRaw(buf, count);
+    PathTree decoded;
+    ASSERT_THROW(common::binaryToPathTree(decoded, buf.data(), buf.size()),
+                 std::runtime_error);
+}
+
+TEST(PathTreeBinary, RejectsTruncatedData) {
+    PathTree tree;
+    setupTree(tree);
+    auto buf = toBinary(tree);
+    ASSERT_THROW(common::pathTreeSnapshotFromBinary(buf.data(), buf.size() - 1),
+                 std::runtime_error);
+}
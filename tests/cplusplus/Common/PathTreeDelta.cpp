@@ -0,0 +1,170 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/PathTreeDelta.h>
+#include <osvr/Common/PathTreeSerialization.h>
+#include <osvr/Common/PathElementTypes.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+using osvr::common::PathTreeDelta;
+using osvr::common::PathTreeSnapshot;
+
+namespace {
+inline PathTreeSnapshot getDummySnapshot() {
+    PathTree tree;
+    dummy::setupDummyTree(tree);
+    return common::pathTreeSnapshotFromJson(common::pathTreeToJson(tree));
+}
+} // namespace
+
+TEST(PathTreeDelta, IdenticalTreesHaveEmptyDelta) {
+    auto snapshot = getDummySnapshot();
+    ASSERT_FALSE(snapshot.empty());
+    auto delta = common::diffPathTreeSnapshots(snapshot, getDummySnapshot());
+    ASSERT_TRUE(delta.empty());
+}
+
+TEST(PathTreeDelta, DeltaFromEmptyIsWholeTree) {
+    auto snapshot = getDummySnapshot();
+    auto delta = common::diffPathTreeSnapshots(PathTreeSnapshot(), snapshot);
+    ASSERT_EQ(snapshot.size(), delta.changed.size());
+    ASSERT_TRUE(delta.removed.empty());
+
+    PathTreeSnapshot applied;
+    common::applyPathTreeDelta(applied, delta);
+    ASSERT_EQ(snapshot, applied);
+}
+
+TEST(PathTreeDelta, ChangedAddedAndRemovedNodes) {
+    PathTree tree;
+    dummy::setupDummyTree(tree);
+    auto before =
+        common::pathTreeSnapshotFromJson(common::pathTreeToJson(tree));
+
+    tree.getNodeByPath(dummy::getDevicePath()).value() =
+        common::elements::DeviceElement::createVRPNDeviceElement(
+            dummy::getDevice(), "otherhost");
+    tree.getNodeByPath("/me/head").value() =
+        common::elements::AliasElement(dummy::getFullSourcePath());
+    auto after =
+        common::pathTreeSnapshotFromJson(common::pathTreeToJson(tree));
+    // "Remove" a node the only way a serialized tree can: by leaving it out.
+    ASSERT_EQ(1u, after.erase(dummy::getAlias()));
+
+    auto delta = common::diffPathTreeSnapshots(before, after);
+    ASSERT_FALSE(delta.empty());
+    ASSERT_EQ(std::vector<std::string>{dummy::getAlias()}, delta.removed);
+    for (auto const &node : delta.changed) {
+        auto path = node["path"].asString();
+        ASSERT_TRUE(after.count(path) == 1) << path;
+        ASSERT_EQ(after[path], node);
+        if (before.count(path)) {
+            ASSERT_NE(before[path], node) << path;
+        }
+    }
+
+    auto applied = before;
+    common::applyPathTreeDelta(applied, delta);
+    ASSERT_EQ(after, applied);
+}
+
+TEST(PathTreeDelta, JsonRoundtrip) {
+    PathTreeSnapshot before;
+    auto after = getDummySnapshot();
+    before["/gone"] = Json::Value(Json::objectValue);
+    before["/gone"]["path"] = "/gone";
+    before["/gone"]["type"] = "NullElement";
+
+    auto delta = common::diffPathTreeSnapshots(before, after);
+    delta.version = 7;
+    delta.base = 6;
+    auto json = common::pathTreeDeltaToJson(delta);
+    auto roundtripped = common::pathTreeDeltaFromJson(json);
+    ASSERT_EQ(7u, roundtripped.version);
+    ASSERT_TRUE(bool(roundtripped.base));
+    ASSERT_EQ(6u, *roundtripped.base);
+    ASSERT_EQ(delta.changed, roundtripped.changed);
+    ASSERT_EQ(delta.removed, roundtripped.removed);
+}
+
+TEST(PathTreeDelta, AnnouncementHasNoBase) {
+    PathTreeDelta announcement;
+    announcement.version = 3;
+    auto roundtripped = common::pathTreeDeltaFromJson(
+        common::pathTreeDeltaToJson(announcement));
+    ASSERT_EQ(3u, roundtripped.version);
+    ASSERT_FALSE(bool(roundtripped.base));
+    ASSERT_TRUE(roundtripped.empty());
+}
+
+TEST(PathTreeDelta, HashOfIdenticalTreesMatches) {
+    PathTree a;
+    dummy::setupDummyTree(a);
+    PathTree b;
+    dummy::setupDummyTree(b);
+    ASSERT_EQ(common::hashPathTreeJson(common::pathTreeToJson(a)),
+              common::hashPathTreeJson(common::pathTreeToJson(b)));
+}
+
+TEST(PathTreeDelta, HashChangesWithContent) {
+    PathTree tree;
+    dummy::setupDummyTree(tree);
+    auto before = common::hashPathTreeJson(common::pathTreeToJson(tree));
+
+    tree.getNodeByPath("/me/head").value() =
+        common::elements::AliasElement(dummy::getFullSourcePath());
+    auto withAlias = common::hashPathTreeJson(common::pathTreeToJson(tree));
+    ASSERT_NE(before, withAlias);
+
+    tree.getNodeByPath(dummy::getDevicePath()).value() =
+        common::elements::DeviceElement::createVRPNDeviceElement(
+            dummy::getDevice(), "otherhost");
+    ASSERT_NE(withAlias,
+              common::hashPathTreeJson(common::pathTreeToJson(tree)));
+}
+
+TEST(PathTreeDelta, HashDistinguishesValueTypesAndBoundaries) {
+    Json::Value one(Json::arrayValue);
+    one.append("ab");
+    one.append("c");
+    Json::Value other(Json::arrayValue);
+    other.append("a");
+    other.append("bc");
+    ASSERT_NE(common::hashPathTreeJson(one), common::hashPathTreeJson(other));
+
+    ASSERT_NE(common::hashPathTreeJson(Json::Value(1)),
+              common::hashPathTreeJson(Json::Value(1.0)));
+    ASSERT_NE(common::hashPathTreeJson(Json::Value("1")),
+              common::hashPathTreeJson(Json::Value(1)));
+}
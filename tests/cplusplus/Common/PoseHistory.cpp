@@ -0,0 +1,158 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/PoseHistory.h>
+#include <osvr/Util/EigenInterop.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+// - none
+
+using osvr::common::PoseHistory;
+using osvr::util::time::TimeValue;
+
+namespace {
+inline TimeValue makeTime(int64_t microseconds) {
+    TimeValue ret;
+    ret.seconds = microseconds / 1000000;
+    ret.microseconds = static_cast<int32_t>(microseconds % 1000000);
+    return ret;
+}
+
+/// @brief Pose rotated about Y by the given angle, and translated along X by
+/// the given distance.
+inline OSVR_Pose3 makePose(double yaw, double x) {
+    OSVR_Pose3 ret;
+    osvr::util::toQuat(
+        Eigen::Quaterniond(Eigen::AngleAxisd(yaw, Eigen::Vector3d::UnitY())),
+        ret.rotation);
+    osvr::util::vecMap(ret.translation) = Eigen::Vector3d(x, 1, 0);
+    return ret;
+}
+
+inline double getYaw(OSVR_Pose3 const &pose) {
+    Eigen::AngleAxisd aa(osvr::util::fromQuat(pose.rotation));
+    return aa.angle() * aa.axis().dot(Eigen::Vector3d::UnitY());
+}
+
+inline double getX(OSVR_Pose3 const &pose) {
+    return osvr::util::vecMap(pose.translation).x();
+}
+} // namespace
+
+TEST(PoseHistory, Empty) {
+    PoseHistory history;
+    OSVR_Pose3 pose;
+    ASSERT_TRUE(history.empty());
+    ASSERT_FALSE(history.getPoseAt(makeTime(1000), pose));
+}
+
+TEST(PoseHistory, SingleEntry) {
+    PoseHistory history;
+    history.add(makeTime(1000), makePose(0.5, 2));
+    OSVR_Pose3 pose;
+    ASSERT_FALSE(history.getPoseAt(makeTime(999), pose));
+    ASSERT_TRUE(history.getPoseAt(makeTime(1000), pose));
+    ASSERT_NEAR(0.5, getYaw(pose), 1e-9);
+    // Can't predict motion from one entry: holds it.
+    ASSERT_TRUE(history.getPoseAt(makeTime(5000), pose));
+    ASSERT_NEAR(2, getX(pose), 1e-9);
+}
+
+TEST(PoseHistory, Interpolates) {
+    PoseHistory history;
+    history.add(makeTime(1000000), makePose(0, 0));
+    history.add(makeTime(1010000), makePose(0.4, 1));
+    history.add(makeTime(1020000), makePose(0.8, 3));
+    OSVR_Pose3 pose;
+    ASSERT_TRUE(history.getPoseAt(makeTime(1005000), pose));
+    ASSERT_NEAR(0.2, getYaw(pose), 1e-9);
+    ASSERT_NEAR(0.5, getX(pose), 1e-9);
+    ASSERT_NEAR(1, osvr::util::vecMap(pose.translation).y(), 1e-9);
+
+    ASSERT_TRUE(history.getPoseAt(makeTime(1017500), pose));
+    ASSERT_NEAR(0.7, getYaw(pose), 1e-9);
+    ASSERT_NEAR(2.5, getX(pose), 1e-9);
+
+    ASSERT_TRUE(history.getPoseAt(makeTime(1010000), pose));
+    ASSERT_NEAR(0.4, getYaw(pose), 1e-9);
+}
+
+TEST(PoseHistory, Predicts) {
+    PoseHistory history;
+    history.add(makeTime(2000000), makePose(0.1, 0));
+    history.add(makeTime(2010000), makePose(0.2, 0.01));
+    OSVR_Pose3 pose;
+    // 20ms past the newest report: two more steps of the same motion.
+    ASSERT_TRUE(history.getPoseAt(makeTime(2030000), pose));
+    ASSERT_NEAR(0.4, getYaw(pose), 1e-9);
+    ASSERT_NEAR(0.03, getX(pose), 1e-9);
+}
+
+TEST(PoseHistory, PredictsShortWayAround) {
+    PoseHistory history;
+    // Equivalent to a rotation of 3.1, but with the opposite quaternion sign
+    history.add(makeTime(1000000), makePose(3.1, 0));
+    history.add(makeTime(1010000), makePose(3.2, 0));
+    OSVR_Pose3 pose;
+    ASSERT_TRUE(history.getPoseAt(makeTime(1020000), pose));
+    Eigen::Quaterniond expected(
+        Eigen::AngleAxisd(3.3, Eigen::Vector3d::UnitY()));
+    ASSERT_NEAR(1, std::abs(expected.dot(osvr::util::fromQuat(pose.rotation))),
+                1e-9);
+}
+
+TEST(PoseHistory, OutOfOrderKeptInPlace) {
+    PoseHistory history;
+    history.add(makeTime(1000000), makePose(0, 0));
+    history.add(makeTime(1020000), makePose(0, 2));
+    history.add(makeTime(1010000), makePose(0, 10));
+    ASSERT_EQ(3u, history.size());
+    OSVR_Pose3 pose;
+    ASSERT_TRUE(history.getPoseAt(makeTime(1010000), pose));
+    ASSERT_NEAR(10, getX(pose), 1e-9);
+    ASSERT_TRUE(history.getPoseAt(makeTime(1015000), pose));
+    ASSERT_NEAR(6, getX(pose), 1e-9);
+}
+
+TEST(PoseHistory, FixedCapacity) {
+    PoseHistory history(4);
+    for (int i = 0; i < 10; ++i) {
+        history.add(makeTime(1000000 + i * 1000), makePose(0, i));
+    }
+    ASSERT_EQ(4u, history.size());
+    OSVR_Pose3 pose;
+    ASSERT_FALSE(history.getPoseAt(makeTime(1005000), pose));
+    ASSERT_TRUE(history.getPoseAt(makeTime(1006000), pose));
+    ASSERT_NEAR(6, getX(pose), 1e-9);
+
+    // Too old to fit
+    history.add(makeTime(1000000), makePose(0, 100));
+    ASSERT_EQ(4u, history.size());
+    ASSERT_FALSE(history.getPoseAt(makeTime(1000000), pose));
+}
@@ -0,0 +1,91 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "DummyTree.h"
+#include <osvr/Common/ResolvedRouteCache.h>
+#include <osvr/Common/ResolveTreeNode.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+
+// Standard includes
+// - none
+
+namespace common = osvr::common;
+using osvr::common::PathTree;
+using osvr::common::ResolvedRouteCache;
+
+class ResolvedRouteCacheTest : public ::testing::Test {
+  public:
+    ResolvedRouteCacheTest() { dummy::setupDummyTree(tree); }
+    PathTree tree;
+    ResolvedRouteCache cache;
+};
+
+TEST_F(ResolvedRouteCacheTest, MatchesUncachedResolution) {
+    auto const &cached = cache.resolve(tree, dummy::getAlias());
+    ASSERT_TRUE(cached.is_initialized());
+    auto uncached = common::resolveTreeNode(tree, dummy::getAlias());
+    ASSERT_TRUE(uncached.is_initialized());
+    ASSERT_EQ(uncached->getDevicePath(), cached->getDevicePath());
+    ASSERT_EQ(uncached->getInterfaceName(), cached->getInterfaceName());
+    ASSERT_EQ(uncached->getSensorNumber(), cached->getSensorNumber());
+    ASSERT_EQ(uncached->getTransformJson(), cached->getTransformJson());
+    ASSERT_EQ(1u, cache.size());
+}
+
+TEST_F(ResolvedRouteCacheTest, KeepsResultUntilInvalidated) {
+    ASSERT_TRUE(cache.resolve(tree, dummy::getAlias()).is_initialized());
+
+    // Point the alias somewhere that doesn't resolve.
+    tree.getNodeByPath(dummy::getAlias()).value() =
+        common::elements::AliasElement("/nowhere");
+    ASSERT_TRUE(cache.resolve(tree, dummy::getAlias()).is_initialized());
+
+    auto generation = cache.getGeneration();
+    cache.invalidate();
+    ASSERT_NE(generation, cache.getGeneration());
+    ASSERT_FALSE(cache.resolve(tree, dummy::getAlias()).is_initialized());
+    ASSERT_EQ(1u, cache.size());
+}
+
+TEST_F(ResolvedRouteCacheTest, TransformsAreKept) {
+    Json::Value alias(Json::objectValue);
+    alias["rotate"]["axis"] = "x";
+    alias["rotate"]["degrees"] = 90;
+    alias["child"] = dummy::getFullSourcePath();
+    tree.getNodeByPath(dummy::getAlias()).value() =
+        common::elements::AliasElement(alias.toStyledString());
+    cache.invalidate();
+
+    auto const &source = cache.resolve(tree, dummy::getAlias());
+    ASSERT_TRUE(source.is_initialized());
+    ASSERT_TRUE(source->hasTransform());
+    auto transform = source->getTransformJson();
+    ASSERT_EQ(90, transform["rotate"]["degrees"].asInt());
+    ASSERT_EQ(dummy::getFullSourcePath(), transform["child"].asString());
+}
@@ -0,0 +1,121 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/Tracing.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <json/value.h>
+#include <json/reader.h>
+
+// Standard includes
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifdef OSVR_COMMON_TRACING_RINGLOG
+namespace tracing = osvr::common::tracing;
+
+namespace {
+inline Json::Value getTrace() {
+    std::ostringstream os;
+    tracing::writeChromeTrace(os);
+    Json::Value ret;
+    Json::Reader reader;
+    if (!reader.parse(os.str(), ret)) {
+        ADD_FAILURE() << "Trace isn't valid JSON: " << os.str();
+    }
+    return ret;
+}
+
+/// @brief Counts events with the given name and phase.
+inline int countEvents(Json::Value const &trace, std::string const &name,
+                       std::string const &phase) {
+    int ret = 0;
+    for (auto const &evt : trace["traceEvents"]) {
+        if (evt["name"].asString() == name && evt["ph"].asString() == phase) {
+            ++ret;
+        }
+    }
+    return ret;
+}
+} // namespace
+
+TEST(TracingRingLog, RegionsAndMarks) {
+    {
+        tracing::ServerUpdate region;
+        tracing::markNewTrackerData();
+    }
+    tracing::markGetState("/me/head \"quoted\"");
+    auto trace = getTrace();
+    ASSERT_TRUE(trace["traceEvents"].isArray());
+    ASSERT_GE(countEvents(trace, "ServerUpdate", "B"), 1);
+    ASSERT_EQ(countEvents(trace, "ServerUpdate", "B"),
+              countEvents(trace, "ServerUpdate", "E"));
+    ASSERT_GE(countEvents(trace, "New tracker data", "i"), 1);
+    ASSERT_GE(countEvents(trace, "GetState /me/head \"quoted\"", "i"), 1);
+
+    double lastTs = -1;
+    for (auto const &evt : trace["traceEvents"]) {
+        ASSERT_TRUE(evt["ts"].isNumeric());
+        ASSERT_TRUE(evt["tid"].isNumeric());
+        if (evt["name"].asString() == "ServerUpdate") {
+            // Single thread here, so should be in order.
+            ASSERT_GE(evt["ts"].asDouble(), lastTs);
+            lastTs = evt["ts"].asDouble();
+        }
+    }
+}
+
+TEST(TracingRingLog, EventsFromOtherThreadsKept) {
+    std::thread worker([] { tracing::ClientUpdate region; });
+    worker.join();
+    auto trace = getTrace();
+    Json::Value tid;
+    for (auto const &evt : trace["traceEvents"]) {
+        if (evt["name"].asString() == "ClientUpdate") {
+            tid = evt["tid"];
+        }
+    }
+    ASSERT_FALSE(tid.isNull());
+    ASSERT_EQ(1, countEvents(trace, "ClientUpdate", "E"));
+}
+
+TEST(TracingRingLog, OverwrittenRegionsStayBalanced) {
+    std::thread worker([] {
+        for (int i = 0; i < 50000; ++i) {
+            tracing::ClientUpdate region;
+            tracing::markTimestampOutOfOrder();
+        }
+    });
+    worker.join();
+    auto trace = getTrace();
+    auto begins = countEvents(trace, "ClientUpdate", "B");
+    ASSERT_GT(begins, 0);
+    ASSERT_LT(begins, 50000);
+    ASSERT_EQ(begins, countEvents(trace, "ClientUpdate", "E"));
+}
+#endif // OSVR_COMMON_TRACING_RINGLOG
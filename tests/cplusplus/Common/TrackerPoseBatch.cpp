@@ -0,0 +1,148 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Common/TrackerPoseBatch.h>
+#include <osvr/Common/Serialization.h>
+#include <osvr/Common/Buffer.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <stdexcept>
+
+using osvr::common::Buffer;
+using osvr::common::SensorPose;
+using osvr::common::SensorPoseList;
+typedef osvr::common::messages::TrackerPoseBatch::MessageSerialization
+    BatchSerialization;
+
+static SensorPoseList makePoses(std::size_t n) {
+    SensorPoseList ret(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ret[i].sensor = static_cast<OSVR_ChannelCount>(2 * i + 1);
+        ret[i].pose.translation.data[0] = 0.5 * i;
+        ret[i].pose.translation.data[1] = -1.0 * i;
+        ret[i].pose.translation.data[2] = 3.25;
+        ret[i].pose.rotation.data[0] = 0.5;
+        ret[i].pose.rotation.data[1] = -0.5;
+        ret[i].pose.rotation.data[2] = 0.5;
+        ret[i].pose.rotation.data[3] = -0.5;
+    }
+    return ret;
+}
+
+static Buffer<> serializePoses(SensorPoseList poses) {
+    Buffer<> buf;
+    BatchSerialization msg(poses);
+    osvr::common::serialize(buf, msg);
+    return buf;
+}
+
+TEST(TrackerPoseBatch, EmptyRoundTrip) {
+    auto buf = serializePoses(SensorPoseList());
+    auto reader = buf.startReading();
+    SensorPoseList out = makePoses(3);
+    BatchSerialization msg(out);
+    osvr::common::deserialize(reader, msg);
+    ASSERT_TRUE(out.empty());
+    ASSERT_EQ(reader.bytesRemaining(), 0);
+}
+
+TEST(TrackerPoseBatch, RoundTrip) {
+    auto in = makePoses(32);
+    auto buf = serializePoses(in);
+    auto reader = buf.startReading();
+    SensorPoseList out;
+    BatchSerialization msg(out);
+    osvr::common::deserialize(reader, msg);
+    ASSERT_EQ(reader.bytesRemaining(), 0);
+    ASSERT_EQ(in.size(), out.size());
+    for (std::size_t i = 0; i < in.size(); ++i) {
+        ASSERT_EQ(in[i].sensor, out[i].sensor);
+        for (int j = 0; j < 3; ++j) {
+            ASSERT_EQ(in[i].pose.translation.data[j],
+                      out[i].pose.translation.data[j]);
+        }
+        for (int j = 0; j < 4; ++j) {
+            ASSERT_EQ(in[i].pose.rotation.data[j],
+                      out[i].pose.rotation.data[j]);
+        }
+    }
+}
+
+TEST(TrackerPoseBatch, ReusesStorage) {
+    SensorPoseList out;
+    {
+        auto buf = serializePoses(makePoses(8));
+        auto reader = buf.startReading();
+        BatchSerialization msg(out);
+        osvr::common::deserialize(reader, msg);
+    }
+    auto capacity = out.capacity();
+    auto buf = serializePoses(makePoses(4));
+    auto reader = buf.startReading();
+    BatchSerialization msg(out);
+    osvr::common::deserialize(reader, msg);
+    ASSERT_EQ(out.size(), 4);
+    ASSERT_EQ(out.capacity(), capacity);
+}
+
+TEST(TrackerPoseBatch, SizeMatchesBudget) {
+    typedef osvr::common::messages::TrackerPoseBatch TrackerPoseBatch;
+    for (std::size_t n : {1, 2, 3, 22, 100}) {
+        ASSERT_LE(serializePoses(makePoses(n)).size(),
+                  n * TrackerPoseBatch::BYTES_PER_POSE);
+    }
+    ASSERT_LE(serializePoses(makePoses(TrackerPoseBatch::MAX_POSES)).size() +
+                  TrackerPoseBatch::OVERHEAD_BYTES,
+              std::size_t(vrpn_CONNECTION_TCP_BUFLEN));
+    auto udpPoses = TrackerPoseBatch::getMaxPoses(vrpn_CONNECTION_UDP_BUFLEN);
+    ASSERT_GT(udpPoses, 0);
+    ASSERT_LE(serializePoses(makePoses(udpPoses)).size() +
+                  TrackerPoseBatch::OVERHEAD_BYTES,
+              std::size_t(vrpn_CONNECTION_UDP_BUFLEN));
+    ASSERT_EQ(TrackerPoseBatch::getMaxPoses(10), 0);
+}
+
+TEST(TrackerPoseBatch, RejectsOversizedCount) {
+    Buffer<> buf;
+    uint32_t count =
+        osvr::common::messages::TrackerPoseBatch::MAX_POSES + 1;
+    osvr::common::serialization::serializeRaw(buf, count);
+    auto reader = buf.startReading();
+    SensorPoseList out;
+    BatchSerialization msg(out);
+    ASSERT_THROW(osvr::common::deserialize(reader, msg), std::runtime_error);
+}
+
+TEST(TrackerPoseBatch, RejectsTruncatedMessage) {
+    auto buf = serializePoses(makePoses(2));
+    auto reader = osvr::common::readExternalBuffer(buf.data(), buf.size() - 1);
+    SensorPoseList out;
+    BatchSerialization msg(out);
+    ASSERT_THROW(osvr::common::deserialize(reader, msg), std::runtime_error);
+}
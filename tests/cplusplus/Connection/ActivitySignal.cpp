@@ -0,0 +1,69 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/ActivitySignal.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <chrono>
+
+using osvr::connection::ActivitySignal;
+typedef std::chrono::steady_clock clock_type;
+
+/// @brief Much longer than any of these tests should take.
+static const int LONG_WAIT = 10 * 1000 * 1000;
+
+TEST(ActivitySignal, TimesOutWithoutSignal) {
+    ActivitySignal activity;
+    ASSERT_FALSE(activity.wait(0));
+    ASSERT_FALSE(activity.wait(1000));
+}
+
+TEST(ActivitySignal, SignalBeforeWaitIsKept) {
+    ActivitySignal activity;
+    activity.signal();
+    activity.signal();
+    auto start = clock_type::now();
+    ASSERT_TRUE(activity.wait(LONG_WAIT));
+    ASSERT_LT(clock_type::now() - start, std::chrono::seconds(1));
+    // Consumed by the wait, no matter how many signals there were.
+    ASSERT_FALSE(activity.wait(0));
+}
+
+TEST(ActivitySignal, SignalFromOtherThreadWakes) {
+    ActivitySignal activity;
+    auto start = clock_type::now();
+    boost::thread signaller([&] {
+        boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+        activity.signal();
+    });
+    ASSERT_TRUE(activity.wait(LONG_WAIT));
+    signaller.join();
+    ASSERT_LT(clock_type::now() - start, std::chrono::seconds(5));
+}
@@ -159,3 +159,31 @@ TEST(AsyncAccessControl, recursive) {
     ASSERT_FALSE(control.mainThreadCTS())
         << "CTS should have no tasks waiting.";
 }
+
+TEST(AsyncAccessControl, notifiedOncePending) {
+    boost::mutex mut;
+    boost::condition_variable cond;
+    bool notified = false;
+    AsyncAccessControl control([&] {
+        boost::lock_guard<boost::mutex> lock(mut);
+        notified = true;
+        cond.notify_one();
+    });
+    volatile bool sent = false;
+
+    ScopedThread asyncThread(new boost::thread([&] {
+        RequestToSend rts(control);
+        ASSERT_TRUE(rts.request()) << "Request should be approved";
+        sent = true;
+    }));
+
+    {
+        boost::unique_lock<boost::mutex> lock(mut);
+        while (!notified) {
+            cond.wait(lock);
+        }
+    }
+    ASSERT_TRUE(control.mainThreadCTS())
+        << "Request should be pending by the time we're notified.";
+    ASSERT_TRUE(sent) << "Should have sent";
+}
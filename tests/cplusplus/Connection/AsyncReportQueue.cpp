@@ -0,0 +1,160 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Connection/AsyncReportQueue.h"
+#include "../../../src/osvr/Connection/AsyncReportQueue.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+#include <vector>
+
+using namespace osvr::connection;
+
+namespace {
+inline AsyncQueueOptions makeOptions(std::size_t capacity,
+                                     AsyncQueueFullPolicy policy) {
+    AsyncQueueOptions opts;
+    opts.capacity = capacity;
+    opts.policy = policy;
+    return opts;
+}
+
+inline bool pushValue(AsyncReportQueue &queue, int value) {
+    osvr::util::time::TimeValue tv = {value, 0};
+    return queue.push(tv, nullptr, reinterpret_cast<const char *>(&value),
+                      sizeof(value));
+}
+
+inline std::vector<int> drainValues(AsyncReportQueue &queue) {
+    std::vector<int> ret;
+    queue.drain([&](QueuedReport const &report) {
+        EXPECT_EQ(sizeof(int), report.data.size());
+        int value = *reinterpret_cast<const int *>(report.data.data());
+        EXPECT_EQ(value, report.timestamp.seconds);
+        ret.push_back(value);
+    });
+    return ret;
+}
+} // namespace
+
+TEST(AsyncReportQueue, empty) {
+    AsyncReportQueue queue;
+    ASSERT_EQ(0u, queue.size());
+    ASSERT_EQ(0u, queue.drain([](QueuedReport const &) {
+        FAIL() << "Should not be called on an empty queue";
+    }));
+}
+
+TEST(AsyncReportQueue, preservesOrder) {
+    AsyncReportQueue queue(makeOptions(4, AsyncQueueFullPolicy::DropNewest));
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(pushValue(queue, i));
+    }
+    ASSERT_EQ(3u, queue.size());
+    ASSERT_EQ((std::vector<int>{0, 1, 2}), drainValues(queue));
+    ASSERT_EQ(0u, queue.size());
+}
+
+TEST(AsyncReportQueue, dropNewest) {
+    AsyncReportQueue queue(makeOptions(2, AsyncQueueFullPolicy::DropNewest));
+    ASSERT_TRUE(pushValue(queue, 1));
+    ASSERT_TRUE(pushValue(queue, 2));
+    ASSERT_FALSE(pushValue(queue, 3));
+    ASSERT_EQ(1u, queue.droppedCount());
+    ASSERT_EQ((std::vector<int>{1, 2}), drainValues(queue));
+}
+
+TEST(AsyncReportQueue, dropOldest) {
+    AsyncReportQueue queue(makeOptions(2, AsyncQueueFullPolicy::DropOldest));
+    ASSERT_TRUE(pushValue(queue, 1));
+    ASSERT_TRUE(pushValue(queue, 2));
+    ASSERT_TRUE(pushValue(queue, 3));
+    ASSERT_TRUE(pushValue(queue, 4));
+    ASSERT_EQ(2u, queue.droppedCount());
+    ASSERT_EQ((std::vector<int>{3, 4}), drainValues(queue));
+}
+
+TEST(AsyncReportQueue, closeRejects) {
+    AsyncReportQueue queue(makeOptions(2, AsyncQueueFullPolicy::Block));
+    queue.close();
+    ASSERT_FALSE(pushValue(queue, 1));
+    ASSERT_EQ(0u, queue.size());
+}
+
+TEST(AsyncReportQueue, blockedProducerReleasedByClose) {
+    AsyncReportQueue queue(makeOptions(1, AsyncQueueFullPolicy::Block));
+    ASSERT_TRUE(pushValue(queue, 1));
+    bool result = true;
+    boost::thread producer([&] { result = pushValue(queue, 2); });
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    queue.close();
+    producer.join();
+    ASSERT_FALSE(result);
+}
+
+TEST(AsyncReportQueue, blockingProducerLosesNothing) {
+    static const int COUNT = 10000;
+    AsyncReportQueue queue(makeOptions(8, AsyncQueueFullPolicy::Block));
+    boost::thread producer([&] {
+        for (int i = 0; i < COUNT; ++i) {
+            pushValue(queue, i);
+        }
+    });
+    std::vector<int> received;
+    while (received.size() < COUNT) {
+        auto batch = drainValues(queue);
+        received.insert(received.end(), batch.begin(), batch.end());
+        boost::this_thread::yield();
+    }
+    producer.join();
+    ASSERT_EQ(0u, queue.droppedCount());
+    for (int i = 0; i < COUNT; ++i) {
+        ASSERT_EQ(i, received[i]);
+    }
+}
+
+TEST(AsyncReportQueue, droppingProducerStaysOrdered) {
+    static const int COUNT = 100000;
+    AsyncReportQueue queue(makeOptions(4, AsyncQueueFullPolicy::DropOldest));
+    std::atomic<bool> done(false);
+    boost::thread producer([&] {
+        for (int i = 0; i < COUNT; ++i) {
+            pushValue(queue, i);
+        }
+        done = true;
+    });
+    int last = -1;
+    while (!done || queue.size() > 0) {
+        for (auto value : drainValues(queue)) {
+            ASSERT_GT(value, last);
+            last = value;
+        }
+    }
+    producer.join();
+}
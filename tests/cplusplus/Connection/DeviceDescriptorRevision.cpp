@@ -0,0 +1,92 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include <osvr/Connection/ConnectionDevice.h>
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+
+// Standard includes
+#include <string>
+
+namespace {
+class TestDevice : public osvr::connection::ConnectionDevice {
+  public:
+    explicit TestDevice(std::string const &name) : ConnectionDevice(name) {}
+
+  private:
+    void m_process() override {}
+    void m_sendData(osvr::util::time::TimeValue const &,
+                    osvr::connection::MessageType *, const char *,
+                    size_t) override {}
+};
+} // namespace
+
+TEST(DeviceDescriptorRevision, ZeroUntilSet) {
+    TestDevice dev("dev");
+    ASSERT_EQ(0, dev.getDeviceDescriptorRevision());
+    dev.setDeviceDescriptor("");
+    ASSERT_NE(0, dev.getDeviceDescriptorRevision())
+        << "Setting even an empty descriptor is a change";
+}
+
+TEST(DeviceDescriptorRevision, ChangesOnlyWithContent) {
+    TestDevice dev("dev");
+    dev.setDeviceDescriptor("{\"interfaces\": {}}");
+    auto first = dev.getDeviceDescriptorRevision();
+    dev.setDeviceDescriptor("{\"interfaces\": {}}");
+    ASSERT_EQ(first, dev.getDeviceDescriptorRevision());
+
+    dev.setDeviceDescriptor("{\"interfaces\": {\"tracker\": {}}}");
+    auto second = dev.getDeviceDescriptorRevision();
+    ASSERT_NE(first, second);
+
+    // Going back to an earlier descriptor is still a change.
+    dev.setDeviceDescriptor("{\"interfaces\": {}}");
+    ASSERT_NE(first, dev.getDeviceDescriptorRevision());
+    ASSERT_NE(second, dev.getDeviceDescriptorRevision());
+}
+
+TEST(DeviceDescriptorRevision, UniqueAcrossDevices) {
+    TestDevice a("a");
+    TestDevice b("b");
+    a.setDeviceDescriptor("{}");
+    b.setDeviceDescriptor("{}");
+    ASSERT_NE(a.getDeviceDescriptorRevision(),
+              b.getDeviceDescriptorRevision());
+
+    // A device replacing one of the same name can't be mistaken for it.
+    std::string const descriptor = "{\"interfaces\": {}}";
+    uint64_t oldRevision;
+    {
+        TestDevice old("dev");
+        old.setDeviceDescriptor(descriptor);
+        oldRevision = old.getDeviceDescriptorRevision();
+    }
+    TestDevice replacement("dev");
+    replacement.setDeviceDescriptor(descriptor);
+    ASSERT_NE(oldRevision, replacement.getDeviceDescriptorRevision());
+}
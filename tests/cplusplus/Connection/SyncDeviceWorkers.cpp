@@ -0,0 +1,142 @@
+/** @file
+    @brief Test Implementation
+
+    @date 2015
+
+    @author
+    Sensics, Inc.
+    <http://sensics.com/osvr>
+
+*/
+
+// Copyright 2015 Sensics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Internal Includes
+#include "../../../src/osvr/Connection/SyncDeviceWorkers.h"
+#include "../../../src/osvr/Connection/SyncDeviceWorkers.cpp"
+
+// Library/third-party includes
+#include "gtest/gtest.h"
+#include <boost/thread/thread.hpp>
+
+// Standard includes
+#include <atomic>
+
+using namespace osvr::connection;
+
+namespace {
+inline SyncDeviceThreadOptions makeOptions(std::size_t threads) {
+    SyncDeviceThreadOptions opts;
+    opts.threads = threads;
+    opts.groups["com_osvr_Serial"] = "serial";
+    opts.groups["com_osvr_Other/Slow"] = "serial";
+    return opts;
+}
+
+/// @brief Kick until the counter reaches the target, with a generous limit.
+inline bool kickUntil(SyncDeviceWorkers::Registration &reg,
+                      std::atomic<int> const &counter, int target) {
+    for (int i = 0; i < 10000 && counter < target; ++i) {
+        reg.kick();
+        boost::this_thread::sleep(boost::posix_time::milliseconds(1));
+    }
+    return counter >= target;
+}
+} // namespace
+
+TEST(SyncDeviceWorkers, NoThreadsRunsInMainLoop) {
+    SyncDeviceWorkers workers{SyncDeviceThreadOptions()};
+    ASSERT_EQ(0u, workers.size());
+    ASSERT_FALSE(bool(workers.add("com_osvr_Test/Dev", [] {})));
+}
+
+TEST(SyncDeviceWorkers, Groups) {
+    SyncDeviceWorkers workers{makeOptions(2)};
+    ASSERT_EQ("com_osvr_Test", workers.getGroup("com_osvr_Test/Dev"));
+    ASSERT_EQ("serial", workers.getGroup("com_osvr_Serial/Dev"));
+    ASSERT_EQ("serial", workers.getGroup("com_osvr_Other/Slow"));
+    ASSERT_EQ("com_osvr_Other", workers.getGroup("com_osvr_Other/Fast"));
+
+    auto serial = workers.getWorkerIndex("com_osvr_Serial/Dev");
+    ASSERT_EQ(serial, workers.getWorkerIndex("com_osvr_Other/Slow"));
+    ASSERT_NE(serial, workers.getWorkerIndex("com_osvr_Other/Fast"));
+    ASSERT_EQ(workers.getWorkerIndex("com_osvr_Other/Fast"),
+              workers.getWorkerIndex("com_osvr_Other/Another"));
+}
+
+TEST(SyncDeviceWorkers, RunsOffThreadWhenKicked) {
+    SyncDeviceWorkers workers{makeOptions(1)};
+    std::atomic<int> calls(0);
+    std::atomic<bool> onMainThread(false);
+    auto mainThread = boost::this_thread::get_id();
+    auto reg = workers.add("com_osvr_Test/Dev", [&] {
+        if (boost::this_thread::get_id() == mainThread) {
+            onMainThread = true;
+        }
+        ++calls;
+    });
+    ASSERT_TRUE(bool(reg));
+    boost::this_thread::sleep(boost::posix_time::milliseconds(50));
+    ASSERT_EQ(0, calls) << "Shouldn't run until kicked.";
+    ASSERT_TRUE(kickUntil(*reg, calls, 3));
+    ASSERT_FALSE(onMainThread);
+}
+
+TEST(SyncDeviceWorkers, SlowGroupDoesNotHoldUpOthers) {
+    SyncDeviceWorkers workers{makeOptions(2)};
+    std::atomic<bool> release(false);
+    std::atomic<int> slowCalls(0);
+    std::atomic<int> fastCalls(0);
+    auto slow = workers.add("com_osvr_Serial/Dev", [&] {
+        ++slowCalls;
+        while (!release) {
+            boost::this_thread::yield();
+        }
+    });
+    auto fast = workers.add("com_osvr_Test/Dev", [&] { ++fastCalls; });
+    slow->kick();
+    auto fastRan = kickUntil(*fast, fastCalls, 5);
+    int slowCallsSeen = slowCalls;
+    // Release before asserting: a failed assertion returns, and tearing down
+    // would wait forever on the slow device.
+    release = true;
+    ASSERT_TRUE(fastRan);
+    ASSERT_EQ(1, slowCallsSeen);
+}
+
+TEST(SyncDeviceWorkers, RemovalWaitsForRunningUpdate) {
+    SyncDeviceWorkers workers{makeOptions(1)};
+    std::atomic<bool> started(false);
+    std::atomic<bool> finished(false);
+    std::atomic<int> calls(0);
+    auto reg = workers.add("com_osvr_Test/Dev", [&] {
+        ++calls;
+        started = true;
+        boost::this_thread::sleep(boost::posix_time::milliseconds(100));
+        finished = true;
+    });
+    reg->kick();
+    while (!started) {
+        boost::this_thread::yield();
+    }
+    reg.reset();
+    ASSERT_TRUE(finished) << "Removal should wait for the update to return.";
+
+    // And it doesn't run again.
+    std::atomic<int> otherCalls(0);
+    auto other = workers.add("com_osvr_Test/Other", [&] { ++otherCalls; });
+    ASSERT_TRUE(kickUntil(*other, otherCalls, 2));
+    ASSERT_EQ(1, calls);
+}
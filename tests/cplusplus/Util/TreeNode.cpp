@@ -31,6 +31,7 @@
 
 // Standard includes
 #include <string>
+#include <vector>
 
 using std::string;
 using osvr::util::TreeNode;
@@ -314,3 +315,53 @@ TEST(TreeNode, ParentPointers) {
     ParentCheckerVisitor visitor;
     visitor(*tree);
 }
+
+class NameOrderVisitor {
+  public:
+    void operator()(IntTree const &node) { names.push_back(node.getName()); }
+    std::vector<string> names;
+};
+
+TEST(TreeNode, ManyChildren) {
+    // Enough children that lookups go through the index.
+    static const int CHILDREN = 1000;
+    IntTreePtr tree(IntTree::createRoot());
+    std::vector<string> names;
+    for (int i = 0; i < CHILDREN; ++i) {
+        // Descending, so creation order differs from sorted order.
+        names.push_back(std::to_string(CHILDREN - i));
+        IntTree::create(*tree, names.back(), i);
+    }
+    ASSERT_EQ(tree->numChildren(), names.size());
+    for (int i = 0; i < CHILDREN; ++i) {
+        ASSERT_EQ(tree->getChildByName(names[i]).value(), i);
+        ASSERT_EQ(tree->getOrCreateChildByName(names[i]).value(), i)
+            << "Should just retrieve the child";
+    }
+    ASSERT_EQ(tree->numChildren(), names.size());
+    ASSERT_THROW((IntTree::create(*tree, names[CHILDREN / 2])),
+                 std::logic_error)
+        << "Can't create a duplicate-named child";
+    ASSERT_THROW(tree->getChildByName("0"), osvr::util::tree::NoSuchChild);
+
+    IntTree::create(*tree, "0");
+    names.push_back("0");
+    ASSERT_NO_THROW(tree->getChildByName("0"));
+
+    NameOrderVisitor visitor;
+    tree->visitConstChildren(visitor);
+    ASSERT_EQ(visitor.names, names) << "Visited in creation order";
+}
+
+TEST(TreeNode, Paths) {
+    IntTreePtr tree(IntTree::createRoot());
+    ASSERT_EQ(tree->getPath(), "/") << "Root";
+    auto &a = tree->getOrCreateChildByName("A");
+    ASSERT_EQ(a.getPath(), "/A") << "First level";
+    auto &b = IntTree::create(a, "B", 5);
+    ASSERT_EQ(b.getPath(), "/A/B") << "Second level";
+    ASSERT_EQ(b.getOrCreateChildByName("C").getPath(), "/A/B/C")
+        << "Third level";
+    ASSERT_EQ(&a.getPath(), &tree->getOrCreateChildByName("A").getPath())
+        << "Path is stored, not rebuilt";
+}